@@ -0,0 +1,633 @@
+// End-to-end throughput benchmark. Starts the loopback mock server, points the SDK
+// at it and drives the public C interface through scripted workloads:
+//
+//   browse     pages through the mod catalog one page at a time
+//   subscribe  subscribes to many mods at once and lists the subscriptions back
+//   update     polls a large batch of mod events for installed mods, then downloads
+//              and installs every mod whose modfile changed
+//   upload     uploads a single large modfile
+//   resume     downloads and installs mods over a link that keeps dropping, so every
+//              mod goes through the resume path
+//   replay     records a browse, then browses again from the recording without the
+//              server, latency and bandwidth are emulated by the replay transport
+//
+// Usage: modio_bench [--workloads=browse,subscribe,update,upload,resume,replay] [--pages=50]
+//                    [--subscriptions=500] [--events=10000] [--installed=50]
+//                    [--downloads=20] [--mod-kb=512] [--upload-mb=2048] [--frame-ms=1]
+//                    [--timeout-s=600] [--work-dir=modio_bench_data] [--json]
+//
+// Network conditions, applied to every workload:
+//                    [--latency-ms=0] [--bandwidth-kbps=0] [--stall-rate=0]
+//                    [--stall-ms=200] [--disconnect-rate=0] [--error-every=0]
+//                    [--error-burst=0] [--error-code=503] [--seed=1]
+// The resume workload drops a third of the transfers unless --disconnect-rate is given.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <time.h>
+
+#include "c/ModioC.h"
+#include "Globals.h"
+#include "Utility.h"
+#include "wrappers/MinizipWrapper.h"
+#include "wrappers/ReplayTransport.h"
+#include "mock_server.h"
+#include "network_emulator.h"
+
+#define BENCH_GAME_ID 7
+#define BENCH_API_KEY "bench"
+#define BENCH_RESUME_DISCONNECT_RATE 0.33
+
+struct BenchOptions
+{
+  std::vector<std::string> workloads;
+  u32 pages = 50;
+  u32 page_size = 100;
+  u32 subscriptions = 500;
+  u32 events = 10000;
+  u32 installed = 50;
+  u32 downloads = 20;
+  u32 mod_kb = 512;
+  u32 upload_mb = 2048;
+  u32 frame_ms = 1;
+  u32 timeout_seconds = 600;
+  std::string work_dir = "modio_bench_data";
+  bool json = false;
+  modio_bench::NetworkConditions conditions;
+  bool disconnect_rate_set = false;
+  u32 seed = 1;
+};
+
+struct WorkloadResult
+{
+  std::string name;
+  bool ok = false;
+  u64 requests = 0;
+  u64 bytes = 0;
+  double seconds = 0;
+  double cpu_seconds = 0;
+  u64 faults = 0;
+  u64 resumes = 0;
+  std::vector<double> latencies_ms;
+};
+
+static BenchOptions g_options;
+static modio_bench::MockServer *g_server = NULL;
+static modio_bench::NetworkEmulator *g_network_emulator = NULL;
+static WorkloadResult *g_result = NULL;
+static u32 g_finished_calls = 0;
+static u32 g_failed_calls = 0;
+static double g_last_completion = 0;
+
+static double getMillis()
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The SDK does all of its work on the thread calling modioProcess, server threads are not counted
+static double getThreadCpuSeconds()
+{
+  timespec cpu_time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time);
+  return cpu_time.tv_sec + cpu_time.tv_nsec / 1e9;
+}
+
+static double getPeakRssMB()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+  return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+static double getPercentile(std::vector<double> samples, double percentile)
+{
+  if (samples.empty())
+    return 0;
+  std::sort(samples.begin(), samples.end());
+  size_t index = (size_t)(percentile / 100.0 * (samples.size() - 1) + 0.5);
+  return samples[std::min(index, samples.size() - 1)];
+}
+
+// Calls modioProcess once per frame until done() returns true, the way a game loop would
+static bool runFrames(const std::function<bool()> &done)
+{
+  double deadline = getMillis() + g_options.timeout_seconds * 1000.0;
+  while (!done())
+  {
+    if (getMillis() > deadline)
+      return false;
+    modioProcess();
+    if (g_options.frame_ms > 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(g_options.frame_ms));
+  }
+  return true;
+}
+
+static void recordCallback(void *object, u32 response_code)
+{
+  double *issued_at = (double *)object;
+  double now = getMillis();
+  g_result->latencies_ms.push_back(now - *issued_at);
+  g_last_completion = now;
+  delete issued_at;
+
+  g_finished_calls++;
+  if (response_code < 200 || response_code >= 300)
+    g_failed_calls++;
+}
+
+static void onGetAllMods(void *object, ModioResponse response, ModioMod mods[], u32 mods_size)
+{
+  recordCallback(object, response.code);
+}
+
+static void onSubscribeToMod(void *object, ModioResponse response, ModioMod mod)
+{
+  recordCallback(object, response.code);
+}
+
+static u32 g_subscriptions_listed = 0;
+
+static void onGetUserSubscriptions(void *object, ModioResponse response, ModioMod mods[], u32 mods_size)
+{
+  g_subscriptions_listed += mods_size;
+  recordCallback(object, response.code);
+}
+
+static u32 g_events_received = 0;
+
+static void onEvents(ModioResponse response, ModioModEvent *events_array, u32 events_array_size)
+{
+  g_events_received += events_array_size;
+}
+
+static void onModDownloaded(u32 response_code, u32 mod_id)
+{
+  // Per mod turnaround, measured from the event poll or the previous download
+  recordCallback(new double(g_last_completion), response_code);
+}
+
+static void onModfileUploaded(u32 response_code, u32 mod_id)
+{
+  recordCallback(new double(g_last_completion), response_code);
+}
+
+static std::string getWorkloadRoot(const std::string &name)
+{
+  return modio::addSlashIfNeeded(g_options.work_dir) + name + "/";
+}
+
+static void startSdk(const std::string &root_path)
+{
+  // modioInit only creates .modio/ itself, not the directories above it
+  modio::createPath(root_path);
+  modioInit(MODIO_ENVIRONMENT_LIVE, BENCH_GAME_ID, BENCH_API_KEY, root_path.c_str());
+  modioSetDebugLevel(MODIO_DEBUGLEVEL_ERROR);
+  modio::MODIO_URL = g_server->getUrl();
+  g_finished_calls = 0;
+  g_failed_calls = 0;
+}
+
+static bool browsePages(const std::string &root_path)
+{
+  startSdk(root_path);
+
+  for (u32 page = 0; page < g_options.pages; page++)
+  {
+    ModioFilterCreator filter;
+    modioInitFilter(&filter);
+    modioSetFilterLimit(&filter, g_options.page_size);
+    modioSetFilterOffset(&filter, page * g_options.page_size);
+    modioGetAllMods(new double(getMillis()), filter, &onGetAllMods);
+    modioFreeFilter(&filter);
+
+    u32 expected_calls = page + 1;
+    if (!runFrames([&]() { return g_finished_calls == expected_calls; }))
+      break;
+  }
+
+  bool ok = g_finished_calls == g_options.pages && g_failed_calls == 0;
+  modioShutdown();
+  return ok;
+}
+
+static void runBrowse()
+{
+  g_result->ok = browsePages(getWorkloadRoot("browse"));
+}
+
+static bool g_replay_recorded = false;
+
+// Not measured, browses the mock server once storing every response for runReplay
+static void recordReplay()
+{
+  modio::curlwrapper::ReplayTransport recorder(getWorkloadRoot("replay_records"), MODIO_TRANSPORT_RECORD);
+  modio::curlwrapper::setTransport(&recorder);
+  g_replay_recorded = browsePages(getWorkloadRoot("replay_record"));
+  modio::curlwrapper::setTransport(NULL);
+}
+
+// Browses again from the recording, the server is never reached so what is left is the
+// SDK's own request, parsing and caching work behind the emulated latency and bandwidth
+static void runReplay()
+{
+  modio::curlwrapper::ReplayTransport replayer(getWorkloadRoot("replay_records"), MODIO_TRANSPORT_REPLAY);
+  replayer.setLatency(g_options.conditions.latency_ms);
+  replayer.setBandwidth(g_options.conditions.bandwidth_bytes_per_second);
+  modio::curlwrapper::setTransport(&replayer);
+  u64 server_requests = g_server->getRequestCount();
+  bool replayed = browsePages(getWorkloadRoot("replay"));
+  modio::curlwrapper::setTransport(NULL);
+
+  g_result->ok = g_replay_recorded && replayed && g_server->getRequestCount() == server_requests;
+  g_result->requests = g_finished_calls;
+}
+
+static void runSubscribe()
+{
+  startSdk(getWorkloadRoot("subscribe"));
+  modio::ACCESS_TOKEN = "bench";
+
+  for (u32 mod_id = 1; mod_id <= g_options.subscriptions; mod_id++)
+    modioSubscribeToMod(new double(getMillis()), mod_id, &onSubscribeToMod);
+
+  bool finished = runFrames([&]() { return g_finished_calls == g_options.subscriptions; });
+
+  g_subscriptions_listed = 0;
+  u32 pages = (g_options.subscriptions + g_options.page_size - 1) / g_options.page_size;
+  for (u32 page = 0; finished && page < pages; page++)
+  {
+    ModioFilterCreator filter;
+    modioInitFilter(&filter);
+    modioSetFilterLimit(&filter, g_options.page_size);
+    modioSetFilterOffset(&filter, page * g_options.page_size);
+    modioGetUserSubscriptions(new double(getMillis()), filter, &onGetUserSubscriptions);
+    modioFreeFilter(&filter);
+
+    u32 expected_calls = g_options.subscriptions + page + 1;
+    finished = runFrames([&]() { return g_finished_calls == expected_calls; });
+  }
+
+  g_result->ok = finished && g_failed_calls == 0 && g_subscriptions_listed == g_options.subscriptions;
+  modio::ACCESS_TOKEN = "";
+  modioShutdown();
+}
+
+static void runUpdate()
+{
+  // Pretend the mods were installed in an earlier session
+  std::string root_path = getWorkloadRoot("update");
+  std::string modio_directory = root_path + ".modio/";
+  nlohmann::json installed_mods_json = nlohmann::json::array();
+  for (u32 mod_id = 1; mod_id <= g_options.installed; mod_id++)
+  {
+    std::string mod_path = modio_directory + "mods/" + modio::toString(mod_id) + "/";
+    modio::createPath(mod_path);
+    nlohmann::json mod_json;
+    mod_json["id"] = mod_id;
+    mod_json["modfile"]["id"] = mod_id;
+    modio::writeJson(mod_path + "modio.json", mod_json);
+
+    nlohmann::json installed_mod_json;
+    installed_mod_json["path"] = mod_path;
+    installed_mod_json["mod_id"] = mod_id;
+    installed_mod_json["modfile_id"] = mod_id;
+    installed_mod_json["date_updated"] = 0;
+    installed_mods_json.push_back(installed_mod_json);
+  }
+  modio::writeJson(modio_directory + "installed_mods.json", installed_mods_json);
+
+  g_events_received = 0;
+  g_server->setPendingEvents(g_options.events);
+  modioSetEventListener(&onEvents);
+  modioSetDownloadListener(&onModDownloaded);
+
+  startSdk(root_path);
+  g_last_completion = getMillis();
+
+  bool finished = runFrames([&]() {
+    return g_events_received == g_options.events && g_finished_calls == g_options.installed && modioGetModDownloadQueueCount() == 0;
+  });
+
+  if (finished)
+    modioInstallDownloadedMods();
+
+  g_result->ok = finished && g_failed_calls == 0 && modioGetAllInstalledModsCount() == g_options.installed;
+  modioSetEventListener(NULL);
+  modioSetDownloadListener(NULL);
+  modioShutdown();
+}
+
+static void runUpload()
+{
+  std::string root_path = getWorkloadRoot("upload");
+  std::string modfile_path = root_path + "upload.zip";
+  modio::createPath(root_path);
+  {
+    std::ofstream modfile(modfile_path, std::ios::binary);
+    std::vector<char> chunk(1024 * 1024);
+    for (size_t i = 0; i < chunk.size(); i++)
+      chunk[i] = (char)(i * 2654435761u >> 24);
+    for (u32 i = 0; i < g_options.upload_mb; i++)
+      modfile.write(chunk.data(), chunk.size());
+  }
+
+  modioSetUploadListener(&onModfileUploaded);
+  startSdk(root_path);
+  modio::ACCESS_TOKEN = "bench";
+
+  ModioModfileCreator modfile_creator;
+  modioInitModfileCreator(&modfile_creator);
+  modioSetModfileCreatorPath(&modfile_creator, modfile_path.c_str());
+  modioSetModfileCreatorVersion(&modfile_creator, "1.0");
+  modioSetModfileCreatorChangelog(&modfile_creator, "Benchmark upload");
+
+  u64 bytes_received_before = g_server->getBytesReceived();
+  g_last_completion = getMillis();
+  modioAddModfile(1, modfile_creator);
+  modioFreeModfileCreator(&modfile_creator);
+
+  bool finished = runFrames([&]() { return g_finished_calls == 1; });
+
+  g_result->ok = finished && g_failed_calls == 0 && g_server->getBytesReceived() - bytes_received_before > (u64)g_options.upload_mb * 1024 * 1024;
+  modio::ACCESS_TOKEN = "";
+  modioSetUploadListener(NULL);
+  modioShutdown();
+  modio::removeFile(modfile_path);
+}
+
+static void runResume()
+{
+  modio_bench::NetworkConditions conditions = g_options.conditions;
+  if (!g_options.disconnect_rate_set)
+    conditions.disconnect_rate = BENCH_RESUME_DISCONNECT_RATE;
+  g_network_emulator->setConditions(conditions);
+
+  std::string root_path = getWorkloadRoot("resume");
+  modioSetDownloadListener(&onModDownloaded);
+  startSdk(root_path);
+  g_last_completion = getMillis();
+
+  for (u32 mod_id = 1; mod_id <= g_options.downloads; mod_id++)
+    modioDownloadMod(mod_id);
+
+  bool finished = runFrames([&]() { return g_finished_calls == g_options.downloads && modioGetModDownloadQueueCount() == 0; });
+
+  if (finished)
+    modioInstallDownloadedMods();
+
+  // A download that was resumed at the wrong offset would not extract to the original size
+  bool intact = true;
+  for (u32 mod_id = 1; finished && mod_id <= g_options.downloads; mod_id++)
+  {
+    std::string asset_path = root_path + ".modio/mods/" + modio::toString(mod_id) + "/asset_0.bin";
+    intact = intact && modio::getFileSize(asset_path) == g_options.mod_kb * 1024 / 4;
+  }
+
+  g_result->ok = finished && g_failed_calls == 0 && intact && modioGetAllInstalledModsCount() == g_options.downloads;
+  modioSetDownloadListener(NULL);
+  modioShutdown();
+  g_network_emulator->setConditions(g_options.conditions);
+}
+
+static std::string buildModZip()
+{
+  std::string source_path = modio::addSlashIfNeeded(g_options.work_dir) + "mod_source/";
+  std::string zip_path = modio::addSlashIfNeeded(g_options.work_dir) + "mod.zip";
+  modio::createPath(source_path);
+
+  // Incompressible content so the zip is as large as requested
+  u32 seed = 12345;
+  for (u32 file_index = 0; file_index < 4; file_index++)
+  {
+    std::ofstream file(source_path + "asset_" + modio::toString(file_index) + ".bin", std::ios::binary);
+    for (u32 i = 0; i < g_options.mod_kb * 1024 / 4; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      file.put((char)(seed >> 16));
+    }
+  }
+  modio::minizipwrapper::compressDirectory(source_path, zip_path);
+
+  std::ifstream zip(zip_path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(zip)), std::istreambuf_iterator<char>());
+}
+
+static bool parseOptions(int argc, char **argv)
+{
+  std::string workloads = "browse,subscribe,update,upload,resume,replay";
+  g_options.conditions.stall_ms = 200;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    std::string value = arg.find('=') != std::string::npos ? arg.substr(arg.find('=') + 1) : "";
+    u32 number = (u32)strtoul(value.c_str(), NULL, 10);
+
+    if (arg.compare(0, 12, "--workloads=") == 0)
+      workloads = value;
+    else if (arg.compare(0, 8, "--pages=") == 0)
+      g_options.pages = number;
+    else if (arg.compare(0, 16, "--subscriptions=") == 0)
+      g_options.subscriptions = number;
+    else if (arg.compare(0, 9, "--events=") == 0)
+      g_options.events = number;
+    else if (arg.compare(0, 12, "--installed=") == 0)
+      g_options.installed = std::max(number, 1u);
+    else if (arg.compare(0, 12, "--downloads=") == 0)
+      g_options.downloads = number;
+    else if (arg.compare(0, 13, "--latency-ms=") == 0)
+      g_options.conditions.latency_ms = number;
+    else if (arg.compare(0, 17, "--bandwidth-kbps=") == 0)
+      g_options.conditions.bandwidth_bytes_per_second = number * 1024 / 8;
+    else if (arg.compare(0, 13, "--stall-rate=") == 0)
+      g_options.conditions.stall_rate = atof(value.c_str());
+    else if (arg.compare(0, 11, "--stall-ms=") == 0)
+      g_options.conditions.stall_ms = number;
+    else if (arg.compare(0, 18, "--disconnect-rate=") == 0)
+    {
+      g_options.conditions.disconnect_rate = atof(value.c_str());
+      g_options.disconnect_rate_set = true;
+    }
+    else if (arg.compare(0, 14, "--error-every=") == 0)
+      g_options.conditions.error_burst_every = number;
+    else if (arg.compare(0, 14, "--error-burst=") == 0)
+      g_options.conditions.error_burst_length = number;
+    else if (arg.compare(0, 13, "--error-code=") == 0)
+      g_options.conditions.error_code = number;
+    else if (arg.compare(0, 7, "--seed=") == 0)
+      g_options.seed = number;
+    else if (arg.compare(0, 9, "--mod-kb=") == 0)
+      g_options.mod_kb = std::max(number, 1u);
+    else if (arg.compare(0, 12, "--upload-mb=") == 0)
+      g_options.upload_mb = std::max(number, 1u);
+    else if (arg.compare(0, 11, "--frame-ms=") == 0)
+      g_options.frame_ms = number;
+    else if (arg.compare(0, 12, "--timeout-s=") == 0)
+      g_options.timeout_seconds = number;
+    else if (arg.compare(0, 11, "--work-dir=") == 0)
+      g_options.work_dir = value;
+    else if (arg == "--json")
+      g_options.json = true;
+    else
+    {
+      fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+      return false;
+    }
+  }
+
+  size_t start = 0, end;
+  while ((end = workloads.find(',', start)) != std::string::npos)
+  {
+    g_options.workloads.push_back(workloads.substr(start, end - start));
+    start = end + 1;
+  }
+  g_options.workloads.push_back(workloads.substr(start));
+  return true;
+}
+
+static void printResults(const std::vector<WorkloadResult> &results)
+{
+  if (g_options.json)
+  {
+    nlohmann::json results_json = nlohmann::json::array();
+    for (auto &result : results)
+    {
+      double megabytes = result.bytes / (1024.0 * 1024.0);
+      nlohmann::json result_json;
+      result_json["workload"] = result.name;
+      result_json["ok"] = result.ok;
+      result_json["requests"] = result.requests;
+      result_json["seconds"] = result.seconds;
+      result_json["requests_per_second"] = result.requests / result.seconds;
+      result_json["mb_per_second"] = megabytes / result.seconds;
+      result_json["p50_ms"] = getPercentile(result.latencies_ms, 50);
+      result_json["p99_ms"] = getPercentile(result.latencies_ms, 99);
+      result_json["cpu_ms_per_mb"] = megabytes > 0 ? result.cpu_seconds * 1000 / megabytes : 0;
+      result_json["faults"] = result.faults;
+      result_json["resumes"] = result.resumes;
+      results_json.push_back(result_json);
+    }
+    nlohmann::json report_json;
+    report_json["results"] = results_json;
+    report_json["peak_rss_mb"] = getPeakRssMB();
+    printf("%s\n", report_json.dump(2).c_str());
+    return;
+  }
+
+  printf("%-10s %4s %9s %10s %9s %9s %9s %11s %7s %8s\n", "workload", "ok", "requests", "req/s", "MB/s", "p50 ms", "p99 ms", "cpu ms/MB", "faults", "resumes");
+  for (auto &result : results)
+  {
+    double megabytes = result.bytes / (1024.0 * 1024.0);
+    printf("%-10s %4s %9llu %10.1f %9.2f %9.2f %9.2f %11.2f %7llu %8llu\n",
+           result.name.c_str(), result.ok ? "yes" : "NO", result.requests,
+           result.requests / result.seconds, megabytes / result.seconds,
+           getPercentile(result.latencies_ms, 50), getPercentile(result.latencies_ms, 99),
+           megabytes > 0 ? result.cpu_seconds * 1000 / megabytes : 0, result.faults, result.resumes);
+  }
+  printf("peak RSS: %.1f MB\n", getPeakRssMB());
+}
+
+int main(int argc, char **argv)
+{
+  if (!parseOptions(argc, argv))
+    return 1;
+
+  modio::removeDirectory(g_options.work_dir);
+  modio::createPath(modio::addSlashIfNeeded(g_options.work_dir));
+
+  // The catalog has to cover every mod a workload touches
+  u32 catalog_size = std::max(std::max(g_options.pages * g_options.page_size, g_options.subscriptions), std::max(g_options.installed, g_options.downloads));
+  modio_bench::NetworkEmulator network_emulator(g_options.seed);
+  network_emulator.setConditions(g_options.conditions);
+  g_network_emulator = &network_emulator;
+
+  modio_bench::MockServer server(BENCH_GAME_ID, catalog_size);
+  server.setDownloadBody(buildModZip());
+  server.setNetworkEmulator(&network_emulator);
+  if (!server.start())
+  {
+    fprintf(stderr, "Could not start the mock server\n");
+    return 1;
+  }
+  g_server = &server;
+
+  std::vector<WorkloadResult> results;
+  for (auto &workload : g_options.workloads)
+  {
+    std::function<void()> prepare;
+    std::function<void()> run;
+    if (workload == "browse")
+      run = &runBrowse;
+    else if (workload == "subscribe")
+      run = &runSubscribe;
+    else if (workload == "update")
+      run = &runUpdate;
+    else if (workload == "upload")
+      run = &runUpload;
+    else if (workload == "resume")
+      run = &runResume;
+    else if (workload == "replay")
+    {
+      prepare = &recordReplay;
+      run = &runReplay;
+    }
+    else
+    {
+      fprintf(stderr, "Unknown workload: %s\n", workload.c_str());
+      continue;
+    }
+
+    WorkloadResult result;
+    result.name = workload;
+    g_result = &result;
+    if (prepare)
+    {
+      prepare();
+      result.latencies_ms.clear();
+    }
+
+    u64 faults_before = network_emulator.getInjectedErrorCount() + network_emulator.getDisconnectCount() + network_emulator.getStallCount();
+    u64 resumes_before = server.getRangeRequestCount();
+    u64 requests_before = server.getRequestCount();
+    u64 bytes_before = server.getBytesReceived() + server.getBytesSent();
+    double cpu_before = getThreadCpuSeconds();
+    double start = getMillis();
+
+    run();
+
+    result.seconds = (getMillis() - start) / 1000.0;
+    result.cpu_seconds = getThreadCpuSeconds() - cpu_before;
+    // The replay transport answers requests itself, runReplay counts them
+    if (result.requests == 0)
+      result.requests = server.getRequestCount() - requests_before;
+    result.faults = network_emulator.getInjectedErrorCount() + network_emulator.getDisconnectCount() + network_emulator.getStallCount() - faults_before;
+    result.resumes = server.getRangeRequestCount() - resumes_before;
+    result.bytes = server.getBytesReceived() + server.getBytesSent() - bytes_before;
+    results.push_back(result);
+    g_result = NULL;
+  }
+
+  server.stop();
+  printResults(results);
+
+  for (auto &result : results)
+  {
+    if (!result.ok)
+      return 1;
+  }
+  return 0;
+}
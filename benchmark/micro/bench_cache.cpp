@@ -0,0 +1,64 @@
+// Cache lookups, the in-memory response cache, the entity store the single mod calls are
+// served from and the on-disk cache store, with the key derivation they all start with
+
+#include <cstdio>
+
+#include "micro_bench.h"
+#include "CacheStore.h"
+#include "EntityStore.h"
+#include "ResponseCache.h"
+#include "../../test/json_examples.h"
+
+void runCacheBenchmarks(std::vector<MicroResult> &results)
+{
+  nlohmann::json page_json = getModPageJson(g_options.page_size);
+  std::string page_str = page_json.dump();
+  std::string url = "https://api.mod.io/v1/games/7/mods?_sort=-date_updated&_limit=100&api_key=e91c01b8882f4affeddd56c96111977b";
+  std::string missing_url = url + "&_offset=100";
+  double now_millis = modio::getCurrentTimeMillis();
+
+  results.push_back(measure("cache_key_hash", g_options.iterations, [&]() {
+    u64 key = modio::getCanonicalUrlHash(url);
+    (void)key;
+  }));
+
+  modio::ResponseCache response_cache(MODIO_MEMORY_CACHE_MAX_BYTES);
+  response_cache.add(url, now_millis, std::make_shared<const nlohmann::json>(page_json), page_str.size());
+  results.push_back(measure("response_cache_hit", g_options.iterations, [&]() {
+    std::shared_ptr<const nlohmann::json> response_json = response_cache.get(url, 60);
+  }));
+
+  results.push_back(measure("response_cache_miss", g_options.iterations, [&]() {
+    std::shared_ptr<const nlohmann::json> response_json = response_cache.get(missing_url, 60);
+  }));
+
+  modio::EntityStore entity_store;
+  for (auto &page_mod_json : page_json["data"])
+    entity_store.putMod(page_mod_json, now_millis);
+  u32 mod_id = 0;
+  results.push_back(measure("entity_store_mod_hit", g_options.iterations, [&]() {
+    nlohmann::json mod_json;
+    entity_store.getMod(mod_id % g_options.page_size + 1, 60, mod_json);
+    mod_id++;
+  }));
+
+  // The on-disk store inflates the page and hands back the string, parsing is measured apart
+  std::string cache_store_path = "modio_microbench.cache";
+  remove(cache_store_path.c_str());
+  modio::CacheStore cache_store;
+  if (cache_store.open(cache_store_path, MODIO_CACHE_STORE_MAX_BYTES))
+  {
+    cache_store.put(url, page_str, now_millis);
+    results.push_back(measure("cache_store_hit", g_options.iterations / g_options.page_size + 1, [&]() {
+      std::string value;
+      cache_store.get(url, 60, value);
+    }));
+
+    results.push_back(measure("cache_store_miss", g_options.iterations, [&]() {
+      std::string value;
+      cache_store.get(missing_url, 60, value);
+    }));
+    cache_store.close();
+  }
+  remove(cache_store_path.c_str());
+}
@@ -0,0 +1,64 @@
+// Installed mod lookups at the scale of a server with thousands of mods installed, what the
+// event polling does for every modfile change and to build its -in filter, and the per mod
+// check of the initialization, a stat when the fingerprint matches or a read of modio.json
+
+#include "micro_bench.h"
+#include "InstalledModRegistry.h"
+#include "../../test/json_examples.h"
+
+#define MICRO_BENCH_INSTALLED_MODS 5000
+
+void runInstalledModBenchmarks(std::vector<MicroResult> &results)
+{
+  results.push_back(measure("installed_mods_put_5000", g_options.iterations / MICRO_BENCH_INSTALLED_MODS + 1, [&]() {
+    modio::InstalledModRegistry registry;
+    for (u32 i = 0; i < MICRO_BENCH_INSTALLED_MODS; i++)
+      registry.put(i + 1, "mods/" + modio::toString(i + 1) + "/", i + 100, 1500000000, modio::FileFingerprint());
+  }));
+
+  modio::InstalledModRegistry registry;
+  for (u32 i = 0; i < MICRO_BENCH_INSTALLED_MODS; i++)
+    registry.put(i + 1, "mods/" + modio::toString(i + 1) + "/", i + 100, 1500000000, modio::FileFingerprint());
+
+  // One lookup per event of a backlog naming every installed mod
+  results.push_back(measure("installed_mods_find_5000", g_options.iterations / MICRO_BENCH_INSTALLED_MODS + 1, [&]() {
+    u32 newer_installs = 0;
+    for (u32 i = 0; i < MICRO_BENCH_INSTALLED_MODS; i++)
+    {
+      const modio::InstalledModRecord *installed_mod = registry.find(MICRO_BENCH_INSTALLED_MODS - i);
+      if (installed_mod && installed_mod->date_updated >= 1400000000)
+        newer_installs++;
+    }
+    (void)newer_installs;
+  }));
+
+  results.push_back(measure("installed_mods_id_list_5000", g_options.iterations / MICRO_BENCH_INSTALLED_MODS + 1, [&]() {
+    std::string installed_mod_ids;
+    for (auto &installed_mod : registry.getRecords())
+    {
+      if (!installed_mod_ids.empty())
+        installed_mod_ids += ",";
+      installed_mod_ids += modio::toString(installed_mod.mod_id);
+    }
+  }));
+
+  std::string mod_path = "modio_microbench_mod/";
+  modio::createDirectory(mod_path);
+  modio::writeJson(mod_path + "modio.json", getScaledModJson(1));
+  modio::FileFingerprint stored_fingerprint;
+  if (modio::getFileFingerprint(mod_path, "modio.json", stored_fingerprint))
+  {
+    results.push_back(measure("installed_mod_fingerprint", g_options.iterations, [&]() {
+      modio::FileFingerprint fingerprint;
+      bool verified = modio::getFileFingerprint(mod_path, "modio.json", fingerprint) && fingerprint == stored_fingerprint;
+      (void)verified;
+    }));
+
+    results.push_back(measure("installed_mod_read", g_options.iterations / 10 + 1, [&]() {
+      nlohmann::json installed_mod_json = modio::openJson(mod_path + "modio.json");
+      bool verified = modio::hasKey(installed_mod_json, "id") && installed_mod_json["id"] == mod_json["id"];
+      (void)verified;
+    }));
+  }
+  modio::removeDirectory(mod_path);
+}
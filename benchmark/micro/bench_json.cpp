@@ -0,0 +1,54 @@
+// Json parsing, nlohmann against every structural parser backend the cpu supports, on the
+// examples, a mod listing page and a backlog of events
+
+#include <algorithm>
+#include <cctype>
+
+#include "micro_bench.h"
+#include "JsonParser.h"
+#include "../../test/json_examples.h"
+
+void runParseBenchmarks(std::vector<MicroResult> &results)
+{
+  nlohmann::json examples_json = {message_json, logo_json, error_json, icon_json, header_image_json, avatar_json, image_json, event_json, comment_json, mod_dependency_json, game_tag_option_json, modfile_json, filehash_json, download_json, mod_media_json, mod_tag_json, metadata_kvp_json, rating_json, stats_json, team_member_json, user_json, game_json, mod_json};
+  nlohmann::json events_json;
+  events_json["data"] = nlohmann::json::array();
+  for (u32 i = 0; i < g_options.page_size * 10; i++)
+  {
+    nlohmann::json page_event_json = event_json;
+    page_event_json["id"] = i + 1;
+    events_json["data"].push_back(page_event_json);
+  }
+
+  struct ParseInput
+  {
+    std::string name;
+    std::string json_str;
+    u32 iterations;
+  };
+  std::vector<ParseInput> parse_inputs;
+  parse_inputs.push_back({"examples", examples_json.dump(2), g_options.iterations / 10 + 1});
+  parse_inputs.push_back({"mod_page", getModPageJson(g_options.page_size).dump(), g_options.iterations / g_options.page_size + 1});
+  parse_inputs.push_back({"event_page", events_json.dump(), g_options.iterations / (g_options.page_size * 10) + 1});
+
+  u32 best_json_backend = modio::getJsonBackend();
+  for (auto &parse_input : parse_inputs)
+  {
+    results.push_back(measure("parse_" + parse_input.name + "_nlohmann", parse_input.iterations, [&]() {
+      nlohmann::json parsed_json = nlohmann::json::parse(parse_input.json_str);
+    }));
+
+    for (u32 backend = MODIO_JSON_BACKEND_SCALAR; backend <= best_json_backend; backend++)
+    {
+      modio::setJsonBackend(backend);
+      std::string backend_name = modio::getJsonBackendName(backend);
+      std::transform(backend_name.begin(), backend_name.end(), backend_name.begin(), ::tolower);
+      backend_name.erase(std::remove(backend_name.begin(), backend_name.end(), '.'), backend_name.end());
+      results.push_back(measure("parse_" + parse_input.name + "_" + backend_name, parse_input.iterations, [&]() {
+        nlohmann::json parsed_json;
+        modio::parseJson(parse_input.json_str.data(), parse_input.json_str.size(), parsed_json);
+      }));
+    }
+    modio::setJsonBackend(best_json_backend);
+  }
+}
@@ -0,0 +1,276 @@
+// Microbenchmark suite of the SDK hot paths: schema decoding, json parsing, request
+// construction, cache and installed mod lookups, on the payloads of
+// test/json_examples.cpp and scaled synthetic ones. Heap allocations made by the SDK are
+// counted through a replaced global operator new and reported per operation next to the
+// time.
+//
+// Results can be stored as a baseline and later runs compared against it, a run with a
+// benchmark allocating more than the baseline exits with 1:
+//
+//   modio_microbench --write-baseline=benchmark/micro/baseline.json
+//   modio_microbench --baseline=benchmark/micro/baseline.json [--time-tolerance=25]
+//
+// Allocation counts and bytes are the same on every run with the same standard library and
+// are always compared. Timings only compare on the machine the baseline was written on, and
+// only when it is quiet, so they are checked on request with the percent they may grow by.
+// The checked in baseline comes from a release build.
+//
+// Usage: modio_microbench [--iterations=20000] [--repetitions=3] [--page-size=100] [--scale=20] [--json]
+//                         [--baseline=path] [--write-baseline=path] [--time-tolerance=percent]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+
+#include "micro_bench.h"
+#include "../../test/json_examples.h"
+
+MicroOptions g_options;
+std::atomic<u64> g_allocations(0);
+std::atomic<u64> g_allocated_bytes(0);
+
+void *operator new(size_t size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  void *pointer = malloc(size > 0 ? size : 1);
+  if (!pointer)
+    throw std::bad_alloc();
+  return pointer;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+// Every operator new above allocates with malloc, so free is the matching release. GCC
+// only sees the inlined new expressions of the callers and warns about the pair anyway.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *pointer) noexcept
+{
+  free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+  free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+  free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+  free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+double getNanos()
+{
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+nlohmann::json getModPageJson(u32 page_size)
+{
+  nlohmann::json page_json;
+  page_json["data"] = nlohmann::json::array();
+  for (u32 i = 0; i < page_size; i++)
+  {
+    nlohmann::json page_mod_json = mod_json;
+    page_mod_json["id"] = i + 1;
+    page_json["data"].push_back(page_mod_json);
+  }
+  page_json["result_count"] = page_size;
+  page_json["result_offset"] = 0;
+  page_json["result_limit"] = page_size;
+  page_json["result_total"] = page_size;
+  return page_json;
+}
+
+nlohmann::json getScaledModJson(u32 scale)
+{
+  nlohmann::json scaled_mod_json = mod_json;
+  std::string description;
+  for (u32 i = 0; i < scale * 16; i++)
+    description += "<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusm.</p>";
+  scaled_mod_json["description"] = description;
+  scaled_mod_json["description_plaintext"] = description;
+
+  scaled_mod_json["tags"] = nlohmann::json::array();
+  scaled_mod_json["metadata_kvp"] = nlohmann::json::array();
+  scaled_mod_json["media"]["images"] = nlohmann::json::array();
+  for (u32 i = 0; i < scale; i++)
+  {
+    nlohmann::json tag_json = mod_tag_json;
+    tag_json["name"] = "Tag " + std::to_string(i);
+    scaled_mod_json["tags"].push_back(tag_json);
+
+    nlohmann::json kvp_json = metadata_kvp_json;
+    kvp_json["metakey"] = "key" + std::to_string(i);
+    scaled_mod_json["metadata_kvp"].push_back(kvp_json);
+
+    nlohmann::json scaled_image_json = image_json;
+    scaled_image_json["filename"] = "image" + std::to_string(i) + ".png";
+    scaled_mod_json["media"]["images"].push_back(scaled_image_json);
+  }
+  return scaled_mod_json;
+}
+
+static bool parseOptions(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    std::string value = arg.find('=') != std::string::npos ? arg.substr(arg.find('=') + 1) : "";
+    u32 number = (u32)strtoul(value.c_str(), NULL, 10);
+
+    if (arg.compare(0, 13, "--iterations=") == 0)
+      g_options.iterations = number > 0 ? number : 1;
+    else if (arg.compare(0, 14, "--repetitions=") == 0)
+      g_options.repetitions = number > 0 ? number : 1;
+    else if (arg.compare(0, 12, "--page-size=") == 0)
+      g_options.page_size = number > 0 ? number : 1;
+    else if (arg.compare(0, 8, "--scale=") == 0)
+      g_options.scale = number > 0 ? number : 1;
+    else if (arg == "--json")
+      g_options.json = true;
+    else if (arg.compare(0, 11, "--baseline=") == 0)
+      g_options.baseline_path = value;
+    else if (arg.compare(0, 17, "--write-baseline=") == 0)
+      g_options.write_baseline_path = value;
+    else if (arg.compare(0, 17, "--time-tolerance=") == 0)
+      g_options.time_tolerance = strtod(value.c_str(), NULL);
+    else
+    {
+      fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+static nlohmann::json toJson(const std::vector<MicroResult> &results)
+{
+  nlohmann::json results_json = nlohmann::json::array();
+  for (auto &result : results)
+  {
+    nlohmann::json result_json;
+    result_json["benchmark"] = result.name;
+    result_json["iterations"] = result.iterations;
+    result_json["ns_per_op"] = result.ns_per_op;
+    result_json["allocations_per_op"] = result.allocations_per_op;
+    result_json["bytes_per_op"] = result.bytes_per_op;
+    results_json.push_back(result_json);
+  }
+  return results_json;
+}
+
+// Benchmarks missing from the baseline are new and pass. The allocation counts get a little
+// slack for the iterations that grow a container.
+static u32 compareWithBaseline(const std::vector<MicroResult> &results, const std::string &baseline_path)
+{
+  std::ifstream baseline_file(baseline_path);
+  if (!baseline_file.is_open())
+  {
+    fprintf(stderr, "Could not open baseline %s\n", baseline_path.c_str());
+    return 1;
+  }
+
+  nlohmann::json baseline_json;
+  try
+  {
+    baseline_file >> baseline_json;
+  }
+  catch (nlohmann::json::parse_error &e)
+  {
+    fprintf(stderr, "Could not parse baseline %s: %s\n", baseline_path.c_str(), e.what());
+    return 1;
+  }
+
+  std::map<std::string, nlohmann::json> baseline_results;
+  for (auto &baseline_result_json : baseline_json)
+    baseline_results[baseline_result_json.value("benchmark", "")] = baseline_result_json;
+
+  u32 regressions = 0;
+  for (auto &result : results)
+  {
+    if (baseline_results.find(result.name) == baseline_results.end())
+      continue;
+
+    const nlohmann::json &baseline_result_json = baseline_results[result.name];
+    double baseline_ns = baseline_result_json.value("ns_per_op", 0.0);
+    double baseline_allocations = baseline_result_json.value("allocations_per_op", 0.0);
+    double baseline_bytes = baseline_result_json.value("bytes_per_op", 0.0);
+
+    if (g_options.time_tolerance > 0 && result.ns_per_op > baseline_ns * (1 + g_options.time_tolerance / 100))
+    {
+      fprintf(stderr, "REGRESSION %s: %.0f ns/op, baseline %.0f\n", result.name.c_str(), result.ns_per_op, baseline_ns);
+      regressions++;
+    }
+    if (result.allocations_per_op > baseline_allocations + 0.5)
+    {
+      fprintf(stderr, "REGRESSION %s: %.1f allocs/op, baseline %.1f\n", result.name.c_str(), result.allocations_per_op, baseline_allocations);
+      regressions++;
+    }
+    if (result.bytes_per_op > baseline_bytes * 1.01 + 64)
+    {
+      fprintf(stderr, "REGRESSION %s: %.0f bytes/op, baseline %.0f\n", result.name.c_str(), result.bytes_per_op, baseline_bytes);
+      regressions++;
+    }
+  }
+  return regressions;
+}
+
+int main(int argc, char **argv)
+{
+  if (!parseOptions(argc, argv))
+    return 1;
+
+  std::vector<MicroResult> results;
+  runSchemaBenchmarks(results);
+  runParseBenchmarks(results);
+  runRequestBenchmarks(results);
+  runCacheBenchmarks(results);
+  runInstalledModBenchmarks(results);
+
+  if (g_options.json)
+  {
+    printf("%s\n", toJson(results).dump(2).c_str());
+  }
+  else
+  {
+    printf("%-30s %10s %12s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op", "bytes/op");
+    for (auto &result : results)
+      printf("%-30s %10u %12.0f %12.1f %12.0f\n", result.name.c_str(), result.iterations, result.ns_per_op, result.allocations_per_op, result.bytes_per_op);
+  }
+
+  if (!g_options.write_baseline_path.empty())
+  {
+    std::ofstream baseline_file(g_options.write_baseline_path);
+    baseline_file << toJson(results).dump(2) << std::endl;
+  }
+
+  if (!g_options.baseline_path.empty())
+  {
+    u32 regressions = compareWithBaseline(results, g_options.baseline_path);
+    if (regressions > 0)
+    {
+      fprintf(stderr, "%u regressions against %s\n", regressions, g_options.baseline_path.c_str());
+      return 1;
+    }
+    fprintf(stderr, "No regressions against %s\n", g_options.baseline_path.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,63 @@
+// Request construction, filters with large -in lists turned into query strings, the urls
+// and headers the Modio*Methods files build for every call, and the canonical form the
+// cache keys are taken from
+
+#include "micro_bench.h"
+#include "Globals.h"
+#include "Utility.h"
+#include "c/creators/ModioFilterCreator.h"
+
+#define MICRO_BENCH_IN_LIST_SIZE 1000
+
+static void addInList(ModioFilterCreator *filter)
+{
+  for (u32 i = 0; i < MICRO_BENCH_IN_LIST_SIZE; i++)
+    modioAddFilterInField(filter, "id", modio::toString(MICRO_BENCH_IN_LIST_SIZE - i).c_str());
+}
+
+void runRequestBenchmarks(std::vector<MicroResult> &results)
+{
+  modio::GAME_ID = 7;
+  modio::API_KEY = "e91c01b8882f4affeddd56c96111977b";
+  modio::ACCESS_TOKEN = "eyJ0eXAiOiJKV1QiLCJhbGciOiJSUzI1NiIsImp0aSI6IjBiNGM2ODk0ZWQ5YTk4ZTc0ZGE5NTIyZDE5";
+
+  results.push_back(measure("filter_build_in_1000", g_options.iterations / MICRO_BENCH_IN_LIST_SIZE + 1, [&]() {
+    ModioFilterCreator filter;
+    modioInitFilter(&filter);
+    addInList(&filter);
+    modioFreeFilter(&filter);
+  }));
+
+  ModioFilterCreator filter;
+  modioInitFilter(&filter);
+  modioSetFilterSort(&filter, "date_updated", false);
+  modioSetFilterLimit(&filter, 100);
+  addInList(&filter);
+  results.push_back(measure("filter_string_in_1000", g_options.iterations / 10 + 1, [&]() {
+    std::string filter_string = modio::getFilterString(&filter);
+  }));
+  std::string filter_string = modio::getFilterString(&filter);
+  modioFreeFilter(&filter);
+
+  // Same construction as getAllModsFilterString and getMod in ModMethods.cpp
+  results.push_back(measure("url_get_all_mods", g_options.iterations, [&]() {
+    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods?" + filter_string + "&api_key=" + modio::API_KEY;
+  }));
+
+  results.push_back(measure("url_get_mod", g_options.iterations, [&]() {
+    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString((u32)1234) + "?api_key=" + modio::API_KEY;
+  }));
+
+  results.push_back(measure("headers", g_options.iterations, [&]() {
+    std::vector<std::string> headers = modio::getHeaders();
+  }));
+
+  results.push_back(measure("url_encoded_headers", g_options.iterations, [&]() {
+    std::vector<std::string> headers = modio::getUrlEncodedHeaders();
+  }));
+
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods?" + filter_string + "&api_key=" + modio::API_KEY;
+  results.push_back(measure("url_canonical_in_1000", g_options.iterations / 10 + 1, [&]() {
+    std::string canonical_url = modio::getCanonicalUrl(url);
+  }));
+}
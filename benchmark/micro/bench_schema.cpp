@@ -0,0 +1,90 @@
+// Schema decoding, the C structs one at a time, as a full listing page with and without a
+// response arena or the lazy fields, and the C++ modio::Mod both ways
+
+#include "micro_bench.h"
+#include "c/schemas/ModioMod.h"
+#include "SchemaArena.h"
+#include "c++/schemas/Mod.h"
+#include "../../test/json_examples.h"
+
+void runSchemaBenchmarks(std::vector<MicroResult> &results)
+{
+  nlohmann::json page_json = getModPageJson(g_options.page_size);
+  nlohmann::json scaled_mod_json = getScaledModJson(g_options.scale);
+
+  results.push_back(measure("mod_init_free", g_options.iterations, [&]() {
+    ModioMod mod;
+    modioInitMod(&mod, mod_json);
+    modioFreeMod(&mod);
+  }));
+
+  results.push_back(measure("mod_scaled_init_free", g_options.iterations / g_options.scale + 1, [&]() {
+    ModioMod mod;
+    modioInitMod(&mod, scaled_mod_json);
+    modioFreeMod(&mod);
+  }));
+
+  // Same walk as the mod listing callbacks
+  std::vector<ModioMod> mods(g_options.page_size);
+  results.push_back(measure("mod_page_init_free", g_options.iterations / g_options.page_size + 1, [&]() {
+    for (u32 i = 0; i < g_options.page_size; i++)
+      modioInitMod(&mods[i], page_json["data"][i]);
+    for (u32 i = 0; i < g_options.page_size; i++)
+      modioFreeMod(&mods[i]);
+  }));
+
+  // What the listing callbacks do now, one arena per response
+  results.push_back(measure("mod_page_arena", g_options.iterations / g_options.page_size + 1, [&]() {
+    modio::SchemaArena arena;
+    modio::SchemaArenaScope arena_scope(arena);
+    ModioMod *arena_mods = modio::allocateSchemaArray<ModioMod>(g_options.page_size);
+    for (u32 i = 0; i < g_options.page_size; i++)
+      modioInitMod(&arena_mods[i], page_json["data"][i]);
+  }));
+
+  // Lazy fields, description, description_plaintext, metadata_blob and media stay in the json
+  results.push_back(measure("mod_page_lazy", g_options.iterations / g_options.page_size + 1, [&]() {
+    modio::SchemaArena arena;
+    modio::SchemaArenaScope arena_scope(arena);
+    ModioMod *arena_mods = modio::allocateSchemaArray<ModioMod>(g_options.page_size);
+    for (u32 i = 0; i < g_options.page_size; i++)
+      modioInitModLazyFields(&arena_mods[i], page_json["data"][i]);
+  }));
+
+  // The C++ Instance, through ModioMod and straight from the json
+  results.push_back(measure("cpp_mod_via_struct", g_options.iterations, [&]() {
+    ModioMod mod;
+    modioInitMod(&mod, mod_json);
+    modio::Mod cpp_mod;
+    cpp_mod.initialize(mod);
+    modioFreeMod(&mod);
+  }));
+
+  results.push_back(measure("cpp_mod_from_json", g_options.iterations, [&]() {
+    modio::Mod cpp_mod;
+    cpp_mod.initialize(mod_json);
+  }));
+
+  results.push_back(measure("cpp_mod_scaled_from_json", g_options.iterations / g_options.scale + 1, [&]() {
+    modio::Mod cpp_mod;
+    cpp_mod.initialize(scaled_mod_json);
+  }));
+
+  results.push_back(measure("cpp_mod_lazy", g_options.iterations, [&]() {
+    modio::Mod cpp_mod;
+    cpp_mod.initializeLazyFields(mod_json);
+  }));
+
+  // What the installed and queued mods are written with
+  modio::Mod cpp_mod;
+  cpp_mod.initialize(mod_json);
+  results.push_back(measure("cpp_mod_to_json", g_options.iterations, [&]() {
+    nlohmann::json encoded_json = modio::toJson(cpp_mod);
+  }));
+
+  modio::Mod scaled_cpp_mod;
+  scaled_cpp_mod.initialize(scaled_mod_json);
+  results.push_back(measure("cpp_mod_scaled_to_json", g_options.iterations / g_options.scale + 1, [&]() {
+    nlohmann::json encoded_json = modio::toJson(scaled_cpp_mod);
+  }));
+}
@@ -0,0 +1,89 @@
+#ifndef MODIO_MICRO_BENCH_H
+#define MODIO_MICRO_BENCH_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "c/ModioC.h"
+#include "dependencies/nlohmann/json.hpp"
+
+struct MicroOptions
+{
+  u32 iterations = 20000;
+  // Timed runs of each benchmark, the fastest one is reported
+  u32 repetitions = 3;
+  u32 page_size = 100;
+  // Tags, metadata, images and kilobytes of description of the scaled mod
+  u32 scale = 20;
+  bool json = false;
+  std::string baseline_path;
+  std::string write_baseline_path;
+  // Percent ns/op may grow over the baseline before it counts as a regression, 0 leaves the
+  // timings unchecked
+  double time_tolerance = 0;
+};
+
+struct MicroResult
+{
+  std::string name;
+  u32 iterations;
+  double ns_per_op;
+  double allocations_per_op;
+  double bytes_per_op;
+};
+
+extern MicroOptions g_options;
+// Atomic so allocations on threads the SDK starts count too and never race the benchmark
+extern std::atomic<u64> g_allocations;
+extern std::atomic<u64> g_allocated_bytes;
+
+double getNanos();
+
+template <typename Operation>
+MicroResult measure(const std::string &name, u32 iterations, Operation operation)
+{
+  // Warm up so lazily built statics do not count against the first iterations
+  operation();
+
+  // Noise from other processes only ever adds time, so the fastest run is the closest to
+  // the cost of the operation. Allocations are the same on every run.
+  double best_nanos = 0;
+  u64 allocations = 0;
+  u64 allocated_bytes = 0;
+  for (u32 repetition = 0; repetition < g_options.repetitions; repetition++)
+  {
+    u64 allocations_before = g_allocations;
+    u64 bytes_before = g_allocated_bytes;
+    double start = getNanos();
+    for (u32 i = 0; i < iterations; i++)
+      operation();
+    double nanos = getNanos() - start;
+    if (repetition == 0 || nanos < best_nanos)
+      best_nanos = nanos;
+    allocations = g_allocations - allocations_before;
+    allocated_bytes = g_allocated_bytes - bytes_before;
+  }
+
+  MicroResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.ns_per_op = best_nanos / iterations;
+  result.allocations_per_op = (double)allocations / iterations;
+  result.bytes_per_op = (double)allocated_bytes / iterations;
+  return result;
+}
+
+// Payloads built from test/json_examples.cpp
+nlohmann::json getModPageJson(u32 page_size);
+nlohmann::json getScaledModJson(u32 scale);
+
+// Benchmark groups, each in its own file
+void runSchemaBenchmarks(std::vector<MicroResult> &results);
+void runParseBenchmarks(std::vector<MicroResult> &results);
+void runRequestBenchmarks(std::vector<MicroResult> &results);
+void runCacheBenchmarks(std::vector<MicroResult> &results);
+void runInstalledModBenchmarks(std::vector<MicroResult> &results);
+
+#endif
@@ -0,0 +1,670 @@
+#include "mock_server.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define MOCK_INVALID_SOCKET -1
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define MOCK_RECEIVE_BUFFER_SIZE 65536
+// Smaller writes while emulating a slow link so throttling stays smooth
+#define MOCK_EMULATED_SEND_SIZE 16384
+#define MOCK_DEFAULT_PAGE_SIZE 100
+
+namespace modio_bench
+{
+static void closeSocket(mock_socket socket)
+{
+  close(socket);
+}
+
+static void shutdownSocket(mock_socket socket)
+{
+  shutdown(socket, SHUT_RDWR);
+}
+
+static std::string toLower(std::string str)
+{
+  std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+  return str;
+}
+
+static std::string urlDecode(const std::string &str)
+{
+  std::string decoded;
+  for (size_t i = 0; i < str.size(); i++)
+  {
+    if (str[i] == '%' && i + 2 < str.size())
+    {
+      decoded += (char)strtol(str.substr(i + 1, 2).c_str(), NULL, 16);
+      i += 2;
+    }
+    else if (str[i] == '+')
+    {
+      decoded += ' ';
+    }
+    else
+    {
+      decoded += str[i];
+    }
+  }
+  return decoded;
+}
+
+static std::vector<std::string> split(const std::string &str, char delimiter)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  std::istringstream stream(str);
+  while (std::getline(stream, token, delimiter))
+  {
+    if (token != "")
+      tokens.push_back(token);
+  }
+  return tokens;
+}
+
+static std::vector<u32> parseIdList(const std::string &str)
+{
+  std::vector<u32> ids;
+  for (auto &token : split(str, ','))
+    ids.push_back((u32)strtoul(token.c_str(), NULL, 10));
+  return ids;
+}
+
+static u32 getQueryNumber(const MockRequest &request, const std::string &key, u32 default_value)
+{
+  auto it = request.query.find(key);
+  if (it == request.query.end())
+    return default_value;
+  return (u32)strtoul(it->second.c_str(), NULL, 10);
+}
+
+static std::string getReasonPhrase(u32 code)
+{
+  switch (code)
+  {
+  case 200:
+    return "OK";
+  case 201:
+    return "Created";
+  case 204:
+    return "No Content";
+  case 206:
+    return "Partial Content";
+  case 404:
+    return "Not Found";
+  case 411:
+    return "Length Required";
+  case 416:
+    return "Range Not Satisfiable";
+  case 429:
+    return "Too Many Requests";
+  case 503:
+    return "Service Unavailable";
+  default:
+    return "Unknown";
+  }
+}
+
+static MockResponse jsonResponse(u32 code, const std::string &body)
+{
+  MockResponse response;
+  response.code = code;
+  response.content_type = "application/json";
+  response.body = body;
+  return response;
+}
+
+static MockResponse errorResponse(u32 code, const std::string &message)
+{
+  return jsonResponse(code, "{\"error\":{\"code\":" + std::to_string(code) + ",\"message\":\"" + message + "\"}}");
+}
+
+static std::string buildListJson(const std::vector<const std::string *> &entries, u32 offset, u32 limit, u32 total)
+{
+  std::string body = "{\"data\":[";
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    if (i > 0)
+      body += ",";
+    body += *entries[i];
+  }
+  body += "],\"result_count\":" + std::to_string(entries.size());
+  body += ",\"result_offset\":" + std::to_string(offset);
+  body += ",\"result_limit\":" + std::to_string(limit);
+  body += ",\"result_total\":" + std::to_string(total) + "}";
+  return body;
+}
+
+MockServer::MockServer(u32 game_id, u32 catalog_size)
+  : game_id(game_id), catalog_size(catalog_size), port(0), listen_socket(MOCK_INVALID_SOCKET), running(false),
+    pending_events(0), network_emulator(NULL), request_count(0), range_request_count(0), bytes_received(0), bytes_sent(0)
+{
+}
+
+MockServer::~MockServer()
+{
+  stop();
+}
+
+bool MockServer::start()
+{
+  listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_socket == MOCK_INVALID_SOCKET)
+    return false;
+
+  int reuse = 1;
+  setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
+  sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+
+  if (bind(listen_socket, (sockaddr *)&address, sizeof(address)) != 0 || listen(listen_socket, 1024) != 0)
+  {
+    closeSocket(listen_socket);
+    listen_socket = MOCK_INVALID_SOCKET;
+    return false;
+  }
+
+  socklen_t address_length = sizeof(address);
+  getsockname(listen_socket, (sockaddr *)&address, &address_length);
+  port = ntohs(address.sin_port);
+
+  // The download urls embed the port so the catalog can only be built once bound
+  mod_jsons.clear();
+  mod_jsons.push_back("");
+  for (u32 mod_id = 1; mod_id <= catalog_size; mod_id++)
+    mod_jsons.push_back(buildModJson(mod_id));
+
+  running = true;
+  accept_thread = std::thread(&MockServer::acceptLoop, this);
+  return true;
+}
+
+void MockServer::stop()
+{
+  if (!running)
+    return;
+  running = false;
+
+  shutdownSocket(listen_socket);
+  closeSocket(listen_socket);
+  listen_socket = MOCK_INVALID_SOCKET;
+  if (accept_thread.joinable())
+    accept_thread.join();
+
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    for (auto connection : connection_sockets)
+      shutdownSocket(connection);
+    threads.swap(connection_threads);
+  }
+  for (auto &thread : threads)
+    thread.join();
+}
+
+std::string MockServer::getUrl() const
+{
+  return "http://127.0.0.1:" + std::to_string(port) + "/";
+}
+
+void MockServer::setDownloadBody(const std::string &body)
+{
+  download_body = body;
+}
+
+void MockServer::setPendingEvents(u32 events_count)
+{
+  std::lock_guard<std::mutex> lock(state_mutex);
+  pending_events = events_count;
+}
+
+void MockServer::setNetworkEmulator(NetworkEmulator *network_emulator_)
+{
+  network_emulator = network_emulator_;
+}
+
+u64 MockServer::getRequestCount() const
+{
+  return request_count;
+}
+
+u64 MockServer::getRangeRequestCount() const
+{
+  return range_request_count;
+}
+
+u64 MockServer::getBytesReceived() const
+{
+  return bytes_received;
+}
+
+u64 MockServer::getBytesSent() const
+{
+  return bytes_sent;
+}
+
+void MockServer::acceptLoop()
+{
+  while (running)
+  {
+    mock_socket connection = accept(listen_socket, NULL, NULL);
+    if (connection == MOCK_INVALID_SOCKET)
+      continue;
+
+    int no_delay = 1;
+    setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, (const char *)&no_delay, sizeof(no_delay));
+
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    if (!running)
+    {
+      closeSocket(connection);
+      break;
+    }
+    connection_sockets.insert(connection);
+    connection_threads.push_back(std::thread(&MockServer::serveConnection, this, connection));
+  }
+}
+
+void MockServer::serveConnection(mock_socket connection)
+{
+  std::string buffer;
+  char chunk[MOCK_RECEIVE_BUFFER_SIZE];
+  bool keep_alive = true;
+
+  while (keep_alive && running)
+  {
+    size_t header_end;
+    while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos)
+    {
+      int received = (int)recv(connection, chunk, sizeof(chunk), 0);
+      if (received <= 0)
+      {
+        keep_alive = false;
+        break;
+      }
+      bytes_received += received;
+      buffer.append(chunk, received);
+    }
+    if (!keep_alive)
+      break;
+
+    MockRequest request;
+    std::vector<std::string> lines;
+    {
+      std::string header = buffer.substr(0, header_end);
+      size_t start = 0, end;
+      while ((end = header.find("\r\n", start)) != std::string::npos)
+      {
+        lines.push_back(header.substr(start, end - start));
+        start = end + 2;
+      }
+      lines.push_back(header.substr(start));
+    }
+    buffer.erase(0, header_end + 4);
+
+    std::istringstream request_line(lines[0]);
+    std::string target;
+    request_line >> request.method >> target;
+
+    size_t query_start = target.find('?');
+    request.path = urlDecode(target.substr(0, query_start));
+    if (query_start != std::string::npos)
+    {
+      for (auto &param : split(target.substr(query_start + 1), '&'))
+      {
+        size_t equals = param.find('=');
+        if (equals == std::string::npos)
+          request.query[urlDecode(param)] = "";
+        else
+          request.query[urlDecode(param.substr(0, equals))] = urlDecode(param.substr(equals + 1));
+      }
+    }
+
+    for (size_t i = 1; i < lines.size(); i++)
+    {
+      size_t colon = lines[i].find(':');
+      if (colon == std::string::npos)
+        continue;
+      std::string value = lines[i].substr(colon + 1);
+      value.erase(0, value.find_first_not_of(' '));
+      request.headers[toLower(lines[i].substr(0, colon))] = value;
+    }
+
+    if (request.headers.count("connection") && toLower(request.headers["connection"]) == "close")
+      keep_alive = false;
+
+    if (request.headers.count("transfer-encoding"))
+    {
+      // libcurl always knows the length of what the SDK sends
+      request.body_size = 0;
+      sendResponse(connection, request, errorResponse(411, "Chunked request bodies are not supported"));
+      break;
+    }
+
+    // Request bodies are drained and counted, nothing the SDK uploads is kept around
+    u64 content_length = request.headers.count("content-length") ? strtoull(request.headers["content-length"].c_str(), NULL, 10) : 0;
+    request.body_size = content_length;
+
+    if (content_length > 0 && request.headers.count("expect") && toLower(request.headers["expect"]) == "100-continue")
+    {
+      const char continue_line[] = "HTTP/1.1 100 Continue\r\n\r\n";
+      if (!sendAll(connection, continue_line, sizeof(continue_line) - 1))
+        break;
+    }
+
+    u64 buffered = std::min<u64>(content_length, buffer.size());
+    buffer.erase(0, (size_t)buffered);
+    u64 remaining = content_length - buffered;
+    while (remaining > 0)
+    {
+      int received = (int)recv(connection, chunk, (int)std::min<u64>(sizeof(chunk), remaining), 0);
+      if (received <= 0)
+      {
+        keep_alive = false;
+        break;
+      }
+      bytes_received += received;
+      remaining -= received;
+    }
+    if (!keep_alive)
+      break;
+
+    request_count++;
+
+    MockResponse response;
+    u32 injected_error = network_emulator ? network_emulator->nextInjectedError() : 0;
+    if (injected_error != 0)
+    {
+      response = errorResponse(injected_error, "Injected by the network emulator");
+      if (injected_error == 429)
+        response.headers.push_back("X-Ratelimit-RetryAfter: " + std::to_string(network_emulator->getConditions().retry_after_seconds));
+    }
+    else
+    {
+      response = route(request);
+    }
+
+    if (!sendResponse(connection, request, response))
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(connections_mutex);
+  connection_sockets.erase(connection);
+  closeSocket(connection);
+}
+
+bool MockServer::sendAll(mock_socket connection, const char *data, size_t size)
+{
+  size_t send_size = network_emulator ? MOCK_EMULATED_SEND_SIZE : MOCK_RECEIVE_BUFFER_SIZE;
+  while (size > 0)
+  {
+    size_t chunk_size = std::min(size, send_size);
+    if (network_emulator)
+      network_emulator->throttle(chunk_size);
+    int sent = (int)send(connection, data, (int)chunk_size, MSG_NOSIGNAL);
+    if (sent <= 0)
+      return false;
+    bytes_sent += sent;
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+bool MockServer::sendResponse(mock_socket connection, const MockRequest &request, const MockResponse &response)
+{
+  std::string header = "HTTP/1.1 " + std::to_string(response.code) + " " + getReasonPhrase(response.code) + "\r\n";
+  if (response.content_type != "")
+    header += "Content-Type: " + response.content_type + "\r\n";
+  header += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+  for (auto &extra_header : response.headers)
+    header += extra_header + "\r\n";
+  header += "\r\n";
+
+  size_t body_size = response.body.size();
+  if (network_emulator)
+  {
+    network_emulator->delayResponse();
+    body_size = network_emulator->getDisconnectOffset(body_size);
+  }
+
+  if (!sendAll(connection, header.c_str(), header.size()) || !sendAll(connection, response.body.c_str(), body_size))
+    return false;
+  // A cut off body closes the connection the way a dropped link would
+  return body_size == response.body.size();
+}
+
+MockResponse MockServer::route(const MockRequest &request)
+{
+  std::vector<std::string> segments = split(request.path, '/');
+
+  if (segments.size() < 2 || segments[0] != "v1")
+    return errorResponse(404, "Unknown endpoint");
+
+  // v1/me/...
+  if (segments[1] == "me")
+  {
+    if (segments.size() == 3 && segments[2] == "subscribed")
+    {
+      std::vector<u32> mod_ids;
+      {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        mod_ids.assign(subscriptions.begin(), subscriptions.end());
+      }
+      return listMods(request, mod_ids);
+    }
+    if (segments.size() == 3 && segments[2] == "events")
+      return jsonResponse(200, buildListJson(std::vector<const std::string *>(), 0, MOCK_DEFAULT_PAGE_SIZE, 0));
+    if (segments.size() == 2)
+      return jsonResponse(200, "{\"id\":1,\"name_id\":\"bench\",\"username\":\"bench\",\"date_online\":0}");
+    return errorResponse(404, "Unknown endpoint");
+  }
+
+  // v1/games/{game_id}/mods/...
+  if (segments.size() < 4 || segments[1] != "games" || segments[3] != "mods")
+    return errorResponse(404, "Unknown endpoint");
+
+  if (segments.size() == 4)
+  {
+    auto id_in = request.query.find("id-in");
+    if (id_in != request.query.end())
+      return listMods(request, parseIdList(id_in->second));
+
+    std::vector<u32> mod_ids;
+    for (u32 mod_id = 1; mod_id <= catalog_size; mod_id++)
+      mod_ids.push_back(mod_id);
+    return listMods(request, mod_ids);
+  }
+
+  if (segments[4] == "events")
+    return listEvents(request);
+
+  u32 mod_id = (u32)strtoul(segments[4].c_str(), NULL, 10);
+  if (mod_id == 0 || mod_id > catalog_size)
+    return errorResponse(404, "The requested mod could not be found");
+
+  if (segments.size() == 5)
+    return jsonResponse(200, mod_jsons[mod_id]);
+
+  if (segments[5] == "subscribe")
+  {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    if (request.method == "DELETE")
+    {
+      subscriptions.erase(mod_id);
+      return jsonResponse(204, "");
+    }
+    subscriptions.insert(mod_id);
+    return jsonResponse(201, mod_jsons[mod_id]);
+  }
+
+  if (segments[5] == "files")
+  {
+    if (segments.size() == 8 && segments[7] == "download")
+      return download(request);
+    if (request.method == "POST")
+      return jsonResponse(201, buildModfileJson(mod_id));
+
+    std::string modfile_json = buildModfileJson(mod_id);
+    return jsonResponse(200, buildListJson(std::vector<const std::string *>(1, &modfile_json), 0, MOCK_DEFAULT_PAGE_SIZE, 1));
+  }
+
+  return errorResponse(404, "Unknown endpoint");
+}
+
+MockResponse MockServer::listMods(const MockRequest &request, const std::vector<u32> &mod_ids)
+{
+  // Page sizes are not capped at the API's 100 so oversized requests show up in the numbers
+  u32 offset = getQueryNumber(request, "_offset", 0);
+  u32 limit = getQueryNumber(request, "_limit", (u32)mod_ids.size());
+
+  std::vector<const std::string *> entries;
+  std::set<u32> added_ids;
+  u32 total = 0;
+  for (auto mod_id : mod_ids)
+  {
+    if (mod_id == 0 || mod_id > catalog_size || !added_ids.insert(mod_id).second)
+      continue;
+    if (total >= offset && entries.size() < limit)
+      entries.push_back(&mod_jsons[mod_id]);
+    total++;
+  }
+  return jsonResponse(200, buildListJson(entries, offset, limit, total));
+}
+
+MockResponse MockServer::listEvents(const MockRequest &request)
+{
+  std::vector<u32> mod_ids;
+  auto mod_id_in = request.query.find("mod_id-in");
+  if (mod_id_in != request.query.end())
+    mod_ids = parseIdList(mod_id_in->second);
+
+  u32 events_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    if (!mod_ids.empty())
+    {
+      events_count = pending_events;
+      pending_events = 0;
+    }
+  }
+
+  // Every mod gets edited repeatedly and its last event is a new modfile
+  u32 now = (u32)time(NULL);
+  std::vector<std::string> events;
+  for (u32 i = 0; i < events_count; i++)
+  {
+    u32 mod_id = mod_ids[i % mod_ids.size()];
+    bool is_last_for_mod = i + mod_ids.size() >= events_count;
+    events.push_back("{\"id\":" + std::to_string(i + 1) + ",\"mod_id\":" + std::to_string(mod_id) +
+                     ",\"user_id\":1,\"date_added\":" + std::to_string(now - events_count + i) +
+                     ",\"event_type\":\"" + (is_last_for_mod ? "MODFILE_CHANGED" : "MOD_EDITED") + "\"}");
+  }
+
+  std::vector<const std::string *> entries;
+  for (auto &event : events)
+    entries.push_back(&event);
+  return jsonResponse(200, buildListJson(entries, 0, events_count, events_count));
+}
+
+MockResponse MockServer::download(const MockRequest &request)
+{
+  MockResponse response;
+  response.content_type = "application/zip";
+
+  u64 size = download_body.size();
+  u64 start = 0;
+
+  auto range = request.headers.find("range");
+  if (range != request.headers.end() && range->second.compare(0, 6, "bytes=") == 0)
+  {
+    start = strtoull(range->second.c_str() + 6, NULL, 10);
+    range_request_count++;
+  }
+
+  if (start == 0)
+  {
+    response.code = 200;
+    response.body = download_body;
+  }
+  else if (start < size)
+  {
+    response.code = 206;
+    response.headers.push_back("Content-Range: bytes " + std::to_string(start) + "-" + std::to_string(size - 1) + "/" + std::to_string(size));
+    response.body = download_body.substr((size_t)start);
+  }
+  else
+  {
+    response.code = 416;
+    response.headers.push_back("Content-Range: bytes */" + std::to_string(size));
+  }
+  return response;
+}
+
+std::string MockServer::buildModfileJson(u32 mod_id)
+{
+  std::string id = std::to_string(mod_id);
+  return "{\"id\":" + id + ",\"mod_id\":" + id +
+         ",\"date_added\":1499841487,\"date_scanned\":1499841487,\"virus_status\":0,\"virus_positive\":0"
+         ",\"virustotal_hash\":\"f9a7bf4a95ce20787337b685a79677cae2281b83c63ab0a25f091407741692af-1508147401\""
+         ",\"filesize\":" + std::to_string(download_body.size()) +
+         ",\"filehash\":{\"md5\":\"2d4a0e2d7273db6b0a94b0740a88ad0d\"}"
+         ",\"filename\":\"mod-" + id + ".zip\",\"version\":\"1.3\""
+         ",\"changelog\":\"VERSION 1.3 -- Changes -- Fixed critical castle floor bug.\""
+         ",\"metadata_blob\":\"rogue,hd,high-res,4k,hd textures\""
+         ",\"download\":{\"binary_url\":\"" + getUrl() + "v1/games/" + std::to_string(game_id) + "/mods/" + id + "/files/" + id + "/download\""
+         ",\"date_expires\":1579316848}}";
+}
+
+std::string MockServer::buildModJson(u32 mod_id)
+{
+  // Same shape and roughly the same size as a listing entry from the live API
+  std::string id = std::to_string(mod_id);
+  std::string description;
+  for (u32 i = 0; i < 8; i++)
+    description += "<p>Rogue HD Pack does exactly what you think it does, it replaces every texture with a 4k version.</p>";
+
+  return "{\"id\":" + id + ",\"game_id\":" + std::to_string(game_id) + ",\"status\":1,\"visible\":1"
+         ",\"submitted_by\":{\"id\":1,\"name_id\":\"xant\",\"username\":\"XanT\",\"date_online\":1509922961"
+         ",\"avatar\":{\"filename\":\"modio-color-dark.png\",\"original\":\"https://static.mod.io/v1/images/original.png\""
+         ",\"thumb_50x50\":\"https://static.mod.io/v1/images/thumb_50x50.png\",\"thumb_100x100\":\"https://static.mod.io/v1/images/thumb_100x100.png\"}"
+         ",\"timezone\":\"America/Los_Angeles\",\"language\":\"en\",\"profile_url\":\"https://mod.io/members/xant\"}"
+         ",\"date_added\":1492564103,\"date_updated\":1499841487,\"date_live\":1499841403,\"maturity_option\":0"
+         ",\"logo\":{\"filename\":\"modio-color-dark.png\",\"original\":\"https://static.mod.io/v1/images/original.png\""
+         ",\"thumb_320x180\":\"https://static.mod.io/v1/images/thumb_320x180.png\",\"thumb_640x360\":\"https://static.mod.io/v1/images/thumb_640x360.png\""
+         ",\"thumb_1280x720\":\"https://static.mod.io/v1/images/thumb_1280x720.png\"}"
+         ",\"homepage_url\":\"https://www.rogue-hdpack.com/\",\"name\":\"Mod " + id + "\",\"name_id\":\"mod-" + id + "\""
+         ",\"summary\":\"It's time to bask in the glory of beautiful 4k textures!\""
+         ",\"description\":\"" + description + "\",\"description_plaintext\":\"Rogue HD Pack does exactly what you think it does.\""
+         ",\"metadata_blob\":\"rogue,hd,high-res,4k,hd textures\",\"profile_url\":\"https://rogue-knight.mod.io/mod-" + id + "\""
+         ",\"media\":{\"youtube\":[\"https://www.youtube.com/watch?v=dQw4w9WgXcQ\"]"
+         ",\"sketchfab\":[\"https://sketchfab.com/models/ef40b2d300334d009984c8865b2db1c8\"]"
+         ",\"images\":[{\"filename\":\"modio-color-dark.png\",\"original\":\"https://static.mod.io/v1/images/original.png\""
+         ",\"thumb_320x180\":\"https://static.mod.io/v1/images/thumb_320x180.png\"}]}"
+         ",\"modfile\":" + buildModfileJson(mod_id) +
+         ",\"metadata_kvp\":[{\"metakey\":\"pistol-dmg\",\"metavalue\":\"800\"}]"
+         ",\"tags\":[{\"name\":\"Unity\",\"date_added\":1499841487}]"
+         ",\"stats\":{\"mod_id\":" + id + ",\"popularity_rank_position\":" + id + ",\"popularity_rank_total_mods\":" + std::to_string(catalog_size) +
+         ",\"downloads_total\":27492,\"subscribers_total\":16394,\"ratings_total\":1230,\"ratings_positive\":1047"
+         ",\"ratings_negative\":183,\"ratings_percentage_positive\":91,\"ratings_weighted_aggregate\":87.38"
+         ",\"ratings_display_text\":\"Very Positive\",\"date_expires\":1492564103}}";
+}
+} // namespace modio_bench
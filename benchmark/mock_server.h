@@ -0,0 +1,105 @@
+#ifndef MODIO_BENCH_MOCK_SERVER_H
+#define MODIO_BENCH_MOCK_SERVER_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "c/ModioC.h"
+#include "network_emulator.h"
+
+typedef int mock_socket;
+
+namespace modio_bench
+{
+struct MockRequest
+{
+  std::string method;
+  std::string path;
+  std::map<std::string, std::string> query;
+  // Header names are lowercased
+  std::map<std::string, std::string> headers;
+  u64 body_size;
+};
+
+struct MockResponse
+{
+  u32 code;
+  std::string content_type;
+  std::vector<std::string> headers;
+  std::string body;
+};
+
+// Loopback stand-in for the v1 endpoints the SDK talks to. Every connection is
+// served on its own thread with keep-alive so libcurl can reuse connections the
+// same way it does against the real API. The catalog is generated up front so
+// serving a request costs as little as possible next to the SDK being measured.
+class MockServer
+{
+public:
+  MockServer(u32 game_id, u32 catalog_size);
+  ~MockServer();
+
+  // Binds an ephemeral port on 127.0.0.1
+  bool start();
+  void stop();
+  // Base url with trailing slash, meant to replace modio::MODIO_URL
+  std::string getUrl() const;
+
+  // Body served for every modfile download, has to be set before start()
+  void setDownloadBody(const std::string &body);
+  // Events returned by the first mod events poll, spread across the requested mod ids
+  void setPendingEvents(u32 events_count);
+  // Degrades every connection as configured on the emulator, NULL serves at full speed.
+  // The emulator is not owned by the server.
+  void setNetworkEmulator(NetworkEmulator *network_emulator);
+
+  u64 getRequestCount() const;
+  // Downloads that asked for a byte range, i.e. resumed ones
+  u64 getRangeRequestCount() const;
+  u64 getBytesReceived() const;
+  u64 getBytesSent() const;
+
+private:
+  u32 game_id;
+  u32 catalog_size;
+  u32 port;
+  mock_socket listen_socket;
+  std::atomic<bool> running;
+  std::thread accept_thread;
+
+  std::mutex connections_mutex;
+  std::vector<std::thread> connection_threads;
+  std::set<mock_socket> connection_sockets;
+
+  std::mutex state_mutex;
+  std::vector<std::string> mod_jsons;
+  std::set<u32> subscriptions;
+  std::string download_body;
+  u32 pending_events;
+  NetworkEmulator *network_emulator;
+
+  std::atomic<u64> request_count;
+  std::atomic<u64> range_request_count;
+  std::atomic<u64> bytes_received;
+  std::atomic<u64> bytes_sent;
+
+  void acceptLoop();
+  void serveConnection(mock_socket connection);
+  bool sendAll(mock_socket connection, const char *data, size_t size);
+  bool sendResponse(mock_socket connection, const MockRequest &request, const MockResponse &response);
+
+  MockResponse route(const MockRequest &request);
+  MockResponse listMods(const MockRequest &request, const std::vector<u32> &mod_ids);
+  MockResponse listEvents(const MockRequest &request);
+  MockResponse download(const MockRequest &request);
+  std::string buildModJson(u32 mod_id);
+  std::string buildModfileJson(u32 mod_id);
+};
+} // namespace modio_bench
+
+#endif
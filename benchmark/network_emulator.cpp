@@ -0,0 +1,99 @@
+#include "network_emulator.h"
+
+#include <chrono>
+#include <thread>
+
+namespace modio_bench
+{
+NetworkEmulator::NetworkEmulator(u32 seed)
+  : generator(seed), requests_until_burst(0), burst_remaining(0), injected_errors(0), disconnects(0), stalls(0)
+{
+}
+
+void NetworkEmulator::setConditions(const NetworkConditions &conditions_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  conditions = conditions_;
+  requests_until_burst = conditions.error_burst_every;
+  burst_remaining = 0;
+}
+
+NetworkConditions NetworkEmulator::getConditions()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return conditions;
+}
+
+double NetworkEmulator::nextRandom()
+{
+  return std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+}
+
+u32 NetworkEmulator::nextInjectedError()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (conditions.error_burst_every == 0 || conditions.error_burst_length == 0)
+    return 0;
+
+  if (burst_remaining == 0)
+  {
+    if (--requests_until_burst > 0)
+      return 0;
+    requests_until_burst = conditions.error_burst_every;
+    burst_remaining = conditions.error_burst_length;
+  }
+
+  burst_remaining--;
+  injected_errors++;
+  return conditions.error_code;
+}
+
+void NetworkEmulator::delayResponse()
+{
+  u32 latency_ms = getConditions().latency_ms;
+  if (latency_ms > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms));
+}
+
+size_t NetworkEmulator::getDisconnectOffset(size_t body_size)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (body_size == 0 || body_size < conditions.disconnect_min_bytes || conditions.disconnect_rate <= 0 || nextRandom() >= conditions.disconnect_rate)
+    return body_size;
+
+  disconnects++;
+  return (size_t)(nextRandom() * body_size);
+}
+
+void NetworkEmulator::throttle(size_t size)
+{
+  u64 delay_us = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (conditions.bandwidth_bytes_per_second > 0)
+      delay_us += (u64)size * 1000000 / conditions.bandwidth_bytes_per_second;
+    if (conditions.stall_rate > 0 && nextRandom() < conditions.stall_rate)
+    {
+      stalls++;
+      delay_us += (u64)conditions.stall_ms * 1000;
+    }
+  }
+  if (delay_us > 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+}
+
+u64 NetworkEmulator::getInjectedErrorCount() const
+{
+  return injected_errors;
+}
+
+u64 NetworkEmulator::getDisconnectCount() const
+{
+  return disconnects;
+}
+
+u64 NetworkEmulator::getStallCount() const
+{
+  return stalls;
+}
+} // namespace modio_bench
@@ -0,0 +1,71 @@
+#ifndef MODIO_BENCH_NETWORK_EMULATOR_H
+#define MODIO_BENCH_NETWORK_EMULATOR_H
+
+#include <atomic>
+#include <mutex>
+#include <random>
+
+#include "c/ModioC.h"
+
+namespace modio_bench
+{
+struct NetworkConditions
+{
+  // Added before every response, per connection
+  u32 latency_ms = 0;
+  // Per connection, 0 means unlimited
+  u32 bandwidth_bytes_per_second = 0;
+  // Chance that sending a chunk stalls for stall_ms, like a burst of lost packets
+  double stall_rate = 0;
+  u32 stall_ms = 0;
+  // Chance that a response body of at least disconnect_min_bytes is cut off at a random
+  // offset and the connection dropped. Long transfers are the ones that get interrupted
+  double disconnect_rate = 0;
+  u32 disconnect_min_bytes = 65536;
+  // Every error_burst_every requests the next error_burst_length ones are answered with
+  // error_code. 429 responses carry X-Ratelimit-RetryAfter: retry_after_seconds
+  u32 error_burst_every = 0;
+  u32 error_burst_length = 0;
+  u32 error_code = 503;
+  u32 retry_after_seconds = 1;
+};
+
+// Degrades the mock server's connections so the download engine, the resume path and
+// the rate limit handling can be measured under the conditions players actually have.
+// Decisions come from a seeded generator so a run can be repeated exactly.
+class NetworkEmulator
+{
+public:
+  explicit NetworkEmulator(u32 seed = 1);
+
+  void setConditions(const NetworkConditions &conditions);
+  NetworkConditions getConditions();
+
+  // Returns the error code the next request has to be answered with, 0 for none
+  u32 nextInjectedError();
+  void delayResponse();
+  // Returns how many of body_size bytes get sent before the connection drops
+  size_t getDisconnectOffset(size_t body_size);
+  // Blocks for as long as sending size bytes takes on the emulated link
+  void throttle(size_t size);
+
+  u64 getInjectedErrorCount() const;
+  u64 getDisconnectCount() const;
+  u64 getStallCount() const;
+
+private:
+  std::mutex mutex;
+  std::mt19937 generator;
+  NetworkConditions conditions;
+  u32 requests_until_burst;
+  u32 burst_remaining;
+
+  std::atomic<u64> injected_errors;
+  std::atomic<u64> disconnects;
+  std::atomic<u64> stalls;
+
+  double nextRandom();
+};
+} // namespace modio_bench
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef MODIO_CACHE_STORE_H
+#define MODIO_CACHE_STORE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+#include "Utility.h"
+
+#define MODIO_CACHE_STORE_MAX_BYTES 33554432
+
+// Values smaller than this are stored as they are
+#define MODIO_CACHE_COMPRESSION_MIN_BYTES 256
+
+// Record flags
+#define MODIO_CACHE_RECORD_TOMBSTONE  1
+#define MODIO_CACHE_RECORD_COMPRESSED 2
+
+namespace modio
+{
+// Single memory-mapped file holding every cached response.
+//
+// Layout: two header slots followed by append-only records. Each header slot carries a
+// generation and a CRC, the valid slot with the highest generation wins, so a torn
+// header write falls back to the previous state. Records carry their own CRC and the
+// scan on open stops at the first damaged one. Records are indexed in memory by the
+// 64-bit hash of their key, the key itself is kept in the record to rule out collisions.
+//
+// Records can carry tags, e.g. the ids of the mods a response contains, and every record
+// with a given tag can be listed or dropped at once.
+//
+// Values are deflated when that makes them smaller. The least recently read records are
+// evicted once the live bytes exceed the budget. Dropping records at the start of the log
+// only moves its start forward, records dropped anywhere else get a tombstone appended.
+// The space left behind is reclaimed by compact(), which rewrites the live records into a
+// new file and renames it over the old one. The file never grows past a quarter over the
+// budget, put() compacts first when it would.
+//
+// Writes go to the mapping and reach the disk when the system flushes it, close() waits
+// for them. Records written since the last flush can be lost on a power failure, the
+// scan on the next open stops at the first one that did not make it.
+class CacheStore
+{
+public:
+  CacheStore();
+  ~CacheStore();
+
+  bool open(const std::string &path, u64 max_bytes);
+  void close();
+  bool isOpen() const;
+
+  bool get(const std::string &key, u32 max_age_seconds, std::string &value, double *datetime_millis = NULL, std::vector<u32> *tags = NULL);
+  bool put(const std::string &key, const std::string &value, double datetime_millis, const std::vector<u32> &tags = std::vector<u32>());
+  void remove(const std::string &key);
+  std::vector<std::string> getTaggedKeys(u32 tag) const;
+  void removeTagged(u32 tag);
+  // Drops every record written before datetime_millis
+  void removeOlderThan(double datetime_millis);
+  void clear();
+
+  void setMaxBytes(u64 max_bytes);
+  bool needsCompaction() const;
+  bool compact();
+
+  u32 getRecordCount() const;
+  // Bytes taken by the live records, and what their values take once inflated
+  u64 getLiveBytes() const;
+  u64 getRawBytes() const;
+  u64 getFileBytes() const;
+  u64 getEvictionCount() const;
+
+private:
+  struct IndexEntry
+  {
+    u64 offset;
+    u64 size;
+    u64 raw_size;
+    double datetime_millis;
+    std::vector<u32> tags;
+    std::list<u64>::iterator recency;
+  };
+
+  std::string path;
+  u64 max_bytes;
+  u64 generation;
+  u64 data_begin;
+  u64 data_end;
+  u64 live_bytes;
+  u64 raw_bytes;
+  u64 evictions;
+
+  char *mapped_data;
+  u64 mapped_size;
+#ifdef MODIO_WINDOWS_DETECTED
+  HANDLE file_handle;
+  HANDLE mapping_handle;
+#else
+  int file_descriptor;
+#endif
+
+  std::unordered_map<u64, IndexEntry> index;
+  // Live records in log order, oldest first
+  std::map<u64, u64> offsets;
+  // Keys of the live records, most recently read first
+  std::list<u64> recency;
+  std::unordered_map<u32, std::vector<u64> > tagged;
+
+  bool map(u64 size);
+  void unmap(bool sync);
+  bool reserve(u64 size);
+  void writeHeader();
+  bool readHeader();
+  void scan();
+  bool append(u64 key, u32 flags, const std::string &key_string, const std::string &value, u64 raw_size, double datetime_millis, const std::vector<u32> &tags, u64 *offset);
+  bool keyMatches(const IndexEntry &entry, const std::string &key) const;
+  void addEntry(u64 key, u64 offset, u64 size, u64 raw_size, double datetime_millis, const std::vector<u32> &tags);
+  void dropEntry(u64 key);
+  void dropEntries(const std::vector<u64> &keys);
+  // Until the live records and incoming_bytes more fit the budget
+  void evict(u64 incoming_bytes);
+};
+} // namespace modio
+
+#endif
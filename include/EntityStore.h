@@ -0,0 +1,78 @@
+#ifndef MODIO_ENTITY_STORE_H
+#define MODIO_ENTITY_STORE_H
+
+#include <list>
+#include <unordered_map>
+
+#include "Utility.h"
+
+#define MODIO_ENTITY_STORE_MAX_ENTITIES 4096
+
+namespace modio
+{
+// Mods and modfiles by id, as last seen in any response. Listings, single gets,
+// subscriptions and edits all feed it so a mod that was already shown can be served
+// without asking the server again.
+//
+// An entity only replaces the stored one when its date_updated (date_added for
+// modfiles) is not older, so a response that was cached or delayed never rolls back
+// newer data. Events naming a change after the stored date_updated drop the entity.
+class EntityTable
+{
+public:
+  explicit EntityTable(u32 max_entities);
+
+  void put(u32 id, u32 date_updated, double datetime_millis, const nlohmann::json &entity_json);
+  // Fills entity_json when the entity was seen in the last max_age_seconds
+  bool get(u32 id, u32 max_age_seconds, nlohmann::json &entity_json);
+  // Drops the entity unless it was already updated at date_changed or later
+  void invalidate(u32 id, u32 date_changed);
+  void remove(u32 id);
+  void clear();
+  u32 getCount() const;
+
+private:
+  struct Entity
+  {
+    u32 id;
+    u32 date_updated;
+    double datetime_millis;
+    nlohmann::json entity_json;
+  };
+
+  u32 max_entities;
+  // Most recently used first
+  std::list<Entity> entities;
+  std::unordered_map<u32, std::list<Entity>::iterator> index;
+};
+
+class EntityStore
+{
+public:
+  EntityStore();
+
+  // Also stores the modfile embedded in the mod
+  void putMod(const nlohmann::json &mod_json, double datetime_millis);
+  void putModfile(const nlohmann::json &modfile_json, double datetime_millis);
+  bool getMod(u32 mod_id, u32 max_age_seconds, nlohmann::json &mod_json);
+  bool getModfile(u32 modfile_id, u32 max_age_seconds, nlohmann::json &modfile_json);
+  void invalidateMod(u32 mod_id, u32 date_changed);
+  void removeMod(u32 mod_id);
+
+  // The mod as it was when installed, kept apart from the listings and never evicted
+  void setInstalledMod(u32 mod_id, const nlohmann::json &mod_json);
+  bool getInstalledMod(u32 mod_id, nlohmann::json &mod_json) const;
+  void clearInstalledMods();
+
+  void clear();
+  u32 getModCount() const;
+  u32 getModfileCount() const;
+
+private:
+  EntityTable mods;
+  EntityTable modfiles;
+  std::unordered_map<u32, nlohmann::json> installed_mods;
+};
+} // namespace modio
+
+#endif
@@ -21,12 +21,15 @@ namespace modio
   extern u32 EVENT_POLL_INTERVAL;
   extern u32 AUTOMATIC_UPDATES;
   extern u32 BACKGROUND_DOWNLOADS;
+  extern u32 BINARY_CACHE;
+  extern u32 LAZY_FIELDS;
+  extern u32 CACHE_MAX_BYTES;
+  extern u32 PREFETCH_BUDGET;
   extern u32 RETRY_AFTER;
   extern ModioUser current_user;
   extern void (*event_listener_callback)(ModioResponse response, ModioModEvent* events_array, u32 events_array_size);
   extern void (*download_callback)(u32 response_code, u32 mod_id);
   extern void (*upload_callback)(u32 response_code, u32 mod_id);
-  extern nlohmann::json installed_mods;
 }
 
 #endif
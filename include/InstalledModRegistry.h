@@ -0,0 +1,53 @@
+#ifndef MODIO_INSTALLED_MOD_REGISTRY_H
+#define MODIO_INSTALLED_MOD_REGISTRY_H
+
+#include <unordered_map>
+
+#include "Utility.h"
+
+namespace modio
+{
+struct InstalledModRecord
+{
+  u32 mod_id;
+  u32 modfile_id;
+  u32 date_updated;
+  std::string path;
+  // Of the modio.json at path when it was last read, a modified_time of 0 means unknown
+  FileFingerprint fingerprint;
+};
+
+// The installed mods in the order they were installed, indexed by mod id. A mod installed
+// at more than one path has a record per path, lookups by id return the first one.
+//
+// Changes only mark the registry dirty, installed_mods.json is rewritten by write() once
+// per batch instead of on every install.
+class InstalledModRegistry
+{
+public:
+  InstalledModRegistry();
+
+  // Updates the record of the mod at path, or adds one
+  void put(u32 mod_id, const std::string &path, u32 modfile_id, u32 date_updated, const FileFingerprint &fingerprint);
+  const InstalledModRecord *find(u32 mod_id) const;
+  const std::vector<InstalledModRecord> &getRecords() const;
+  u32 getCount() const;
+  void clear();
+
+  bool isDirty() const;
+  // For a registry just loaded from the file write() would produce
+  void markClean();
+  // Writes the records to file_path as the installed_mods.json array and clears the dirty flag
+  void write(const std::string &file_path);
+
+private:
+  std::vector<InstalledModRecord> records;
+  // Mod id to the positions of its records, in install order
+  std::unordered_multimap<u32, u32> index;
+  bool dirty;
+};
+
+nlohmann::json toJson(const InstalledModRecord &installed_mod);
+} // namespace modio
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef MODIO_JSON_PARSER_H
+#define MODIO_JSON_PARSER_H
+
+#include <cstddef>
+
+#include "c/ModioC.h"
+#include "dependencies/nlohmann/json.hpp"
+
+#define MODIO_JSON_BACKEND_SCALAR 0
+#define MODIO_JSON_BACKEND_SSE42 1
+#define MODIO_JSON_BACKEND_AVX2 2
+
+// Deeper documents are handed to nlohmann, the structural parser recurses per level
+#define MODIO_JSON_MAX_DEPTH 512
+
+namespace modio
+{
+// Two stage parser in the style of simdjson. The first stage classifies 64 bytes at a
+// time and builds an index of the structural characters outside of the strings, the
+// second walks the index and builds the nlohmann::json the rest of the SDK reads.
+// Only the first stage differs between backends, the fastest one the cpu supports is
+// picked at startup.
+//
+// Returns false on anything the parser does not take, malformed documents included, so
+// the caller falls back to nlohmann::json::parse and reports the error as before. Every
+// document it does take gives the same json nlohmann would.
+bool parseJson(const char *json_str, size_t json_str_size, nlohmann::json &json);
+
+u32 getJsonBackend();
+const char *getJsonBackendName(u32 backend);
+// For benchmarks, backends the cpu does not support fall back to the best supported one
+void setJsonBackend(u32 backend);
+} // namespace modio
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef MODIO_LAZY_FIELDS_H
+#define MODIO_LAZY_FIELDS_H
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "Utility.h"
+#include "Globals.h"
+#include "c/schemas/ModioMedia.h"
+
+// Listings retained for the lazy fields, older ones are released with their mods
+#define MODIO_LAZY_FIELDS_MAX_RESPONSES 16
+
+namespace modio
+{
+// With LAZY_FIELDS enabled the mod listings leave description, description_plaintext,
+// metadata_blob and media out of the decoded mods. The parsed response is kept instead
+// and each mod points at its object in it, the fields are read from there the first
+// time they are asked for. Only the last MODIO_LAZY_FIELDS_MAX_RESPONSES listings are
+// kept, a mod found in a newer one points there.
+//
+// The strings and media handed out point into what is retained. What gets released,
+// by newer listings or by a newer copy of the same mod, is only freed on the next
+// modioProcess, so a pointer taken in a callback outlives a prefetch that evicts its
+// listing later in the same process call.
+
+// Keeps the response and indexes the mods of its data array by id
+void retainLazyResponse(const std::shared_ptr<const nlohmann::json> &response_json);
+// The mod object in the latest retained response holding it, NULL when none does
+const nlohmann::json *findLazyMod(u32 mod_id);
+// Media decoded on the first call and kept with the retained response, NULL when no
+// retained response holds the mod
+const ModioMedia *getLazyMedia(u32 mod_id);
+// Frees what was released since the last call, run at the start of modioProcess
+void processLazyFields();
+// Frees everything at once, for modioShutdown
+void clearLazyFields();
+} // namespace modio
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MODIO_LOGGER_H
+#define MODIO_LOGGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "c/ModioC.h"
+
+// Must be a power of two
+#define MODIO_LOG_RING_SIZE 1024
+// The log is moved to log.1 once it grows past this
+#define MODIO_LOG_MAX_BYTES 4194304
+#define MODIO_LOG_FLUSH_INTERVAL_MILLIS 50
+
+namespace modio
+{
+struct LogLine
+{
+  u32 debug_level;
+  u32 time;
+  std::string text;
+};
+
+// Bounded multi-producer single-consumer queue. Producers claim a slot with a CAS on the
+// head and publish it through the slot sequence, nothing ever blocks. When the flusher
+// falls behind the ring fills up and new lines are dropped instead of stalling callers.
+class LogRing
+{
+public:
+  LogRing();
+
+  bool push(LogLine &line);
+  bool pop(LogLine &line);
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    LogLine line;
+  };
+
+  Slot slots[MODIO_LOG_RING_SIZE];
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+};
+
+// Lines are queued by writeLogLine and written by a background thread that keeps the
+// log file open, so logging costs a copy of the message instead of an open, a write and
+// a close. Before startLogger and after stopLogger lines are written synchronously.
+void startLogger(const std::string &log_path);
+// Joins the logger thread, waits for the producers still pushing, then writes whatever
+// is still queued on the calling thread
+void stopLogger();
+// Returns false when the logger is not running or stopping, the caller writes the line then
+bool queueLogLine(u32 debug_level, const std::string &text);
+// The listener is called from the logger thread while it runs, see modioSetLogListener
+void setLogListener(void (*callback)(u32 debug_level, char const *message));
+void callLogListener(u32 debug_level, const std::string &text);
+std::string formatLogLine(u32 debug_level, u32 time, const std::string &text);
+} // namespace modio
+
+#endif
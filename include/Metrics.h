@@ -0,0 +1,71 @@
+#ifndef MODIO_METRICS_H
+#define MODIO_METRICS_H
+
+#include <atomic>
+#include <string>
+
+#include "c/ModioC.h"
+
+#define MODIO_HISTOGRAM_SUB_BUCKETS 8
+// Values up to 2^38 microseconds, about 76 hours, larger ones count in the last bucket
+#define MODIO_HISTOGRAM_MAGNITUDES 36
+#define MODIO_HISTOGRAM_BUCKETS (MODIO_HISTOGRAM_MAGNITUDES * MODIO_HISTOGRAM_SUB_BUCKETS)
+// Endpoints and hosts past these count together under "other"
+#define MODIO_METRICS_MAX_ENDPOINTS 64
+#define MODIO_METRICS_ENDPOINT_SIZE 96
+#define MODIO_METRICS_MAX_HOSTS 16
+#define MODIO_METRICS_HOST_SIZE 96
+
+#define MODIO_CACHE_TIER_MEMORY 0
+#define MODIO_CACHE_TIER_STORE 1
+#define MODIO_CACHE_TIER_ENTITY_STORE 2
+#define MODIO_CACHE_TIER_MISS 3
+#define MODIO_CACHE_TIER_ENTITY_STORE_MISS 4
+
+#define MODIO_GAUGE_ACTIVE_REQUESTS 0
+#define MODIO_GAUGE_ACTIVE_DOWNLOADS 1
+#define MODIO_GAUGE_ACTIVE_UPLOADS 2
+#define MODIO_GAUGE_MOD_DOWNLOAD_QUEUE 3
+#define MODIO_GAUGE_MODFILE_UPLOAD_QUEUE 4
+#define MODIO_GAUGE_PREFETCH_QUEUE 5
+
+namespace modio
+{
+// Log-linear buckets in the way of HDR histograms, 8 linear sub-buckets per power of two
+// keep every value within 12.5% of the bound it is reported as, from microseconds to
+// hours, in a fixed 1KB of counters. Recording is a few relaxed atomic adds.
+class AtomicHistogram
+{
+public:
+  AtomicHistogram();
+
+  void record(u64 value);
+  ModioHistogram getSnapshot() const;
+
+private:
+  std::atomic<u32> buckets[MODIO_HISTOGRAM_BUCKETS];
+  std::atomic<u64> count;
+  std::atomic<u64> sum;
+  std::atomic<u64> max;
+};
+
+// Everything is counted with atomics so the SDK thread, the log thread and whoever
+// reads the metrics never wait on each other. Durations are in microseconds.
+void recordRequest(const std::string &url, u32 response_code, double network_micros, double parse_micros, double callback_micros, u64 bytes_up, u64 bytes_down, u64 decoded_bytes_down);
+// Downloads and uploads count per endpoint and in the bytes, their durations would drown the request latencies
+void recordTransfer(const std::string &endpoint, u32 response_code, u64 bytes_up, u64 bytes_down);
+// Phase times and connection reuse per host, so a slow CDN node stands out
+void recordHostTransfer(const ModioTransferInfo &transfer, u64 bytes_down);
+void recordCacheLookup(u32 cache_tier);
+// What the SDK thread has in flight or queued, set by it whenever the size changes so
+// getMetrics never reads the containers themselves
+void setGauge(u32 gauge, u32 value);
+void recordExtract(u64 extracted_bytes, u32 extracted_files, double extract_micros);
+void recordProcess(double process_micros);
+// Path of url with the ids replaced, "/v1/games/{id}/mods/{id}/stats"
+std::string getMetricsEndpoint(const std::string &url);
+ModioMetrics getMetrics();
+void freeMetrics(ModioMetrics *metrics);
+} // namespace modio
+
+#endif
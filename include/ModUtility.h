@@ -3,19 +3,75 @@
 
 #include "Utility.h"
 #include "Globals.h"
+#include "CacheStore.h"
+#include "EntityStore.h"
+#include "InstalledModRegistry.h"
+#include "LazyFields.h"
+#include "Prefetcher.h"
+#include "ResponseCache.h"
+#include "SchemaImage.h"
+#include "Metrics.h"
+#include "Tracer.h"
+#include "c/schemas/ModioResponse.h"
 #include "wrappers/MinizipWrapper.h"
 
+// How long expired responses can still be served by MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE
+#define MODIO_CACHE_STALE_MAX_AGE_SECONDS 604800
+
 namespace modio
 {
   void addCallToCache(std::string url, nlohmann::json response_json);
-  std::string getCallFileFromCache(std::string url, u32 max_age_seconds);
+  // Points response_json at the cached response and returns true when one younger than
+  // max_age_seconds is cached, the response is shared with the cache and never copied
+  bool getCallFromCache(std::string url, u32 max_age_seconds, std::shared_ptr<const nlohmann::json> &response_json);
+  // Returns a cached response regardless of max age, for MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE
+  bool getStaleCallFromCache(std::string url, std::shared_ptr<const nlohmann::json> &response_json);
+  // Restarts the age of a cached response the server confirmed unchanged
+  void refreshCachedCall(std::string url);
+  u64 getResponseHash(const nlohmann::json &response_json);
+  // 304 when the response revalidating a stale one served before it is unchanged
+  u32 getRevalidatedResponseCode(u64 stale_hash, u32 response_code, const nlohmann::json &response_json);
+  // Caches a mods listing already decoded when the binary cache is enabled, as JSON otherwise
+  void addModsCallToCache(std::string url, const nlohmann::json &response_json, const ModioResponse &response, const ModioMod *mods, u32 mods_size);
+  // Calls callback with the mods rehydrated from the binary cache, returns false on a miss
+  bool serveModsFromCache(std::string url, u32 max_age_seconds, void *object, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size));
+  // Same regardless of max age with the response flagged as stale, stale_hash identifies what was served
+  bool serveStaleModsFromCache(std::string url, void *object, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size), u64 &stale_hash);
+  // Drops every cached response containing the mod, found through the mod ids each one is tagged with
+  void invalidateCachedMod(u32 mod_id);
+  // Replaces the mod in every cached JSON response containing it, decoded listings are dropped
+  void patchCachedMod(const nlohmann::json &mod_json);
+  // Entity store, fed by every response that carries mods or modfiles
+  void storeMod(const nlohmann::json &mod_json);
+  void storeMods(const nlohmann::json &response_json);
+  void storeModfile(const nlohmann::json &modfile_json);
+  void storeModfiles(const nlohmann::json &response_json);
+  // Fills the json when the entity was seen in the last MAX_CACHE_TIME seconds
+  bool getStoredMod(u32 mod_id, nlohmann::json &mod_json);
+  bool getStoredModfile(u32 modfile_id, nlohmann::json &modfile_json);
+  void invalidateStoredMod(u32 mod_id, u32 date_changed);
+  void removeStoredMod(u32 mod_id);
+  void setInstalledModJson(u32 mod_id, const nlohmann::json &mod_json);
+  // The modio.json of an installed mod without reading it from disk
+  nlohmann::json getInstalledModJson(u32 mod_id, std::string path);
   void installDownloadedMods();
   void addToDownloadedModsJson(std::string installation_path, std::string downloaded_zip_path, nlohmann::json mod_json);
   void addToInstalledModsJson(u32 mod_id, std::string path, u32 modfile_id, u32 date_updated);
   bool checkIfModIsStillInstalled(std::string path, u32 mod_id);
   bool checkIfModfileIsStillInstalled(std::string path, u32 modfile_id);
   void updateInstalledModsJson();
+  // Rewrites installed_mods.json when installs changed the registry since the last write
+  void writeInstalledMods();
+  // Writes what is pending and empties the registry, for modioShutdown
+  void closeInstalledMods();
+  const InstalledModRecord *findInstalledMod(u32 mod_id);
+  const std::vector<InstalledModRecord> &getInstalledMods();
   void clearOldCache();
+  void setCacheMaxBytes(u32 max_bytes);
+  ModioCacheStats getCacheStats();
+  // Compacts the cache store once enough of it is dead, called between frames from modioProcess
+  void processCacheStore();
+  void closeCacheStore();
   std::string getInstalledModPath(u32 mod_id);
   void updateModsCache(std::vector<u32> mod_ids);
 }
@@ -0,0 +1,34 @@
+#ifndef MODIO_PREFETCHER_H
+#define MODIO_PREFETCHER_H
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "Utility.h"
+#include "Globals.h"
+
+#define MODIO_PREFETCH_QUEUE_SIZE 64
+// Prefetched responses not asked for within this time are dropped
+#define MODIO_PREFETCH_MAX_AGE_SECONDS 120
+
+namespace modio
+{
+// Opt-in prefetching of what is likely asked for next once a mods listing is shown: the
+// next page, then the dependencies and stats of the mods on the page. Prefetches run
+// from modioProcess one at a time while no other GET is in flight, stay within
+// PREFETCH_BUDGET requests per minute and stop while the API rate limit is hit.
+// Their responses go to the response cache and are served once to the matching call.
+
+void queueListingPrefetch(const std::string &url, const ModioResponse &response, const std::vector<u32> &mod_ids);
+// Points response_json at the cached response when url was prefetched recently and not
+// served yet
+bool getPrefetchedCall(const std::string &url, std::shared_ptr<const nlohmann::json> &response_json);
+void processPrefetch();
+void clearPrefetch();
+u32 getPrefetchRequestCount();
+u32 getPrefetchHitCount();
+u32 getPrefetchQueueSize();
+} // namespace modio
+
+#endif
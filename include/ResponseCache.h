@@ -0,0 +1,71 @@
+#ifndef MODIO_RESPONSE_CACHE_H
+#define MODIO_RESPONSE_CACHE_H
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Utility.h"
+
+#define MODIO_MEMORY_CACHE_MAX_BYTES 8388608
+
+namespace modio
+{
+// Size bounded LRU of parsed responses keyed by the hash of the call url. It sits in
+// front of the on-disk cache so repeated calls skip both the file I/O and the parsing.
+// Responses are immutable once added and handed out shared, a hit copies nothing. Besides
+// parsed responses it holds raw byte images, such as the decoded mod listings, under the
+// same budget; each entry holds one or the other. Entries can be tagged with the ids of
+// the mods they contain, so an edited mod is purged here even when the on-disk cache
+// already dropped its copy.
+class ResponseCache
+{
+public:
+  explicit ResponseCache(u64 max_bytes);
+
+  // NULL when the url is missing or older than max_age_seconds
+  std::shared_ptr<const nlohmann::json> get(const std::string &url, u32 max_age_seconds);
+  // size is the serialized size of the response, used against the byte budget
+  void add(const std::string &url, double datetime_millis, std::shared_ptr<const nlohmann::json> response_json, u64 size, const std::vector<u32> &tags = std::vector<u32>());
+  // NULL when the url is missing, older than max_age_seconds or holds a parsed response
+  std::shared_ptr<const std::string> getImage(const std::string &url, u32 max_age_seconds);
+  void addImage(const std::string &url, double datetime_millis, std::shared_ptr<const std::string> image, const std::vector<u32> &tags = std::vector<u32>());
+  // Renews the timestamp of a cached entry, it keeps its content and tracked size
+  void touch(const std::string &url, double datetime_millis);
+  void remove(const std::string &url);
+  // Drops every entry tagged with tag
+  void removeTagged(u32 tag);
+  void clear();
+
+  void setMaxBytes(u64 max_bytes);
+  u64 getBytes() const;
+
+private:
+  struct Entry
+  {
+    u64 key;
+    std::string url;
+    double datetime_millis;
+    u64 size;
+    std::shared_ptr<const nlohmann::json> response_json;
+    std::shared_ptr<const std::string> image;
+    std::vector<u32> tags;
+  };
+
+  u64 max_bytes;
+  u64 bytes;
+  // Most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<u64, std::list<Entry>::iterator> index;
+  // Keys of the entries holding each tag
+  std::unordered_multimap<u32, u64> tagged_keys;
+
+  Entry *find(const std::string &url, u32 max_age_seconds);
+  void insert(Entry &entry);
+  void erase(std::unordered_map<u64, std::list<Entry>::iterator>::iterator it);
+  void evict();
+};
+} // namespace modio
+
+#endif
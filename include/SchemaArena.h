@@ -0,0 +1,87 @@
+#ifndef MODIO_SCHEMA_ARENA_H
+#define MODIO_SCHEMA_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+#define MODIO_SCHEMA_ARENA_FIRST_BLOCK_SIZE 16384
+#define MODIO_SCHEMA_ARENA_MAX_BLOCK_SIZE 1048576
+
+namespace modio
+{
+// Bump allocator backing the strings and arrays of a decoded response. The callbacks
+// decode a page of results into one arena and drop it in one go after the user callback
+// returns, instead of a new[] and a delete[] for every string of every struct.
+//
+// While a SchemaArenaScope is alive the schema initializers allocate from its arena,
+// otherwise they use new[] as before. The schema free functions skip memory owned by a
+// live arena, so modioFree* stays safe on either kind of struct. Arenas are meant for
+// the thread calling modioProcess and are not shared between threads.
+class SchemaArena
+{
+public:
+  SchemaArena();
+  ~SchemaArena();
+
+  void *allocate(size_t size, size_t alignment);
+  bool owns(const void *pointer) const;
+  size_t getAllocatedBytes() const;
+
+private:
+  struct Block
+  {
+    char *begin;
+    char *end;
+  };
+
+  std::vector<Block> blocks;
+  char *cursor;
+  char *limit;
+  size_t next_block_size;
+  size_t allocated_bytes;
+  // Arenas alive on the thread, searched when freeing
+  SchemaArena *previous_live;
+
+  SchemaArena(const SchemaArena &);
+  SchemaArena &operator=(const SchemaArena &);
+
+  friend bool isSchemaArenaMemory(const void *pointer);
+};
+
+// Routes the schema allocations to arena until the scope ends, scopes nest
+class SchemaArenaScope
+{
+public:
+  explicit SchemaArenaScope(SchemaArena &arena);
+  ~SchemaArenaScope();
+
+private:
+  SchemaArena *previous_arena;
+};
+
+SchemaArena *getCurrentSchemaArena();
+bool isSchemaArenaMemory(const void *pointer);
+
+template <typename T>
+T *allocateSchemaArray(size_t count)
+{
+  SchemaArena *arena = getCurrentSchemaArena();
+  if (!arena)
+    return new T[count];
+  // The schema structs are plain C structs, new[] leaves them uninitialized as well
+  return (T *)arena->allocate(count * sizeof(T), alignof(T));
+}
+
+template <typename T>
+void freeSchemaArray(T *array)
+{
+  if (array && !isSchemaArenaMemory(array))
+    delete[] array;
+}
+
+// Untyped arrays of structs for the schema tables, freed with freeSchemaBytes
+void *allocateSchemaBytes(size_t size, size_t alignment);
+void freeSchemaBytes(void *bytes);
+} // namespace modio
+
+#endif
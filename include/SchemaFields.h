@@ -0,0 +1,95 @@
+#ifndef MODIO_SCHEMA_FIELDS_H
+#define MODIO_SCHEMA_FIELDS_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include "Utility.h"
+
+#define MODIO_FIELD_U32 0
+#define MODIO_FIELD_I32 1
+#define MODIO_FIELD_LONG 2
+#define MODIO_FIELD_DOUBLE 3
+#define MODIO_FIELD_BOOL 4
+#define MODIO_FIELD_STRING 5
+#define MODIO_FIELD_STRING_ARRAY 6
+#define MODIO_FIELD_OBJECT 7
+#define MODIO_FIELD_OBJECT_ARRAY 8
+#define MODIO_FIELD_ENUM 9
+
+// Field entries of a schema table. The member types are checked at compile time, a
+// table naming a member with another type than the field kind does not build.
+#define MODIO_SCHEMA_U32(Struct, member) \
+  { #member, MODIO_FIELD_U32, modio::getFieldOffset<u32>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_I32(Struct, member) \
+  { #member, MODIO_FIELD_I32, modio::getFieldOffset<i32>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_LONG(Struct, member) \
+  { #member, MODIO_FIELD_LONG, modio::getFieldOffset<long>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_DOUBLE(Struct, member) \
+  { #member, MODIO_FIELD_DOUBLE, modio::getFieldOffset<double>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_BOOL(Struct, member) \
+  { #member, MODIO_FIELD_BOOL, modio::getFieldOffset<bool>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_STRING(Struct, member) \
+  { #member, MODIO_FIELD_STRING, modio::getFieldOffset<char *>(&Struct::member, offsetof(Struct, member)), 0, NULL, NULL }
+#define MODIO_SCHEMA_STRING_ARRAY(Struct, key, member, size_member) \
+  { key, MODIO_FIELD_STRING_ARRAY, modio::getFieldOffset<char **>(&Struct::member, offsetof(Struct, member)), modio::getFieldOffset<u32>(&Struct::size_member, offsetof(Struct, size_member)), NULL, NULL }
+#define MODIO_SCHEMA_OBJECT(Struct, member, schema) \
+  { #member, MODIO_FIELD_OBJECT, offsetof(Struct, member), 0, &(schema), NULL }
+#define MODIO_SCHEMA_OBJECT_ARRAY(Struct, key, member, size_member, schema) \
+  { key, MODIO_FIELD_OBJECT_ARRAY, offsetof(Struct, member), modio::getFieldOffset<u32>(&Struct::size_member, offsetof(Struct, size_member)), &(schema), NULL }
+#define MODIO_SCHEMA_ENUM(Struct, member, values) \
+  { #member, MODIO_FIELD_ENUM, modio::getFieldOffset<u32>(&Struct::member, offsetof(Struct, member)), 0, NULL, values }
+
+namespace modio
+{
+class SchemaTable;
+
+// A json string and the value it decodes to, lists end with a NULL name
+struct SchemaEnumValue
+{
+  const char *name;
+  u32 value;
+};
+
+struct SchemaField
+{
+  const char *key;
+  u32 type;
+  size_t offset;
+  // The u32 count of the array fields
+  size_t size_offset;
+  // Nested struct of the object and object array fields
+  const SchemaTable *schema;
+  const SchemaEnumValue *enum_values;
+};
+
+// The fields of a C schema struct, described once and used by the decoder, the encoder,
+// the free function and the binary cache images. Missing and null fields are zero, like
+// the hand-written initializers always did.
+class SchemaTable
+{
+public:
+  SchemaTable(size_t struct_size, size_t struct_alignment, std::initializer_list<SchemaField> fields);
+
+  size_t struct_size;
+  size_t struct_alignment;
+  // Sorted by key, the order the members of a json object are kept in
+  std::vector<SchemaField> fields;
+};
+
+template <typename T, typename Struct>
+size_t getFieldOffset(T Struct::*, size_t offset)
+{
+  return offset;
+}
+
+// Single pass over the members of object_json, merged with the sorted fields, so no key
+// is looked up and no key string is built
+void decodeSchema(const SchemaTable &schema, void *object, const nlohmann::json &object_json);
+void freeSchema(const SchemaTable &schema, void *object);
+// Null strings and arrays are left out, decoding the result gives the same struct back
+nlohmann::json encodeSchema(const SchemaTable &schema, const void *object);
+} // namespace modio
+
+#endif
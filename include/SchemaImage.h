@@ -0,0 +1,28 @@
+#ifndef MODIO_SCHEMA_IMAGE_H
+#define MODIO_SCHEMA_IMAGE_H
+
+#include "Utility.h"
+
+#define MODIO_SCHEMA_IMAGE_VERSION 1
+
+namespace modio
+{
+// Decoded ModioMod arrays stored as relocatable binary images so cache hits skip the JSON
+// parsing and the per string allocations. An image is the mods array followed by every
+// nested array and string it points to, with pointers stored as offsets into the image.
+// A relocation table lists the pointer slots, rehydrating is one copy plus a fix-up pass.
+//
+// Images embed the struct layout signature and are rejected when it does not match the
+// running build, so a cache written by another SDK version or architecture is a miss.
+// They also keep the hash of the response they were decoded from, to tell whether a
+// newer response changed anything.
+
+std::string serializeMods(const ModioResponse &response, const ModioMod *mods, u32 mods_size, u64 source_hash);
+// Fills mods, mods_size, source_hash and the result counters of response. Returns NULL
+// when the image is damaged or was written with a different layout. The returned block
+// holds the mods and everything they point to, the mods must not be freed with
+// modioFreeMod, delete[] the block instead.
+u64 *rehydrateMods(const std::string &image, ModioResponse &response, ModioMod *&mods, u32 &mods_size, u64 &source_hash);
+} // namespace modio
+
+#endif
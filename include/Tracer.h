@@ -0,0 +1,76 @@
+#ifndef MODIO_TRACER_H
+#define MODIO_TRACER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "c/ModioC.h"
+
+#define MODIO_TRACE_DEFAULT_MAX_EVENTS 65536
+
+#define MODIO_TRACE_CONCAT_(a, b) a##b
+#define MODIO_TRACE_CONCAT(a, b) MODIO_TRACE_CONCAT_(a, b)
+// Records the enclosing scope as a span, name and category must be string literals
+#define MODIO_TRACE_SCOPE(name, category) modio::TraceScope MODIO_TRACE_CONCAT(modio_trace_scope_, __LINE__)(name, category)
+
+namespace modio
+{
+// Spans are kept in a bounded ring, the oldest are overwritten once it is full, and
+// written as Chrome trace JSON that chrome://tracing and Perfetto open. Requests are
+// async spans keyed by call number so their phases nest under them. While tracing is
+// off every trace point costs one relaxed load.
+extern std::atomic<bool> TRACING;
+
+// Shown with a span in the viewer, fields left at their defaults are not written
+struct TraceArgs
+{
+  TraceArgs();
+
+  std::string url;
+  // 0 is the code of a transfer that failed, so it has its own flag
+  bool has_response_code;
+  u32 response_code;
+  u32 mod_id;
+};
+
+struct TraceEvent
+{
+  const char *name;
+  const char *category;
+  char phase;
+  u64 id;
+  double timestamp_micros;
+  double duration_micros;
+  u32 thread_id;
+  TraceArgs args;
+};
+
+class TraceScope
+{
+public:
+  TraceScope(const char *name, const char *category);
+  ~TraceScope();
+
+private:
+  const char *name;
+  const char *category;
+  double start_micros;
+};
+
+inline bool isTracing()
+{
+  return TRACING.load(std::memory_order_relaxed);
+}
+
+void startTracing(u32 max_events);
+void stopTracing();
+bool writeTrace(const std::string &path);
+void addTraceSpan(const char *name, const char *category, double start_micros, double end_micros, const TraceArgs &args = TraceArgs());
+// Async spans with the same category and id nest by time in the viewer
+void addAsyncTraceSpan(const char *name, const char *category, u64 id, double start_micros, double end_micros, const TraceArgs &args = TraceArgs());
+} // namespace modio
+
+#endif
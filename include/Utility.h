@@ -23,6 +23,7 @@
 #  define MODIO_UE4_DETECTED
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <string.h>
@@ -33,6 +34,7 @@
 #include "dependencies/nlohmann/json.hpp"
 #include "dependencies/minizip/minizip.h"
 #include "Globals.h"
+#include "SchemaArena.h"
 
 #ifdef MODIO_LINUX_DETECTED
 #include <sys/stat.h>
@@ -72,18 +74,59 @@ std::string addSlashIfNeeded(const std::string &directory_path);
 // Log methods
 void writeLogLine(const std::string &text, u32 debug_level);
 void clearLog();
+// Same as writeLogLine but the message is not built when debug_level is filtered out.
+// Compared as int, an unsigned comparison against MODIO_DEBUGLEVEL_ERROR (0) is always true
+// and warns under -Wtype-limits.
+#define MODIO_LOG(text, debug_level)                     \
+  do                                                     \
+  {                                                      \
+    if ((int)modio::DEBUG_LEVEL >= (int)(debug_level))   \
+      modio::writeLogLine((text), (debug_level));        \
+  } while (0)
 
 // Time methods
 u32 getCurrentTime();
 double getCurrentTimeMillis();
+// Steady clock, for measuring durations
+double getSteadyTimeMicros();
+
+// Hash methods
+u64 hash64(const std::string &str);
+
+// Url methods
+// Query parameters sorted, -in and -not-in lists sorted and deduplicated and every
+// component percent-encoded the same way, so urls asking for the same thing are equal
+std::string getCanonicalUrl(const std::string &url);
+u64 getCanonicalUrlHash(const std::string &url);
 
 // Json methods
-bool hasKey(nlohmann::json json_object, const std::string &key);
+// A null value counts as missing, the API sends null for unset fields
+bool hasKey(const nlohmann::json &json_object, const std::string &key);
+// Single lookup, NULL when the key is missing or null
+const nlohmann::json *findKey(const nlohmann::json &json_object, const char *key);
+// Child at key, or a null json the schema initializers read as empty
+const nlohmann::json &getJsonChild(const nlohmann::json &json_object, const char *key);
+// Copy of the string at key for the C schemas, NULL when missing, freed with delete[]
+char *getJsonCString(const nlohmann::json &json_object, const char *key);
+char *getJsonCString(const nlohmann::json &string_json);
+template <typename T>
+void getJsonValue(const nlohmann::json &json_object, const char *key, T &value)
+{
+  const nlohmann::json *value_json = findKey(json_object, key);
+  if (value_json)
+    value = value_json->get<T>();
+}
+// Assigns in place, without a temporary string
+void getJsonValue(const nlohmann::json &json_object, const char *key, std::string &value);
 nlohmann::json toJson(const std::string &json_str);
 nlohmann::json openJson(const std::string &file_path);
 void writeJson(const std::string &file_path, nlohmann::json json_object);
 
 // Filesystem methods
+#ifdef MODIO_WINDOWS_DETECTED
+// For the wide Windows file APIs, the caller frees the returned string
+wchar_t *WideCharFromString(std::string const &str);
+#endif
 std::string getModIODirectory();
 std::vector<std::string> getFilenames(const std::string &directory);
 bool isDirectory(const std::string &directory);
@@ -94,6 +137,19 @@ void createDirectory(const std::string &directory);
 bool removeDirectory(const std::string &directory);
 void removeFile(const std::string &filename);
 double getFileSize(const std::string &file_path);
+// What a stat of a file and its directory tells without opening the file. The modified time
+// is in nanoseconds. On Windows it only has 1 second precision and the directory id is
+// always 0, so a rewrite of the same size within the same second goes unnoticed there.
+struct FileFingerprint
+{
+  u64 directory_id;
+  u64 modified_time;
+  u64 size;
+};
+bool operator==(const FileFingerprint &left, const FileFingerprint &right);
+bool operator!=(const FileFingerprint &left, const FileFingerprint &right);
+// Returns false if directory/filename does not exist
+bool getFileFingerprint(const std::string &directory, const std::string &filename, FileFingerprint &fingerprint);
 void createPath(const std::string &strPathAndFile);
 std::vector<std::string> getHeaders();
 std::vector<std::string> getUrlEncodedHeaders();
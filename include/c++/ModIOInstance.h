@@ -16,6 +16,7 @@
 #include "schemas/InstalledMod.h"
 #include "schemas/Media.h"
 #include "schemas/MetadataKVP.h"
+#include "schemas/Metrics.h"
 #include "schemas/Mod.h"
 #include "schemas/ModEvent.h"
 #include "schemas/Modfile.h"
@@ -63,6 +64,7 @@ public:
   void setDebugLevel(u32 debug_level);
   void sleep(u32 milliseconds);
   void compressFiles(std::string root_directory, std::vector<std::string> filenames, std::string zip_path);
+  modio::Metrics getMetrics();
 
   //Events
   void getEvents(u32 mod_id, modio::FilterCreator &filter, const std::function<void(const modio::Response &, const std::vector<modio::ModEvent> &events)> &callback);
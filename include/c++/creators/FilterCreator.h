@@ -17,6 +17,7 @@ namespace modio
     void setOffset(u32 offset);
     void setFullTextSearch(const std::string& text);
     void setCacheMaxAgeSeconds(u32 max_age_seconds);
+    void setCachePolicy(u32 cache_policy);
     void addFieldValue(const std::string& field, const std::string& value);
     void addLikeField(const std::string& field, const std::string& value);
     void addNotLikeField(const std::string& field, const std::string& value);
@@ -7,7 +7,7 @@ struct GetModCall
 
 struct GetAllModsCall
 {
-  const std::function<void(const modio::Response &, std::vector<modio::Mod> &mods)> callback;
+  const std::function<void(const modio::Response &, const std::vector<modio::Mod> &mods)> callback;
 };
 
 struct AddModCall
@@ -27,7 +27,9 @@ extern std::map<u32, EditModCall *> edit_mod_calls;
 extern std::map<u32, GenericCall *> delete_mod_calls;
 
 void onGetMod(void *object, ModioResponse modio_response, ModioMod mod);
+void onGetModJson(void *object, ModioResponse modio_response, const nlohmann::json &mod_json);
 void onGetAllMods(void *object, ModioResponse modio_response, ModioMod mods[], u32 mods_size);
+void onGetAllModsJson(void *object, ModioResponse modio_response, const nlohmann::json &mods_json);
 void onAddMod(void *object, ModioResponse modio_response, ModioMod mod);
 void onEditMod(void *object, ModioResponse modio_response, ModioMod mod);
 void onDeleteMod(void *object, ModioResponse modio_response);
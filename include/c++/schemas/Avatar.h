@@ -2,6 +2,7 @@
 #define MODIO_AVATAR_H
 
 #include "../../c/schemas/ModioAvatar.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -16,8 +17,10 @@ public:
   std::string thumb_100x100;
 
   void initialize(ModioAvatar Avatar);
+  void initialize(const nlohmann::json &avatar_json);
 };
 
+const ClassSchemaTable &getAvatarClassSchema();
 extern nlohmann::json toJson(Avatar &avatar);
 } // namespace modio
 
@@ -2,6 +2,7 @@
 #define MODIO_COMMENT_H
 
 #include "../../c/schemas/ModioComment.h"
+#include "SchemaClass.h"
 #include "User.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
@@ -24,6 +25,7 @@ public:
   void initialize(ModioComment modio_comment);
 };
 
+const ClassSchemaTable &getCommentClassSchema();
 extern nlohmann::json toJson(Comment &comment);
 } // namespace modio
 
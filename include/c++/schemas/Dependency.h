@@ -2,6 +2,7 @@
 #define MODIO_DEPENDENCY_H
 
 #include "../../c/schemas/ModioDependency.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -16,6 +17,7 @@ public:
 	void initialize(ModioDependency modio_dependency);
 };
 
+const ClassSchemaTable &getDependencyClassSchema();
 extern nlohmann::json toJson(Dependency &dependency);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioDownload.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -13,8 +14,10 @@ public:
   std::string binary_url;
 
   void initialize(ModioDownload download);
+  void initialize(const nlohmann::json &download_json);
 };
 
+const ClassSchemaTable &getDownloadClassSchema();
 extern nlohmann::json toJson(Download &download);
 } // namespace modio
 
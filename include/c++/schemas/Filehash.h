@@ -2,6 +2,7 @@
 #define MODIO_FILEHASH_H
 
 #include "../../c/schemas/ModioFilehash.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 
 namespace modio
@@ -12,8 +13,10 @@ public:
   std::string md5;
 
   void initialize(ModioFilehash filehash);
+  void initialize(const nlohmann::json &filehash_json);
 };
 
+const ClassSchemaTable &getFilehashClassSchema();
 extern nlohmann::json toJson(Filehash &filehash);
 } // namespace modio
 
@@ -2,6 +2,7 @@
 #define MODIO_GAME_H
 
 #include "../../c/schemas/ModioGame.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "User.h"
 #include "Icon.h"
@@ -42,6 +43,7 @@ public:
   void initialize(ModioGame game);
 };
 
+const ClassSchemaTable &getGameClassSchema();
 extern nlohmann::json toJson(Game &game);
 } // namespace modio
 
@@ -2,6 +2,7 @@
 #define MODIO_GAMETAGOPTION_H
 
 #include "../../c/schemas/ModioGameTagOption.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 
 namespace modio
@@ -17,6 +18,7 @@ public:
   void initialize(ModioGameTagOption game_tag_option);
 };
 
+const ClassSchemaTable &getGameTagOptionClassSchema();
 extern nlohmann::json toJson(GameTagOption &game_tag_option);
 } // namespace modio
 
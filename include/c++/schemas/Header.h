@@ -2,6 +2,7 @@
 #define MODIO_HEADER_H
 
 #include "../../c/schemas/ModioHeader.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -16,6 +17,7 @@ public:
   void initialize(ModioHeader Header);
 };
 
+const ClassSchemaTable &getHeaderClassSchema();
 extern nlohmann::json toJson(Header &header);
 } // namespace modio
 
@@ -2,6 +2,7 @@
 #define MODIO_ICON_H
 
 #include "../../c/schemas/ModioIcon.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -20,6 +21,7 @@ public:
   void initialize(ModioIcon Icon);
 };
 
+const ClassSchemaTable &getIconClassSchema();
 extern nlohmann::json toJson(Icon &icon);
 } // namespace modio
 
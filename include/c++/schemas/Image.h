@@ -2,6 +2,7 @@
 #define MODIO_IMAGE_H
 
 #include "../../c/schemas/ModioImage.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -15,8 +16,10 @@ public:
   std::string thumb_320x180;
 
   void initialize(ModioImage image);
+  void initialize(const nlohmann::json &image_json);
 };
 
+const ClassSchemaTable &getImageClassSchema();
 extern nlohmann::json toJson(Image &image);
 } // namespace modio
 
@@ -2,6 +2,7 @@
 #define MODIO_LOGO_H
 
 #include "../../c/schemas/ModioLogo.h"
+#include "SchemaClass.h"
 #include "../../Globals.h"
 #include "../../Utility.h"
 
@@ -17,8 +18,10 @@ public:
   std::string thumb_1280x720;
 
   void initialize(ModioLogo Logo);
+  void initialize(const nlohmann::json &logo_json);
 };
 
+const ClassSchemaTable &getLogoClassSchema();
 extern nlohmann::json toJson(Logo &logo);
 } // namespace modio
 
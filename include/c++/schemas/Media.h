@@ -2,6 +2,7 @@
 #define MODIO_MEDIA_H
 
 #include "../../c/schemas/ModioMedia.h"
+#include "SchemaClass.h"
 #include "Image.h"
 #include "../../Globals.h"
 
@@ -15,8 +16,10 @@ public:
   std::vector<Image> images;
 
   void initialize(ModioMedia media);
+  void initialize(const nlohmann::json &media_json);
 };
 
+const ClassSchemaTable &getMediaClassSchema();
 extern nlohmann::json toJson(Media &media);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioMetadataKVP.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -13,8 +14,10 @@ public:
   std::string metavalue;
 
   void initialize(ModioMetadataKVP metadata_kvp);
+  void initialize(const nlohmann::json &metadata_kvp_json);
 };
 
+const ClassSchemaTable &getMetadataKVPClassSchema();
 extern nlohmann::json toJson(MetadataKVP &metadata_kvp);
 } // namespace modio
 
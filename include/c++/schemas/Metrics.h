@@ -0,0 +1,95 @@
+#ifndef MODIO_SDKMETRICS_H
+#define MODIO_SDKMETRICS_H
+
+#include "../../Globals.h"
+#include "../../c/ModioC.h"
+
+namespace modio
+{
+class Histogram
+{
+public:
+  u32 count;
+  double mean_millis;
+  double p50_millis;
+  double p90_millis;
+  double p99_millis;
+  double max_millis;
+
+  void initialize(ModioHistogram histogram);
+};
+
+class EndpointMetrics
+{
+public:
+  std::string endpoint;
+  u32 requests;
+  u32 status_2xx;
+  u32 status_3xx;
+  u32 status_4xx;
+  u32 status_5xx;
+  u32 failed;
+
+  void initialize(ModioEndpointMetrics endpoint_metrics);
+};
+
+class HostMetrics
+{
+public:
+  std::string host;
+  u32 transfers;
+  u32 reused_connections;
+  u32 http_version;
+  double mean_dns_millis;
+  double mean_connect_millis;
+  double mean_tls_millis;
+  double mean_ttfb_millis;
+  double mean_transfer_millis;
+  double download_bytes_per_second;
+
+  void initialize(ModioHostMetrics host_metrics);
+};
+
+class Metrics
+{
+public:
+  u32 requests;
+  u32 failed_requests;
+  std::vector<EndpointMetrics> endpoints;
+  std::vector<HostMetrics> hosts;
+  Histogram network_latency;
+  Histogram parse_latency;
+  Histogram callback_latency;
+  u64 bytes_up;
+  u64 bytes_down;
+  u64 decoded_bytes_down;
+  u32 memory_cache_hits;
+  u32 store_cache_hits;
+  u32 cache_misses;
+  u32 entity_store_hits;
+  u32 entity_store_misses;
+  double memory_cache_hit_ratio;
+  double store_cache_hit_ratio;
+  double entity_store_hit_ratio;
+  u32 active_requests;
+  u32 active_downloads;
+  u32 active_uploads;
+  u32 mod_download_queue_size;
+  u32 modfile_upload_queue_size;
+  u32 prefetch_queue_size;
+  u64 extracted_bytes;
+  u32 extracted_files;
+  Histogram extract_time;
+  double extract_bytes_per_second;
+  Histogram process_time;
+
+  void initialize(ModioMetrics metrics);
+};
+
+extern nlohmann::json toJson(Histogram &histogram);
+extern nlohmann::json toJson(EndpointMetrics &endpoint_metrics);
+extern nlohmann::json toJson(HostMetrics &host_metrics);
+extern nlohmann::json toJson(Metrics &metrics);
+} // namespace modio
+
+#endif
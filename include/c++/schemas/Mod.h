@@ -12,6 +12,7 @@
 #include "Tag.h"
 #include "MetadataKVP.h"
 #include "../../c/schemas/ModioMod.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -43,8 +44,26 @@ public:
   std::vector<MetadataKVP> metadata_kvps;
 
   void initialize(ModioMod mod);
+  void initialize(const nlohmann::json &mod_json);
+  // Leaves description, description_plaintext, metadata_blob and media to the getters
+  void initializeLazyFields(const nlohmann::json &mod_json);
+
+  // Listings leave these in the retained response while lazy fields are enabled, the
+  // getters load them on first use
+  const std::string &getDescription();
+  const std::string &getDescriptionPlaintext();
+  const std::string &getMetadataBlob();
+  const Media &getMedia();
+
+private:
+  // Fields still to be loaded from the retained response
+  u32 lazy_fields = 0;
+
+  void initializeJson(const nlohmann::json &mod_json, bool lazy);
+  void loadLazyField(u32 field);
 };
 
+const ClassSchemaTable &getModClassSchema();
 extern nlohmann::json toJson(Mod &mod);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioModEvent.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -18,6 +19,7 @@ public:
   void initialize(ModioModEvent event);
 };
 
+const ClassSchemaTable &getModEventClassSchema();
 extern nlohmann::json toJson(ModEvent &event);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioModfile.h"
+#include "SchemaClass.h"
 #include "Filehash.h"
 #include "Download.h"
 
@@ -27,8 +28,10 @@ public:
   modio::Download download;
 
   void initialize(ModioModfile modfile);
+  void initialize(const nlohmann::json &modfile_json);
 };
 
+const ClassSchemaTable &getModfileClassSchema();
 extern nlohmann::json toJson(Modfile &modfile);
 } // namespace modio
 
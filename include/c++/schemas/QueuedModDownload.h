@@ -4,6 +4,7 @@
 #include "Mod.h"
 #include "../../Globals.h"
 #include "../../c/schemas/ModioQueuedModDownload.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -21,6 +22,7 @@ public:
   void initialize(ModioQueuedModDownload queued_mod_download);
 };
 
+const ClassSchemaTable &getQueuedModDownloadClassSchema();
 extern nlohmann::json toJson(QueuedModDownload &queued_mod_download);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioRating.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -17,6 +18,7 @@ public:
   void initialize(ModioRating rating);
 };
 
+const ClassSchemaTable &getRatingClassSchema();
 extern nlohmann::json toJson(Rating &rating);
 } // namespace modio
 
@@ -4,6 +4,7 @@
 #include "../../Globals.h"
 #include "../../c/schemas/ModioResponse.h"
 #include "Error.h"
+#include "TransferInfo.h"
 
 namespace modio
 {
@@ -16,7 +17,9 @@ public:
   i32 result_offset;
   u32 result_total;
   bool result_cached;
+  bool result_stale;
   modio::Error error;
+  modio::TransferInfo transfer;
 
   void initialize(ModioResponse response);
 };
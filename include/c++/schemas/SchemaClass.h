@@ -0,0 +1,106 @@
+#ifndef MODIO_SCHEMA_CLASS_H
+#define MODIO_SCHEMA_CLASS_H
+
+#include <string>
+#include <vector>
+
+#include "../../SchemaFields.h"
+
+// Field entries of a C++ schema class table, keyed like the fields of the C table. The
+// member types are checked at compile time like the C entries, strings are std::string,
+// arrays are std::vector of the element class.
+#define MODIO_CLASS_U32(Class, member) \
+  { #member, MODIO_FIELD_U32, &modio::getClassMember<Class, u32, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_I32(Class, member) \
+  { #member, MODIO_FIELD_I32, &modio::getClassMember<Class, i32, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_LONG(Class, member) \
+  { #member, MODIO_FIELD_LONG, &modio::getClassMember<Class, long, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_DOUBLE(Class, member) \
+  { #member, MODIO_FIELD_DOUBLE, &modio::getClassMember<Class, double, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_BOOL(Class, member) \
+  { #member, MODIO_FIELD_BOOL, &modio::getClassMember<Class, bool, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_STRING(Class, member) \
+  { #member, MODIO_FIELD_STRING, &modio::getClassMember<Class, std::string, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_STRING_ARRAY(Class, key, member) \
+  { key, MODIO_FIELD_STRING_ARRAY, &modio::getClassMember<Class, std::vector<std::string>, &Class::member>, NULL, NULL, NULL }
+#define MODIO_CLASS_OBJECT(Class, member, MemberClass, schema) \
+  { #member, MODIO_FIELD_OBJECT, &modio::getClassMember<Class, MemberClass, &Class::member>, &(schema), NULL, NULL }
+#define MODIO_CLASS_OBJECT_ARRAY(Class, key, member, ElementClass, schema) \
+  { key, MODIO_FIELD_OBJECT_ARRAY, &modio::getClassMember<Class, std::vector<ElementClass>, &Class::member>, &(schema), &modio::ClassArray<ElementClass>::ops, NULL }
+#define MODIO_CLASS_ENUM(Class, member, values) \
+  { #member, MODIO_FIELD_ENUM, &modio::getClassMember<Class, u32, &Class::member>, NULL, NULL, values }
+
+namespace modio
+{
+class ClassSchemaTable;
+
+// Vectors of the element classes, handled without knowing their type
+struct ClassArrayOps
+{
+  size_t (*size)(const void *vector);
+  void (*resize)(void *vector, size_t size);
+  void *(*at)(void *vector, size_t index);
+};
+
+struct ClassSchemaField
+{
+  const char *key;
+  u32 type;
+  void *(*get_member)(void *object);
+  // Nested class of the object and object array fields
+  const ClassSchemaTable *schema;
+  const ClassArrayOps *array_ops;
+  const SchemaEnumValue *enum_values;
+};
+
+// The members of a C++ schema class and the C table of the struct it wraps. Fields pair
+// up with the C fields by key, so the class is filled from the C struct or straight from
+// the json with no per-class code, the same way the C tables drive the structs.
+class ClassSchemaTable
+{
+public:
+  ClassSchemaTable(const SchemaTable &c_schema, std::initializer_list<ClassSchemaField> fields);
+
+  const SchemaTable *c_schema;
+  // Sorted by key like the C fields
+  std::vector<ClassSchemaField> fields;
+};
+
+template <typename Class, typename T, T Class::*member>
+void *getClassMember(void *object)
+{
+  return &(static_cast<Class *>(object)->*member);
+}
+
+template <typename T>
+struct ClassArray
+{
+  static size_t size(const void *vector)
+  {
+    return static_cast<const std::vector<T> *>(vector)->size();
+  }
+
+  static void resize(void *vector, size_t size)
+  {
+    static_cast<std::vector<T> *>(vector)->resize(size);
+  }
+
+  static void *at(void *vector, size_t index)
+  {
+    return &(*static_cast<std::vector<T> *>(vector))[index];
+  }
+
+  static const ClassArrayOps ops;
+};
+
+template <typename T>
+const ClassArrayOps ClassArray<T>::ops = {&ClassArray<T>::size, &ClassArray<T>::resize, &ClassArray<T>::at};
+
+// Missing and null fields are zero or empty, like the C structs decoded from the same json
+void initializeClass(const ClassSchemaTable &schema, void *object, const nlohmann::json &object_json);
+void initializeClass(const ClassSchemaTable &schema, void *object, const void *c_object);
+// Every field is written, empty strings and arrays included
+nlohmann::json encodeClass(const ClassSchemaTable &schema, const void *object);
+} // namespace modio
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioStats.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -23,8 +24,10 @@ public:
   u32 date_expires;
 
   void initialize(ModioStats mod);
+  void initialize(const nlohmann::json &stats_json);
 };
 
+const ClassSchemaTable &getStatsClassSchema();
 extern nlohmann::json toJson(Stats &stats);
 } // namespace modio
 
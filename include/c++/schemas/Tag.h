@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioTag.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -13,8 +14,10 @@ public:
   std::string name;
 
   void initialize(ModioTag tag);
+  void initialize(const nlohmann::json &tag_json);
 };
 
+const ClassSchemaTable &getTagClassSchema();
 extern nlohmann::json toJson(Tag &tag);
 } // namespace modio
 
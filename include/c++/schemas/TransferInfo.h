@@ -0,0 +1,30 @@
+#ifndef MODIO_TRANSFERINFO_H
+#define MODIO_TRANSFERINFO_H
+
+#include "../../Globals.h"
+#include "../../c/ModioC.h"
+
+namespace modio
+{
+class TransferInfo
+{
+public:
+  std::string effective_url;
+  u32 http_version;
+  bool connection_reused;
+  double dns_millis;
+  double connect_millis;
+  double tls_millis;
+  double ttfb_millis;
+  double transfer_millis;
+  double total_millis;
+  double download_bytes_per_second;
+  double upload_bytes_per_second;
+
+  void initialize(ModioTransferInfo transfer_info);
+};
+
+extern nlohmann::json toJson(TransferInfo &transfer_info);
+} // namespace modio
+
+#endif
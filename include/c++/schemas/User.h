@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioUser.h"
+#include "SchemaClass.h"
 #include "Avatar.h"
 
 namespace modio
@@ -20,8 +21,10 @@ public:
   Avatar avatar;
 
   void initialize(ModioUser modio_user);
+  void initialize(const nlohmann::json &user_json);
 };
 
+const ClassSchemaTable &getUserClassSchema();
 extern nlohmann::json toJson(User &user);
 } // namespace modio
 
@@ -3,6 +3,7 @@
 
 #include "../../Globals.h"
 #include "../../c/schemas/ModioUserEvent.h"
+#include "SchemaClass.h"
 
 namespace modio
 {
@@ -19,6 +20,7 @@ public:
   void initialize(ModioUserEvent event);
 };
 
+const ClassSchemaTable &getUserEventClassSchema();
 extern nlohmann::json toJson(UserEvent &event);
 } // namespace modio
 
@@ -15,6 +15,7 @@
 
 typedef unsigned int u32;
 typedef int i32;
+typedef unsigned long long u64;
 
 #define MODIO_ENVIRONMENT_LIVE 0
 #define MODIO_ENVIRONMENT_TEST 1
@@ -79,6 +80,21 @@ typedef int i32;
 #define MODIO_UPDATES_DISABLED  0
 #define MODIO_UPDATES_ENABLED   1
 
+// Cache Policies
+#define MODIO_CACHE_POLICY_DEFAULT                0
+#define MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE 1
+
+// Binary Cache Options
+#define MODIO_BINARY_CACHE_DISABLED 0
+#define MODIO_BINARY_CACHE_ENABLED  1
+
+// Lazy Fields Options
+#define MODIO_LAZY_FIELDS_DISABLED 0
+#define MODIO_LAZY_FIELDS_ENABLED  1
+
+// Prefetch budget, in requests per minute
+#define MODIO_PREFETCH_DISABLED 0
+
 // Report Types
 #define MODIO_GENERIC_REPORT  0
 #define MODIO_DMCA_REPORT     1
@@ -113,14 +129,18 @@ extern "C"
 #endif
   // Schemas
   typedef struct ModioAvatar ModioAvatar;
+  typedef struct ModioCacheStats ModioCacheStats;
   typedef struct ModioComment ModioComment;
   typedef struct ModioDependency ModioDependency;
   typedef struct ModioDownload ModioDownload;
+  typedef struct ModioEndpointMetrics ModioEndpointMetrics;
   typedef struct ModioError ModioError;
   typedef struct ModioFilehash ModioFilehash;
   typedef struct ModioGame ModioGame;
   typedef struct ModioGameTagOption ModioGameTagOption;
   typedef struct ModioHeader ModioHeader;
+  typedef struct ModioHistogram ModioHistogram;
+  typedef struct ModioHostMetrics ModioHostMetrics;
   typedef struct ModioIcon ModioIcon;
   typedef struct ModioImage ModioImage;
   typedef struct ModioInstalledMod ModioInstalledMod;
@@ -128,6 +148,7 @@ extern "C"
   typedef struct ModioLogo ModioLogo;
   typedef struct ModioMedia ModioMedia;
   typedef struct ModioMetadataKVP ModioMetadataKVP;
+  typedef struct ModioMetrics ModioMetrics;
   typedef struct ModioMod ModioMod;
   typedef struct ModioModEvent ModioModEvent;
   typedef struct ModioModfile ModioModfile;
@@ -137,6 +158,7 @@ extern "C"
   typedef struct ModioResponse ModioResponse;
   typedef struct ModioStats ModioStats;
   typedef struct ModioTag ModioTag;
+  typedef struct ModioTransferInfo ModioTransferInfo;
   typedef struct ModioUser ModioUser;
   typedef struct ModioUserEvent ModioUserEvent;
   // Creators
@@ -160,6 +182,7 @@ extern "C"
     char* offset;
     char* full_text_search;
     u32 cache_max_age_seconds;
+    u32 cache_policy;
     ModioListNode* field_value_list;
     ModioListNode* like_list;
     ModioListNode* not_like_list;
@@ -477,6 +500,23 @@ extern "C"
     ModioModfileCreator modio_modfile_creator;
   };
 
+  // Phase durations of the transfer behind a response, http_version is 0 when the response
+  // did not come from the network
+  struct ModioTransferInfo
+  {
+    char* effective_url;
+    u32 http_version;
+    bool connection_reused;
+    double dns_millis;
+    double connect_millis;
+    double tls_millis;
+    double ttfb_millis;
+    double transfer_millis;
+    double total_millis;
+    double download_bytes_per_second;
+    double upload_bytes_per_second;
+  };
+
   struct ModioResponse
   {
     u32 code;
@@ -485,7 +525,9 @@ extern "C"
     i32 result_offset;
     u32 result_total;
     bool result_cached;
+    bool result_stale;
     ModioError error;
+    ModioTransferInfo transfer;
   };
 
   struct ModioUserEvent
@@ -498,13 +540,112 @@ extern "C"
     u32 date_added;
   };
 
+  struct ModioCacheStats
+  {
+    u32 hits;
+    u32 stale_hits;
+    u32 misses;
+    u32 evictions;
+    u32 records;
+    u32 stored_bytes;
+    u32 uncompressed_bytes;
+    u32 file_bytes;
+    u32 memory_bytes;
+    u32 stored_mods;
+    u32 stored_modfiles;
+    u32 prefetches;
+    u32 prefetch_hits;
+  };
+
+  struct ModioHistogram
+  {
+    u32 count;
+    double mean_millis;
+    double p50_millis;
+    double p90_millis;
+    double p99_millis;
+    double max_millis;
+  };
+
+  struct ModioEndpointMetrics
+  {
+    char* endpoint;
+    u32 requests;
+    u32 status_2xx;
+    u32 status_3xx;
+    u32 status_4xx;
+    u32 status_5xx;
+    u32 failed;
+  };
+
+  struct ModioHostMetrics
+  {
+    char* host;
+    u32 transfers;
+    u32 reused_connections;
+    u32 http_version;
+    double mean_dns_millis;
+    double mean_connect_millis;
+    double mean_tls_millis;
+    double mean_ttfb_millis;
+    double mean_transfer_millis;
+    double download_bytes_per_second;
+  };
+
+  struct ModioMetrics
+  {
+    u32 requests;
+    u32 failed_requests;
+    ModioEndpointMetrics* endpoints_array;
+    u32 endpoints_array_size;
+    ModioHostMetrics* hosts_array;
+    u32 hosts_array_size;
+    ModioHistogram network_latency;
+    ModioHistogram parse_latency;
+    ModioHistogram callback_latency;
+    u64 bytes_up;
+    u64 bytes_down;
+    u64 decoded_bytes_down;
+    u32 memory_cache_hits;
+    u32 store_cache_hits;
+    u32 cache_misses;
+    u32 entity_store_hits;
+    u32 entity_store_misses;
+    double memory_cache_hit_ratio;
+    double store_cache_hit_ratio;
+    double entity_store_hit_ratio;
+    u32 active_requests;
+    u32 active_downloads;
+    u32 active_uploads;
+    u32 mod_download_queue_size;
+    u32 modfile_upload_queue_size;
+    u32 prefetch_queue_size;
+    u64 extracted_bytes;
+    u32 extracted_files;
+    ModioHistogram extract_time;
+    double extract_bytes_per_second;
+    ModioHistogram process_time;
+  };
+
   //General Methods
   void MODIO_DLL modioInit(u32 environment, u32 game_id, char const* api_key, char const* root_path);
   void MODIO_DLL modioShutdown(void);
   void MODIO_DLL modioSetDebugLevel(u32 debug_level);
+  // The listener receives every logged line from the SDK log thread, not the thread that logged it.
+  // Lines logged while the SDK is not initialized reach it on the logging thread, and modioShutdown
+  // delivers the last queued lines on its own thread. It must not call back into the SDK.
+  void MODIO_DLL modioSetLogListener(void (*callback)(u32 debug_level, char const* message));
+  // Records requests, downloads, zip and cache work, max_events 0 keeps the default
+  void MODIO_DLL modioStartTracing(u32 max_events);
+  void MODIO_DLL modioStopTracing(void);
+  // Chrome trace JSON, opens in chrome://tracing and Perfetto
+  bool MODIO_DLL modioWriteTrace(char const* path);
   void MODIO_DLL modioProcess(void);
   void MODIO_DLL modioSleep(u32 milliseconds);
   void MODIO_DLL compressFiles(char const* root_directory, char const* const filenames[], u32 filenames_size, char const* zip_path);
+  ModioCacheStats MODIO_DLL modioGetCacheStats(void);
+  ModioMetrics MODIO_DLL modioGetMetrics(void);
+  void MODIO_DLL modioFreeMetrics(ModioMetrics* metrics);
 
   //Events
   void MODIO_DLL modioSetEventListener(void (*callback)(ModioResponse response, ModioModEvent* events_array, u32 events_array_size));
@@ -544,6 +685,13 @@ extern "C"
   void MODIO_DLL modioAddMod(void* object, ModioModCreator mod_handler, void (*callback)(void* object, ModioResponse response, ModioMod mod));
   void MODIO_DLL modioEditMod(void* object, u32 mod_id, ModioModEditor mod_handler, void (*callback)(void* object, ModioResponse response, ModioMod mod));
   void MODIO_DLL modioDeleteMod(void* object, u32 mod_id, void (*callback)(void* object, ModioResponse response));
+  // Read the heavy fields through these, listings leave them out while lazy fields are enabled.
+  // The results stay valid until the next modioProcess call, even if a listing that is
+  // fetched or prefetched meanwhile replaces the mod. modioShutdown frees them right away.
+  char const* MODIO_DLL modioGetModDescription(ModioMod const* mod);
+  char const* MODIO_DLL modioGetModDescriptionPlaintext(ModioMod const* mod);
+  char const* MODIO_DLL modioGetModMetadataBlob(ModioMod const* mod);
+  ModioMedia const* MODIO_DLL modioGetModMedia(ModioMod const* mod);
 
   //Media Methods
   void MODIO_DLL modioAddModLogo(void* object, u32 mod_id, char const* logo_path, void (*callback)(void* object, ModioResponse response));
@@ -578,6 +726,7 @@ extern "C"
   void MODIO_DLL modioSetFilterOffset(ModioFilterCreator* filter, u32 offset);
   void MODIO_DLL modioSetFilterFullTextSearch(ModioFilterCreator* filter, char const* text);
   void MODIO_DLL modioSetFilterCacheMaxAgeSeconds(ModioFilterCreator* filter, u32 max_age_seconds);
+  void MODIO_DLL modioSetFilterCachePolicy(ModioFilterCreator* filter, u32 cache_policy);
   void MODIO_DLL modioAddFilterFieldValue(ModioFilterCreator* filter, char const* field, char const* value);
   void MODIO_DLL modioAddFilterLikeField(ModioFilterCreator* filter, char const* field, char const* value);
   void MODIO_DLL modioAddFilterNotLikeField(ModioFilterCreator* filter, char const* field, char const* value);
@@ -657,6 +806,14 @@ extern "C"
   u32 MODIO_DLL modioGetAllowBackgroundDownloadsConfig(void);
   void MODIO_DLL modioSetAutomaticUpdatesConfig(u32 option);
   void MODIO_DLL modioSetAllowBackgroundDownloadsConfig(u32 option);
+  u32 MODIO_DLL modioGetBinaryCacheConfig(void);
+  void MODIO_DLL modioSetBinaryCacheConfig(u32 option);
+  u32 MODIO_DLL modioGetCacheMaxBytesConfig(void);
+  void MODIO_DLL modioSetCacheMaxBytesConfig(u32 max_bytes);
+  u32 MODIO_DLL modioGetLazyFieldsConfig(void);
+  void MODIO_DLL modioSetLazyFieldsConfig(u32 option);
+  u32 MODIO_DLL modioGetPrefetchBudgetConfig(void);
+  void MODIO_DLL modioSetPrefetchBudgetConfig(u32 requests_per_minute);
 
   //Downloads Methods
   void MODIO_DLL modioDownloadMod(u32 mod_id);
@@ -3,6 +3,7 @@
 
 #include "../../wrappers/CurlWrapper.h"
 #include "../../wrappers/MinizipWrapper.h"
+#include "../../Prefetcher.h"
 #include "../schemas/ModioResponse.h"
 #include "../ModioC.h"
 #include "callbacks/DependenciesCallbacks.h"
@@ -7,4 +7,13 @@
 #include "callbacks/ModCallbacks.h"
 #include "../ModioC.h"
 
+namespace modio
+{
+// For the C++ Instance, json_callback gets the mod json of network, json cache and stored
+// mod responses and decodes it straight into modio::Mod. Listings served from the binary
+// cache are already decoded and still come through callback.
+void getModJson(void *object, u32 mod_id, void (*json_callback)(void *object, ModioResponse response, const nlohmann::json &mod_json));
+void getAllModsJson(void *object, ModioFilterCreator filter, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size), void (*json_callback)(void *object, ModioResponse response, const nlohmann::json &mods_json));
+} // namespace modio
+
 #endif
@@ -24,7 +24,7 @@ extern std::map< u32, GetAllModCommentsParams* > get_all_mod_comments_callbacks;
 extern std::map< u32, GetModCommentParams* > get_mod_comment_callbacks;
 extern std::map< u32, GenericRequestParams* > delete_mod_comment_callbacks;
 
-void modioOnGetAllModComments(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetAllModComments(u32 call_number, u32 response_code, const nlohmann::json &response_json);
 void modioOnGetModComment(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnDeleteModComment(u32 call_number, u32 response_code, nlohmann::json response_json);
 
@@ -21,6 +21,8 @@ struct GetUserSubscriptionsParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size);
 };
 
@@ -35,6 +37,8 @@ struct GetUserGamesParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioGame games[], u32 games_size);
 };
 
@@ -43,6 +47,8 @@ struct GetUserModsParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size);
 };
 
@@ -51,6 +57,8 @@ struct GetUserModfilesParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size);
 };
 
@@ -59,6 +67,8 @@ struct GetUserRatingsParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioRating ratings[], u32 ratings_size);
 };
 
@@ -72,11 +82,13 @@ extern std::map< u32, GetUserRatingsParams* > get_user_ratings_callbacks;
 
 void modioOnGetAuthenticatedUser(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnGetUserSubscriptions(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetUserSubscriptionsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json);
 void modioOnGetUserEvents(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnGetUserMods(u32 call_number, u32 response_code, nlohmann::json response_json);
-void modioOnGetUserGames(u32 call_number, u32 response_code, nlohmann::json response_json);
-void modioOnGetUserModfiles(u32 call_number, u32 response_code, nlohmann::json response_json);
-void modioOnGetUserRatings(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetUserModsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json);
+void modioOnGetUserGames(u32 call_number, u32 response_code, const nlohmann::json &response_json);
+void modioOnGetUserModfiles(u32 call_number, u32 response_code, const nlohmann::json &response_json);
+void modioOnGetUserRatings(u32 call_number, u32 response_code, const nlohmann::json &response_json);
 
 void clearMeCallbackParams();
 
@@ -13,6 +13,8 @@ struct GetModParams
 {
   void* object;
   void (*callback)(void* object, ModioResponse response, ModioMod mod);
+  // Set by the C++ Instance to decode the mod json itself, callback is not called then
+  void (*json_callback)(void* object, ModioResponse response, const nlohmann::json &mod_json);
 };
 
 struct GetAllModsParams
@@ -20,7 +22,11 @@ struct GetAllModsParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size);
+  // Set by the C++ Instance to decode the data array itself, callback is not called then
+  void (*json_callback)(void* object, ModioResponse response, const nlohmann::json &mods_json);
 };
 
 struct AddModParams
@@ -29,6 +35,13 @@ struct AddModParams
   void (*callback)(void* object, ModioResponse response, ModioMod mod);
 };
 
+struct DeleteModParams
+{
+  void* object;
+  u32 mod_id;
+  void (*callback)(void* object, ModioResponse response);
+};
+
 struct CallbackParamReturnsId
 {
   void* object;
@@ -38,12 +51,13 @@ struct CallbackParamReturnsId
 
 extern std::map< u32,GetModParams* > get_mod_callbacks;
 extern std::map< u32,AddModParams* > add_mod_callbacks;
-extern std::map< u32,GenericRequestParams* > delete_mod_callbacks;
+extern std::map< u32,DeleteModParams* > delete_mod_callbacks;
 extern std::map< u32,GetAllModsParams* > get_all_mods_callbacks;
 extern std::map< u32,CallbackParamReturnsId* > return_id_callbacks;
 
 void modioOnGetMod(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnGetAllMods(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetAllModsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json);
 void modioOnModAdded(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnModDeleted(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnReturnIdCallback(u32 call_number, u32 response_code, nlohmann::json response_json);
@@ -25,8 +25,8 @@ struct GetAllModStatsParams
 extern std::map< u32,GetModStatsParams* > get_mod_stats_callbacks;
 extern std::map< u32,GetAllModStatsParams* > get_all_mod_stats_callbacks;
 
-void modioOnGetModStats(u32 call_number, u32 response_code, nlohmann::json response_json);
-void modioOnGetAllModStats(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetModStats(u32 call_number, u32 response_code, const nlohmann::json &response_json);
+void modioOnGetAllModStats(u32 call_number, u32 response_code, const nlohmann::json &response_json);
 
 void clearModStatsCallbackParams();
 
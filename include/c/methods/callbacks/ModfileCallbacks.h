@@ -18,6 +18,8 @@ struct GetAllModfilesParams
   void* object;
   std::string url;
   bool is_cache;
+  bool is_stale;
+  u64 stale_hash;
   void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size);
 };
 
@@ -41,7 +43,7 @@ extern std::map< u32, EditModfileParams* > edit_modfile_callbacks;
 extern std::map< u32, GenericRequestParams* > delete_modfile_callbacks;
 
 void modioOnGetModfile(u32 call_number, u32 response_code, nlohmann::json response_json);
-void modioOnGetAllModfiles(u32 call_number, u32 response_code, nlohmann::json response_json);
+void modioOnGetAllModfiles(u32 call_number, u32 response_code, const nlohmann::json &response_json);
 void modioOnModfileAdded(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnModfileEdited(u32 call_number, u32 response_code, nlohmann::json response_json);
 void modioOnModfileDeleted(u32 call_number, u32 response_code, nlohmann::json response_json);
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getAvatarSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitAvatar(ModioAvatar* avatar, nlohmann::json avatar_json);
+  void modioInitAvatar(ModioAvatar* avatar, const nlohmann::json &avatar_json);
   void modioFreeAvatar(ModioAvatar* avatar);
 }
 
@@ -3,11 +3,17 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioUser.h"
 
+namespace modio
+{
+const SchemaTable &getCommentSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitComment(ModioComment* comment, nlohmann::json comment_json);
+  void modioInitComment(ModioComment* comment, const nlohmann::json &comment_json);
   void modioFreeComment(ModioComment* comment);
 }
 
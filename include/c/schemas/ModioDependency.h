@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getDependencySchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitDependency(ModioDependency* dependency, nlohmann::json dependency_json);
+  void modioInitDependency(ModioDependency* dependency, const nlohmann::json &dependency_json);
   void modioFreeDependency(ModioDependency* dependency);
 }
 
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getDownloadSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitDownload(ModioDownload* download, nlohmann::json download_json);
+  void modioInitDownload(ModioDownload* download, const nlohmann::json &download_json);
   void modioFreeDownload(ModioDownload* download);
 }
 
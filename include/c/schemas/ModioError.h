@@ -6,7 +6,7 @@
 
 extern "C"
 {
-  void modioInitError(ModioError* error, nlohmann::json image_json);
+  void modioInitError(ModioError* error, const nlohmann::json &image_json);
   void modioFreeError(ModioError* error);
 }
 
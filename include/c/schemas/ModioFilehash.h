@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getFilehashSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitFilehash(ModioFilehash* filehash, nlohmann::json filehash_json);
+  void modioInitFilehash(ModioFilehash* filehash, const nlohmann::json &filehash_json);
   void modioFreeFilehash(ModioFilehash* filehash);
 }
 
@@ -3,15 +3,21 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioUser.h"
 #include "ModioIcon.h"
 #include "ModioLogo.h"
 #include "ModioHeader.h"
 #include "ModioGameTagOption.h"
 
+namespace modio
+{
+const SchemaTable &getGameSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitGame(ModioGame* game, nlohmann::json game_json);
+  void modioInitGame(ModioGame* game, const nlohmann::json &game_json);
   void modioFreeGame(ModioGame* game);
 }
 
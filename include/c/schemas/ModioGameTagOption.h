@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getGameTagOptionSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitGameTagOption(ModioGameTagOption* game_tag_option, nlohmann::json game_tag_option_json);
+  void modioInitGameTagOption(ModioGameTagOption* game_tag_option, const nlohmann::json &game_tag_option_json);
   void modioFreeGameTagOption(ModioGameTagOption* game_tag_option);
 }
 
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getHeaderSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitHeader(ModioHeader* header, nlohmann::json header_json);
+  void modioInitHeader(ModioHeader* header, const nlohmann::json &header_json);
   void modioFreeHeader(ModioHeader* header);
 }
 
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getIconSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitIcon(ModioIcon* icon, nlohmann::json icon_json);
+  void modioInitIcon(ModioIcon* icon, const nlohmann::json &icon_json);
   void modioFreeIcon(ModioIcon* icon);
 }
 
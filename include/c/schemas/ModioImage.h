@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getImageSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitImage(ModioImage* image, nlohmann::json image_json);
+  void modioInitImage(ModioImage* image, const nlohmann::json &image_json);
   void modioFreeImage(ModioImage* image);
 }
 
@@ -4,10 +4,11 @@
 #include "../../Utility.h"
 #include "../ModioC.h"
 #include "ModioMod.h"
+#include "../../ModUtility.h"
 
 extern "C"
 {
-	void modioInitInstalledMod(ModioInstalledMod* installed_mod, nlohmann::json image_json);
+	void modioInitInstalledMod(ModioInstalledMod* installed_mod, const nlohmann::json &image_json);
 }
 
 #endif
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getLogoSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitLogo(ModioLogo* logo, nlohmann::json logo_json);
+  void modioInitLogo(ModioLogo* logo, const nlohmann::json &logo_json);
   void modioFreeLogo(ModioLogo* logo);
 }
 
@@ -3,11 +3,17 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioImage.h"
 
+namespace modio
+{
+const SchemaTable &getMediaSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitMedia(ModioMedia* media, nlohmann::json media_json);
+  void modioInitMedia(ModioMedia* media, const nlohmann::json &media_json);
   void modioFreeMedia(ModioMedia* media);
 }
 
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getMetadataKVPSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitMetadataKVP(ModioMetadataKVP* metadata_kvp, nlohmann::json metadata_kvp_json);
+  void modioInitMetadataKVP(ModioMetadataKVP* metadata_kvp, const nlohmann::json &metadata_kvp_json);
   void modioFreeMetadataKVP(ModioMetadataKVP* metadata_kvp);
 }
 
@@ -3,6 +3,7 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioLogo.h"
 #include "ModioUser.h"
 #include "ModioMedia.h"
@@ -11,9 +12,16 @@
 #include "ModioTag.h"
 #include "ModioMetadataKVP.h"
 
+namespace modio
+{
+const SchemaTable &getModSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitMod(ModioMod* mod, nlohmann::json mod_json);
+  void modioInitMod(ModioMod* mod, const nlohmann::json &mod_json);
+  // Leaves description, description_plaintext, metadata_blob and media empty
+  void modioInitModLazyFields(ModioMod* mod, const nlohmann::json &mod_json);
   void modioFreeMod(ModioMod* mod);
 }
 
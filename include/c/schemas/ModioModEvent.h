@@ -3,10 +3,18 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+// Names of the event_type values in the event responses
+const SchemaEnumValue *getEventTypeValues();
+const SchemaTable &getModEventSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitModEvent(ModioModEvent* event, nlohmann::json event_json);
+  void modioInitModEvent(ModioModEvent* event, const nlohmann::json &event_json);
   void modioFreeModEvent(ModioModEvent* event);
 }
 
@@ -3,12 +3,18 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioFilehash.h"
 #include "ModioDownload.h"
 
+namespace modio
+{
+const SchemaTable &getModfileSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitModfile(ModioModfile* modfile, nlohmann::json modfile_json);
+  void modioInitModfile(ModioModfile* modfile, const nlohmann::json &modfile_json);
   void modioFreeModfile(ModioModfile* modfile);
 }
 
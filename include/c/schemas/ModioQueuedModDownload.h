@@ -3,11 +3,17 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioMod.h"
 
+namespace modio
+{
+const SchemaTable &getQueuedModDownloadSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitQueuedModDownload(ModioQueuedModDownload* queued_mod_download, nlohmann::json queued_mod_download_json);
+  void modioInitQueuedModDownload(ModioQueuedModDownload* queued_mod_download, const nlohmann::json &queued_mod_download_json);
 }
 
 #endif
@@ -7,7 +7,7 @@
 
 extern "C"
 {
-  void modioInitQueuedModfileUpload(ModioQueuedModfileUpload* queued_modfile_upload, nlohmann::json queued_modfile_upload_json);
+  void modioInitQueuedModfileUpload(ModioQueuedModfileUpload* queued_modfile_upload, const nlohmann::json &queued_modfile_upload_json);
 }
 
 #endif
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getRatingSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitRating(ModioRating* rating, nlohmann::json rating_json);
+  void modioInitRating(ModioRating* rating, const nlohmann::json &rating_json);
   void modioFreeRating(ModioRating* rating);
 }
 
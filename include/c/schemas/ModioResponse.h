@@ -7,8 +7,17 @@
 
 extern "C"
 {
-  void modioInitResponse(ModioResponse* response, nlohmann::json response_json);
+  void modioInitResponse(ModioResponse* response, const nlohmann::json &response_json);
   void modioFreeResponse(ModioResponse* response);
 }
 
+namespace modio
+{
+// The transfer the next initialized response gets, curlwrapper sets it around request
+// callbacks. Initializing a response clears it so the responses a callback builds for
+// other calls do not inherit it.
+void setResponseTransfer(const ModioTransferInfo *transfer);
+const ModioTransferInfo *getResponseTransfer();
+}
+
 #endif
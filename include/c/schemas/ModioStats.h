@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getStatsSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitStats(ModioStats* stats, nlohmann::json stats_json);
+  void modioInitStats(ModioStats* stats, const nlohmann::json &stats_json);
   void modioFreeStats(ModioStats* stats);
 }
 
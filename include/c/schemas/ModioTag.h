@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getTagSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitTag(ModioTag* tag, nlohmann::json tag_json);
+  void modioInitTag(ModioTag* tag, const nlohmann::json &tag_json);
   void modioFreeTag(ModioTag* tag);
 }
 
@@ -3,11 +3,17 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
 #include "ModioAvatar.h"
 
+namespace modio
+{
+const SchemaTable &getUserSchema();
+} // namespace modio
+
 extern "C"
 {
-  void modioInitUser(ModioUser* user, nlohmann::json user_json);
+  void modioInitUser(ModioUser* user, const nlohmann::json &user_json);
   void modioFreeUser(ModioUser* user);
 }
 
@@ -3,10 +3,16 @@
 
 #include "../../Utility.h"
 #include "../ModioC.h"
+#include "../../SchemaFields.h"
+
+namespace modio
+{
+const SchemaTable &getUserEventSchema();
+} // namespace modio
 
 extern "C"
 {
-  void modioInitUserEvent(ModioUserEvent* event, nlohmann::json event_json);
+  void modioInitUserEvent(ModioUserEvent* event, const nlohmann::json &event_json);
   void modioFreeUserEvent(ModioUserEvent* event);
 }
 
@@ -3,6 +3,10 @@
 
 #include "Utility.h"
 #include "Globals.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Tracer.h"
+#include "JsonParser.h"
 #include "wrappers/CurlWrapper.h"
 #include "wrappers/MinizipWrapper.h"
 #include "c/ModioC.h"
@@ -13,7 +13,7 @@ namespace curlwrapper
 
 void onJsonRequestFinished(CURL* curl);
 void onDownloadFinished(CURL* curl);
-void onModDownloadFinished(CURL* curl);
+void onModDownloadFinished(CURL* curl, CURLcode result);
 void onModfileUploadFinished(CURL* curl);
 
 }
@@ -9,6 +9,8 @@
 #include <curl/curl.h>
 #include "../Utility.h"
 #include "../Globals.h"
+#include "../Tracer.h"
+#include "../Metrics.h"
 #include "CurlProgressFunctions.h"
 #include "CurlWriteFunctions.h"
 #include "../c++/schemas/QueuedModDownload.h"
@@ -21,6 +23,9 @@
 #define SKIP_PEER_VERIFICATION
 #define SKIP_HOSTNAME_VERIFICATION
 
+// Interrupted mod downloads are resumed from the partially downloaded file this many times
+#define MODIO_MAX_DOWNLOAD_RETRIES 3
+
 namespace modio
 {
 namespace curlwrapper
@@ -40,6 +45,7 @@ public:
   struct curl_httppost *formpost = NULL;
 #endif
   std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback;
+  double queued_micros;
 
 #ifdef MODIO_WINDOWS_DETECTED
   JsonResponseHandler(u32 call_number, struct curl_slist *slist, char *post_fields, curl_mime *curl_mime, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback);
@@ -57,6 +63,7 @@ public:
   std::string url;
   struct curl_slist *slist = NULL;
   std::function<void(u32 call_number, u32 response_code)> callback;
+  double queued_micros;
   OngoingDownload(u32 call_number, std::string url, struct curl_slist *slist, std::function<void(u32 call_number, u32 response_code)> callback);
   ~OngoingDownload();
 };
@@ -75,6 +82,7 @@ public:
   CURL *curl_handle;
   struct curl_slist *slist;
   FILE *file;
+  double queued_micros;
 
   CurrentModDownload();
   ~CurrentModDownload();
@@ -102,12 +110,15 @@ extern std::list<QueuedModDownload *> g_mod_download_queue;
 extern std::list<QueuedModfileUpload *> g_modfile_upload_queue;
 
 extern CurrentModDownload* g_current_mod_download;
+extern u32 g_mod_download_retries;
 extern CurrentModfileUpload* g_current_modfile_upload;
 
 std::list<QueuedModDownload *> getModDownloadQueue();
 std::list<QueuedModfileUpload *> getModfileUploadQueue();
 
 void updateModDownloadQueue();
+// Publishes the sizes of the containers above to the metrics, run after they change
+void updateTransferGauges();
 void updateModDownloadQueueFile();
 void updateModUploadQueueFile();
 void prioritizeModDownload(u32 mod_id);
@@ -3,6 +3,8 @@
 
 #include "CurlUtility.h"
 #include "CurlCallbacks.h"
+#include "Transport.h"
+#include "ReplayTransport.h"
 
 #ifdef MODIO_WINDOWS_DETECTED
 #  pragma comment(lib, "ws2_32.lib")
@@ -17,6 +19,8 @@ void initCurl();
 void shutdownCurl();
 u32 getCallNumber();
 void process();
+// GETs in flight, identical ones joined together count once
+u32 getPendingGetCount();
 
 //HTTP methods
 void get(u32 call_number, std::string url, std::vector<std::string> headers, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback);
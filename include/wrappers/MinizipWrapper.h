@@ -9,6 +9,8 @@
 #include "../dependencies/minizip/unzip.h"
 #include "../dependencies/minizip/minizip.h"
 #include "../Utility.h"
+#include "../Metrics.h"
+#include "../Tracer.h"
 
 #define dir_delimter '/'
 #define MAX_FILENAME 512
@@ -0,0 +1,70 @@
+#ifndef MODIO_REPLAY_TRANSPORT_H
+#define MODIO_REPLAY_TRANSPORT_H
+
+#include <map>
+
+#include "Transport.h"
+
+#define MODIO_TRANSPORT_RECORD 0
+#define MODIO_TRANSPORT_REPLAY 1
+
+namespace modio
+{
+namespace curlwrapper
+{
+// Record mode forwards every call to libcurl and stores the responses under directory.
+// Replay mode serves those stored responses back without touching the network, delayed
+// by the configured latency and limited by the configured bandwidth so that request
+// scheduling, parsing and caching can be profiled deterministically.
+class MODIO_DLL ReplayTransport : public Transport
+{
+public:
+  ReplayTransport(const std::string &directory, u32 mode);
+  ~ReplayTransport();
+
+  void setLatency(u32 milliseconds);
+  // Bytes per second shared by all replayed transfers, 0 means unlimited
+  void setBandwidth(u32 bytes_per_second);
+  u32 getPendingCount() const;
+  // Stores the response a replay of the call gets, the way record mode does
+  void storeRecord(const std::string &method, const std::string &url, const std::string &body, u32 response_code, const nlohmann::json &response_json);
+
+  void get(u32 call_number, std::string url, std::vector<std::string> headers, JsonRequestCallback callback);
+  void post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback);
+  void put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, JsonRequestCallback callback);
+  void postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, JsonRequestCallback callback);
+  void deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback);
+  void download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, DownloadCallback callback);
+  void process();
+  void shutdown();
+
+private:
+  struct PendingReply
+  {
+    u32 call_number;
+    double deliver_at;
+    u32 response_code;
+    nlohmann::json response_json;
+    JsonRequestCallback json_callback;
+    DownloadCallback download_callback;
+    std::string body_path;
+    FILE *file;
+  };
+
+  std::string directory;
+  u32 mode;
+  u32 latency;
+  u32 bandwidth;
+  double link_free_at;
+  // By due time, replies due at the same time in the order they were made
+  std::multimap<double, PendingReply *> pending_replies;
+
+  std::string getRecordPath(const std::string &key);
+  double scheduleDelivery(double size);
+  void jsonCall(const std::string &method, u32 call_number, const std::string &url, const std::string &body, JsonRequestCallback callback, const std::function<void(JsonRequestCallback)> &forward);
+};
+
+} // namespace curlwrapper
+} // namespace modio
+
+#endif
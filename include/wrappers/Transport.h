@@ -0,0 +1,58 @@
+#ifndef MODIO_TRANSPORT_H
+#define MODIO_TRANSPORT_H
+
+#include <map>
+#include <functional>
+
+#include "../Utility.h"
+
+namespace modio
+{
+namespace curlwrapper
+{
+typedef std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> JsonRequestCallback;
+typedef std::function<void(u32 call_number, u32 response_code)> DownloadCallback;
+
+// Backend used by the HTTP methods below. The SDK talks to libcurl through
+// CurlTransport by default, other transports can be swapped in with setTransport
+// to run the SDK offline, e.g. for benchmarks and regression tests.
+class Transport
+{
+public:
+  virtual ~Transport() {}
+
+  virtual void get(u32 call_number, std::string url, std::vector<std::string> headers, JsonRequestCallback callback) = 0;
+  virtual void post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback) = 0;
+  virtual void put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, JsonRequestCallback callback) = 0;
+  virtual void postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, JsonRequestCallback callback) = 0;
+  virtual void deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback) = 0;
+  virtual void download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, DownloadCallback callback) = 0;
+
+  // Called on every modioProcess(), finished transfers fire their callbacks from here
+  virtual void process() = 0;
+  // Drops every transfer that did not finish yet without firing its callback
+  virtual void shutdown() = 0;
+};
+
+class CurlTransport : public Transport
+{
+public:
+  void get(u32 call_number, std::string url, std::vector<std::string> headers, JsonRequestCallback callback);
+  void post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback);
+  void put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, JsonRequestCallback callback);
+  void postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, JsonRequestCallback callback);
+  void deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback);
+  void download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, DownloadCallback callback);
+  void process();
+  void shutdown();
+};
+
+// Passing NULL restores the default libcurl transport. The transport is not owned by the SDK.
+void MODIO_DLL setTransport(Transport *transport);
+Transport MODIO_DLL *getTransport();
+CurlTransport *getCurlTransport();
+
+} // namespace curlwrapper
+} // namespace modio
+
+#endif
@@ -0,0 +1,725 @@
+#include "CacheStore.h"
+#include "Tracer.h"
+
+#ifndef MODIO_WINDOWS_DETECTED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MODIO_CACHE_STORE_MAGIC 0x3142534F49444F4DULL // "MODIOSB1"
+#define MODIO_CACHE_STORE_VERSION 3
+#define MODIO_CACHE_RECORD_MAGIC 0x5243444DU // "MDCR"
+#define MODIO_CACHE_HEADER_SLOT_SIZE 64
+#define MODIO_CACHE_DATA_OFFSET 4096
+#define MODIO_CACHE_MIN_FILE_SIZE 1048576
+#define MODIO_CACHE_MIN_COMPACTION_BYTES 1048576
+
+namespace modio
+{
+struct CacheStoreHeader
+{
+  u64 magic;
+  u32 version;
+  u32 reserved;
+  u64 generation;
+  u64 data_begin;
+  u64 data_end;
+  u32 crc;
+  u32 padding;
+};
+
+struct CacheRecordHeader
+{
+  u32 magic;
+  u32 flags;
+  u64 key;
+  double datetime_millis;
+  u32 key_size;
+  u32 value_size;
+  u32 raw_size;
+  u32 tag_count;
+  u32 crc;
+  u32 padding;
+};
+
+static u64 align8(u64 size)
+{
+  return (size + 7) & ~(u64)7;
+}
+
+// Small stores can't afford a fixed amount of dead space before compacting
+static u64 getMinCompactionBytes(u64 max_bytes)
+{
+  return max_bytes / 8 < MODIO_CACHE_MIN_COMPACTION_BYTES ? max_bytes / 8 : MODIO_CACHE_MIN_COMPACTION_BYTES;
+}
+
+// The file may grow a bit past the budget, dead records are only reclaimed by compaction
+static u64 getMaxFileSize(u64 max_bytes)
+{
+  return align8(MODIO_CACHE_DATA_OFFSET + max_bytes + max_bytes / 4);
+}
+
+static u32 getHeaderCrc(const CacheStoreHeader &header)
+{
+  return (u32)mz_crc32(MZ_CRC32_INIT, (const unsigned char *)&header, offsetof(CacheStoreHeader, crc));
+}
+
+// Key, value and tags follow the record header in that order
+static u64 getRecordSize(const CacheRecordHeader &record)
+{
+  return sizeof(record) + record.key_size + record.value_size + record.tag_count * sizeof(u32);
+}
+
+static u32 getRecordCrc(const CacheRecordHeader &record, const char *key)
+{
+  mz_ulong crc = mz_crc32(MZ_CRC32_INIT, (const unsigned char *)&record, offsetof(CacheRecordHeader, crc));
+  return (u32)mz_crc32(crc, (const unsigned char *)key, getRecordSize(record) - sizeof(record));
+}
+
+static std::vector<u32> readTags(const CacheRecordHeader &record, const char *key)
+{
+  std::vector<u32> tags(record.tag_count);
+  if (record.tag_count > 0)
+    memcpy(&tags[0], key + record.key_size + record.value_size, record.tag_count * sizeof(u32));
+  return tags;
+}
+
+CacheStore::CacheStore()
+  : max_bytes(MODIO_CACHE_STORE_MAX_BYTES), generation(0), data_begin(MODIO_CACHE_DATA_OFFSET), data_end(MODIO_CACHE_DATA_OFFSET), live_bytes(0),
+    raw_bytes(0), evictions(0), mapped_data(NULL), mapped_size(0)
+{
+#ifdef MODIO_WINDOWS_DETECTED
+  file_handle = INVALID_HANDLE_VALUE;
+  mapping_handle = NULL;
+#else
+  file_descriptor = -1;
+#endif
+}
+
+CacheStore::~CacheStore()
+{
+  close();
+}
+
+bool CacheStore::open(const std::string &path_, u64 max_bytes_)
+{
+  MODIO_TRACE_SCOPE("open", "cache store");
+  close();
+  path = path_;
+  max_bytes = max_bytes_;
+
+#ifdef MODIO_WINDOWS_DETECTED
+  wchar_t *path_wc = modio::WideCharFromString(path);
+  file_handle = CreateFileW(path_wc, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  free(path_wc);
+  if (file_handle == INVALID_HANDLE_VALUE)
+  {
+    MODIO_LOG("Could not open the cache store: " + path, MODIO_DEBUGLEVEL_ERROR);
+    return false;
+  }
+  LARGE_INTEGER file_size;
+  GetFileSizeEx(file_handle, &file_size);
+  u64 size = (u64)file_size.QuadPart;
+#else
+  file_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file_descriptor < 0)
+  {
+    MODIO_LOG("Could not open the cache store: " + path, MODIO_DEBUGLEVEL_ERROR);
+    return false;
+  }
+  struct stat file_stat;
+  fstat(file_descriptor, &file_stat);
+  u64 size = (u64)file_stat.st_size;
+#endif
+
+  u64 min_size = MODIO_CACHE_MIN_FILE_SIZE < getMaxFileSize(max_bytes) ? MODIO_CACHE_MIN_FILE_SIZE : getMaxFileSize(max_bytes);
+  if (!map(size < min_size ? min_size : size))
+  {
+    close();
+    return false;
+  }
+
+  if (size < MODIO_CACHE_DATA_OFFSET || !readHeader())
+  {
+    if (size > 0)
+      writeLogLine("Cache store header is damaged, starting with an empty cache", MODIO_DEBUGLEVEL_WARNING);
+    generation = 0;
+    data_begin = data_end = MODIO_CACHE_DATA_OFFSET;
+    writeHeader();
+  }
+
+  scan();
+  evict(0);
+  return true;
+}
+
+void CacheStore::close()
+{
+  unmap(true);
+#ifdef MODIO_WINDOWS_DETECTED
+  if (file_handle != INVALID_HANDLE_VALUE)
+    CloseHandle(file_handle);
+  file_handle = INVALID_HANDLE_VALUE;
+#else
+  if (file_descriptor >= 0)
+    ::close(file_descriptor);
+  file_descriptor = -1;
+#endif
+  index.clear();
+  offsets.clear();
+  recency.clear();
+  tagged.clear();
+  live_bytes = 0;
+  raw_bytes = 0;
+}
+
+bool CacheStore::isOpen() const
+{
+  return mapped_data != NULL;
+}
+
+bool CacheStore::map(u64 size)
+{
+#ifdef MODIO_WINDOWS_DETECTED
+  mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), NULL);
+  if (mapping_handle == NULL)
+    return false;
+  mapped_data = (char *)MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)size);
+  if (mapped_data == NULL)
+  {
+    CloseHandle(mapping_handle);
+    mapping_handle = NULL;
+    return false;
+  }
+#else
+  if (ftruncate(file_descriptor, (off_t)size) != 0)
+    return false;
+  void *data = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+  if (data == MAP_FAILED)
+    return false;
+  mapped_data = (char *)data;
+#endif
+  mapped_size = size;
+  return true;
+}
+
+void CacheStore::unmap(bool sync)
+{
+  if (!mapped_data)
+    return;
+#ifdef MODIO_WINDOWS_DETECTED
+  FlushViewOfFile(mapped_data, 0);
+  if (sync)
+    FlushFileBuffers(file_handle);
+  UnmapViewOfFile(mapped_data);
+  CloseHandle(mapping_handle);
+  mapping_handle = NULL;
+#else
+  // Growing the mapping keeps the pages in the page cache, only closing waits for the disk
+  msync(mapped_data, (size_t)mapped_size, sync ? MS_SYNC : MS_ASYNC);
+  munmap(mapped_data, (size_t)mapped_size);
+#endif
+  mapped_data = NULL;
+  mapped_size = 0;
+}
+
+bool CacheStore::reserve(u64 size)
+{
+  if (size <= mapped_size)
+    return true;
+
+  // put() evicts and compacts before the log would outgrow the cap
+  u64 max_file_size = getMaxFileSize(max_bytes);
+  if (size > max_file_size)
+    return false;
+
+  u64 new_size = mapped_size * 2;
+  if (new_size < size)
+    new_size = align8(size + size / 4);
+  if (new_size > max_file_size)
+    new_size = max_file_size;
+
+  unmap(false);
+  if (!map(new_size))
+  {
+    MODIO_LOG("Could not grow the cache store to " + modio::toString((u32)(new_size / 1024)) + " KiB", MODIO_DEBUGLEVEL_ERROR);
+    return false;
+  }
+  return true;
+}
+
+void CacheStore::writeHeader()
+{
+  // Alternate slots so a torn write leaves the previous header intact
+  generation++;
+  CacheStoreHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = MODIO_CACHE_STORE_MAGIC;
+  header.version = MODIO_CACHE_STORE_VERSION;
+  header.generation = generation;
+  header.data_begin = data_begin;
+  header.data_end = data_end;
+  header.crc = getHeaderCrc(header);
+  memcpy(mapped_data + (generation % 2) * MODIO_CACHE_HEADER_SLOT_SIZE, &header, sizeof(header));
+}
+
+bool CacheStore::readHeader()
+{
+  bool found = false;
+  for (u32 slot = 0; slot < 2; slot++)
+  {
+    CacheStoreHeader header;
+    memcpy(&header, mapped_data + slot * MODIO_CACHE_HEADER_SLOT_SIZE, sizeof(header));
+
+    if (header.magic != MODIO_CACHE_STORE_MAGIC || header.version != MODIO_CACHE_STORE_VERSION || header.crc != getHeaderCrc(header))
+      continue;
+    if (header.data_begin < MODIO_CACHE_DATA_OFFSET || header.data_begin > header.data_end || header.data_end > mapped_size)
+      continue;
+
+    if (!found || header.generation > generation)
+    {
+      generation = header.generation;
+      data_begin = header.data_begin;
+      data_end = header.data_end;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void CacheStore::scan()
+{
+  index.clear();
+  offsets.clear();
+  recency.clear();
+  tagged.clear();
+  live_bytes = 0;
+  raw_bytes = 0;
+
+  u64 offset = data_begin;
+  while (offset < data_end)
+  {
+    CacheRecordHeader record;
+    bool valid = offset + sizeof(record) <= data_end;
+    if (valid)
+    {
+      memcpy(&record, mapped_data + offset, sizeof(record));
+      valid = record.magic == MODIO_CACHE_RECORD_MAGIC && offset + getRecordSize(record) <= data_end;
+    }
+    const char *key = mapped_data + offset + sizeof(record);
+    if (valid)
+      valid = record.crc == getRecordCrc(record, key);
+
+    if (!valid)
+    {
+      MODIO_LOG("Cache store record at " + modio::toString((u32)offset) + " is damaged, dropping the rest of the log", MODIO_DEBUGLEVEL_WARNING);
+      data_end = offset;
+      writeHeader();
+      break;
+    }
+
+    u64 size = align8(getRecordSize(record));
+    dropEntry(record.key);
+    if (!(record.flags & MODIO_CACHE_RECORD_TOMBSTONE))
+      addEntry(record.key, offset, size, record.raw_size, record.datetime_millis, readTags(record, key));
+    offset += size;
+  }
+}
+
+bool CacheStore::append(u64 key, u32 flags, const std::string &key_string, const std::string &value, u64 raw_size, double datetime_millis, const std::vector<u32> &tags, u64 *offset)
+{
+  CacheRecordHeader record;
+  memset(&record, 0, sizeof(record));
+  record.magic = MODIO_CACHE_RECORD_MAGIC;
+  record.flags = flags;
+  record.key = key;
+  record.datetime_millis = datetime_millis;
+  record.key_size = (u32)key_string.size();
+  record.value_size = (u32)value.size();
+  record.raw_size = (u32)raw_size;
+  record.tag_count = (u32)tags.size();
+
+  u64 size = align8(getRecordSize(record));
+  if (!reserve(data_end + size))
+    return false;
+
+  // The CRC is computed over the record in place, once everything it covers is written
+  char *destination = mapped_data + data_end;
+  memcpy(destination + sizeof(record), key_string.c_str(), key_string.size());
+  memcpy(destination + sizeof(record) + key_string.size(), value.c_str(), value.size());
+  if (!tags.empty())
+    memcpy(destination + sizeof(record) + key_string.size() + value.size(), &tags[0], tags.size() * sizeof(u32));
+  record.crc = getRecordCrc(record, destination + sizeof(record));
+  memcpy(destination, &record, sizeof(record));
+
+  *offset = data_end;
+  data_end += size;
+  writeHeader();
+  return true;
+}
+
+bool CacheStore::keyMatches(const IndexEntry &entry, const std::string &key) const
+{
+  CacheRecordHeader record;
+  memcpy(&record, mapped_data + entry.offset, sizeof(record));
+  return record.key_size == key.size() && memcmp(mapped_data + entry.offset + sizeof(record), key.c_str(), key.size()) == 0;
+}
+
+void CacheStore::addEntry(u64 key, u64 offset, u64 size, u64 raw_size, double datetime_millis, const std::vector<u32> &tags)
+{
+  dropEntry(key);
+  recency.push_front(key);
+
+  IndexEntry entry;
+  entry.offset = offset;
+  entry.size = size;
+  entry.raw_size = raw_size;
+  entry.datetime_millis = datetime_millis;
+  entry.tags = tags;
+  entry.recency = recency.begin();
+  index[key] = entry;
+  for (auto tag : tags)
+    tagged[tag].push_back(key);
+  offsets[offset] = key;
+  live_bytes += size;
+  raw_bytes += raw_size;
+}
+
+void CacheStore::dropEntry(u64 key)
+{
+  auto it = index.find(key);
+  if (it == index.end())
+    return;
+  live_bytes -= it->second.size;
+  raw_bytes -= it->second.raw_size;
+  for (auto tag : it->second.tags)
+  {
+    std::vector<u64> &tagged_keys = tagged[tag];
+    tagged_keys.erase(std::find(tagged_keys.begin(), tagged_keys.end(), key));
+    if (tagged_keys.empty())
+      tagged.erase(tag);
+  }
+  offsets.erase(it->second.offset);
+  recency.erase(it->second.recency);
+  index.erase(it);
+}
+
+void CacheStore::dropEntries(const std::vector<u64> &keys)
+{
+  std::unordered_map<u64, u64> dropped_offsets;
+  for (auto key : keys)
+  {
+    auto it = index.find(key);
+    if (it == index.end())
+      continue;
+    dropped_offsets[it->second.offset] = key;
+    dropEntry(key);
+  }
+  if (dropped_offsets.empty())
+    return;
+
+  // Records before the oldest survivor are dropped by moving the start of the log, the
+  // ones behind it need a tombstone to stay dropped when the log is scanned again
+  data_begin = offsets.empty() ? data_end : offsets.begin()->first;
+  bool tombstones_written = true;
+  for (auto &dropped : dropped_offsets)
+  {
+    if (dropped.first < data_begin)
+      continue;
+
+    // The key string is copied out first, appending may remap the file
+    CacheRecordHeader record;
+    memcpy(&record, mapped_data + dropped.first, sizeof(record));
+    std::string key_string(mapped_data + dropped.first + sizeof(record), record.key_size);
+    u64 tombstone_offset;
+    if (!append(dropped.second, MODIO_CACHE_RECORD_TOMBSTONE, key_string, "", 0, modio::getCurrentTimeMillis(), std::vector<u32>(), &tombstone_offset))
+      tombstones_written = false;
+  }
+  writeHeader();
+
+  // Without room left for a tombstone only rewriting the live records keeps the dropped
+  // ones from coming back on the next open
+  if (!tombstones_written)
+    compact();
+}
+
+bool CacheStore::get(const std::string &key, u32 max_age_seconds, std::string &value, double *datetime_millis, std::vector<u32> *tags)
+{
+  if (!isOpen())
+    return false;
+
+  auto it = index.find(modio::hash64(key));
+  if (it == index.end() || !keyMatches(it->second, key))
+    return false;
+
+  if (modio::getCurrentTimeMillis() - it->second.datetime_millis > max_age_seconds * 1000.0)
+    return false;
+
+  CacheRecordHeader record;
+  memcpy(&record, mapped_data + it->second.offset, sizeof(record));
+  const char *stored_value = mapped_data + it->second.offset + sizeof(record) + record.key_size;
+  if (record.flags & MODIO_CACHE_RECORD_COMPRESSED)
+  {
+    value.resize(record.raw_size);
+    mz_ulong raw_size = record.raw_size;
+    if (mz_uncompress((unsigned char *)&value[0], &raw_size, (const unsigned char *)stored_value, record.value_size) != MZ_OK || raw_size != record.raw_size)
+    {
+      writeLogLine("Could not inflate a cache store record, dropping it", MODIO_DEBUGLEVEL_WARNING);
+      remove(key);
+      return false;
+    }
+  }
+  else
+  {
+    value.assign(stored_value, record.value_size);
+  }
+
+  recency.splice(recency.begin(), recency, it->second.recency);
+  if (datetime_millis)
+    *datetime_millis = record.datetime_millis;
+  if (tags)
+    *tags = it->second.tags;
+  return true;
+}
+
+bool CacheStore::put(const std::string &key, const std::string &value, double datetime_millis, const std::vector<u32> &tags)
+{
+  if (!isOpen())
+    return false;
+
+  u32 flags = 0;
+  std::string compressed_value;
+  if (value.size() >= MODIO_CACHE_COMPRESSION_MIN_BYTES)
+  {
+    mz_ulong compressed_size = mz_compressBound((mz_ulong)value.size());
+    compressed_value.resize(compressed_size);
+    // Responses are written on the request path, speed matters more than the last few bytes
+    if (mz_compress2((unsigned char *)&compressed_value[0], &compressed_size, (const unsigned char *)value.c_str(), (mz_ulong)value.size(), MZ_BEST_SPEED) == MZ_OK && compressed_size < value.size())
+    {
+      compressed_value.resize(compressed_size);
+      flags |= MODIO_CACHE_RECORD_COMPRESSED;
+    }
+  }
+  const std::string &stored_value = (flags & MODIO_CACHE_RECORD_COMPRESSED) ? compressed_value : value;
+
+  u64 size = align8(sizeof(CacheRecordHeader) + key.size() + stored_value.size() + tags.size() * sizeof(u32));
+  if (size > max_bytes)
+    return false;
+
+  // The file is capped near the budget, once the log reaches the cap room is made for the
+  // record and the dead records are dropped by compacting
+  if (data_end + size > getMaxFileSize(max_bytes))
+  {
+    evict(size);
+    if (data_end + size > getMaxFileSize(max_bytes) && !compact())
+      return false;
+  }
+
+  u64 hash = modio::hash64(key);
+  u64 offset;
+  if (!append(hash, flags, key, stored_value, value.size(), datetime_millis, tags, &offset))
+    return false;
+
+  addEntry(hash, offset, size, value.size(), datetime_millis, tags);
+  evict(0);
+  return true;
+}
+
+void CacheStore::remove(const std::string &key)
+{
+  if (!isOpen())
+    return;
+
+  auto it = index.find(modio::hash64(key));
+  if (it == index.end() || !keyMatches(it->second, key))
+    return;
+
+  dropEntries(std::vector<u64>(1, it->first));
+}
+
+std::vector<std::string> CacheStore::getTaggedKeys(u32 tag) const
+{
+  std::vector<std::string> keys;
+  auto it = tagged.find(tag);
+  if (it == tagged.end())
+    return keys;
+
+  for (auto key : it->second)
+  {
+    CacheRecordHeader record;
+    u64 offset = index.at(key).offset;
+    memcpy(&record, mapped_data + offset, sizeof(record));
+    keys.push_back(std::string(mapped_data + offset + sizeof(record), record.key_size));
+  }
+  return keys;
+}
+
+void CacheStore::removeTagged(u32 tag)
+{
+  auto it = tagged.find(tag);
+  if (it == tagged.end())
+    return;
+
+  // Copied, dropping the entries changes the tag list
+  dropEntries(std::vector<u64>(it->second));
+}
+
+void CacheStore::removeOlderThan(double datetime_millis)
+{
+  if (!isOpen())
+    return;
+
+  std::vector<u64> expired_keys;
+  for (auto &entry : index)
+  {
+    if (entry.second.datetime_millis < datetime_millis)
+      expired_keys.push_back(entry.first);
+  }
+  dropEntries(expired_keys);
+}
+
+void CacheStore::clear()
+{
+  if (!isOpen())
+    return;
+
+  index.clear();
+  offsets.clear();
+  recency.clear();
+  tagged.clear();
+  live_bytes = 0;
+  raw_bytes = 0;
+  data_begin = data_end = MODIO_CACHE_DATA_OFFSET;
+  writeHeader();
+}
+
+void CacheStore::setMaxBytes(u64 max_bytes_)
+{
+  max_bytes = max_bytes_;
+  evict(0);
+}
+
+void CacheStore::evict(u64 incoming_bytes)
+{
+  MODIO_TRACE_SCOPE("evict", "cache store");
+  if (!isOpen() || live_bytes + incoming_bytes <= max_bytes)
+    return;
+
+  // Least recently read records go first
+  std::vector<u64> evicted_keys;
+  u64 evicted_bytes = 0;
+  for (auto it = recency.rbegin(); it != recency.rend() && live_bytes + incoming_bytes - evicted_bytes > max_bytes; ++it)
+  {
+    evicted_keys.push_back(*it);
+    evicted_bytes += index[*it].size;
+  }
+  evictions += evicted_keys.size();
+  dropEntries(evicted_keys);
+}
+
+bool CacheStore::needsCompaction() const
+{
+  if (!isOpen())
+    return false;
+  u64 log_bytes = data_end - MODIO_CACHE_DATA_OFFSET;
+  u64 dead_bytes = log_bytes - live_bytes;
+  return dead_bytes >= getMinCompactionBytes(max_bytes) && (dead_bytes > live_bytes || log_bytes > max_bytes);
+}
+
+bool CacheStore::compact()
+{
+  MODIO_TRACE_SCOPE("compact", "cache store");
+  if (!isOpen())
+    return false;
+
+  std::string compacted_path = path + ".tmp";
+  std::ofstream compacted_file(compacted_path, std::ios::binary | std::ios::trunc);
+  if (!compacted_file.is_open())
+    return false;
+
+  std::vector<char> header_region(MODIO_CACHE_DATA_OFFSET, 0);
+  compacted_file.write(header_region.data(), header_region.size());
+
+  // Records are position independent and are copied as they are, CRCs included
+  u64 compacted_end = MODIO_CACHE_DATA_OFFSET;
+  for (auto &offset : offsets)
+  {
+    const IndexEntry &entry = index[offset.second];
+    compacted_file.write(mapped_data + entry.offset, entry.size);
+    compacted_end += entry.size;
+  }
+
+  CacheStoreHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = MODIO_CACHE_STORE_MAGIC;
+  header.version = MODIO_CACHE_STORE_VERSION;
+  header.generation = 1;
+  header.data_begin = MODIO_CACHE_DATA_OFFSET;
+  header.data_end = compacted_end;
+  header.crc = getHeaderCrc(header);
+  compacted_file.seekp(MODIO_CACHE_HEADER_SLOT_SIZE);
+  compacted_file.write((const char *)&header, sizeof(header));
+  compacted_file.close();
+
+  if (compacted_file.fail())
+  {
+    modio::removeFile(compacted_path);
+    return false;
+  }
+
+  u64 previous_file_bytes = mapped_size;
+  std::list<u64> previous_recency = recency;
+  close();
+  // The rename is atomic, a crash leaves either the old or the compacted store behind
+#ifdef MODIO_WINDOWS_DETECTED
+  wchar_t *compacted_path_wc = modio::WideCharFromString(compacted_path);
+  wchar_t *path_wc = modio::WideCharFromString(path);
+  bool renamed = MoveFileExW(compacted_path_wc, path_wc, MOVEFILE_REPLACE_EXISTING) != 0;
+  free(compacted_path_wc);
+  free(path_wc);
+#else
+  bool renamed = rename(compacted_path.c_str(), path.c_str()) == 0;
+#endif
+  if (!renamed)
+    modio::removeFile(compacted_path);
+
+  bool opened = open(path, max_bytes);
+  // Reopening orders the records by age, restore the order they were read in
+  for (auto it = previous_recency.rbegin(); opened && it != previous_recency.rend(); ++it)
+  {
+    auto entry = index.find(*it);
+    if (entry != index.end())
+      recency.splice(recency.begin(), recency, entry->second.recency);
+  }
+  if (opened)
+    MODIO_LOG("Cache store compacted from " + modio::toString((u32)(previous_file_bytes / 1024)) + " KiB to " + modio::toString((u32)(data_end / 1024)) + " KiB", MODIO_DEBUGLEVEL_LOG);
+  return renamed && opened;
+}
+
+u32 CacheStore::getRecordCount() const
+{
+  return (u32)index.size();
+}
+
+u64 CacheStore::getLiveBytes() const
+{
+  return live_bytes;
+}
+
+u64 CacheStore::getRawBytes() const
+{
+  return raw_bytes;
+}
+
+u64 CacheStore::getFileBytes() const
+{
+  return mapped_size;
+}
+
+u64 CacheStore::getEvictionCount() const
+{
+  return evictions;
+}
+} // namespace modio
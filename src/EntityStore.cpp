@@ -0,0 +1,157 @@
+#include "EntityStore.h"
+
+namespace modio
+{
+EntityTable::EntityTable(u32 max_entities_)
+  : max_entities(max_entities_)
+{
+}
+
+void EntityTable::put(u32 id, u32 date_updated, double datetime_millis, const nlohmann::json &entity_json)
+{
+  auto it = index.find(id);
+  if (it != index.end())
+  {
+    if (it->second->date_updated > date_updated)
+      return;
+    entities.erase(it->second);
+    index.erase(it);
+  }
+
+  Entity entity;
+  entity.id = id;
+  entity.date_updated = date_updated;
+  entity.datetime_millis = datetime_millis;
+  entity.entity_json = entity_json;
+  entities.push_front(entity);
+  index[id] = entities.begin();
+
+  while (entities.size() > max_entities)
+  {
+    index.erase(entities.back().id);
+    entities.pop_back();
+  }
+}
+
+bool EntityTable::get(u32 id, u32 max_age_seconds, nlohmann::json &entity_json)
+{
+  auto it = index.find(id);
+  if (it == index.end())
+    return false;
+
+  if (modio::getCurrentTimeMillis() - it->second->datetime_millis > max_age_seconds * 1000.0)
+    return false;
+
+  entities.splice(entities.begin(), entities, it->second);
+  entity_json = it->second->entity_json;
+  return true;
+}
+
+void EntityTable::invalidate(u32 id, u32 date_changed)
+{
+  auto it = index.find(id);
+  if (it != index.end() && it->second->date_updated < date_changed)
+    remove(id);
+}
+
+void EntityTable::remove(u32 id)
+{
+  auto it = index.find(id);
+  if (it == index.end())
+    return;
+
+  entities.erase(it->second);
+  index.erase(it);
+}
+
+void EntityTable::clear()
+{
+  entities.clear();
+  index.clear();
+}
+
+u32 EntityTable::getCount() const
+{
+  return (u32)entities.size();
+}
+
+EntityStore::EntityStore()
+  : mods(MODIO_ENTITY_STORE_MAX_ENTITIES), modfiles(MODIO_ENTITY_STORE_MAX_ENTITIES)
+{
+}
+
+void EntityStore::putMod(const nlohmann::json &mod_json, double datetime_millis)
+{
+  if (!modio::hasKey(mod_json, "id") || !modio::hasKey(mod_json, "date_updated"))
+    return;
+
+  mods.put(mod_json["id"], mod_json["date_updated"], datetime_millis, mod_json);
+
+  if (modio::hasKey(mod_json, "modfile"))
+    putModfile(mod_json["modfile"], datetime_millis);
+}
+
+void EntityStore::putModfile(const nlohmann::json &modfile_json, double datetime_millis)
+{
+  if (!modio::hasKey(modfile_json, "id") || !modio::hasKey(modfile_json, "date_added"))
+    return;
+
+  modfiles.put(modfile_json["id"], modfile_json["date_added"], datetime_millis, modfile_json);
+}
+
+bool EntityStore::getMod(u32 mod_id, u32 max_age_seconds, nlohmann::json &mod_json)
+{
+  return mods.get(mod_id, max_age_seconds, mod_json);
+}
+
+bool EntityStore::getModfile(u32 modfile_id, u32 max_age_seconds, nlohmann::json &modfile_json)
+{
+  return modfiles.get(modfile_id, max_age_seconds, modfile_json);
+}
+
+void EntityStore::invalidateMod(u32 mod_id, u32 date_changed)
+{
+  mods.invalidate(mod_id, date_changed);
+}
+
+void EntityStore::removeMod(u32 mod_id)
+{
+  mods.remove(mod_id);
+}
+
+void EntityStore::setInstalledMod(u32 mod_id, const nlohmann::json &mod_json)
+{
+  installed_mods[mod_id] = mod_json;
+}
+
+bool EntityStore::getInstalledMod(u32 mod_id, nlohmann::json &mod_json) const
+{
+  auto it = installed_mods.find(mod_id);
+  if (it == installed_mods.end())
+    return false;
+
+  mod_json = it->second;
+  return true;
+}
+
+void EntityStore::clearInstalledMods()
+{
+  installed_mods.clear();
+}
+
+void EntityStore::clear()
+{
+  mods.clear();
+  modfiles.clear();
+}
+
+u32 EntityStore::getModCount() const
+{
+  return mods.getCount();
+}
+
+u32 EntityStore::getModfileCount() const
+{
+  return modfiles.getCount();
+}
+} // namespace modio
@@ -20,5 +20,8 @@ namespace modio
   void (*upload_callback)(u32 response_code, u32 mod_id) = NULL;
   u32 AUTOMATIC_UPDATES = 0;
   u32 BACKGROUND_DOWNLOADS = 0;
-  nlohmann::json installed_mods;
+  u32 BINARY_CACHE = 0;
+  u32 LAZY_FIELDS = 0;
+  u32 CACHE_MAX_BYTES = 33554432;
+  u32 PREFETCH_BUDGET = 0;
 }
@@ -0,0 +1,101 @@
+#include "InstalledModRegistry.h"
+
+namespace modio
+{
+InstalledModRegistry::InstalledModRegistry()
+  : dirty(false)
+{
+}
+
+void InstalledModRegistry::put(u32 mod_id, const std::string &path, u32 modfile_id, u32 date_updated, const FileFingerprint &fingerprint)
+{
+  dirty = true;
+
+  auto range = index.equal_range(mod_id);
+  for (auto it = range.first; it != range.second; it++)
+  {
+    InstalledModRecord &record = records[it->second];
+    if (record.path == path)
+    {
+      record.modfile_id = modfile_id;
+      record.date_updated = date_updated;
+      record.fingerprint = fingerprint;
+      return;
+    }
+  }
+
+  InstalledModRecord record;
+  record.mod_id = mod_id;
+  record.modfile_id = modfile_id;
+  record.date_updated = date_updated;
+  record.path = path;
+  record.fingerprint = fingerprint;
+  index.insert(std::make_pair(mod_id, (u32)records.size()));
+  records.push_back(record);
+}
+
+const InstalledModRecord *InstalledModRegistry::find(u32 mod_id) const
+{
+  // The multimap keeps no order between the records of a mod, the first installed wins
+  const InstalledModRecord *first_record = NULL;
+  auto range = index.equal_range(mod_id);
+  for (auto it = range.first; it != range.second; it++)
+  {
+    if (!first_record || &records[it->second] < first_record)
+      first_record = &records[it->second];
+  }
+  return first_record;
+}
+
+const std::vector<InstalledModRecord> &InstalledModRegistry::getRecords() const
+{
+  return records;
+}
+
+u32 InstalledModRegistry::getCount() const
+{
+  return (u32)records.size();
+}
+
+void InstalledModRegistry::clear()
+{
+  dirty = dirty || !records.empty();
+  records.clear();
+  index.clear();
+}
+
+bool InstalledModRegistry::isDirty() const
+{
+  return dirty;
+}
+
+void InstalledModRegistry::markClean()
+{
+  dirty = false;
+}
+
+void InstalledModRegistry::write(const std::string &file_path)
+{
+  nlohmann::json installed_mods_json = nlohmann::json::array();
+  for (auto &record : records)
+    installed_mods_json.push_back(toJson(record));
+  modio::writeJson(file_path, installed_mods_json);
+  dirty = false;
+}
+
+nlohmann::json toJson(const InstalledModRecord &installed_mod)
+{
+  nlohmann::json installed_mod_json;
+  installed_mod_json["path"] = installed_mod.path;
+  installed_mod_json["mod_id"] = installed_mod.mod_id;
+  installed_mod_json["modfile_id"] = installed_mod.modfile_id;
+  installed_mod_json["date_updated"] = installed_mod.date_updated;
+  if (installed_mod.fingerprint.modified_time != 0)
+  {
+    installed_mod_json["fingerprint"]["directory_id"] = installed_mod.fingerprint.directory_id;
+    installed_mod_json["fingerprint"]["modified_time"] = installed_mod.fingerprint.modified_time;
+    installed_mod_json["fingerprint"]["size"] = installed_mod.fingerprint.size;
+  }
+  return installed_mod_json;
+}
+} // namespace modio
@@ -0,0 +1,801 @@
+#include "JsonParser.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MODIO_JSON_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles the intrinsics of any instruction set, gcc and clang only inside functions
+// marked for it, which keeps the rest of the SDK buildable for the baseline cpu
+#if defined(__GNUC__) || defined(__clang__)
+#define MODIO_JSON_TARGET(features) __attribute__((target(features)))
+#else
+#define MODIO_JSON_TARGET(features)
+#endif
+
+namespace modio
+{
+#define MODIO_JSON_CLASS_QUOTE 1
+#define MODIO_JSON_CLASS_BACKSLASH 2
+#define MODIO_JSON_CLASS_OP 4
+#define MODIO_JSON_CLASS_WHITESPACE 8
+#define MODIO_JSON_CLASS_CONTROL 16
+#define MODIO_JSON_CLASS_NON_ASCII 32
+
+// One bit per byte of a 64 byte block
+struct JsonBlockMasks
+{
+  u64 quote;
+  u64 backslash;
+  // { } [ ] : ,
+  u64 op;
+  u64 whitespace;
+  // Bytes below 0x20, not allowed raw inside strings
+  u64 control;
+  u64 non_ascii;
+};
+
+typedef void (*ClassifyJsonBlock)(const char *block, JsonBlockMasks &masks);
+
+struct JsonCharClasses
+{
+  unsigned char classes[256];
+
+  JsonCharClasses()
+  {
+    for (u32 c = 0; c < 256; c++)
+    {
+      unsigned char char_class = 0;
+      if (c == '"')
+        char_class |= MODIO_JSON_CLASS_QUOTE;
+      if (c == '\\')
+        char_class |= MODIO_JSON_CLASS_BACKSLASH;
+      if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',')
+        char_class |= MODIO_JSON_CLASS_OP;
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        char_class |= MODIO_JSON_CLASS_WHITESPACE;
+      if (c < 0x20)
+        char_class |= MODIO_JSON_CLASS_CONTROL;
+      if (c >= 0x80)
+        char_class |= MODIO_JSON_CLASS_NON_ASCII;
+      classes[c] = char_class;
+    }
+  }
+};
+
+static void classifyBlockScalar(const char *block, JsonBlockMasks &masks)
+{
+  static const JsonCharClasses char_classes;
+  memset(&masks, 0, sizeof(masks));
+  for (u32 i = 0; i < 64; i++)
+  {
+    unsigned char char_class = char_classes.classes[(unsigned char)block[i]];
+    if (!char_class)
+      continue;
+    u64 bit = (u64)1 << i;
+    if (char_class & MODIO_JSON_CLASS_QUOTE)
+      masks.quote |= bit;
+    if (char_class & MODIO_JSON_CLASS_BACKSLASH)
+      masks.backslash |= bit;
+    if (char_class & MODIO_JSON_CLASS_OP)
+      masks.op |= bit;
+    if (char_class & MODIO_JSON_CLASS_WHITESPACE)
+      masks.whitespace |= bit;
+    if (char_class & MODIO_JSON_CLASS_CONTROL)
+      masks.control |= bit;
+    if (char_class & MODIO_JSON_CLASS_NON_ASCII)
+      masks.non_ascii |= bit;
+  }
+}
+
+#ifdef MODIO_JSON_SIMD
+MODIO_JSON_TARGET("sse4.2")
+static void classifyBlockSse42(const char *block, JsonBlockMasks &masks)
+{
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control_max = _mm_set1_epi8(0x1F);
+  // pcmpestrm matches every byte against a set of up to 16 characters at once
+  const __m128i op_set = _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i whitespace_set = _mm_setr_epi8(' ', '\t', '\n', '\r', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const int set_mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+
+  memset(&masks, 0, sizeof(masks));
+  for (u32 i = 0; i < 64; i += 16)
+  {
+    __m128i chunk = _mm_loadu_si128((const __m128i *)(block + i));
+    masks.quote |= (u64)(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+    masks.backslash |= (u64)(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) << i;
+    masks.op |= (u64)(u32)_mm_cvtsi128_si32(_mm_cmpestrm(op_set, 6, chunk, 16, set_mode)) << i;
+    masks.whitespace |= (u64)(u32)_mm_cvtsi128_si32(_mm_cmpestrm(whitespace_set, 4, chunk, 16, set_mode)) << i;
+    masks.control |= (u64)(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk)) << i;
+    masks.non_ascii |= (u64)(u32)_mm_movemask_epi8(chunk) << i;
+  }
+}
+
+MODIO_JSON_TARGET("avx2")
+static void classifyBlockAvx2(const char *block, JsonBlockMasks &masks)
+{
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i control_max = _mm256_set1_epi8(0x1F);
+  const __m256i lower_case_bit = _mm256_set1_epi8(0x20);
+  const __m256i open_brace = _mm256_set1_epi8('{');
+  const __m256i close_brace = _mm256_set1_epi8('}');
+  const __m256i colon = _mm256_set1_epi8(':');
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i line_feed = _mm256_set1_epi8('\n');
+  const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+  for (u32 i = 0; i < 64; i += 32)
+  {
+    __m256i chunk = _mm256_loadu_si256((const __m256i *)(block + i));
+    // [ and ] are { and } without the 0x20 bit
+    __m256i braces = _mm256_or_si256(chunk, lower_case_bit);
+    __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(braces, open_brace), _mm256_cmpeq_epi8(braces, close_brace)),
+                                 _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+    __m256i whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(chunk, line_feed), _mm256_cmpeq_epi8(chunk, carriage_return)));
+
+    u64 quote_bits = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote));
+    u64 backslash_bits = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash));
+    u64 op_bits = (u32)_mm256_movemask_epi8(op);
+    u64 whitespace_bits = (u32)_mm256_movemask_epi8(whitespace);
+    u64 control_bits = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control_max), chunk));
+    u64 non_ascii_bits = (u32)_mm256_movemask_epi8(chunk);
+    if (i == 0)
+    {
+      masks.quote = quote_bits;
+      masks.backslash = backslash_bits;
+      masks.op = op_bits;
+      masks.whitespace = whitespace_bits;
+      masks.control = control_bits;
+      masks.non_ascii = non_ascii_bits;
+    }
+    else
+    {
+      masks.quote |= quote_bits << 32;
+      masks.backslash |= backslash_bits << 32;
+      masks.op |= op_bits << 32;
+      masks.whitespace |= whitespace_bits << 32;
+      masks.control |= control_bits << 32;
+      masks.non_ascii |= non_ascii_bits << 32;
+    }
+  }
+}
+#endif
+
+static u32 getBestJsonBackend()
+{
+#ifdef MODIO_JSON_SIMD
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return MODIO_JSON_BACKEND_AVX2;
+  if (__builtin_cpu_supports("sse4.2"))
+    return MODIO_JSON_BACKEND_SSE42;
+#elif defined(_MSC_VER)
+  int cpu_info[4];
+  __cpuid(cpu_info, 0);
+  int max_leaf = cpu_info[0];
+  __cpuid(cpu_info, 1);
+  bool sse42 = (cpu_info[2] & (1 << 20)) != 0;
+  // AVX state has to be enabled by the os as well, checked through xgetbv
+  bool os_avx = (cpu_info[2] & (1 << 27)) != 0 && (cpu_info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+  if (os_avx && max_leaf >= 7)
+  {
+    __cpuidex(cpu_info, 7, 0);
+    if (cpu_info[1] & (1 << 5))
+      return MODIO_JSON_BACKEND_AVX2;
+  }
+  if (sse42)
+    return MODIO_JSON_BACKEND_SSE42;
+#endif
+#endif
+  return MODIO_JSON_BACKEND_SCALAR;
+}
+
+static u32 g_best_json_backend = getBestJsonBackend();
+static u32 g_json_backend = g_best_json_backend;
+
+static ClassifyJsonBlock getClassifyJsonBlock(u32 backend)
+{
+#ifdef MODIO_JSON_SIMD
+  if (backend == MODIO_JSON_BACKEND_AVX2)
+    return classifyBlockAvx2;
+  if (backend == MODIO_JSON_BACKEND_SSE42)
+    return classifyBlockSse42;
+#endif
+  return classifyBlockScalar;
+}
+
+static u32 countTrailingZeros(u64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (u32)__builtin_ctzll(bits);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return (u32)index;
+#else
+  u32 count = 0;
+  while (!(bits & 1))
+  {
+    bits >>= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+// Bit i set when an odd number of bits at or below i are set, marks the bytes from an
+// opening quote up to, not including, the closing one
+static u64 getPrefixXor(u64 bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// Backslashes are rare, so they are walked one by one. A backslash not escaped itself
+// escapes the byte after it, possibly the first byte of the next block.
+static u64 getEscaped(u64 backslash, u64 &next_block_escaped)
+{
+  u64 escaped = next_block_escaped;
+  next_block_escaped = 0;
+  backslash &= ~escaped;
+  while (backslash)
+  {
+    u64 lowest = backslash & (0 - backslash);
+    u64 next = lowest << 1;
+    if (!next)
+      next_block_escaped = 1;
+    escaped |= next;
+    backslash &= ~(lowest | next);
+  }
+  return escaped;
+}
+
+// Stage one, the positions of the operators outside strings and of the first byte of
+// every string and scalar value, followed by json_str_size
+static bool indexStructurals(ClassifyJsonBlock classify, const char *json_str, size_t json_str_size, std::vector<u32> &structurals, bool &non_ascii)
+{
+  u64 next_block_escaped = 0;
+  u64 previous_in_string = 0;
+  u64 previous_scalar = 0;
+  u64 errors = 0;
+  u64 non_ascii_bits = 0;
+  size_t structurals_size = 0;
+  char padded_block[64];
+
+  structurals.resize(json_str_size / 8 + 64);
+  for (size_t block_start = 0; block_start < json_str_size; block_start += 64)
+  {
+    const char *block = json_str + block_start;
+    if (json_str_size - block_start < 64)
+    {
+      // The tail is padded with whitespace, which never adds a structural
+      memset(padded_block, ' ', sizeof(padded_block));
+      memcpy(padded_block, block, json_str_size - block_start);
+      block = padded_block;
+    }
+
+    JsonBlockMasks masks;
+    classify(block, masks);
+
+    u64 quote = masks.quote & ~getEscaped(masks.backslash, next_block_escaped);
+    u64 in_string = getPrefixXor(quote) ^ previous_in_string;
+    previous_in_string = 0 - (in_string >> 63);
+    // Inside a string, the closing quote included and the opening one left out
+    u64 string_tail = in_string ^ quote;
+
+    // A scalar starts on any byte that is no operator or whitespace and does not follow
+    // another such byte, strings start on their opening quote the same way
+    u64 scalar = ~(masks.op | masks.whitespace);
+    u64 nonquote_scalar = scalar & ~quote;
+    u64 follows_nonquote_scalar = (nonquote_scalar << 1) | previous_scalar;
+    previous_scalar = nonquote_scalar >> 63;
+    u64 block_structurals = (masks.op | (scalar & ~follows_nonquote_scalar)) & ~string_tail;
+
+    errors |= masks.control & in_string;
+    non_ascii_bits |= masks.non_ascii;
+
+    if (structurals_size + 64 > structurals.size())
+      structurals.resize(structurals.size() * 2 + 64);
+    u32 *structural = &structurals[structurals_size];
+    while (block_structurals)
+    {
+      *structural++ = (u32)(block_start + countTrailingZeros(block_structurals));
+      block_structurals &= block_structurals - 1;
+    }
+    structurals_size = structural - &structurals[0];
+  }
+
+  // An unterminated string, or raw control characters inside one
+  if (previous_in_string || errors)
+    return false;
+
+  structurals.resize(structurals_size + 1);
+  structurals[structurals_size] = (u32)json_str_size;
+  non_ascii = non_ascii_bits != 0;
+  return true;
+}
+
+static bool isJsonWhitespace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+static bool isInRange(const unsigned char *&byte, const unsigned char *end, unsigned char min, unsigned char max)
+{
+  if (byte == end || *byte < min || *byte > max)
+    return false;
+  byte++;
+  return true;
+}
+
+// Same well-formed UTF-8 ranges nlohmann checks for
+static bool isValidUtf8(const char *str, size_t str_size)
+{
+  const unsigned char *byte = (const unsigned char *)str;
+  const unsigned char *end = byte + str_size;
+  while (byte != end)
+  {
+    unsigned char lead = *byte++;
+    if (lead < 0x80)
+      continue;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+      if (!isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if (lead == 0xE0)
+    {
+      if (!isInRange(byte, end, 0xA0, 0xBF) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if ((lead >= 0xE1 && lead <= 0xEC) || lead == 0xEE || lead == 0xEF)
+    {
+      if (!isInRange(byte, end, 0x80, 0xBF) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if (lead == 0xED)
+    {
+      if (!isInRange(byte, end, 0x80, 0x9F) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if (lead == 0xF0)
+    {
+      if (!isInRange(byte, end, 0x90, 0xBF) || !isInRange(byte, end, 0x80, 0xBF) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if (lead >= 0xF1 && lead <= 0xF3)
+    {
+      if (!isInRange(byte, end, 0x80, 0xBF) || !isInRange(byte, end, 0x80, 0xBF) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else if (lead == 0xF4)
+    {
+      if (!isInRange(byte, end, 0x80, 0x8F) || !isInRange(byte, end, 0x80, 0xBF) || !isInRange(byte, end, 0x80, 0xBF))
+        return false;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool readHex4(const char *digits, u32 &value)
+{
+  value = 0;
+  for (u32 i = 0; i < 4; i++)
+  {
+    char c = digits[i];
+    value <<= 4;
+    if (c >= '0' && c <= '9')
+      value |= (u32)(c - '0');
+    else if (c >= 'a' && c <= 'f')
+      value |= (u32)(c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      value |= (u32)(c - 'A' + 10);
+    else
+      return false;
+  }
+  return true;
+}
+
+static void appendUtf8(std::string &str, u32 codepoint)
+{
+  if (codepoint < 0x80)
+  {
+    str += (char)codepoint;
+  }
+  else if (codepoint < 0x800)
+  {
+    str += (char)(0xC0 | (codepoint >> 6));
+    str += (char)(0x80 | (codepoint & 0x3F));
+  }
+  else if (codepoint < 0x10000)
+  {
+    str += (char)(0xE0 | (codepoint >> 12));
+    str += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    str += (char)(0x80 | (codepoint & 0x3F));
+  }
+  else
+  {
+    str += (char)(0xF0 | (codepoint >> 18));
+    str += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+    str += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+    str += (char)(0x80 | (codepoint & 0x3F));
+  }
+}
+
+// Stage two, a recursive descent over the structural index
+class StructuralParser
+{
+public:
+  StructuralParser(const char *json_str, const std::vector<u32> &structurals, bool validate_utf8)
+    : json_str(json_str), structurals(&structurals[0]), structurals_size((u32)structurals.size() - 1), validate_utf8(validate_utf8), index(0)
+  {
+  }
+
+  bool parseDocument(nlohmann::json &json)
+  {
+    return parseValue(json, 0) && index == structurals_size;
+  }
+
+private:
+  const char *json_str;
+  const u32 *structurals;
+  u32 structurals_size;
+  bool validate_utf8;
+  u32 index;
+
+  bool consume(char op)
+  {
+    if (index < structurals_size && json_str[structurals[index]] == op)
+    {
+      index++;
+      return true;
+    }
+    return false;
+  }
+
+  // Only whitespace may sit between the end of a scalar and the next structural
+  bool isTokenEnd(u32 end)
+  {
+    for (u32 position = end; position < structurals[index]; position++)
+    {
+      if (!isJsonWhitespace(json_str[position]))
+        return false;
+    }
+    return true;
+  }
+
+  bool parseValue(nlohmann::json &value, u32 depth)
+  {
+    if (index >= structurals_size)
+      return false;
+
+    u32 start = structurals[index++];
+    switch (json_str[start])
+    {
+    case '{':
+      return parseObject(value, depth);
+    case '[':
+      return parseArray(value, depth);
+    case '"':
+      value = nlohmann::json::value_t::string;
+      return parseString(start, *value.get_ptr<std::string *>());
+    case 't':
+      value = true;
+      return parseLiteral(start, "true", 4);
+    case 'f':
+      value = false;
+      return parseLiteral(start, "false", 5);
+    case 'n':
+      value = nullptr;
+      return parseLiteral(start, "null", 4);
+    default:
+      return parseNumber(start, value);
+    }
+  }
+
+  bool parseObject(nlohmann::json &value, u32 depth)
+  {
+    if (depth >= MODIO_JSON_MAX_DEPTH)
+      return false;
+
+    value = nlohmann::json::value_t::object;
+    nlohmann::json::object_t &members = *value.get_ptr<nlohmann::json::object_t *>();
+    if (consume('}'))
+      return true;
+
+    std::string key;
+    while (true)
+    {
+      if (index >= structurals_size || json_str[structurals[index]] != '"')
+        return false;
+      key.clear();
+      if (!parseString(structurals[index++], key) || !consume(':'))
+        return false;
+      // A repeated key keeps the first value, like nlohmann
+      std::pair<nlohmann::json::object_t::iterator, bool> member = members.emplace(std::move(key), nlohmann::json());
+      if (member.second)
+      {
+        if (!parseValue(member.first->second, depth + 1))
+          return false;
+      }
+      else
+      {
+        nlohmann::json repeated_value;
+        if (!parseValue(repeated_value, depth + 1))
+          return false;
+      }
+      if (!consume(','))
+        return consume('}');
+    }
+  }
+
+  bool parseArray(nlohmann::json &value, u32 depth)
+  {
+    if (depth >= MODIO_JSON_MAX_DEPTH)
+      return false;
+
+    value = nlohmann::json::value_t::array;
+    nlohmann::json::array_t &elements = *value.get_ptr<nlohmann::json::array_t *>();
+    if (consume(']'))
+      return true;
+
+    while (true)
+    {
+      elements.emplace_back();
+      if (!parseValue(elements.back(), depth + 1))
+        return false;
+      if (!consume(','))
+        return consume(']');
+    }
+  }
+
+  bool parseString(u32 start, std::string &str)
+  {
+    // The closing quote is the last byte before the next structural that is not
+    // whitespace, stage one already made sure the string is terminated
+    u32 end = structurals[index];
+    while (end > start + 1 && isJsonWhitespace(json_str[end - 1]))
+      end--;
+    if (end <= start + 1 || json_str[end - 1] != '"')
+      return false;
+
+    const char *chars = json_str + start + 1;
+    const char *chars_end = json_str + end - 1;
+    if (validate_utf8 && !isValidUtf8(chars, chars_end - chars))
+      return false;
+
+    const char *escape = (const char *)memchr(chars, '\\', chars_end - chars);
+    if (!escape)
+    {
+      str.assign(chars, chars_end - chars);
+      return true;
+    }
+
+    str.reserve(chars_end - chars);
+    while (escape)
+    {
+      str.append(chars, escape - chars);
+      chars = escape + 1;
+      if (chars == chars_end)
+        return false;
+      switch (*chars++)
+      {
+      case '"':
+        str += '"';
+        break;
+      case '\\':
+        str += '\\';
+        break;
+      case '/':
+        str += '/';
+        break;
+      case 'b':
+        str += '\b';
+        break;
+      case 'f':
+        str += '\f';
+        break;
+      case 'n':
+        str += '\n';
+        break;
+      case 'r':
+        str += '\r';
+        break;
+      case 't':
+        str += '\t';
+        break;
+      case 'u':
+      {
+        u32 codepoint;
+        if (chars_end - chars < 4 || !readHex4(chars, codepoint))
+          return false;
+        chars += 4;
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+        {
+          // A high surrogate has to be followed by an escaped low one
+          u32 low_surrogate;
+          if (chars_end - chars < 6 || chars[0] != '\\' || chars[1] != 'u' || !readHex4(chars + 2, low_surrogate) || low_surrogate < 0xDC00 || low_surrogate > 0xDFFF)
+            return false;
+          chars += 6;
+          codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low_surrogate - 0xDC00);
+        }
+        else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+        {
+          return false;
+        }
+        appendUtf8(str, codepoint);
+        break;
+      }
+      default:
+        return false;
+      }
+      escape = (const char *)memchr(chars, '\\', chars_end - chars);
+    }
+    str.append(chars, chars_end - chars);
+    return true;
+  }
+
+  bool parseLiteral(u32 start, const char *literal, u32 literal_size)
+  {
+    return structurals[index] - start >= literal_size && memcmp(json_str + start, literal, literal_size) == 0 && isTokenEnd(start + literal_size);
+  }
+
+  bool parseNumber(u32 start, nlohmann::json &value)
+  {
+    const char *number = json_str + start;
+    const char *limit = json_str + structurals[index];
+    const char *digit = number;
+
+    bool negative = *digit == '-';
+    if (negative)
+      digit++;
+    if (digit == limit || !isDigit(*digit))
+      return false;
+
+    // Integers are read on the way, up to the first digit that would overflow
+    u64 magnitude = 0;
+    bool overflow = false;
+    if (*digit == '0')
+    {
+      digit++;
+    }
+    else
+    {
+      while (digit != limit && isDigit(*digit))
+      {
+        u64 digit_value = (u64)(*digit - '0');
+        if (magnitude > (~(u64)0 - digit_value) / 10)
+          overflow = true;
+        magnitude = magnitude * 10 + digit_value;
+        digit++;
+      }
+    }
+
+    bool is_float = false;
+    if (digit != limit && *digit == '.')
+    {
+      digit++;
+      if (digit == limit || !isDigit(*digit))
+        return false;
+      while (digit != limit && isDigit(*digit))
+        digit++;
+      is_float = true;
+    }
+    if (digit != limit && (*digit == 'e' || *digit == 'E'))
+    {
+      digit++;
+      if (digit != limit && (*digit == '+' || *digit == '-'))
+        digit++;
+      if (digit == limit || !isDigit(*digit))
+        return false;
+      while (digit != limit && isDigit(*digit))
+        digit++;
+      is_float = true;
+    }
+    if (!isTokenEnd((u32)(digit - json_str)))
+      return false;
+
+    // Integers that do not fit are stored as floats, like nlohmann does
+    if (!is_float && !overflow)
+    {
+      if (!negative)
+      {
+        value = (nlohmann::json::number_unsigned_t)magnitude;
+        return true;
+      }
+      if (magnitude <= (u64)1 << 63)
+      {
+        value = (nlohmann::json::number_integer_t)(0 - magnitude);
+        return true;
+      }
+    }
+
+    // strtod needs a terminated copy. It follows the C locale, a game that changed the
+    // decimal point gets the nlohmann path, which accounts for it.
+    std::string number_str(number, digit - number);
+    char *number_end = NULL;
+    double number_value = strtod(number_str.c_str(), &number_end);
+    if (number_end != number_str.c_str() + number_str.size() || !std::isfinite(number_value))
+      return false;
+    value = number_value;
+    return true;
+  }
+};
+
+bool parseJson(const char *json_str, size_t json_str_size, nlohmann::json &json)
+{
+  // Positions are kept as u32
+  if (json_str_size == 0 || json_str_size >= 0xFFFFFFFF)
+    return false;
+
+  // nlohmann skips a leading byte order mark as well
+  if (json_str_size >= 3 && memcmp(json_str, "\xEF\xBB\xBF", 3) == 0)
+  {
+    json_str += 3;
+    json_str_size -= 3;
+    if (json_str_size == 0)
+      return false;
+  }
+
+  std::vector<u32> structurals;
+  bool non_ascii = false;
+  if (!indexStructurals(getClassifyJsonBlock(g_json_backend), json_str, json_str_size, structurals, non_ascii))
+    return false;
+
+  StructuralParser parser(json_str, structurals, non_ascii);
+  return parser.parseDocument(json);
+}
+
+u32 getJsonBackend()
+{
+  return g_json_backend;
+}
+
+const char *getJsonBackendName(u32 backend)
+{
+  switch (backend)
+  {
+  case MODIO_JSON_BACKEND_AVX2:
+    return "AVX2";
+  case MODIO_JSON_BACKEND_SSE42:
+    return "SSE4.2";
+  default:
+    return "scalar";
+  }
+}
+
+void setJsonBackend(u32 backend)
+{
+  g_json_backend = backend <= g_best_json_backend ? backend : g_best_json_backend;
+}
+} // namespace modio
@@ -0,0 +1,130 @@
+#include "LazyFields.h"
+
+#include <algorithm>
+
+namespace modio
+{
+struct LazyMod
+{
+  std::shared_ptr<const nlohmann::json> response_json;
+  const nlohmann::json *mod_json;
+  ModioMedia *media;
+};
+
+// Most recently retained first
+static std::list<std::shared_ptr<const nlohmann::json>> g_lazy_responses;
+static std::unordered_map<u32, LazyMod> g_lazy_mods;
+// Dropped during this process cycle, callers may still hold pointers into them
+static std::vector<std::shared_ptr<const nlohmann::json>> g_released_responses;
+static std::vector<ModioMedia *> g_released_media;
+
+static void releaseLazyMedia(LazyMod &lazy_mod)
+{
+  if (lazy_mod.media)
+  {
+    g_released_media.push_back(lazy_mod.media);
+    lazy_mod.media = NULL;
+  }
+}
+
+static void freeReleasedLazyFields()
+{
+  for (ModioMedia *media : g_released_media)
+  {
+    modioFreeMedia(media);
+    delete media;
+  }
+  g_released_media.clear();
+  g_released_responses.clear();
+}
+
+static void releaseLazyResponse(const nlohmann::json *response_json)
+{
+  for (auto it = g_lazy_mods.begin(); it != g_lazy_mods.end();)
+  {
+    if (it->second.response_json.get() == response_json)
+    {
+      releaseLazyMedia(it->second);
+      it = g_lazy_mods.erase(it);
+    }
+    else
+      it++;
+  }
+}
+
+void retainLazyResponse(const std::shared_ptr<const nlohmann::json> &retained_json)
+{
+  const nlohmann::json *mods_json = modio::findKey(*retained_json, "data");
+  if (!mods_json || !mods_json->is_array())
+    return;
+
+  for (auto &mod_json : *mods_json)
+  {
+    u32 mod_id = 0;
+    modio::getJsonValue(mod_json, "id", mod_id);
+    if (mod_id == 0)
+      continue;
+
+    LazyMod &lazy_mod = g_lazy_mods[mod_id];
+    // Served again from the response cache, the media decoded from it stays valid
+    if (lazy_mod.response_json == retained_json)
+      continue;
+    if (lazy_mod.response_json)
+      releaseLazyMedia(lazy_mod);
+    lazy_mod.response_json = retained_json;
+    lazy_mod.mod_json = &mod_json;
+    lazy_mod.media = NULL;
+  }
+
+  // The same response retained again moves to the front instead of being listed twice,
+  // else the older entry ageing out would release the mods it holds now
+  auto retained_it = std::find(g_lazy_responses.begin(), g_lazy_responses.end(), retained_json);
+  if (retained_it != g_lazy_responses.end())
+    g_lazy_responses.splice(g_lazy_responses.begin(), g_lazy_responses, retained_it);
+  else
+    g_lazy_responses.push_front(retained_json);
+  while (g_lazy_responses.size() > MODIO_LAZY_FIELDS_MAX_RESPONSES)
+  {
+    releaseLazyResponse(g_lazy_responses.back().get());
+    g_released_responses.push_back(g_lazy_responses.back());
+    g_lazy_responses.pop_back();
+  }
+}
+
+const nlohmann::json *findLazyMod(u32 mod_id)
+{
+  auto it = g_lazy_mods.find(mod_id);
+  if (it == g_lazy_mods.end())
+    return NULL;
+  return it->second.mod_json;
+}
+
+const ModioMedia *getLazyMedia(u32 mod_id)
+{
+  auto it = g_lazy_mods.find(mod_id);
+  if (it == g_lazy_mods.end())
+    return NULL;
+
+  LazyMod &lazy_mod = it->second;
+  if (!lazy_mod.media)
+  {
+    lazy_mod.media = new ModioMedia;
+    modioInitMedia(lazy_mod.media, modio::getJsonChild(*lazy_mod.mod_json, "media"));
+  }
+  return lazy_mod.media;
+}
+
+void processLazyFields()
+{
+  freeReleasedLazyFields();
+}
+
+void clearLazyFields()
+{
+  for (auto &lazy_mod : g_lazy_mods)
+    releaseLazyMedia(lazy_mod.second);
+  g_lazy_mods.clear();
+  g_lazy_responses.clear();
+  freeReleasedLazyFields();
+}
+} // namespace modio
@@ -0,0 +1,212 @@
+#include "Logger.h"
+#include "Utility.h"
+
+namespace modio
+{
+LogRing::LogRing()
+  : head(0), tail(0)
+{
+  for (size_t i = 0; i < MODIO_LOG_RING_SIZE; i++)
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool LogRing::push(LogLine &line)
+{
+  size_t position = head.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;)
+  {
+    slot = &slots[position & (MODIO_LOG_RING_SIZE - 1)];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+    if (difference == 0)
+    {
+      if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (difference < 0)
+    {
+      return false;
+    }
+    else
+    {
+      position = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->line.debug_level = line.debug_level;
+  slot->line.time = line.time;
+  slot->line.text.swap(line.text);
+  slot->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+bool LogRing::pop(LogLine &line)
+{
+  size_t position = tail.load(std::memory_order_relaxed);
+  Slot &slot = slots[position & (MODIO_LOG_RING_SIZE - 1)];
+  if ((intptr_t)slot.sequence.load(std::memory_order_acquire) - (intptr_t)(position + 1) < 0)
+    return false;
+
+  line.debug_level = slot.line.debug_level;
+  line.time = slot.line.time;
+  line.text.swap(slot.line.text);
+  slot.line.text.clear();
+  slot.sequence.store(position + MODIO_LOG_RING_SIZE, std::memory_order_release);
+  tail.store(position + 1, std::memory_order_relaxed);
+  return true;
+}
+
+static LogRing g_log_ring;
+static std::thread g_log_thread;
+static std::atomic<bool> g_log_running(false);
+// Producers between their check of g_log_running and their push, stopLogger waits for them
+static std::atomic<u32> g_log_producers(0);
+static std::atomic<u32> g_dropped_log_lines(0);
+static std::mutex g_log_mutex;
+static std::condition_variable g_log_condition;
+static std::string g_log_path;
+static std::atomic<void (*)(u32 debug_level, char const *message)> g_log_listener(NULL);
+
+std::string formatLogLine(u32 debug_level, u32 time, const std::string &text)
+{
+  std::string line = "[" + modio::toString(time) + "] ";
+  if (debug_level == MODIO_DEBUGLEVEL_ERROR)
+    line += "[Error] ";
+  else if (debug_level == MODIO_DEBUGLEVEL_WARNING)
+    line += "[WARNING] ";
+  else if (debug_level == MODIO_DEBUGLEVEL_LOG)
+    line += "[LOG] ";
+  return line + text + "\n";
+}
+
+static void rotateLog(std::ofstream &log_file)
+{
+  log_file.close();
+  std::string rotated_path = g_log_path + ".1";
+  std::remove(rotated_path.c_str());
+  std::rename(g_log_path.c_str(), rotated_path.c_str());
+  log_file.open(g_log_path, std::ios::binary | std::ios::trunc);
+}
+
+// Writes the queued lines and tells the listener about them on the calling thread
+static void writeQueuedLines(std::ofstream &log_file, u64 &log_bytes)
+{
+  std::string batch;
+  LogLine line;
+  while (g_log_ring.pop(line))
+  {
+    modio::callLogListener(line.debug_level, line.text);
+    batch += modio::formatLogLine(line.debug_level, line.time, line.text);
+  }
+
+  u32 dropped_log_lines = g_dropped_log_lines.exchange(0);
+  if (dropped_log_lines > 0)
+    batch += modio::formatLogLine(MODIO_DEBUGLEVEL_WARNING, modio::getCurrentTime(), modio::toString(dropped_log_lines) + " log lines dropped, the log buffer was full");
+
+  if (batch.empty())
+    return;
+
+  if (log_bytes + batch.size() > MODIO_LOG_MAX_BYTES)
+  {
+    rotateLog(log_file);
+    log_bytes = 0;
+  }
+  log_file.write(batch.c_str(), batch.size());
+  log_file.flush();
+  log_bytes += batch.size();
+}
+
+static void openLog(std::ofstream &log_file, u64 &log_bytes)
+{
+  log_file.open(g_log_path, std::ios::binary | std::ios::app);
+  log_file.seekp(0, std::ios::end);
+  log_bytes = (u64)log_file.tellp();
+}
+
+static void flushLog()
+{
+  std::ofstream log_file;
+  u64 log_bytes;
+  openLog(log_file, log_bytes);
+
+  for (;;)
+  {
+    // Read before draining so the lines queued before stopLogger are all written
+    bool running = g_log_running.load();
+
+    writeQueuedLines(log_file, log_bytes);
+
+    if (!running)
+      break;
+
+    std::unique_lock<std::mutex> lock(g_log_mutex);
+    g_log_condition.wait_for(lock, std::chrono::milliseconds(MODIO_LOG_FLUSH_INTERVAL_MILLIS));
+  }
+}
+
+void startLogger(const std::string &log_path)
+{
+  stopLogger();
+  g_log_path = log_path;
+  g_log_running = true;
+  g_log_thread = std::thread(flushLog);
+}
+
+void stopLogger()
+{
+  if (!g_log_running.exchange(false))
+    return;
+
+  g_log_condition.notify_one();
+  g_log_thread.join();
+
+  // A producer that saw the logger running may still be pushing, its line has to make the
+  // final drain below instead of waiting in the ring for the next startLogger
+  while (g_log_producers.load() > 0)
+    std::this_thread::yield();
+
+  std::ofstream log_file;
+  u64 log_bytes;
+  openLog(log_file, log_bytes);
+  writeQueuedLines(log_file, log_bytes);
+}
+
+bool queueLogLine(u32 debug_level, const std::string &text)
+{
+  // Counted before the check, so either this call sees the logger stopping and the caller
+  // writes the line itself, or stopLogger sees this call and waits for its push
+  g_log_producers++;
+  if (!g_log_running.load())
+  {
+    g_log_producers--;
+    return false;
+  }
+
+  LogLine line;
+  line.debug_level = debug_level;
+  line.time = modio::getCurrentTime();
+  line.text = text;
+  bool queued = g_log_ring.push(line);
+  if (!queued)
+    g_dropped_log_lines++;
+
+  // Errors are written right away, they may be followed by a crash
+  if (!queued || debug_level == MODIO_DEBUGLEVEL_ERROR)
+    g_log_condition.notify_one();
+  g_log_producers--;
+  return true;
+}
+
+void setLogListener(void (*callback)(u32 debug_level, char const *message))
+{
+  g_log_listener = callback;
+}
+
+void callLogListener(u32 debug_level, const std::string &text)
+{
+  void (*log_listener)(u32 debug_level, char const *message) = g_log_listener.load();
+  if (log_listener)
+    log_listener(debug_level, text.c_str());
+}
+} // namespace modio
@@ -0,0 +1,395 @@
+#include "Metrics.h"
+
+#include <cstring>
+#include <vector>
+
+#include "Utility.h"
+
+namespace modio
+{
+struct EndpointSlot
+{
+  std::atomic<u64> hash;
+  std::atomic<bool> ready;
+  char endpoint[MODIO_METRICS_ENDPOINT_SIZE];
+  std::atomic<u32> requests;
+  std::atomic<u32> status_2xx;
+  std::atomic<u32> status_3xx;
+  std::atomic<u32> status_4xx;
+  std::atomic<u32> status_5xx;
+  std::atomic<u32> failed;
+};
+
+struct HostSlot
+{
+  std::atomic<u64> hash;
+  std::atomic<bool> ready;
+  char host[MODIO_METRICS_HOST_SIZE];
+  std::atomic<u32> transfers;
+  std::atomic<u32> reused_connections;
+  std::atomic<u32> http_version;
+  std::atomic<u64> dns_micros;
+  std::atomic<u64> connect_micros;
+  std::atomic<u64> tls_micros;
+  std::atomic<u64> ttfb_micros;
+  std::atomic<u64> transfer_micros;
+  std::atomic<u64> bytes_down;
+};
+
+// Open addressing on the name hash, a slot is claimed with a CAS and never freed.
+// The extra slot at the end takes what does not fit.
+static EndpointSlot g_endpoints[MODIO_METRICS_MAX_ENDPOINTS + 1];
+static HostSlot g_hosts[MODIO_METRICS_MAX_HOSTS + 1];
+
+static std::atomic<u64> g_requests(0);
+static std::atomic<u64> g_failed_requests(0);
+static std::atomic<u64> g_bytes_up(0);
+static std::atomic<u64> g_bytes_down(0);
+static std::atomic<u64> g_decoded_bytes_down(0);
+static std::atomic<u64> g_cache_lookups[MODIO_CACHE_TIER_ENTITY_STORE_MISS + 1];
+static std::atomic<u32> g_gauges[MODIO_GAUGE_PREFETCH_QUEUE + 1];
+static std::atomic<u64> g_extracted_bytes(0);
+static std::atomic<u64> g_extracted_files(0);
+static std::atomic<u64> g_extract_micros(0);
+static AtomicHistogram g_network_latency;
+static AtomicHistogram g_parse_latency;
+static AtomicHistogram g_callback_latency;
+static AtomicHistogram g_extract_time;
+static AtomicHistogram g_process_time;
+
+static u32 getHistogramBucket(u64 value)
+{
+  if (value < MODIO_HISTOGRAM_SUB_BUCKETS)
+    return (u32)value;
+
+  u32 magnitude = 0;
+  while ((value >> magnitude) >= 2 * MODIO_HISTOGRAM_SUB_BUCKETS)
+    magnitude++;
+  u32 bucket = (magnitude + 1) * MODIO_HISTOGRAM_SUB_BUCKETS + (u32)(value >> magnitude) - MODIO_HISTOGRAM_SUB_BUCKETS;
+  return bucket < MODIO_HISTOGRAM_BUCKETS ? bucket : MODIO_HISTOGRAM_BUCKETS - 1;
+}
+
+// Highest value that lands in bucket
+static u64 getHistogramBucketBound(u32 bucket)
+{
+  if (bucket < MODIO_HISTOGRAM_SUB_BUCKETS)
+    return bucket;
+
+  u32 magnitude = bucket / MODIO_HISTOGRAM_SUB_BUCKETS - 1;
+  u64 lowest = (u64)(MODIO_HISTOGRAM_SUB_BUCKETS + bucket % MODIO_HISTOGRAM_SUB_BUCKETS) << magnitude;
+  return lowest + ((u64)1 << magnitude) - 1;
+}
+
+AtomicHistogram::AtomicHistogram()
+  : count(0), sum(0), max(0)
+{
+  for (u32 i = 0; i < MODIO_HISTOGRAM_BUCKETS; i++)
+    buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void AtomicHistogram::record(u64 value)
+{
+  buckets[getHistogramBucket(value)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+
+  u64 current_max = max.load(std::memory_order_relaxed);
+  while (value > current_max && !max.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+ModioHistogram AtomicHistogram::getSnapshot() const
+{
+  ModioHistogram histogram;
+  u32 bucket_counts[MODIO_HISTOGRAM_BUCKETS];
+  u64 total = 0;
+  for (u32 i = 0; i < MODIO_HISTOGRAM_BUCKETS; i++)
+  {
+    bucket_counts[i] = buckets[i].load(std::memory_order_relaxed);
+    total += bucket_counts[i];
+  }
+
+  u64 max_value = max.load(std::memory_order_relaxed);
+  histogram.count = (u32)total;
+  histogram.mean_millis = total > 0 ? (double)sum.load(std::memory_order_relaxed) / total / 1000.0 : 0;
+  histogram.max_millis = max_value / 1000.0;
+
+  double percentiles[3] = {0.5, 0.9, 0.99};
+  double *percentile_millis[3] = {&histogram.p50_millis, &histogram.p90_millis, &histogram.p99_millis};
+  for (u32 i = 0; i < 3; i++)
+  {
+    *percentile_millis[i] = 0;
+    u64 rank = (u64)(percentiles[i] * total + 0.999999);
+    u64 seen = 0;
+    for (u32 bucket = 0; bucket < MODIO_HISTOGRAM_BUCKETS && rank > 0; bucket++)
+    {
+      seen += bucket_counts[bucket];
+      if (seen >= rank)
+      {
+        *percentile_millis[i] = std::min(getHistogramBucketBound(bucket), max_value) / 1000.0;
+        break;
+      }
+    }
+  }
+  return histogram;
+}
+
+template <typename Slot, size_t name_size>
+static Slot &getSlot(Slot *slots, u32 slots_size, char (Slot::*name)[name_size], const std::string &key)
+{
+  u64 hash = modio::hash64(key);
+  if (hash == 0)
+    hash = 1;
+
+  for (u32 probe = 0; probe < slots_size; probe++)
+  {
+    Slot &slot = slots[(hash + probe) % slots_size];
+    u64 slot_hash = slot.hash.load(std::memory_order_acquire);
+    if (slot_hash == 0)
+    {
+      if (slot.hash.compare_exchange_strong(slot_hash, hash, std::memory_order_acq_rel))
+      {
+        strncpy(slot.*name, key.c_str(), name_size - 1);
+        (slot.*name)[name_size - 1] = 0;
+        slot.ready.store(true, std::memory_order_release);
+        return slot;
+      }
+    }
+    if (slot_hash == hash)
+      return slot;
+  }
+  return slots[slots_size];
+}
+
+static EndpointSlot &getEndpointSlot(const std::string &endpoint)
+{
+  return getSlot(g_endpoints, MODIO_METRICS_MAX_ENDPOINTS, &EndpointSlot::endpoint, endpoint);
+}
+
+static void countResponse(EndpointSlot &slot, u32 response_code)
+{
+  slot.requests++;
+  g_requests++;
+  if (response_code >= 200 && response_code < 300)
+    slot.status_2xx++;
+  else if (response_code >= 300 && response_code < 400)
+    slot.status_3xx++;
+  else if (response_code >= 400 && response_code < 500)
+    slot.status_4xx++;
+  else if (response_code >= 500 && response_code < 600)
+    slot.status_5xx++;
+  else
+  {
+    slot.failed++;
+    g_failed_requests++;
+  }
+}
+
+std::string getMetricsEndpoint(const std::string &url)
+{
+  size_t path_begin = url.find("://");
+  path_begin = url.find('/', path_begin == std::string::npos ? 0 : path_begin + 3);
+  if (path_begin == std::string::npos)
+    return "/";
+  size_t path_end = url.find('?', path_begin);
+  std::string path = url.substr(path_begin, path_end == std::string::npos ? std::string::npos : path_end - path_begin);
+
+  std::string endpoint;
+  size_t segment_begin = 1;
+  while (segment_begin <= path.size())
+  {
+    size_t segment_end = path.find('/', segment_begin);
+    if (segment_end == std::string::npos)
+      segment_end = path.size();
+
+    std::string segment = path.substr(segment_begin, segment_end - segment_begin);
+    if (!segment.empty())
+    {
+      bool is_id = segment.find_first_not_of("0123456789") == std::string::npos;
+      endpoint += "/" + (is_id ? std::string("{id}") : segment);
+    }
+    segment_begin = segment_end + 1;
+  }
+  return endpoint.empty() ? "/" : endpoint;
+}
+
+void recordRequest(const std::string &url, u32 response_code, double network_micros, double parse_micros, double callback_micros, u64 bytes_up, u64 bytes_down, u64 decoded_bytes_down)
+{
+  countResponse(getEndpointSlot(getMetricsEndpoint(url)), response_code);
+  g_network_latency.record((u64)network_micros);
+  g_parse_latency.record((u64)parse_micros);
+  g_callback_latency.record((u64)callback_micros);
+  g_bytes_up += bytes_up;
+  g_bytes_down += bytes_down;
+  g_decoded_bytes_down += decoded_bytes_down;
+}
+
+void recordTransfer(const std::string &endpoint, u32 response_code, u64 bytes_up, u64 bytes_down)
+{
+  countResponse(getEndpointSlot(endpoint), response_code);
+  g_bytes_up += bytes_up;
+  g_bytes_down += bytes_down;
+  g_decoded_bytes_down += bytes_down;
+}
+
+void recordHostTransfer(const ModioTransferInfo &transfer, u64 bytes_down)
+{
+  std::string url = transfer.effective_url ? transfer.effective_url : "";
+  size_t host_begin = url.find("://");
+  host_begin = host_begin == std::string::npos ? 0 : host_begin + 3;
+  std::string host = url.substr(host_begin, url.find('/', host_begin) - host_begin);
+
+  HostSlot &slot = getSlot(g_hosts, MODIO_METRICS_MAX_HOSTS, &HostSlot::host, host);
+  slot.transfers++;
+  if (transfer.connection_reused)
+    slot.reused_connections++;
+  slot.http_version = transfer.http_version;
+  slot.dns_micros += (u64)(transfer.dns_millis * 1000.0);
+  slot.connect_micros += (u64)(transfer.connect_millis * 1000.0);
+  slot.tls_micros += (u64)(transfer.tls_millis * 1000.0);
+  slot.ttfb_micros += (u64)(transfer.ttfb_millis * 1000.0);
+  slot.transfer_micros += (u64)(transfer.transfer_millis * 1000.0);
+  slot.bytes_down += bytes_down;
+}
+
+void recordCacheLookup(u32 cache_tier)
+{
+  g_cache_lookups[cache_tier].fetch_add(1, std::memory_order_relaxed);
+}
+
+void setGauge(u32 gauge, u32 value)
+{
+  g_gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void recordExtract(u64 extracted_bytes, u32 extracted_files, double extract_micros)
+{
+  g_extracted_bytes += extracted_bytes;
+  g_extracted_files += extracted_files;
+  g_extract_micros += (u64)extract_micros;
+  g_extract_time.record((u64)extract_micros);
+}
+
+void recordProcess(double process_micros)
+{
+  g_process_time.record((u64)process_micros);
+}
+
+ModioMetrics getMetrics()
+{
+  ModioMetrics metrics;
+  metrics.requests = (u32)g_requests.load();
+  metrics.failed_requests = (u32)g_failed_requests.load();
+
+  std::vector<EndpointSlot *> endpoint_slots;
+  for (u32 i = 0; i <= MODIO_METRICS_MAX_ENDPOINTS; i++)
+  {
+    if (g_endpoints[i].requests.load() == 0)
+      continue;
+    if (i < MODIO_METRICS_MAX_ENDPOINTS && !g_endpoints[i].ready.load(std::memory_order_acquire))
+      continue;
+    endpoint_slots.push_back(&g_endpoints[i]);
+  }
+
+  metrics.endpoints_array_size = (u32)endpoint_slots.size();
+  metrics.endpoints_array = metrics.endpoints_array_size > 0 ? new ModioEndpointMetrics[metrics.endpoints_array_size] : NULL;
+  for (u32 i = 0; i < metrics.endpoints_array_size; i++)
+  {
+    EndpointSlot &slot = *endpoint_slots[i];
+    std::string endpoint = &slot == &g_endpoints[MODIO_METRICS_MAX_ENDPOINTS] ? "other" : slot.endpoint;
+    metrics.endpoints_array[i].endpoint = new char[endpoint.size() + 1];
+    strcpy(metrics.endpoints_array[i].endpoint, endpoint.c_str());
+    metrics.endpoints_array[i].requests = slot.requests.load();
+    metrics.endpoints_array[i].status_2xx = slot.status_2xx.load();
+    metrics.endpoints_array[i].status_3xx = slot.status_3xx.load();
+    metrics.endpoints_array[i].status_4xx = slot.status_4xx.load();
+    metrics.endpoints_array[i].status_5xx = slot.status_5xx.load();
+    metrics.endpoints_array[i].failed = slot.failed.load();
+  }
+
+  std::vector<HostSlot *> host_slots;
+  for (u32 i = 0; i <= MODIO_METRICS_MAX_HOSTS; i++)
+  {
+    if (g_hosts[i].transfers.load() == 0)
+      continue;
+    if (i < MODIO_METRICS_MAX_HOSTS && !g_hosts[i].ready.load(std::memory_order_acquire))
+      continue;
+    host_slots.push_back(&g_hosts[i]);
+  }
+
+  metrics.hosts_array_size = (u32)host_slots.size();
+  metrics.hosts_array = metrics.hosts_array_size > 0 ? new ModioHostMetrics[metrics.hosts_array_size] : NULL;
+  for (u32 i = 0; i < metrics.hosts_array_size; i++)
+  {
+    HostSlot &slot = *host_slots[i];
+    std::string host = &slot == &g_hosts[MODIO_METRICS_MAX_HOSTS] ? "other" : slot.host;
+    u32 transfers = slot.transfers.load();
+    u64 transfer_micros = slot.transfer_micros.load();
+    ModioHostMetrics &host_metrics = metrics.hosts_array[i];
+    host_metrics.host = new char[host.size() + 1];
+    strcpy(host_metrics.host, host.c_str());
+    host_metrics.transfers = transfers;
+    host_metrics.reused_connections = slot.reused_connections.load();
+    host_metrics.http_version = slot.http_version.load();
+    host_metrics.mean_dns_millis = slot.dns_micros.load() / 1000.0 / transfers;
+    host_metrics.mean_connect_millis = slot.connect_micros.load() / 1000.0 / transfers;
+    host_metrics.mean_tls_millis = slot.tls_micros.load() / 1000.0 / transfers;
+    host_metrics.mean_ttfb_millis = slot.ttfb_micros.load() / 1000.0 / transfers;
+    host_metrics.mean_transfer_millis = transfer_micros / 1000.0 / transfers;
+    host_metrics.download_bytes_per_second = transfer_micros > 0 ? slot.bytes_down.load() * 1000000.0 / transfer_micros : 0;
+  }
+
+  metrics.network_latency = g_network_latency.getSnapshot();
+  metrics.parse_latency = g_parse_latency.getSnapshot();
+  metrics.callback_latency = g_callback_latency.getSnapshot();
+  metrics.bytes_up = g_bytes_up.load();
+  metrics.bytes_down = g_bytes_down.load();
+  metrics.decoded_bytes_down = g_decoded_bytes_down.load();
+
+  metrics.memory_cache_hits = (u32)g_cache_lookups[MODIO_CACHE_TIER_MEMORY].load();
+  metrics.store_cache_hits = (u32)g_cache_lookups[MODIO_CACHE_TIER_STORE].load();
+  metrics.cache_misses = (u32)g_cache_lookups[MODIO_CACHE_TIER_MISS].load();
+  metrics.entity_store_hits = (u32)g_cache_lookups[MODIO_CACHE_TIER_ENTITY_STORE].load();
+  metrics.entity_store_misses = (u32)g_cache_lookups[MODIO_CACHE_TIER_ENTITY_STORE_MISS].load();
+  u32 cache_lookups = metrics.memory_cache_hits + metrics.store_cache_hits + metrics.cache_misses;
+  u32 entity_store_lookups = metrics.entity_store_hits + metrics.entity_store_misses;
+  metrics.memory_cache_hit_ratio = cache_lookups > 0 ? (double)metrics.memory_cache_hits / cache_lookups : 0;
+  metrics.store_cache_hit_ratio = cache_lookups > 0 ? (double)metrics.store_cache_hits / cache_lookups : 0;
+  metrics.entity_store_hit_ratio = entity_store_lookups > 0 ? (double)metrics.entity_store_hits / entity_store_lookups : 0;
+
+  metrics.active_requests = g_gauges[MODIO_GAUGE_ACTIVE_REQUESTS].load(std::memory_order_relaxed);
+  metrics.active_downloads = g_gauges[MODIO_GAUGE_ACTIVE_DOWNLOADS].load(std::memory_order_relaxed);
+  metrics.active_uploads = g_gauges[MODIO_GAUGE_ACTIVE_UPLOADS].load(std::memory_order_relaxed);
+  metrics.mod_download_queue_size = g_gauges[MODIO_GAUGE_MOD_DOWNLOAD_QUEUE].load(std::memory_order_relaxed);
+  metrics.modfile_upload_queue_size = g_gauges[MODIO_GAUGE_MODFILE_UPLOAD_QUEUE].load(std::memory_order_relaxed);
+  metrics.prefetch_queue_size = g_gauges[MODIO_GAUGE_PREFETCH_QUEUE].load(std::memory_order_relaxed);
+
+  metrics.extracted_bytes = g_extracted_bytes.load();
+  metrics.extracted_files = (u32)g_extracted_files.load();
+  metrics.extract_time = g_extract_time.getSnapshot();
+  u64 extract_micros = g_extract_micros.load();
+  metrics.extract_bytes_per_second = extract_micros > 0 ? metrics.extracted_bytes * 1000000.0 / extract_micros : 0;
+
+  metrics.process_time = g_process_time.getSnapshot();
+  return metrics;
+}
+
+void freeMetrics(ModioMetrics *metrics)
+{
+  if (!metrics)
+    return;
+
+  for (u32 i = 0; i < metrics->endpoints_array_size; i++)
+    delete[] metrics->endpoints_array[i].endpoint;
+  delete[] metrics->endpoints_array;
+  metrics->endpoints_array = NULL;
+  metrics->endpoints_array_size = 0;
+
+  for (u32 i = 0; i < metrics->hosts_array_size; i++)
+    delete[] metrics->hosts_array[i].host;
+  delete[] metrics->hosts_array;
+  metrics->hosts_array = NULL;
+  metrics->hosts_array_size = 0;
+}
+} // namespace modio
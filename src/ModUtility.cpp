@@ -2,56 +2,434 @@
 
 namespace modio
 {
+static ResponseCache g_memory_cache(MODIO_MEMORY_CACHE_MAX_BYTES);
+// Every cached response lives in a single mapped file, lookups never open a file
+static CacheStore g_cache_store;
+static EntityStore g_entity_store;
+static InstalledModRegistry g_installed_mods;
+static u32 g_cache_hits = 0;
+static u32 g_cache_stale_hits = 0;
+static u32 g_cache_misses = 0;
+
+// Games, users and the like carry an id too, only a mod has both a name_id and a modfile
+static bool isModObject(const nlohmann::json &object)
+{
+  return modio::hasKey(object, "game_id") && modio::hasKey(object, "name_id") && object.count("modfile") > 0 && modio::hasKey(object, "id") && object["id"].is_number();
+}
+
+// Ids of the mods in a response, the objects of listings of modfiles, stats, events and
+// such name theirs in mod_id
+static std::vector<u32> getResponseModIds(const nlohmann::json &response_json)
+{
+  std::vector<u32> mod_ids;
+  const nlohmann::json *objects = &response_json;
+  nlohmann::json single_object = nlohmann::json::array();
+  if (modio::hasKey(response_json, "data") && response_json["data"].is_array())
+  {
+    objects = &response_json["data"];
+  }
+  else
+  {
+    single_object.push_back(response_json);
+    objects = &single_object;
+  }
+
+  for (auto &object : *objects)
+  {
+    if (!object.is_object())
+      continue;
+    if (modio::hasKey(object, "mod_id") && object["mod_id"].is_number())
+      mod_ids.push_back(object["mod_id"]);
+    else if (isModObject(object))
+      mod_ids.push_back(object["id"]);
+  }
+
+  std::sort(mod_ids.begin(), mod_ids.end());
+  mod_ids.erase(std::unique(mod_ids.begin(), mod_ids.end()), mod_ids.end());
+  return mod_ids;
+}
+
+static std::shared_ptr<const nlohmann::json> lookupCall(const std::string &url, u32 max_age_seconds)
+{
+  std::string key = modio::getCanonicalUrl(url);
+  std::shared_ptr<const nlohmann::json> response_json = g_memory_cache.get(key, max_age_seconds);
+  if (response_json)
+  {
+    modio::recordCacheLookup(MODIO_CACHE_TIER_MEMORY);
+    return response_json;
+  }
+
+  std::string response_string;
+  double datetime_millis;
+  std::vector<u32> mod_ids;
+  if (!g_cache_store.get(key, max_age_seconds, response_string, &datetime_millis, &mod_ids))
+  {
+    modio::recordCacheLookup(MODIO_CACHE_TIER_MISS);
+    return NULL;
+  }
+
+  nlohmann::json cache_json = modio::toJson(response_string);
+  if (cache_json.empty())
+  {
+    modio::recordCacheLookup(MODIO_CACHE_TIER_MISS);
+    return NULL;
+  }
+  modio::recordCacheLookup(MODIO_CACHE_TIER_STORE);
+
+  response_json = std::make_shared<const nlohmann::json>(std::move(cache_json));
+  g_memory_cache.add(key, datetime_millis, response_json, response_string.size(), mod_ids);
+  return response_json;
+}
+
 void addCallToCache(std::string url, nlohmann::json response_json)
 {
+  MODIO_TRACE_SCOPE("add call to cache", "cache");
+  std::string key = modio::getCanonicalUrl(url);
   double current_time_millis = modio::getCurrentTimeMillis();
-  std::string current_time_string = modio::toString(current_time_millis);
-  current_time_string.erase(current_time_string.find('.'), std::string::npos);
-  std::string filename = current_time_string + ".json";
+  std::string response_string = response_json.dump();
 
-  modio::writeJson(modio::getModIODirectory() + "cache/" + filename, response_json);
+  std::vector<u32> mod_ids = getResponseModIds(response_json);
+  g_cache_store.put(key, response_string, current_time_millis, mod_ids);
+  g_memory_cache.add(key, current_time_millis, std::make_shared<const nlohmann::json>(std::move(response_json)), response_string.size(), mod_ids);
+}
+
+bool getCallFromCache(std::string url, u32 max_age_seconds, std::shared_ptr<const nlohmann::json> &response_json)
+{
+  MODIO_TRACE_SCOPE("get call from cache", "cache");
+  response_json = lookupCall(url, max_age_seconds);
+  if (!response_json)
+  {
+    g_cache_misses++;
+    return false;
+  }
+  g_cache_hits++;
+  return true;
+}
 
-  nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache.json");
+bool getStaleCallFromCache(std::string url, std::shared_ptr<const nlohmann::json> &response_json)
+{
+  response_json = lookupCall(url, MODIO_CACHE_STALE_MAX_AGE_SECONDS);
+  if (!response_json)
+    return false;
+  g_cache_stale_hits++;
+  return true;
+}
 
-  // TODO: Restore automatic cache removal?
-  for (nlohmann::json::iterator it = cache_file_json.begin(); it != cache_file_json.end(); ++it)
+void refreshCachedCall(std::string url)
+{
+  MODIO_TRACE_SCOPE("refresh cached call", "cache");
+  std::string key = modio::getCanonicalUrl(url);
+  double current_time_millis = modio::getCurrentTimeMillis();
+  std::string cache_keys[] = {key, "mods:" + key};
+  for (auto &cache_key : cache_keys)
   {
-    if (modio::hasKey((*it), "url") && modio::hasKey((*it), "file") && (*it)["url"] == url)
-    {
-      std::string cache_filename = (*it)["file"];
-      cache_file_json.erase(it);
-      modio::removeFile(modio::getModIODirectory() + "cache/" + cache_filename);
-      break;
-    }
+    std::string value;
+    std::vector<u32> mod_ids;
+    if (g_cache_store.get(cache_key, MODIO_CACHE_STALE_MAX_AGE_SECONDS, value, NULL, &mod_ids))
+      g_cache_store.put(cache_key, value, current_time_millis, mod_ids);
+
+    g_memory_cache.touch(cache_key, current_time_millis);
+  }
+}
+
+u64 getResponseHash(const nlohmann::json &response_json)
+{
+  return modio::hash64(response_json.dump());
+}
+
+u32 getRevalidatedResponseCode(u64 stale_hash, u32 response_code, const nlohmann::json &response_json)
+{
+  if (stale_hash != 0 && response_code == 200 && modio::getResponseHash(response_json) == stale_hash)
+    return 304;
+  return response_code;
+}
+
+void addModsCallToCache(std::string url, const nlohmann::json &response_json, const ModioResponse &response, const ModioMod *mods, u32 mods_size)
+{
+  MODIO_TRACE_SCOPE("add mods call to cache", "cache");
+  if (modio::BINARY_CACHE != MODIO_BINARY_CACHE_ENABLED)
+  {
+    modio::addCallToCache(url, response_json);
+    return;
+  }
+
+  // Decoded listings live under their own key so they never shadow the JSON response. The
+  // memory tier keeps the image inflated, hits skip the inflating
+  double current_time_millis = modio::getCurrentTimeMillis();
+  std::shared_ptr<const std::string> image = std::make_shared<const std::string>(modio::serializeMods(response, mods, mods_size, modio::getResponseHash(response_json)));
+  std::vector<u32> mod_ids;
+  for (u32 i = 0; i < mods_size; i++)
+    mod_ids.push_back(mods[i].id);
+  std::string key = "mods:" + modio::getCanonicalUrl(url);
+  g_cache_store.put(key, *image, current_time_millis, mod_ids);
+  g_memory_cache.addImage(key, current_time_millis, image, mod_ids);
+}
+
+static bool serveCachedMods(const std::string &url, u32 max_age_seconds, bool is_stale, void *object, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size), u64 *source_hash)
+{
+  if (modio::BINARY_CACHE != MODIO_BINARY_CACHE_ENABLED)
+    return false;
+
+  std::string key = "mods:" + modio::getCanonicalUrl(url);
+
+  std::shared_ptr<const std::string> image = g_memory_cache.getImage(key, max_age_seconds);
+  if (!image)
+  {
+    std::string stored_image;
+    double datetime_millis;
+    std::vector<u32> mod_ids;
+    if (!g_cache_store.get(key, max_age_seconds, stored_image, &datetime_millis, &mod_ids))
+      return false;
+    image = std::make_shared<const std::string>(std::move(stored_image));
+    g_memory_cache.addImage(key, datetime_millis, image, mod_ids);
+  }
+
+  ModioResponse response;
+  modioInitResponse(&response, nlohmann::json());
+  ModioMod *mods = NULL;
+  u32 mods_size = 0;
+  u64 *mods_block = modio::rehydrateMods(*image, response, mods, mods_size, *source_hash);
+  if (!mods_block)
+  {
+    modio::writeLogLine("Discarding a cached mods image written with a different layout", MODIO_DEBUGLEVEL_WARNING);
+    g_cache_store.remove(key);
+    g_memory_cache.remove(key);
+    modioFreeResponse(&response);
+    return false;
+  }
+
+  if (is_stale)
+    g_cache_stale_hits++;
+  else
+    g_cache_hits++;
+  response.code = 200;
+  response.result_cached = true;
+  response.result_stale = is_stale;
+  callback(object, response, mods, mods_size);
+  if (!is_stale)
+  {
+    std::vector<u32> mod_ids;
+    for (u32 i = 0; i < mods_size; i++)
+      mod_ids.push_back(mods[i].id);
+    modio::queueListingPrefetch(url, response, mod_ids);
+  }
+
+  modioFreeResponse(&response);
+  delete[] mods_block;
+  return true;
+}
+
+bool serveModsFromCache(std::string url, u32 max_age_seconds, void *object, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size))
+{
+  u64 source_hash;
+  return serveCachedMods(url, max_age_seconds, false, object, callback, &source_hash);
+}
+
+bool serveStaleModsFromCache(std::string url, void *object, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size), u64 &stale_hash)
+{
+  return serveCachedMods(url, MODIO_CACHE_STALE_MAX_AGE_SECONDS, true, object, callback, &stale_hash);
+}
+
+// Imports the responses still fresh from the cache.json index and cache/ directory used by older versions
+static void migrateLegacyCache(double oldest_time_millis)
+{
+  std::string cache_index_path = modio::getModIODirectory() + "cache.json";
+  std::string cache_directory = modio::getModIODirectory() + "cache/";
+  if (!modio::fileExists(cache_index_path) && !modio::directoryExists(cache_directory))
+    return;
+
+  modio::writeLogLine("Migrating the legacy cache files...", MODIO_DEBUGLEVEL_LOG);
+
+  u32 migrated_count = 0;
+  nlohmann::json cache_file_json = modio::openJson(cache_index_path);
+  for (auto &cache_object : cache_file_json)
+  {
+    if (!modio::hasKey(cache_object, "url") || !modio::hasKey(cache_object, "datetime") || !modio::hasKey(cache_object, "file"))
+      continue;
+
+    double cache_time = cache_object["datetime"];
+    if (cache_time < oldest_time_millis)
+      continue;
+
+    std::string cache_filename = cache_object["file"];
+    nlohmann::json response_json = modio::openJson(cache_directory + cache_filename);
+    if (response_json.empty())
+      continue;
+
+    std::string url = cache_object["url"];
+    if (g_cache_store.put(modio::getCanonicalUrl(url), response_json.dump(), cache_time))
+      migrated_count++;
   }
 
-  nlohmann::json cache_object;
-  cache_object["datetime"] = current_time_millis;
-  cache_object["file"] = filename;
-  cache_object["url"] = url;
-  cache_file_json.push_back(cache_object);
+  modio::removeFile(cache_index_path);
+  modio::removeDirectory(cache_directory);
+  MODIO_LOG("Migrated " + modio::toString(migrated_count) + " cached responses.", MODIO_DEBUGLEVEL_LOG);
+}
 
-  modio::writeJson(modio::getModIODirectory() + "cache.json", cache_file_json);
+void invalidateCachedMod(u32 mod_id)
+{
+  // Each tier by its own tags, the memory one may hold responses the store evicted
+  g_memory_cache.removeTagged(mod_id);
+  g_cache_store.removeTagged(mod_id);
 }
 
-std::string getCallFileFromCache(std::string url, u32 max_age_seconds)
+void patchCachedMod(const nlohmann::json &mod_json)
 {
-  nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache.json");
-  double current_time = modio::getCurrentTimeMillis();
-  for (nlohmann::json::iterator it = cache_file_json.begin(); it != cache_file_json.end(); ++it)
+  if (!modio::hasKey(mod_json, "id"))
+    return;
+
+  u32 mod_id = mod_json["id"];
+  // Dropped from memory whether or not the store still has them, the patched copies are
+  // read back from the store
+  g_memory_cache.removeTagged(mod_id);
+  for (auto &key : g_cache_store.getTaggedKeys(mod_id))
   {
-    if (modio::hasKey((*it), "url") && modio::hasKey((*it), "datetime") && modio::hasKey((*it), "file") && (*it)["url"] == url)
+    if (key.compare(0, 5, "mods:") == 0)
     {
-      double file_datetime = (*it)["datetime"];
-      double difference = current_time - file_datetime;
+      g_cache_store.remove(key);
+      continue;
+    }
+
+    std::string response_string;
+    double datetime_millis;
+    std::vector<u32> mod_ids;
+    if (!g_cache_store.get(key, MODIO_CACHE_STALE_MAX_AGE_SECONDS, response_string, &datetime_millis, &mod_ids))
+      continue;
 
-      if (difference <= max_age_seconds * 1000)
+    nlohmann::json response_json = modio::toJson(response_string);
+    bool patched = false;
+    if (modio::hasKey(response_json, "data") && response_json["data"].is_array())
+    {
+      for (auto &object : response_json["data"])
       {
-        return (*it)["file"];
+        if (modio::hasKey(object, "game_id") && modio::hasKey(object, "id") && object["id"] == mod_id)
+        {
+          object = mod_json;
+          patched = true;
+        }
       }
     }
+    else if (modio::hasKey(response_json, "game_id") && modio::hasKey(response_json, "id") && response_json["id"] == mod_id)
+    {
+      response_json = mod_json;
+      patched = true;
+    }
+
+    // Responses only naming the mod, like its modfiles, are not affected by an edit. The
+    // patched response keeps its age, it is not any fresher than the rest of it
+    if (patched)
+      g_cache_store.put(key, response_json.dump(), datetime_millis, mod_ids);
   }
-  return "";
+}
+
+void storeMod(const nlohmann::json &mod_json)
+{
+  g_entity_store.putMod(mod_json, modio::getCurrentTimeMillis());
+}
+
+void storeMods(const nlohmann::json &response_json)
+{
+  if (!modio::hasKey(response_json, "data"))
+    return;
+
+  double current_time_millis = modio::getCurrentTimeMillis();
+  for (auto &mod_json : response_json["data"])
+    g_entity_store.putMod(mod_json, current_time_millis);
+}
+
+void storeModfile(const nlohmann::json &modfile_json)
+{
+  g_entity_store.putModfile(modfile_json, modio::getCurrentTimeMillis());
+}
+
+void storeModfiles(const nlohmann::json &response_json)
+{
+  if (!modio::hasKey(response_json, "data"))
+    return;
+
+  double current_time_millis = modio::getCurrentTimeMillis();
+  for (auto &modfile_json : response_json["data"])
+    g_entity_store.putModfile(modfile_json, current_time_millis);
+}
+
+bool getStoredMod(u32 mod_id, nlohmann::json &mod_json)
+{
+  bool is_stored = g_entity_store.getMod(mod_id, modio::MAX_CACHE_TIME, mod_json);
+  modio::recordCacheLookup(is_stored ? MODIO_CACHE_TIER_ENTITY_STORE : MODIO_CACHE_TIER_ENTITY_STORE_MISS);
+  return is_stored;
+}
+
+bool getStoredModfile(u32 modfile_id, nlohmann::json &modfile_json)
+{
+  bool is_stored = g_entity_store.getModfile(modfile_id, modio::MAX_CACHE_TIME, modfile_json);
+  modio::recordCacheLookup(is_stored ? MODIO_CACHE_TIER_ENTITY_STORE : MODIO_CACHE_TIER_ENTITY_STORE_MISS);
+  return is_stored;
+}
+
+void invalidateStoredMod(u32 mod_id, u32 date_changed)
+{
+  g_entity_store.invalidateMod(mod_id, date_changed);
+}
+
+void removeStoredMod(u32 mod_id)
+{
+  g_entity_store.removeMod(mod_id);
+}
+
+void setInstalledModJson(u32 mod_id, const nlohmann::json &mod_json)
+{
+  g_entity_store.setInstalledMod(mod_id, mod_json);
+}
+
+nlohmann::json getInstalledModJson(u32 mod_id, std::string path)
+{
+  nlohmann::json mod_json;
+  if (g_entity_store.getInstalledMod(mod_id, mod_json))
+    return mod_json;
+
+  mod_json = modio::openJson(modio::addSlashIfNeeded(path) + "modio.json");
+  if (!mod_json.empty())
+    g_entity_store.setInstalledMod(mod_id, mod_json);
+  return mod_json;
+}
+
+void setCacheMaxBytes(u32 max_bytes)
+{
+  g_cache_store.setMaxBytes(max_bytes);
+}
+
+ModioCacheStats getCacheStats()
+{
+  ModioCacheStats cache_stats;
+  cache_stats.hits = g_cache_hits;
+  cache_stats.stale_hits = g_cache_stale_hits;
+  cache_stats.misses = g_cache_misses;
+  cache_stats.evictions = (u32)g_cache_store.getEvictionCount();
+  cache_stats.records = g_cache_store.getRecordCount();
+  cache_stats.stored_bytes = (u32)g_cache_store.getLiveBytes();
+  cache_stats.uncompressed_bytes = (u32)g_cache_store.getRawBytes();
+  cache_stats.file_bytes = (u32)g_cache_store.getFileBytes();
+  cache_stats.memory_bytes = (u32)g_memory_cache.getBytes();
+  cache_stats.stored_mods = g_entity_store.getModCount();
+  cache_stats.stored_modfiles = g_entity_store.getModfileCount();
+  cache_stats.prefetches = modio::getPrefetchRequestCount();
+  cache_stats.prefetch_hits = modio::getPrefetchHitCount();
+  return cache_stats;
+}
+
+void processCacheStore()
+{
+  if (g_cache_store.needsCompaction())
+    g_cache_store.compact();
+}
+
+void closeCacheStore()
+{
+  g_cache_store.close();
+  g_memory_cache.clear();
+  g_entity_store.clear();
+  g_entity_store.clearInstalledMods();
+  modio::clearLazyFields();
 }
 
 void installDownloadedMods()
@@ -75,7 +453,7 @@ void installDownloadedMods()
       u32 modfile_id = mod_json["modfile"]["id"];
       u32 date_updated = mod_json["date_updated"];
 
-      modio::writeLogLine("Installing mod " + modio::toString(mod_id), MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Installing mod " + modio::toString(mod_id), MODIO_DEBUGLEVEL_LOG);
 
       modio::createDirectory(installation_path);
       modio::writeLogLine("Extracting...", MODIO_DEBUGLEVEL_LOG);
@@ -83,6 +461,7 @@ void installDownloadedMods()
       modio::writeLogLine("Removing temporary file...", MODIO_DEBUGLEVEL_LOG);
       modio::removeFile(downloaded_zip_path);
       modio::writeJson(installation_path + std::string("modio.json"), mod_json);
+      modio::setInstalledModJson(mod_id, mod_json);
 
       modio::addToInstalledModsJson(mod_id,
                                     installation_path,
@@ -96,6 +475,8 @@ void installDownloadedMods()
       modio::writeLogLine("Mod data is missing, could not install mod.", MODIO_DEBUGLEVEL_ERROR);
     }
   }
+  // Written once for the whole batch, before the downloads are forgotten
+  writeInstalledMods();
   nlohmann::json empty_json;
   modio::writeJson(modio::getModIODirectory() + "downloaded_mods.json", empty_json);
   modio::writeLogLine("Finished installing downloaded mods", MODIO_DEBUGLEVEL_LOG);
@@ -135,33 +516,22 @@ void addToDownloadedModsJson(std::string installation_path, std::string download
 
 void addToInstalledModsJson(u32 mod_id, std::string path, u32 modfile_id, u32 date_updated)
 {
-  bool mod_reinstalled = false;
-  for (auto &installed_mod : modio::installed_mods)
-  {
-    if (modio::hasKey(installed_mod, "mod_id") &&
-        modio::hasKey(installed_mod, "path") &&
-        installed_mod["mod_id"] == mod_id &&
-        installed_mod["path"] == path)
-    {
-      installed_mod["modfile_id"] = modfile_id;
-      installed_mod["date_updated"] = date_updated;
-      mod_reinstalled = true;
-      break;
-    }
-  }
-
-  if (!mod_reinstalled)
-  {
-    nlohmann::json installed_mod_json;
-    installed_mod_json["path"] = path;
-    installed_mod_json["mod_id"] = mod_id;
-    installed_mod_json["modfile_id"] = modfile_id;
-    installed_mod_json["date_updated"] = date_updated;
-
-    modio::installed_mods.push_back(installed_mod_json);
-  }
+  // Taken after modio.json was written so the next initialization trusts it without reading it
+  FileFingerprint fingerprint = FileFingerprint();
+  modio::getFileFingerprint(path, "modio.json", fingerprint);
+  g_installed_mods.put(mod_id, path, modfile_id, date_updated, fingerprint);
+}
 
-  modio::writeJson(modio::getModIODirectory() + "installed_mods.json", modio::installed_mods);
+static bool getStoredFingerprint(const nlohmann::json &stored_installed_mod, FileFingerprint &fingerprint)
+{
+  if (!modio::hasKey(stored_installed_mod, "fingerprint") || !stored_installed_mod["fingerprint"].is_object())
+    return false;
+  const nlohmann::json &fingerprint_json = stored_installed_mod["fingerprint"];
+  fingerprint = FileFingerprint();
+  modio::getJsonValue(fingerprint_json, "directory_id", fingerprint.directory_id);
+  modio::getJsonValue(fingerprint_json, "modified_time", fingerprint.modified_time);
+  modio::getJsonValue(fingerprint_json, "size", fingerprint.size);
+  return fingerprint.modified_time != 0;
 }
 
 bool checkIfModIsStillInstalled(std::string path, u32 mod_id)
@@ -184,65 +554,118 @@ void updateInstalledModsJson()
 {
   modio::writeLogLine("Checking installed mod cache data...", MODIO_DEBUGLEVEL_LOG);
   nlohmann::json stored_installed_mods = modio::openJson(modio::getModIODirectory() + "installed_mods.json");
-  modio::installed_mods.clear();
+  g_installed_mods.clear();
+  g_entity_store.clearInstalledMods();
 
   // Migrating from v0.9.0
+  bool changed = false;
   if (modio::hasKey(stored_installed_mods, "mods"))
   {
     stored_installed_mods = stored_installed_mods["mods"];
+    changed = true;
   }
 
-  for (auto stored_installed_mod : stored_installed_mods)
+  u32 verified_mods = 0;
+  u32 read_mods = 0;
+  for (auto &stored_installed_mod : stored_installed_mods)
   {
-    if (modio::hasKey(stored_installed_mod, "path") && modio::hasKey(stored_installed_mod, "mod_id") && checkIfModIsStillInstalled(stored_installed_mod["path"], stored_installed_mod["mod_id"]))
+    if (!modio::hasKey(stored_installed_mod, "path") || !modio::hasKey(stored_installed_mod, "mod_id") || !stored_installed_mod["mod_id"].is_number())
+    {
+      changed = true;
+      continue;
+    }
+
+    std::string path = stored_installed_mod["path"];
+    FileFingerprint fingerprint;
+    if (!modio::getFileFingerprint(path, "modio.json", fingerprint))
     {
-      modio::installed_mods.push_back(stored_installed_mod);
+      changed = true;
+      continue;
+    }
+
+    u32 mod_id = stored_installed_mod["mod_id"];
+    u32 modfile_id = 0;
+    u32 date_updated = 0;
+    modio::getJsonValue(stored_installed_mod, "modfile_id", modfile_id);
+    modio::getJsonValue(stored_installed_mod, "date_updated", date_updated);
+
+    // An unchanged modio.json is trusted without reading it, getInstalledModJson reads it
+    // the first time it is asked for
+    FileFingerprint stored_fingerprint;
+    if (getStoredFingerprint(stored_installed_mod, stored_fingerprint) && stored_fingerprint == fingerprint)
+    {
+      g_installed_mods.put(mod_id, path, modfile_id, date_updated, fingerprint);
+      verified_mods++;
+      continue;
+    }
+
+    // The modio.json read to check the installation is kept so it is not read again
+    changed = true;
+    read_mods++;
+    nlohmann::json mod_json = modio::openJson(path + "modio.json");
+    if (modio::hasKey(mod_json, "id") && mod_json["id"] == mod_id)
+    {
+      g_installed_mods.put(mod_id, path, modfile_id, date_updated, fingerprint);
+      modio::setInstalledModJson(mod_id, mod_json);
     }
   }
 
-  modio::writeJson(modio::getModIODirectory() + "installed_mods.json", modio::installed_mods);
+  // Duplicated records were merged by put
+  if (changed || g_installed_mods.getCount() != stored_installed_mods.size())
+    g_installed_mods.write(modio::getModIODirectory() + "installed_mods.json");
+  else
+    g_installed_mods.markClean();
+
+  MODIO_LOG(modio::toString(verified_mods) + " installed mods verified by fingerprint, " + modio::toString(read_mods) + " read", MODIO_DEBUGLEVEL_LOG);
   modio::writeLogLine("Finished checking installed mod cache data...", MODIO_DEBUGLEVEL_LOG);
 }
 
+void writeInstalledMods()
+{
+  if (g_installed_mods.isDirty())
+    g_installed_mods.write(modio::getModIODirectory() + "installed_mods.json");
+}
+
+void closeInstalledMods()
+{
+  writeInstalledMods();
+  // Nothing is kept for a later modioInit, which may use another root path
+  g_installed_mods.clear();
+  g_installed_mods.markClean();
+}
+
+const InstalledModRecord *findInstalledMod(u32 mod_id)
+{
+  return g_installed_mods.find(mod_id);
+}
+
+const std::vector<InstalledModRecord> &getInstalledMods()
+{
+  return g_installed_mods.getRecords();
+}
+
 void clearOldCache()
 {
   modio::writeLogLine("Clearing old cache files...", MODIO_DEBUGLEVEL_LOG);
-  u32 current_time = modio::getCurrentTime();
-  nlohmann::json cache_json = modio::openJson(modio::getModIODirectory() + "cache.json");
-  nlohmann::json resulting_cache_json;
-  for (auto cache_file_json : cache_json)
-  {
-    if (modio::hasKey(cache_file_json, "datetime") && modio::hasKey(cache_file_json, "file"))
-    {
-      u32 cache_time = cache_file_json["datetime"];
-      u32 time_difference = current_time - cache_time;
 
-      if (time_difference > MAX_CACHE_TIME)
-      {
-        std::string cache_file_to_delete_path = modio::getModIODirectory() + "cache/";
-        std::string cache_filename = cache_file_json["file"];
-        cache_file_to_delete_path += cache_filename;
-        modio::removeFile(cache_file_to_delete_path);
-      }
-      else
-      {
-        resulting_cache_json.push_back(cache_file_json);
-      }
-    }
-  }
-  modio::writeJson(modio::getModIODirectory() + "cache.json", resulting_cache_json);
+  // The root path may have changed since the last initialization
+  g_memory_cache.clear();
+  g_entity_store.clear();
+  if (!g_cache_store.open(modio::getModIODirectory() + "cache.bin", modio::CACHE_MAX_BYTES))
+    modio::writeLogLine("Responses will not be cached on disk", MODIO_DEBUGLEVEL_WARNING);
+
+  // Expired responses are kept a while longer to be served stale while revalidating
+  u32 max_cache_time = MAX_CACHE_TIME > MODIO_CACHE_STALE_MAX_AGE_SECONDS ? MAX_CACHE_TIME : MODIO_CACHE_STALE_MAX_AGE_SECONDS;
+  double oldest_time_millis = modio::getCurrentTimeMillis() - max_cache_time * 1000.0;
+  g_cache_store.removeOlderThan(oldest_time_millis);
+  migrateLegacyCache(oldest_time_millis);
+
   modio::writeLogLine("Finished clearing old cache files.", MODIO_DEBUGLEVEL_LOG);
 }
 
 std::string getInstalledModPath(u32 mod_id)
 {
-  for (auto installed_mod_json : modio::installed_mods)
-  {
-    if (modio::hasKey(installed_mod_json, "mod_id") && modio::hasKey(installed_mod_json, "path") && installed_mod_json["mod_id"] == mod_id)
-    {
-      return installed_mod_json["path"];
-    }
-  }
-  return "";
+  const InstalledModRecord *installed_mod = g_installed_mods.find(mod_id);
+  return installed_mod ? installed_mod->path : "";
 }
 } // namespace modio
@@ -25,19 +25,37 @@ static void onAddModsToDownloadQueue(void *object, ModioResponse response, Modio
   }
 }
 
+// Edited mods waiting for their new data to patch the cached responses
+static std::set<u32> g_edited_mod_ids;
+
 static void onModsUpdateEvent(void *object, ModioResponse response, ModioMod *mods, u32 mods_size)
 {
   if (response.code == 200)
   {
     for (u32 i = 0; i < mods_size; i++)
     {
+      // The listing just fed the entity store with the mod as the API returned it
+      nlohmann::json api_mod_json;
+      if (modio::getStoredMod(mods[i].id, api_mod_json))
+      {
+        modio::patchCachedMod(api_mod_json);
+        g_edited_mod_ids.erase(mods[i].id);
+      }
+
       modio::Mod mod;
       mod.initialize(mods[i]);
       std::string mod_path_str = modio::getInstalledModPath(mod.id) + "modio.json";
-      modio::writeJson(mod_path_str, modio::toJson(mod));
+      nlohmann::json mod_json = modio::toJson(mod);
+      modio::writeJson(mod_path_str, mod_json);
+      modio::setInstalledModJson(mod.id, mod_json);
       modio::writeLogLine("Mod updated", MODIO_DEBUGLEVEL_LOG);
     }
   }
+
+  // Whatever could not be patched is dropped instead
+  for (auto mod_id : g_edited_mod_ids)
+    modio::invalidateCachedMod(mod_id);
+  g_edited_mod_ids.clear();
 }
 
 void updateModsCache(std::vector<u32> mod_ids)
@@ -83,18 +101,18 @@ static void onGetAllEventsPoll(void *object, ModioResponse response, ModioModEve
         break;
       case MODIO_EVENT_MODFILE_CHANGED:
       {
+        modio::invalidateStoredMod(events_array[i].mod_id, events_array[i].date_added);
+        modio::invalidateCachedMod(events_array[i].mod_id);
         bool reinstall = true;
-        for (auto installed_mod : modio::installed_mods)
+        const modio::InstalledModRecord *installed_mod = modio::findInstalledMod(events_array[i].mod_id);
+        if (installed_mod && installed_mod->date_updated >= events_array[i].date_added)
         {
-          if (modio::hasKey(installed_mod, "mod_id") && modio::hasKey(installed_mod, "date_updated") && installed_mod["mod_id"] == events_array[i].mod_id && installed_mod["date_updated"] >= events_array[i].date_added)
-          {
-            modio::writeLogLine("Modfile changed event detected but you already have a newer version installed, the modfile will not be downloaded. Mod id: " + modio::toString(events_array[i].mod_id), MODIO_DEBUGLEVEL_LOG);
-          }
+          MODIO_LOG("Modfile changed event detected but you already have a newer version installed, the modfile will not be downloaded. Mod id: " + modio::toString(events_array[i].mod_id), MODIO_DEBUGLEVEL_LOG);
         }
 
         if (reinstall)
         {
-          modio::writeLogLine("Modfile changed. Mod id: " + modio::toString(events_array[i].mod_id) + " Reisntalling...", MODIO_DEBUGLEVEL_LOG);
+          MODIO_LOG("Modfile changed. Mod id: " + modio::toString(events_array[i].mod_id) + " Reisntalling...", MODIO_DEBUGLEVEL_LOG);
           mod_to_download_queue_ids.push_back(events_array[i].mod_id);
         }
       }
@@ -106,12 +124,15 @@ static void onGetAllEventsPoll(void *object, ModioResponse response, ModioModEve
       }
       case MODIO_EVENT_MOD_UNAVAILABLE:
       {
-        // N/A
+        modio::removeStoredMod(events_array[i].mod_id);
+        modio::invalidateCachedMod(events_array[i].mod_id);
         break;
       }
       case MODIO_EVENT_MOD_EDITED:
       {
-        modio::writeLogLine("Mod updated. Mod id: " + modio::toString(events_array[i].mod_id) + " Updating cache...", MODIO_DEBUGLEVEL_LOG);
+        modio::invalidateStoredMod(events_array[i].mod_id, events_array[i].date_added);
+        g_edited_mod_ids.insert(events_array[i].mod_id);
+        MODIO_LOG("Mod updated. Mod id: " + modio::toString(events_array[i].mod_id) + " Updating cache...", MODIO_DEBUGLEVEL_LOG);
         mod_edited_ids.push_back(events_array[i].mod_id);
         break;
       }
@@ -128,7 +149,7 @@ static void onGetAllEventsPoll(void *object, ModioResponse response, ModioModEve
   }
   else
   {
-    modio::writeLogLine("Could not poll mod events. Error code: " + modio::toString(response.code), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not poll mod events. Error code: " + modio::toString(response.code), MODIO_DEBUGLEVEL_ERROR);
   }
 }
 
@@ -179,18 +200,18 @@ static void onGetUserEventsPoll(void *object, ModioResponse response, ModioUserE
       }
       case MODIO_EVENT_USER_SUBSCRIBE:
       {
-        modio::writeLogLine("Current User subscribed to a Mod. Mod id: " + modio::toString(events_array[i].mod_id) + " Installing...", MODIO_DEBUGLEVEL_LOG);
+        MODIO_LOG("Current User subscribed to a Mod. Mod id: " + modio::toString(events_array[i].mod_id) + " Installing...", MODIO_DEBUGLEVEL_LOG);
         std::string modfile_path_str = modio::getInstalledModPath(events_array[i].mod_id);
         if (modfile_path_str == "")
         {
-          modio::writeLogLine("Installing mod. Id: " + modio::toString(events_array[i].mod_id), MODIO_DEBUGLEVEL_LOG);
+          MODIO_LOG("Installing mod. Id: " + modio::toString(events_array[i].mod_id), MODIO_DEBUGLEVEL_LOG);
           mod_to_download_queue_ids.push_back(events_array[i].mod_id);
         }
         break;
       }
       case MODIO_EVENT_USER_UNSUBSCRIBE:
       {
-        modio::writeLogLine("Current User unsubscribed from a Mod. Mod id: " + modio::toString(events_array[i].mod_id) + " Uninstalling...", MODIO_DEBUGLEVEL_LOG);
+        MODIO_LOG("Current User unsubscribed from a Mod. Mod id: " + modio::toString(events_array[i].mod_id) + " Uninstalling...", MODIO_DEBUGLEVEL_LOG);
         modioUninstallMod(events_array[i].mod_id);
         break;
       }
@@ -204,7 +225,7 @@ static void onGetUserEventsPoll(void *object, ModioResponse response, ModioUserE
   }
   else
   {
-    modio::writeLogLine("Could not poll user events. Error code: " + modio::toString(response.code), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not poll user events. Error code: " + modio::toString(response.code), MODIO_DEBUGLEVEL_ERROR);
   }
 }
 
@@ -223,11 +244,15 @@ void pollEvents()
       modioAddFilterMinField(&filter, "date_added", modio::toString(modio::LAST_MOD_EVENT_POLL).c_str());
       modioAddFilterSmallerThanField(&filter, "date_added", modio::toString(current_time).c_str());
 
-      for (auto installed_mod : modio::installed_mods)
+      // Joined up front, adding the ids one by one copies the whole list every time
+      std::string installed_mod_ids;
+      for (auto &installed_mod : modio::getInstalledMods())
       {
-        if (modio::hasKey(installed_mod, "mod_id"))
-          modioAddFilterInField(&filter, "mod_id", modio::toString((u32)installed_mod["mod_id"]).c_str());
+        if (!installed_mod_ids.empty())
+          installed_mod_ids += ",";
+        installed_mod_ids += modio::toString(installed_mod.mod_id);
       }
+      modioAddFilterInField(&filter, "mod_id", installed_mod_ids.c_str());
 
       modioGetAllEvents(NULL, filter, &onGetAllEventsPoll);
       modioFreeFilter(&filter);
@@ -0,0 +1,146 @@
+#include "Prefetcher.h"
+#include "ModUtility.h"
+#include "Metrics.h"
+#include "wrappers/CurlWrapper.h"
+
+namespace modio
+{
+static std::deque<std::string> g_prefetch_queue;
+// Prefetched responses not served yet by canonical url hash, with the time they arrived
+static std::unordered_map<u64, double> g_prefetched_calls;
+// When the prefetches of the last minute started, oldest first
+static std::deque<double> g_prefetch_times;
+static u32 g_prefetch_requests = 0;
+static u32 g_prefetch_hits = 0;
+
+static std::string getNextPageUrl(const std::string &url, u32 offset)
+{
+  size_t query_begin = url.find('?');
+  std::string next_page_url = url.substr(0, query_begin) + "?";
+  std::string query = url.substr(query_begin + 1);
+  size_t begin = 0;
+  while (begin < query.size())
+  {
+    size_t end = query.find('&', begin);
+    if (end == std::string::npos)
+      end = query.size();
+
+    std::string param = query.substr(begin, end - begin);
+    if (!param.empty() && param.compare(0, 8, "_offset=") != 0)
+      next_page_url += param + "&";
+    begin = end + 1;
+  }
+  return next_page_url + "_offset=" + modio::toString(offset);
+}
+
+static void queuePrefetch(const std::string &url)
+{
+  if (g_prefetch_queue.size() >= MODIO_PREFETCH_QUEUE_SIZE)
+    return;
+
+  if (g_prefetched_calls.find(modio::getCanonicalUrlHash(url)) != g_prefetched_calls.end())
+    return;
+
+  g_prefetch_queue.push_back(url);
+  modio::setGauge(MODIO_GAUGE_PREFETCH_QUEUE, (u32)g_prefetch_queue.size());
+}
+
+void queueListingPrefetch(const std::string &url, const ModioResponse &response, const std::vector<u32> &mod_ids)
+{
+  if (modio::PREFETCH_BUDGET == 0)
+    return;
+
+  std::string mods_url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods";
+  if (url.compare(0, mods_url.size() + 1, mods_url + "?") != 0)
+    return;
+
+  // What the previous page would have needed is not relevant anymore
+  g_prefetch_queue.clear();
+  modio::setGauge(MODIO_GAUGE_PREFETCH_QUEUE, 0);
+
+  if (response.result_limit > 0 && response.result_offset + response.result_limit < response.result_total)
+    queuePrefetch(getNextPageUrl(url, response.result_offset + response.result_limit));
+
+  for (size_t i = 0; i < mod_ids.size(); i++)
+  {
+    std::string mod_url = mods_url + "/" + modio::toString(mod_ids[i]);
+    queuePrefetch(mod_url + "/dependencies/?api_key=" + modio::API_KEY);
+    queuePrefetch(mod_url + "/stats?api_key=" + modio::API_KEY);
+  }
+}
+
+bool getPrefetchedCall(const std::string &url, std::shared_ptr<const nlohmann::json> &response_json)
+{
+  auto prefetched_call = g_prefetched_calls.find(modio::getCanonicalUrlHash(url));
+  if (prefetched_call == g_prefetched_calls.end())
+    return false;
+
+  g_prefetched_calls.erase(prefetched_call);
+  if (!modio::getCallFromCache(url, MODIO_PREFETCH_MAX_AGE_SECONDS, response_json))
+    return false;
+
+  g_prefetch_hits++;
+  return true;
+}
+
+void processPrefetch()
+{
+  if (modio::PREFETCH_BUDGET == 0 || g_prefetch_queue.empty())
+    return;
+
+  double current_time_millis = modio::getCurrentTimeMillis();
+  for (auto it = g_prefetched_calls.begin(); it != g_prefetched_calls.end();)
+  {
+    if (current_time_millis - it->second > MODIO_PREFETCH_MAX_AGE_SECONDS * 1000.0)
+      it = g_prefetched_calls.erase(it);
+    else
+      it++;
+  }
+
+  // Prefetches only use the connection when nothing else needs it
+  if (modio::getCurrentTime() < modio::RETRY_AFTER || modio::curlwrapper::getPendingGetCount() > 0)
+    return;
+
+  while (!g_prefetch_times.empty() && current_time_millis - g_prefetch_times.front() > 60000.0)
+    g_prefetch_times.pop_front();
+  if (g_prefetch_times.size() >= modio::PREFETCH_BUDGET)
+    return;
+
+  std::string url = g_prefetch_queue.front();
+  g_prefetch_queue.pop_front();
+  modio::setGauge(MODIO_GAUGE_PREFETCH_QUEUE, (u32)g_prefetch_queue.size());
+  g_prefetch_times.push_back(current_time_millis);
+  g_prefetch_requests++;
+
+  modio::curlwrapper::get(modio::curlwrapper::getCallNumber(), url, modio::getHeaders(), [url](u32, u32 response_code, nlohmann::json response_json) {
+    if (response_code != 200)
+      return;
+
+    modio::addCallToCache(url, std::move(response_json));
+    g_prefetched_calls[modio::getCanonicalUrlHash(url)] = modio::getCurrentTimeMillis();
+  });
+}
+
+void clearPrefetch()
+{
+  g_prefetch_queue.clear();
+  g_prefetched_calls.clear();
+  g_prefetch_times.clear();
+  modio::setGauge(MODIO_GAUGE_PREFETCH_QUEUE, 0);
+}
+
+u32 getPrefetchRequestCount()
+{
+  return g_prefetch_requests;
+}
+
+u32 getPrefetchHitCount()
+{
+  return g_prefetch_hits;
+}
+
+u32 getPrefetchQueueSize()
+{
+  return (u32)g_prefetch_queue.size();
+}
+} // namespace modio
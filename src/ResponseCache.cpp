@@ -0,0 +1,166 @@
+#include "ResponseCache.h"
+
+namespace modio
+{
+ResponseCache::ResponseCache(u64 max_bytes_)
+  : max_bytes(max_bytes_), bytes(0)
+{
+}
+
+std::shared_ptr<const nlohmann::json> ResponseCache::get(const std::string &url, u32 max_age_seconds)
+{
+  Entry *entry = find(url, max_age_seconds);
+  if (!entry)
+    return NULL;
+  return entry->response_json;
+}
+
+void ResponseCache::add(const std::string &url, double datetime_millis, std::shared_ptr<const nlohmann::json> response_json, u64 size, const std::vector<u32> &tags)
+{
+  Entry entry;
+  entry.url = url;
+  entry.datetime_millis = datetime_millis;
+  entry.size = size;
+  entry.response_json = std::move(response_json);
+  entry.tags = tags;
+  insert(entry);
+}
+
+std::shared_ptr<const std::string> ResponseCache::getImage(const std::string &url, u32 max_age_seconds)
+{
+  Entry *entry = find(url, max_age_seconds);
+  if (!entry)
+    return NULL;
+  return entry->image;
+}
+
+void ResponseCache::addImage(const std::string &url, double datetime_millis, std::shared_ptr<const std::string> image, const std::vector<u32> &tags)
+{
+  Entry entry;
+  entry.url = url;
+  entry.datetime_millis = datetime_millis;
+  entry.size = image->size();
+  entry.image = std::move(image);
+  entry.tags = tags;
+  insert(entry);
+}
+
+void ResponseCache::touch(const std::string &url, double datetime_millis)
+{
+  auto it = index.find(modio::hash64(url));
+  if (it == index.end() || it->second->url != url)
+    return;
+
+  it->second->datetime_millis = datetime_millis;
+  entries.splice(entries.begin(), entries, it->second);
+}
+
+void ResponseCache::remove(const std::string &url)
+{
+  auto it = index.find(modio::hash64(url));
+  if (it == index.end() || it->second->url != url)
+    return;
+
+  erase(it);
+}
+
+void ResponseCache::removeTagged(u32 tag)
+{
+  std::vector<u64> keys;
+  auto range = tagged_keys.equal_range(tag);
+  for (auto tagged = range.first; tagged != range.second; tagged++)
+    keys.push_back(tagged->second);
+
+  for (auto key : keys)
+  {
+    auto it = index.find(key);
+    if (it != index.end())
+      erase(it);
+  }
+}
+
+void ResponseCache::clear()
+{
+  entries.clear();
+  index.clear();
+  tagged_keys.clear();
+  bytes = 0;
+}
+
+void ResponseCache::setMaxBytes(u64 max_bytes_)
+{
+  max_bytes = max_bytes_;
+  evict();
+}
+
+u64 ResponseCache::getBytes() const
+{
+  return bytes;
+}
+
+ResponseCache::Entry *ResponseCache::find(const std::string &url, u32 max_age_seconds)
+{
+  auto it = index.find(modio::hash64(url));
+  if (it == index.end() || it->second->url != url)
+    return NULL;
+
+  if (modio::getCurrentTimeMillis() - it->second->datetime_millis > max_age_seconds * 1000.0)
+    return NULL;
+
+  entries.splice(entries.begin(), entries, it->second);
+  return &*it->second;
+}
+
+void ResponseCache::insert(Entry &entry)
+{
+  remove(entry.url);
+
+  // A response larger than the whole budget would only flush everything else
+  if (entry.size > max_bytes)
+    return;
+
+  entry.key = modio::hash64(entry.url);
+
+  // Colliding urls simply replace each other
+  auto colliding = index.find(entry.key);
+  if (colliding != index.end())
+    erase(colliding);
+
+  u64 key = entry.key;
+  u64 size = entry.size;
+  for (auto tag : entry.tags)
+    tagged_keys.insert(std::make_pair(tag, key));
+  entries.push_front(std::move(entry));
+  index[key] = entries.begin();
+  bytes += size;
+
+  evict();
+}
+
+void ResponseCache::erase(std::unordered_map<u64, std::list<Entry>::iterator>::iterator it)
+{
+  Entry &entry = *it->second;
+  for (auto tag : entry.tags)
+  {
+    auto range = tagged_keys.equal_range(tag);
+    for (auto tagged = range.first; tagged != range.second; tagged++)
+    {
+      if (tagged->second == entry.key)
+      {
+        tagged_keys.erase(tagged);
+        break;
+      }
+    }
+  }
+
+  bytes -= entry.size;
+  entries.erase(it->second);
+  index.erase(it);
+}
+
+void ResponseCache::evict()
+{
+  while (bytes > max_bytes && !entries.empty())
+    erase(index.find(entries.back().key));
+}
+} // namespace modio
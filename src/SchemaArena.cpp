@@ -0,0 +1,112 @@
+#include "SchemaArena.h"
+
+namespace modio
+{
+static SchemaArena *g_current_schema_arena = NULL;
+static SchemaArena *g_live_schema_arenas = NULL;
+
+SchemaArena::SchemaArena()
+  : cursor(NULL), limit(NULL), next_block_size(MODIO_SCHEMA_ARENA_FIRST_BLOCK_SIZE), allocated_bytes(0), previous_live(g_live_schema_arenas)
+{
+  g_live_schema_arenas = this;
+}
+
+SchemaArena::~SchemaArena()
+{
+  // Arenas are locals of the callbacks so they die in reverse order, the search still
+  // copes with any order
+  SchemaArena **live = &g_live_schema_arenas;
+  while (*live && *live != this)
+    live = &((*live)->previous_live);
+  if (*live)
+    *live = previous_live;
+
+  for (size_t i = 0; i < blocks.size(); i++)
+    delete[] blocks[i].begin;
+}
+
+void *SchemaArena::allocate(size_t size, size_t alignment)
+{
+  if (size == 0)
+    size = 1;
+
+  size_t padding = (alignment - ((size_t)cursor % alignment)) % alignment;
+  if (!cursor || (size_t)(limit - cursor) < padding + size)
+  {
+    // Blocks grow so a large page takes few of them, oversized requests get their own
+    size_t block_size = next_block_size;
+    if (block_size < size + alignment)
+      block_size = size + alignment;
+    if (next_block_size < MODIO_SCHEMA_ARENA_MAX_BLOCK_SIZE)
+      next_block_size *= 2;
+
+    Block block;
+    block.begin = new char[block_size];
+    block.end = block.begin + block_size;
+    blocks.push_back(block);
+    cursor = block.begin;
+    limit = block.end;
+    padding = (alignment - ((size_t)cursor % alignment)) % alignment;
+  }
+
+  void *pointer = cursor + padding;
+  cursor += padding + size;
+  allocated_bytes += size;
+  return pointer;
+}
+
+bool SchemaArena::owns(const void *pointer) const
+{
+  const char *byte = (const char *)pointer;
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    if (byte >= blocks[i].begin && byte < blocks[i].end)
+      return true;
+  }
+  return false;
+}
+
+size_t SchemaArena::getAllocatedBytes() const
+{
+  return allocated_bytes;
+}
+
+SchemaArenaScope::SchemaArenaScope(SchemaArena &arena)
+  : previous_arena(g_current_schema_arena)
+{
+  g_current_schema_arena = &arena;
+}
+
+SchemaArenaScope::~SchemaArenaScope()
+{
+  g_current_schema_arena = previous_arena;
+}
+
+SchemaArena *getCurrentSchemaArena()
+{
+  return g_current_schema_arena;
+}
+
+void *allocateSchemaBytes(size_t size, size_t alignment)
+{
+  SchemaArena *arena = getCurrentSchemaArena();
+  if (!arena)
+    return new char[size];
+  return arena->allocate(size, alignment);
+}
+
+void freeSchemaBytes(void *bytes)
+{
+  freeSchemaArray((char *)bytes);
+}
+
+bool isSchemaArenaMemory(const void *pointer)
+{
+  for (SchemaArena *arena = g_live_schema_arenas; arena; arena = arena->previous_live)
+  {
+    if (arena->owns(pointer))
+      return true;
+  }
+  return false;
+}
+} // namespace modio
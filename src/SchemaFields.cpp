@@ -0,0 +1,239 @@
+#include "SchemaFields.h"
+
+#include <algorithm>
+
+namespace modio
+{
+static bool isKeyLess(const SchemaField &a, const SchemaField &b)
+{
+  return strcmp(a.key, b.key) < 0;
+}
+
+SchemaTable::SchemaTable(size_t struct_size, size_t struct_alignment, std::initializer_list<SchemaField> fields)
+  : struct_size(struct_size), struct_alignment(struct_alignment), fields(fields)
+{
+  // strcmp orders like the std::string keys of the json objects
+  std::sort(this->fields.begin(), this->fields.end(), isKeyLess);
+}
+
+template <typename T>
+static T &getField(void *object, size_t offset)
+{
+  return *(T *)((char *)object + offset);
+}
+
+template <typename T>
+static const T &getField(const void *object, size_t offset)
+{
+  return *(const T *)((const char *)object + offset);
+}
+
+// Array fields point to struct types the tables do not know, they are moved as bytes
+static void setArray(void *object, size_t offset, void *array)
+{
+  memcpy((char *)object + offset, &array, sizeof(array));
+}
+
+static char *getArray(const void *object, size_t offset)
+{
+  char *array;
+  memcpy(&array, (const char *)object + offset, sizeof(array));
+  return array;
+}
+
+static void decodeField(const SchemaField &field, void *object, const nlohmann::json &value_json)
+{
+  switch (field.type)
+  {
+  case MODIO_FIELD_U32:
+    getField<u32>(object, field.offset) = value_json.get<u32>();
+    break;
+  case MODIO_FIELD_I32:
+    getField<i32>(object, field.offset) = value_json.get<i32>();
+    break;
+  case MODIO_FIELD_LONG:
+    getField<long>(object, field.offset) = value_json.get<long>();
+    break;
+  case MODIO_FIELD_DOUBLE:
+    getField<double>(object, field.offset) = value_json.get<double>();
+    break;
+  case MODIO_FIELD_BOOL:
+    getField<bool>(object, field.offset) = value_json.get<bool>();
+    break;
+  case MODIO_FIELD_STRING:
+    getField<char *>(object, field.offset) = getJsonCString(value_json);
+    break;
+  case MODIO_FIELD_STRING_ARRAY:
+  {
+    u32 strings_size = (u32)value_json.size();
+    char **strings = allocateSchemaArray<char *>(strings_size);
+    for (u32 i = 0; i < strings_size; i++)
+      strings[i] = getJsonCString(value_json[i]);
+    getField<char **>(object, field.offset) = strings;
+    getField<u32>(object, field.size_offset) = strings_size;
+    break;
+  }
+  case MODIO_FIELD_OBJECT:
+    decodeSchema(*field.schema, (char *)object + field.offset, value_json);
+    break;
+  case MODIO_FIELD_OBJECT_ARRAY:
+  {
+    const SchemaTable &element_schema = *field.schema;
+    u32 elements_size = (u32)value_json.size();
+    char *elements = (char *)allocateSchemaBytes(elements_size * element_schema.struct_size, element_schema.struct_alignment);
+    for (u32 i = 0; i < elements_size; i++)
+      decodeSchema(element_schema, elements + i * element_schema.struct_size, value_json[i]);
+    setArray(object, field.offset, elements);
+    getField<u32>(object, field.size_offset) = elements_size;
+    break;
+  }
+  case MODIO_FIELD_ENUM:
+  {
+    // Values not in the list, or not even strings, decode as 0
+    const std::string *name = value_json.get_ptr<const std::string *>();
+    for (const SchemaEnumValue *enum_value = field.enum_values; name && enum_value->name; enum_value++)
+    {
+      if (*name == enum_value->name)
+      {
+        getField<u32>(object, field.offset) = enum_value->value;
+        break;
+      }
+    }
+    break;
+  }
+  }
+}
+
+void decodeSchema(const SchemaTable &schema, void *object, const nlohmann::json &object_json)
+{
+  // Every field kind is zero when missing, a null pointer for the strings and arrays
+  memset(object, 0, schema.struct_size);
+
+  const nlohmann::json::object_t *members = object_json.get_ptr<const nlohmann::json::object_t *>();
+  if (!members)
+    return;
+
+  nlohmann::json::object_t::const_iterator member = members->begin();
+  std::vector<SchemaField>::const_iterator field = schema.fields.begin();
+  while (member != members->end() && field != schema.fields.end())
+  {
+    int order = member->first.compare(field->key);
+    if (order < 0)
+    {
+      member++;
+    }
+    else if (order > 0)
+    {
+      field++;
+    }
+    else
+    {
+      // A null value counts as missing, the API sends null for unset fields
+      if (!member->second.is_null())
+        decodeField(*field, object, member->second);
+      member++;
+      field++;
+    }
+  }
+}
+
+void freeSchema(const SchemaTable &schema, void *object)
+{
+  for (auto &field : schema.fields)
+  {
+    switch (field.type)
+    {
+    case MODIO_FIELD_STRING:
+      freeSchemaArray(getField<char *>(object, field.offset));
+      break;
+    case MODIO_FIELD_STRING_ARRAY:
+    {
+      char **strings = getField<char **>(object, field.offset);
+      if (!strings)
+        break;
+      for (u32 i = 0; i < getField<u32>(object, field.size_offset); i++)
+        freeSchemaArray(strings[i]);
+      freeSchemaArray(strings);
+      break;
+    }
+    case MODIO_FIELD_OBJECT:
+      freeSchema(*field.schema, (char *)object + field.offset);
+      break;
+    case MODIO_FIELD_OBJECT_ARRAY:
+    {
+      char *elements = getArray(object, field.offset);
+      if (!elements)
+        break;
+      for (u32 i = 0; i < getField<u32>(object, field.size_offset); i++)
+        freeSchema(*field.schema, elements + i * field.schema->struct_size);
+      freeSchemaBytes(elements);
+      break;
+    }
+    }
+  }
+}
+
+nlohmann::json encodeSchema(const SchemaTable &schema, const void *object)
+{
+  nlohmann::json object_json = nlohmann::json::object();
+  for (auto &field : schema.fields)
+  {
+    switch (field.type)
+    {
+    case MODIO_FIELD_U32:
+      object_json[field.key] = getField<u32>(object, field.offset);
+      break;
+    case MODIO_FIELD_I32:
+      object_json[field.key] = getField<i32>(object, field.offset);
+      break;
+    case MODIO_FIELD_LONG:
+      object_json[field.key] = getField<long>(object, field.offset);
+      break;
+    case MODIO_FIELD_DOUBLE:
+      object_json[field.key] = getField<double>(object, field.offset);
+      break;
+    case MODIO_FIELD_BOOL:
+      object_json[field.key] = getField<bool>(object, field.offset);
+      break;
+    case MODIO_FIELD_STRING:
+      if (getField<char *>(object, field.offset))
+        object_json[field.key] = getField<char *>(object, field.offset);
+      break;
+    case MODIO_FIELD_STRING_ARRAY:
+    {
+      char *const *strings = getField<char **>(object, field.offset);
+      if (!strings)
+        break;
+      nlohmann::json &strings_json = object_json[field.key] = nlohmann::json::array();
+      for (u32 i = 0; i < getField<u32>(object, field.size_offset); i++)
+        strings_json.push_back(strings[i] ? strings[i] : "");
+      break;
+    }
+    case MODIO_FIELD_OBJECT:
+      object_json[field.key] = encodeSchema(*field.schema, (const char *)object + field.offset);
+      break;
+    case MODIO_FIELD_OBJECT_ARRAY:
+    {
+      const char *elements = getArray(object, field.offset);
+      if (!elements)
+        break;
+      nlohmann::json &elements_json = object_json[field.key] = nlohmann::json::array();
+      for (u32 i = 0; i < getField<u32>(object, field.size_offset); i++)
+        elements_json.push_back(encodeSchema(*field.schema, elements + i * field.schema->struct_size));
+      break;
+    }
+    case MODIO_FIELD_ENUM:
+      for (const SchemaEnumValue *enum_value = field.enum_values; enum_value->name; enum_value++)
+      {
+        if (enum_value->value == getField<u32>(object, field.offset))
+        {
+          object_json[field.key] = enum_value->name;
+          break;
+        }
+      }
+      break;
+    }
+  }
+  return object_json;
+}
+} // namespace modio
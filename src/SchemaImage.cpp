@@ -0,0 +1,241 @@
+#include "SchemaImage.h"
+#include "c/schemas/ModioMod.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+#define MODIO_SCHEMA_IMAGE_MAGIC 0x32474D49U // "IMG2"
+
+namespace modio
+{
+struct SchemaImageHeader
+{
+  u32 magic;
+  u32 layout_signature;
+  u32 mods_size;
+  u32 relocations_size;
+  u32 image_size;
+  u32 result_count;
+  u32 result_limit;
+  i32 result_offset;
+  u32 result_total;
+  u32 reserved;
+  u64 source_hash;
+};
+
+static void appendLayout(std::string &layout, const SchemaTable &schema)
+{
+  layout += modio::toString((u32)schema.struct_size) + "{";
+  for (auto &field : schema.fields)
+  {
+    layout += std::string(field.key) + ":" + modio::toString(field.type) + ":" + modio::toString((u32)field.offset) + ":" + modio::toString((u32)field.size_offset);
+    if (field.schema)
+      appendLayout(layout, *field.schema);
+    layout += ",";
+  }
+  layout += "}";
+}
+
+// Any change to the layout of the structs copied into an image, or to their schema
+// tables, changes the signature
+static u32 getLayoutSignature()
+{
+  static u32 layout_signature = 0;
+  if (layout_signature == 0)
+  {
+    std::string layout = modio::toString((u32)MODIO_SCHEMA_IMAGE_VERSION) + ":" + modio::toString((u32)sizeof(void *)) + ":";
+    appendLayout(layout, getModSchema());
+    layout_signature = (u32)(modio::hash64(layout) | 1);
+  }
+  return layout_signature;
+}
+
+class ImageWriter
+{
+public:
+  std::string image;
+  std::vector<u32> relocations;
+
+  // Appends a zeroed region and returns its offset
+  u32 reserve(size_t size, size_t alignment)
+  {
+    size_t offset = (image.size() + alignment - 1) & ~(alignment - 1);
+    image.resize(offset + size, '\0');
+    return (u32)offset;
+  }
+
+  u32 copy(const void *data, size_t size)
+  {
+    u32 offset = reserve(size, 8);
+    memcpy(&image[offset], data, size);
+    return offset;
+  }
+
+  void setPointer(size_t slot, u32 target)
+  {
+    uintptr_t value = target;
+    memcpy(&image[slot], &value, sizeof(value));
+    relocations.push_back((u32)slot);
+  }
+
+  void setNull(size_t slot)
+  {
+    uintptr_t value = 0;
+    memcpy(&image[slot], &value, sizeof(value));
+  }
+
+  void writeString(size_t slot, const char *str)
+  {
+    if (!str)
+    {
+      setNull(slot);
+      return;
+    }
+    size_t size = strlen(str) + 1;
+    u32 offset = reserve(size, 1);
+    memcpy(&image[offset], str, size);
+    setPointer(slot, offset);
+  }
+
+  void writeStrings(size_t slot, char **strings, u32 strings_size)
+  {
+    if (!strings || strings_size == 0)
+    {
+      setNull(slot);
+      return;
+    }
+    u32 offset = reserve(strings_size * sizeof(char *), 8);
+    setPointer(slot, offset);
+    for (u32 i = 0; i < strings_size; i++)
+      writeString(offset + i * sizeof(char *), strings[i]);
+  }
+};
+
+// Fills the pointers of a struct already copied to slot, walking its schema table
+static void writeSchema(ImageWriter &writer, size_t slot, const SchemaTable &schema, const char *object)
+{
+  for (auto &field : schema.fields)
+  {
+    switch (field.type)
+    {
+    case MODIO_FIELD_STRING:
+    {
+      char *str;
+      memcpy(&str, object + field.offset, sizeof(str));
+      writer.writeString(slot + field.offset, str);
+      break;
+    }
+    case MODIO_FIELD_STRING_ARRAY:
+    {
+      char **strings;
+      u32 strings_size;
+      memcpy(&strings, object + field.offset, sizeof(strings));
+      memcpy(&strings_size, object + field.size_offset, sizeof(strings_size));
+      writer.writeStrings(slot + field.offset, strings, strings_size);
+      break;
+    }
+    case MODIO_FIELD_OBJECT:
+      writeSchema(writer, slot + field.offset, *field.schema, object + field.offset);
+      break;
+    case MODIO_FIELD_OBJECT_ARRAY:
+    {
+      const char *elements;
+      u32 elements_size;
+      memcpy(&elements, object + field.offset, sizeof(elements));
+      memcpy(&elements_size, object + field.size_offset, sizeof(elements_size));
+      if (!elements || elements_size == 0)
+      {
+        writer.setNull(slot + field.offset);
+        break;
+      }
+      size_t element_size = field.schema->struct_size;
+      u32 elements_offset = writer.copy(elements, elements_size * element_size);
+      writer.setPointer(slot + field.offset, elements_offset);
+      for (u32 i = 0; i < elements_size; i++)
+        writeSchema(writer, elements_offset + i * element_size, *field.schema, elements + i * element_size);
+      break;
+    }
+    }
+  }
+}
+
+std::string serializeMods(const ModioResponse &response, const ModioMod *mods, u32 mods_size, u64 source_hash)
+{
+  ImageWriter writer;
+  // The mods come first so the rehydrated block can be used as the mods array directly
+  if (mods_size > 0)
+    writer.copy(mods, mods_size * sizeof(ModioMod));
+  for (u32 i = 0; i < mods_size; i++)
+    writeSchema(writer, i * sizeof(ModioMod), getModSchema(), (const char *)&mods[i]);
+
+  SchemaImageHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = MODIO_SCHEMA_IMAGE_MAGIC;
+  header.layout_signature = getLayoutSignature();
+  header.mods_size = mods_size;
+  header.relocations_size = (u32)writer.relocations.size();
+  header.image_size = (u32)writer.image.size();
+  header.result_count = response.result_count;
+  header.result_limit = response.result_limit;
+  header.result_offset = response.result_offset;
+  header.result_total = response.result_total;
+  header.source_hash = source_hash;
+
+  std::string serialized;
+  serialized.reserve(sizeof(header) + writer.relocations.size() * sizeof(u32) + writer.image.size());
+  serialized.append((const char *)&header, sizeof(header));
+  if (!writer.relocations.empty())
+    serialized.append((const char *)&writer.relocations[0], writer.relocations.size() * sizeof(u32));
+  serialized.append(writer.image);
+  return serialized;
+}
+
+u64 *rehydrateMods(const std::string &image, ModioResponse &response, ModioMod *&mods, u32 &mods_size, u64 &source_hash)
+{
+  SchemaImageHeader header;
+  if (image.size() < sizeof(header))
+    return NULL;
+  memcpy(&header, image.c_str(), sizeof(header));
+
+  if (header.magic != MODIO_SCHEMA_IMAGE_MAGIC || header.layout_signature != getLayoutSignature())
+    return NULL;
+
+  size_t relocations_bytes = (size_t)header.relocations_size * sizeof(u32);
+  if (image.size() != sizeof(header) + relocations_bytes + header.image_size || (u64)header.mods_size * sizeof(ModioMod) > header.image_size)
+    return NULL;
+
+  const char *relocations = image.c_str() + sizeof(header);
+  u64 *block = new u64[header.image_size / sizeof(u64) + 1];
+  char *base = (char *)block;
+  memcpy(base, relocations + relocations_bytes, header.image_size);
+
+  for (u32 i = 0; i < header.relocations_size; i++)
+  {
+    u32 slot;
+    memcpy(&slot, relocations + i * sizeof(u32), sizeof(slot));
+    uintptr_t target;
+    if ((u64)slot + sizeof(target) > header.image_size)
+    {
+      delete[] block;
+      return NULL;
+    }
+    memcpy(&target, base + slot, sizeof(target));
+    if (target >= header.image_size)
+    {
+      delete[] block;
+      return NULL;
+    }
+    char *pointer = base + target;
+    memcpy(base + slot, &pointer, sizeof(pointer));
+  }
+
+  response.result_count = header.result_count;
+  response.result_limit = header.result_limit;
+  response.result_offset = header.result_offset;
+  response.result_total = header.result_total;
+  mods = header.mods_size > 0 ? (ModioMod *)base : NULL;
+  mods_size = header.mods_size;
+  source_hash = header.source_hash;
+  return block;
+}
+} // namespace modio
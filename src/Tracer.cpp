@@ -0,0 +1,173 @@
+#include "Tracer.h"
+#include "Utility.h"
+
+namespace modio
+{
+std::atomic<bool> TRACING(false);
+
+static std::mutex g_trace_mutex;
+static std::vector<TraceEvent> g_trace_events;
+static size_t g_trace_max_events = 0;
+// Where the next event goes once the ring is full
+static size_t g_trace_next = 0;
+static u64 g_trace_dropped = 0;
+
+TraceArgs::TraceArgs()
+  : has_response_code(false), response_code(0), mod_id(0)
+{
+}
+
+static u32 getTraceThreadId()
+{
+  return (u32)std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+
+static void addTraceEvent(TraceEvent &event)
+{
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (g_trace_max_events == 0)
+    return;
+
+  if (g_trace_events.size() < g_trace_max_events)
+  {
+    g_trace_events.push_back(std::move(event));
+    return;
+  }
+
+  g_trace_events[g_trace_next] = std::move(event);
+  g_trace_next = (g_trace_next + 1) % g_trace_max_events;
+  g_trace_dropped++;
+}
+
+TraceScope::TraceScope(const char *name, const char *category)
+  : name(name), category(category), start_micros(-1)
+{
+  if (modio::isTracing())
+    start_micros = modio::getSteadyTimeMicros();
+}
+
+TraceScope::~TraceScope()
+{
+  if (start_micros >= 0 && modio::isTracing())
+    modio::addTraceSpan(name, category, start_micros, modio::getSteadyTimeMicros());
+}
+
+void startTracing(u32 max_events)
+{
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  g_trace_events.clear();
+  g_trace_max_events = max_events > 0 ? max_events : MODIO_TRACE_DEFAULT_MAX_EVENTS;
+  g_trace_events.reserve(g_trace_max_events);
+  g_trace_next = 0;
+  g_trace_dropped = 0;
+  TRACING = true;
+}
+
+void stopTracing()
+{
+  TRACING = false;
+}
+
+void addTraceSpan(const char *name, const char *category, double start_micros, double end_micros, const TraceArgs &args)
+{
+  TraceEvent event;
+  event.name = name;
+  event.category = category;
+  event.phase = 'X';
+  event.id = 0;
+  event.timestamp_micros = start_micros;
+  event.duration_micros = end_micros > start_micros ? end_micros - start_micros : 0;
+  event.thread_id = getTraceThreadId();
+  event.args = args;
+  addTraceEvent(event);
+}
+
+void addAsyncTraceSpan(const char *name, const char *category, u64 id, double start_micros, double end_micros, const TraceArgs &args)
+{
+  if (end_micros < start_micros)
+    end_micros = start_micros;
+
+  TraceEvent begin_event;
+  begin_event.name = name;
+  begin_event.category = category;
+  begin_event.phase = 'b';
+  begin_event.id = id;
+  begin_event.timestamp_micros = start_micros;
+  begin_event.duration_micros = 0;
+  begin_event.thread_id = getTraceThreadId();
+  begin_event.args = args;
+
+  TraceEvent end_event;
+  end_event.name = name;
+  end_event.category = category;
+  end_event.phase = 'e';
+  end_event.id = id;
+  end_event.timestamp_micros = end_micros;
+  end_event.duration_micros = 0;
+  end_event.thread_id = begin_event.thread_id;
+
+  addTraceEvent(begin_event);
+  addTraceEvent(end_event);
+}
+
+// Hex strings, viewers read ids as JavaScript numbers that lose the top bits of a u64
+static std::string getTraceId(u64 id)
+{
+  char id_string[24];
+  snprintf(id_string, sizeof(id_string), "0x%llx", (unsigned long long)id);
+  return id_string;
+}
+
+static nlohmann::json getTraceArgsJson(const TraceArgs &args)
+{
+  nlohmann::json args_json;
+  if (!args.url.empty())
+    args_json["url"] = args.url;
+  if (args.has_response_code)
+    args_json["response_code"] = args.response_code;
+  if (args.mod_id != 0)
+    args_json["mod_id"] = args.mod_id;
+  return args_json;
+}
+
+bool writeTrace(const std::string &path)
+{
+  nlohmann::json trace_json;
+  nlohmann::json trace_events_json = nlohmann::json::array();
+  {
+    std::lock_guard<std::mutex> lock(g_trace_mutex);
+    // Oldest first, the viewer does not need it but diffs of two traces read better
+    for (size_t i = 0; i < g_trace_events.size(); i++)
+    {
+      const TraceEvent &event = g_trace_events[(g_trace_next + i) % g_trace_events.size()];
+      nlohmann::json event_json;
+      event_json["name"] = event.name;
+      event_json["cat"] = event.category;
+      event_json["ph"] = std::string(1, event.phase);
+      event_json["ts"] = event.timestamp_micros;
+      event_json["pid"] = 1;
+      event_json["tid"] = event.thread_id;
+      if (event.phase == 'X')
+        event_json["dur"] = event.duration_micros;
+      else
+        event_json["id"] = getTraceId(event.id);
+      nlohmann::json args_json = getTraceArgsJson(event.args);
+      if (!args_json.is_null())
+        event_json["args"] = args_json;
+      trace_events_json.push_back(event_json);
+    }
+    trace_json["otherData"]["dropped_events"] = g_trace_dropped;
+  }
+  trace_json["traceEvents"] = trace_events_json;
+  trace_json["displayTimeUnit"] = "ms";
+
+  std::ofstream trace_file(path, std::ios::binary | std::ios::trunc);
+  if (!trace_file.is_open())
+  {
+    MODIO_LOG("Could not open " + path + " to write the trace", MODIO_DEBUGLEVEL_ERROR);
+    return false;
+  }
+  trace_file << trace_json.dump();
+  return trace_file.good();
+}
+} // namespace modio
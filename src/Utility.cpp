@@ -1,10 +1,15 @@
 #include "Utility.h"
+#include "Logger.h"
+#include "JsonParser.h"
+
+#include <iterator>
+#include <sstream>
 
 namespace modio
 {
 
 #ifdef MODIO_WINDOWS_DETECTED
-static wchar_t *WideCharFromString(std::string const &str)
+wchar_t *WideCharFromString(std::string const &str)
 {
   // returns the number of required wchar_t WITHOUT terminating NUL
   size_t rl = mbstowcs(NULL, str.c_str(), 0);
@@ -90,21 +95,12 @@ void writeLogLine(const std::string &text, u32 debug_level)
   if (DEBUG_LEVEL < debug_level)
     return;
 
-  std::ofstream log_file(getModIODirectory() + "log", std::ios::app);
-  log_file << "[" << modio::getCurrentTime() << "] ";
-  if (debug_level == MODIO_DEBUGLEVEL_ERROR)
-  {
-    log_file << "[Error] ";
-  }
-  else if (debug_level == MODIO_DEBUGLEVEL_WARNING)
-  {
-    log_file << "[WARNING] ";
-  }
-  else if (debug_level == MODIO_DEBUGLEVEL_LOG)
-  {
-    log_file << "[LOG] ";
-  }
-  log_file << text.c_str() << "\n";
+  if (modio::queueLogLine(debug_level, text))
+    return;
+
+  modio::callLogListener(debug_level, text);
+  std::ofstream log_file(getModIODirectory() + "log", std::ios::binary | std::ios::app);
+  log_file << modio::formatLogLine(debug_level, modio::getCurrentTime(), text);
   log_file.close();
 }
 
@@ -121,6 +117,12 @@ u32 getCurrentTime()
   return (u32)std::time(nullptr);
 }
 
+double getSteadyTimeMicros()
+{
+  static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+  return (double)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
 double getCurrentTimeMillis()
 {
   std::chrono::milliseconds current_time =
@@ -128,11 +130,180 @@ double getCurrentTimeMillis()
   return (double)current_time.count();
 }
 
+// Hash methods
+
+u64 hash64(const std::string &str)
+{
+  // FNV-1a, stable across platforms and runs so it can be used for on-disk keys
+  u64 hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < str.size(); i++)
+  {
+    hash ^= (unsigned char)str[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Url methods
+
+static std::string decodeQueryComponent(const std::string &str)
+{
+  std::string decoded;
+  decoded.reserve(str.size());
+  for (size_t i = 0; i < str.size(); i++)
+  {
+    if (str[i] == '%' && i + 2 < str.size() && isxdigit((unsigned char)str[i + 1]) && isxdigit((unsigned char)str[i + 2]))
+    {
+      decoded += (char)strtol(str.substr(i + 1, 2).c_str(), NULL, 16);
+      i += 2;
+    }
+    else
+    {
+      decoded += str[i];
+    }
+  }
+  return decoded;
+}
+
+static std::string encodeQueryComponent(const std::string &str)
+{
+  static const char hex_digits[] = "0123456789ABCDEF";
+  std::string encoded;
+  encoded.reserve(str.size());
+  for (size_t i = 0; i < str.size(); i++)
+  {
+    unsigned char c = (unsigned char)str[i];
+    if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == ',')
+    {
+      encoded += (char)c;
+    }
+    else
+    {
+      encoded += '%';
+      encoded += hex_digits[c >> 4];
+      encoded += hex_digits[c & 15];
+    }
+  }
+  return encoded;
+}
+
+static bool endsWith(const std::string &str, const std::string &suffix)
+{
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static std::string getCanonicalList(const std::string &list)
+{
+  std::vector<std::string> values;
+  size_t begin = 0;
+  while (begin <= list.size())
+  {
+    size_t end = list.find(',', begin);
+    if (end == std::string::npos)
+      end = list.size();
+    if (end > begin)
+      values.push_back(list.substr(begin, end - begin));
+    begin = end + 1;
+  }
+
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+
+  std::string canonical_list;
+  for (size_t i = 0; i < values.size(); i++)
+    canonical_list += (i > 0 ? "," : "") + encodeQueryComponent(values[i]);
+  return canonical_list;
+}
+
+std::string getCanonicalUrl(const std::string &url)
+{
+  size_t query_begin = url.find('?');
+  if (query_begin == std::string::npos)
+    return url;
+
+  std::vector<std::string> params;
+  std::string query = url.substr(query_begin + 1);
+  size_t begin = 0;
+  while (begin <= query.size())
+  {
+    size_t end = query.find('&', begin);
+    if (end == std::string::npos)
+      end = query.size();
+
+    std::string param = query.substr(begin, end - begin);
+    begin = end + 1;
+    if (param.empty())
+      continue;
+
+    size_t separator = param.find('=');
+    std::string name = decodeQueryComponent(param.substr(0, separator));
+    std::string value = separator == std::string::npos ? "" : decodeQueryComponent(param.substr(separator + 1));
+
+    if (endsWith(name, "-in"))
+      value = getCanonicalList(value);
+    else
+      value = encodeQueryComponent(value);
+
+    params.push_back(encodeQueryComponent(name) + "=" + value);
+  }
+
+  std::sort(params.begin(), params.end());
+
+  std::string canonical_url = url.substr(0, query_begin + 1);
+  for (size_t i = 0; i < params.size(); i++)
+    canonical_url += (i > 0 ? "&" : "") + params[i];
+  return canonical_url;
+}
+
+u64 getCanonicalUrlHash(const std::string &url)
+{
+  return modio::hash64(modio::getCanonicalUrl(url));
+}
+
 // Json methods
 
-bool hasKey(nlohmann::json json_object, const std::string &key)
+bool hasKey(const nlohmann::json &json_object, const std::string &key)
 {
-  return json_object.find(key) != json_object.end() && !json_object[key].is_null();
+  return findKey(json_object, key.c_str()) != NULL;
+}
+
+const nlohmann::json *findKey(const nlohmann::json &json_object, const char *key)
+{
+  if (!json_object.is_object())
+    return NULL;
+  nlohmann::json::const_iterator it = json_object.find(key);
+  if (it == json_object.end() || it->is_null())
+    return NULL;
+  return &(*it);
+}
+
+void getJsonValue(const nlohmann::json &json_object, const char *key, std::string &value)
+{
+  const nlohmann::json *value_json = findKey(json_object, key);
+  if (value_json)
+    value = value_json->get_ref<const std::string &>();
+}
+
+const nlohmann::json &getJsonChild(const nlohmann::json &json_object, const char *key)
+{
+  static const nlohmann::json null_json;
+  const nlohmann::json *child_json = findKey(json_object, key);
+  return child_json ? *child_json : null_json;
+}
+
+char *getJsonCString(const nlohmann::json &json_object, const char *key)
+{
+  const nlohmann::json *value_json = findKey(json_object, key);
+  return value_json ? getJsonCString(*value_json) : NULL;
+}
+
+char *getJsonCString(const nlohmann::json &string_json)
+{
+  // Reads the string in place instead of copying it out first
+  const std::string &value = string_json.get_ref<const std::string &>();
+  char *c_string = modio::allocateSchemaArray<char>(value.size() + 1);
+  memcpy(c_string, value.c_str(), value.size() + 1);
+  return c_string;
 }
 
 nlohmann::json toJson(const std::string &json_str)
@@ -141,13 +312,17 @@ nlohmann::json toJson(const std::string &json_str)
     return "{}"_json;
 
   nlohmann::json response_json;
+  // Anything the structural parser turns down goes through nlohmann, which reports the error
+  if (parseJson(json_str.data(), json_str.size(), response_json))
+    return response_json;
+
   try
   {
     response_json = nlohmann::json::parse(json_str);
   }
   catch (nlohmann::json::parse_error &e)
   {
-    writeLogLine(std::string("Error parsing json: ") + e.what(), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG(std::string("Error parsing json: ") + e.what(), MODIO_DEBUGLEVEL_ERROR);
     response_json = "{}"_json;
   }
   return response_json;
@@ -155,18 +330,25 @@ nlohmann::json toJson(const std::string &json_str)
 
 nlohmann::json openJson(const std::string &file_path)
 {
-  std::ifstream ifs(file_path);
+  std::ifstream ifs(file_path, std::ios::binary);
   nlohmann::json cache_file_json;
   if (ifs.is_open())
   {
-    try
+    std::string json_str((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    if (!parseJson(json_str.data(), json_str.size(), cache_file_json))
     {
-      ifs >> cache_file_json;
-    }
-    catch (nlohmann::json::parse_error &e)
-    {
-      modio::writeLogLine(std::string("Error parsing json: ") + e.what(), MODIO_DEBUGLEVEL_ERROR);
-      cache_file_json = {};
+      // Read as a stream like before, which also skips whatever follows the first value
+      std::istringstream json_stream(json_str);
+      try
+      {
+        cache_file_json = nlohmann::json();
+        json_stream >> cache_file_json;
+      }
+      catch (nlohmann::json::parse_error &e)
+      {
+        MODIO_LOG(std::string("Error parsing json: ") + e.what(), MODIO_DEBUGLEVEL_ERROR);
+        cache_file_json = {};
+      }
     }
   }
   ifs.close();
@@ -202,7 +384,7 @@ static void writeLastErrorLog(const std::string &error_function)
 
   std::string message(messageBuffer, size);
 
-  modio::writeLogLine("Error while using " + error_function + ": " + message, MODIO_DEBUGLEVEL_ERROR);
+  MODIO_LOG("Error while using " + error_function + ": " + message, MODIO_DEBUGLEVEL_ERROR);
 
   //Free the buffer.
   LocalFree(messageBuffer);
@@ -213,9 +395,9 @@ static void writeLastErrorLog(const std::string &error_function)
 static void removeEmptyDirectory(const std::string &path)
 {
   if (remove(path.c_str()))
-    writeLogLine(path + " removed", MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG(path + " removed", MODIO_DEBUGLEVEL_LOG);
   else
-    writeLogLine("Could not remove " + path, MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not remove " + path, MODIO_DEBUGLEVEL_ERROR);
 }
 #endif
 
@@ -381,7 +563,7 @@ void createDirectory(const std::string &directory)
   if (modio::directoryExists(directory))
     return;
 
-  writeLogLine("Creating directory " + directory, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Creating directory " + directory, MODIO_DEBUGLEVEL_LOG);
 #if defined(MODIO_LINUX_DETECTED) || defined(MODIO_OSX_DETECTED)
   mkdir(directory.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
 #endif
@@ -399,7 +581,7 @@ bool removeDirectory(const std::string &directory)
 #ifdef MODIO_WINDOWS_DETECTED
   DWORD error_code = deleteDirectoryWindows(directory);
   if (error_code != 0)
-    modio::writeLogLine("Could not remove directory, error code: " + modio::toString((u32)error_code), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not remove directory, error code: " + modio::toString((u32)error_code), MODIO_DEBUGLEVEL_ERROR);
   return error_code == 0;
 #else
 
@@ -427,12 +609,12 @@ bool removeDirectory(const std::string &directory)
         closedir(subdir);
         removeDirectory(path);
       }
-      writeLogLine("Deleting: " + std::string(path), MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Deleting: " + std::string(path), MODIO_DEBUGLEVEL_LOG);
       removeFile(path);
     }
   }
   closedir(dir);
-  writeLogLine("Deleting: " + directory_with_slash, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Deleting: " + directory_with_slash, MODIO_DEBUGLEVEL_LOG);
   removeEmptyDirectory(directory_with_slash);
 
   return true;
@@ -442,9 +624,9 @@ bool removeDirectory(const std::string &directory)
 void removeFile(const std::string &filename)
 {
   if (remove(filename.c_str()) != 0)
-    writeLogLine("Could not remove " + filename, MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not remove " + filename, MODIO_DEBUGLEVEL_ERROR);
   else
-    writeLogLine(filename + " removed", MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG(filename + " removed", MODIO_DEBUGLEVEL_LOG);
 }
 
 double getFileSize(const std::string &file_path)
@@ -460,6 +642,47 @@ double getFileSize(const std::string &file_path)
   return file_size;
 }
 
+bool operator==(const FileFingerprint &left, const FileFingerprint &right)
+{
+  return left.directory_id == right.directory_id && left.modified_time == right.modified_time && left.size == right.size;
+}
+
+bool operator!=(const FileFingerprint &left, const FileFingerprint &right)
+{
+  return !(left == right);
+}
+
+bool getFileFingerprint(const std::string &directory, const std::string &filename, FileFingerprint &fingerprint)
+{
+  std::string directory_with_slash = modio::addSlashIfNeeded(directory);
+#ifdef MODIO_WINDOWS_DETECTED
+  // st_ino is always 0 on Windows and st_mtime is in whole seconds, the modification time
+  // and size carry the fingerprint
+  struct _stat64 file_stat;
+  wchar_t *file_path_wc = WideCharFromString(directory_with_slash + filename);
+  int result = _wstat64(file_path_wc, &file_stat);
+  free(file_path_wc);
+  if (result != 0)
+    return false;
+  fingerprint.directory_id = 0;
+  fingerprint.modified_time = (u64)file_stat.st_mtime * 1000000000ULL;
+  fingerprint.size = (u64)file_stat.st_size;
+#else
+  struct stat directory_stat;
+  struct stat file_stat;
+  if (stat(directory_with_slash.c_str(), &directory_stat) != 0 || stat((directory_with_slash + filename).c_str(), &file_stat) != 0)
+    return false;
+  fingerprint.directory_id = (u64)directory_stat.st_ino;
+#  ifdef MODIO_OSX_DETECTED
+  fingerprint.modified_time = (u64)file_stat.st_mtimespec.tv_sec * 1000000000ULL + (u64)file_stat.st_mtimespec.tv_nsec;
+#  else
+  fingerprint.modified_time = (u64)file_stat.st_mtim.tv_sec * 1000000000ULL + (u64)file_stat.st_mtim.tv_nsec;
+#  endif
+  fingerprint.size = (u64)file_stat.st_size;
+#endif
+  return true;
+}
+
 void createPath(const std::string &path)
 {
   std::string current_path;
@@ -59,6 +59,15 @@ void Instance::compressFiles(std::string root_directory, std::vector<std::string
   modio::minizipwrapper::compressFiles(root_directory, filenames, zip_path);
 }
 
+modio::Metrics Instance::getMetrics()
+{
+  ModioMetrics modio_metrics = modioGetMetrics();
+  modio::Metrics metrics;
+  metrics.initialize(modio_metrics);
+  modioFreeMetrics(&modio_metrics);
+  return metrics;
+}
+
 void Instance::process()
 {
   modioProcess();
@@ -33,6 +33,11 @@ namespace modio
     modioSetFilterCacheMaxAgeSeconds(filter, max_age_seconds);
   }
 
+  void FilterCreator::setCachePolicy(u32 cache_policy)
+  {
+    modioSetFilterCachePolicy(filter, cache_policy);
+  }
+
   void FilterCreator::addFieldValue(const std::string& field, const std::string& value)
   {
     modioAddFilterFieldValue(filter, field.c_str(), value.c_str());
@@ -7,7 +7,7 @@ void Instance::getMod(u32 mod_id, const std::function<void(const modio::Response
   struct GetModCall *get_mod_call = new GetModCall{callback};
   get_mod_calls[current_call_id] = get_mod_call;
 
-  modioGetMod((void*)((uintptr_t)current_call_id), mod_id, &onGetMod);
+  modio::getModJson((void*)((uintptr_t)current_call_id), mod_id, &onGetModJson);
 
   current_call_id++;
 }
@@ -17,7 +17,7 @@ void Instance::getAllMods(modio::FilterCreator &filter, const std::function<void
   struct GetAllModsCall *get_mods_call = new GetAllModsCall{callback};
   get_all_mods_calls[current_call_id] = get_mods_call;
 
-  modioGetAllMods((void*)((uintptr_t)current_call_id), *filter.getFilter(), &onGetAllMods);
+  modio::getAllModsJson((void*)((uintptr_t)current_call_id), *filter.getFilter(), &onGetAllMods, &onGetAllModsJson);
 
   current_call_id++;
 }
@@ -46,8 +46,12 @@ void onGetUserSubscriptions(void *object, ModioResponse modio_response, ModioMod
 
   get_user_subscriptions_calls[call_id]->callback(response, mods_vector);
 
-  delete get_user_subscriptions_calls[call_id];
-  get_user_subscriptions_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_user_subscriptions_calls[call_id];
+    get_user_subscriptions_calls.erase(call_id);
+  }
 }
 
 void onGetUserEvents(void *object, ModioResponse modio_response, ModioUserEvent *events_array, u32 events_array_size)
@@ -85,8 +89,12 @@ void onGetUserGames(void *object, ModioResponse modio_response, ModioGame games[
 
   get_user_games_calls[call_id]->callback(response, games_vector);
 
-  delete get_user_games_calls[call_id];
-  get_user_games_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_user_games_calls[call_id];
+    get_user_games_calls.erase(call_id);
+  }
 }
 
 void onGetUserMods(void *object, ModioResponse modio_response, ModioMod mods[], u32 mods_size)
@@ -105,8 +113,12 @@ void onGetUserMods(void *object, ModioResponse modio_response, ModioMod mods[],
 
   get_user_mods_calls[call_id]->callback(response, mods_vector);
 
-  delete get_user_mods_calls[call_id];
-  get_user_mods_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_user_mods_calls[call_id];
+    get_user_mods_calls.erase(call_id);
+  }
 }
 
 void onGetUserModfiles(void *object, ModioResponse modio_response, ModioModfile modfiles[], u32 modfiles_size)
@@ -125,8 +137,12 @@ void onGetUserModfiles(void *object, ModioResponse modio_response, ModioModfile
 
   get_user_modfiles_calls[call_id]->callback(response, modfiles_vector);
 
-  delete get_user_modfiles_calls[call_id];
-  get_user_modfiles_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_user_modfiles_calls[call_id];
+    get_user_modfiles_calls.erase(call_id);
+  }
 }
 
 void onGetUserRatings(void *object, ModioResponse modio_response, ModioRating ratings[], u32 ratings_size)
@@ -145,8 +161,12 @@ void onGetUserRatings(void *object, ModioResponse modio_response, ModioRating ra
 
   get_user_ratings_calls[call_id]->callback(response, ratings_vector);
 
-  delete get_user_ratings_calls[call_id];
-  get_user_ratings_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_user_ratings_calls[call_id];
+    get_user_ratings_calls.erase(call_id);
+  }
 }
 
 void clearMeRequestCalls()
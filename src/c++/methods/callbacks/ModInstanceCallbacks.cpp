@@ -28,6 +28,26 @@ void onGetMod(void *object, ModioResponse modio_response, ModioMod mod)
   get_mod_calls.erase(call_id);
 }
 
+void onGetModJson(void *object, ModioResponse modio_response, const nlohmann::json &mod_json)
+{
+  u32 call_id = (u32)((uintptr_t)object);
+
+  modio::Response response;
+  response.initialize(modio_response);
+
+  modio::Mod modio_mod;
+
+  if (modio_response.code == 200)
+  {
+    modio_mod.initialize(mod_json);
+  }
+
+  get_mod_calls[call_id]->callback(response, modio_mod);
+
+  delete get_mod_calls[call_id];
+  get_mod_calls.erase(call_id);
+}
+
 void onGetAllMods(void *object, ModioResponse modio_response, ModioMod mods[], u32 mods_size)
 {
   u32 call_id = (u32)((uintptr_t)object);
@@ -44,8 +64,44 @@ void onGetAllMods(void *object, ModioResponse modio_response, ModioMod mods[], u
 
   get_all_mods_calls[call_id]->callback(response, mods_vector);
 
-  delete get_all_mods_calls[call_id];
-  get_all_mods_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_all_mods_calls[call_id];
+    get_all_mods_calls.erase(call_id);
+  }
+}
+
+void onGetAllModsJson(void *object, ModioResponse modio_response, const nlohmann::json &mods_json)
+{
+  u32 call_id = (u32)((uintptr_t)object);
+
+  modio::Response response;
+  response.initialize(modio_response);
+
+  // Straight from the response, the mods are never decoded into ModioMod structs first
+  std::vector<modio::Mod> mods_vector;
+  if (modio_response.code == 200)
+  {
+    mods_vector.resize(mods_json.size());
+    for (size_t i = 0; i < mods_vector.size(); i++)
+    {
+      // The listing was retained for the heavy fields, see LazyFields.h
+      if (modio::LAZY_FIELDS == MODIO_LAZY_FIELDS_ENABLED)
+        mods_vector[i].initializeLazyFields(mods_json[i]);
+      else
+        mods_vector[i].initialize(mods_json[i]);
+    }
+  }
+
+  get_all_mods_calls[call_id]->callback(response, mods_vector);
+
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_all_mods_calls[call_id];
+    get_all_mods_calls.erase(call_id);
+  }
 }
 
 void onAddMod(void *object, ModioResponse modio_response, ModioMod mod)
@@ -43,8 +43,12 @@ void onGetAllModfiles(void *object, ModioResponse modio_response, ModioModfile m
 
   get_all_modfiles_calls[call_id]->callback(response, modfiles_vector);
 
-  delete get_all_modfiles_calls[call_id];
-  get_all_modfiles_calls.erase(call_id);
+  // A stale response is followed by the revalidated one
+  if (!modio_response.result_stale)
+  {
+    delete get_all_modfiles_calls[call_id];
+    get_all_modfiles_calls.erase(call_id);
+  }
 }
 
 void onAddModfile(void *object, ModioResponse modio_response, ModioModfile modio_modfile)
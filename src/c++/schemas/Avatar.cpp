@@ -2,27 +2,28 @@
 
 namespace modio
 {
-void Avatar::initialize(ModioAvatar modio_avatar)
+const ClassSchemaTable &getAvatarClassSchema()
 {
-  if (modio_avatar.filename)
-    filename = modio_avatar.filename;
-  if (modio_avatar.original)
-    original = modio_avatar.original;
-  if (modio_avatar.thumb_50x50)
-    thumb_50x50 = modio_avatar.thumb_50x50;
-  if (modio_avatar.thumb_100x100)
-    thumb_100x100 = modio_avatar.thumb_100x100;
+  static const ClassSchemaTable schema(getAvatarSchema(), {
+      MODIO_CLASS_STRING(Avatar, filename),
+      MODIO_CLASS_STRING(Avatar, original),
+      MODIO_CLASS_STRING(Avatar, thumb_50x50),
+      MODIO_CLASS_STRING(Avatar, thumb_100x100)});
+  return schema;
 }
 
-nlohmann::json toJson(Avatar &avatar)
+void Avatar::initialize(ModioAvatar modio_avatar)
 {
-  nlohmann::json avatar_json;
+  modio::initializeClass(getAvatarClassSchema(), this, &modio_avatar);
+}
 
-  avatar_json["filename"] = avatar.filename;
-  avatar_json["original"] = avatar.original;
-  avatar_json["thumb_50x50"] = avatar.thumb_50x50;
-  avatar_json["thumb_100x100"] = avatar.thumb_100x100;
+void Avatar::initialize(const nlohmann::json &avatar_json)
+{
+  modio::initializeClass(getAvatarClassSchema(), this, avatar_json);
+}
 
-  return avatar_json;
+nlohmann::json toJson(Avatar &avatar)
+{
+  return modio::encodeClass(getAvatarClassSchema(), &avatar);
 }
 } // namespace modio
@@ -2,19 +2,21 @@
 
 namespace modio
 {
+const ClassSchemaTable &getDependencyClassSchema()
+{
+	static const ClassSchemaTable schema(getDependencySchema(), {
+			MODIO_CLASS_U32(Dependency, mod_id),
+			MODIO_CLASS_U32(Dependency, date_added)});
+	return schema;
+}
+
 void Dependency::initialize(ModioDependency modio_dependency)
 {
-	mod_id = modio_dependency.mod_id;
-	date_added = modio_dependency.date_added;
+	modio::initializeClass(getDependencyClassSchema(), this, &modio_dependency);
 }
 
 nlohmann::json toJson(Dependency &dependency)
 {
-	nlohmann::json dependency_json;
-
-	dependency_json["mod_id"] = dependency.mod_id;
-	dependency_json["date_added"] = dependency.date_added;
-
-	return dependency_json;
+	return modio::encodeClass(getDependencyClassSchema(), &dependency);
 }
 } // namespace modio
@@ -2,20 +2,26 @@
 
 namespace modio
 {
-void Download::initialize(ModioDownload modio_download)
+const ClassSchemaTable &getDownloadClassSchema()
 {
-  date_expires = modio_download.date_expires;
-  if (modio_download.binary_url)
-    binary_url = modio_download.binary_url;
+  static const ClassSchemaTable schema(getDownloadSchema(), {
+      MODIO_CLASS_U32(Download, date_expires),
+      MODIO_CLASS_STRING(Download, binary_url)});
+  return schema;
 }
 
-nlohmann::json toJson(Download &download)
+void Download::initialize(ModioDownload modio_download)
 {
-  nlohmann::json download_json;
+  modio::initializeClass(getDownloadClassSchema(), this, &modio_download);
+}
 
-  download_json["date_expires"] = download.date_expires;
-  download_json["binary_url"] = download.binary_url;
+void Download::initialize(const nlohmann::json &download_json)
+{
+  modio::initializeClass(getDownloadClassSchema(), this, download_json);
+}
 
-  return download_json;
+nlohmann::json toJson(Download &download)
+{
+  return modio::encodeClass(getDownloadClassSchema(), &download);
 }
 } // namespace modio
@@ -2,18 +2,25 @@
 
 namespace modio
 {
-void Filehash::initialize(ModioFilehash modio_filehash)
+const ClassSchemaTable &getFilehashClassSchema()
 {
-  if (modio_filehash.md5)
-    md5 = modio_filehash.md5;
+  static const ClassSchemaTable schema(getFilehashSchema(), {
+      MODIO_CLASS_STRING(Filehash, md5)});
+  return schema;
 }
 
-nlohmann::json toJson(Filehash &filehash)
+void Filehash::initialize(ModioFilehash modio_filehash)
 {
-  nlohmann::json filehash_json;
+  modio::initializeClass(getFilehashClassSchema(), this, &modio_filehash);
+}
 
-  filehash_json["md5"] = filehash.md5;
+void Filehash::initialize(const nlohmann::json &filehash_json)
+{
+  modio::initializeClass(getFilehashClassSchema(), this, filehash_json);
+}
 
-  return filehash_json;
+nlohmann::json toJson(Filehash &filehash)
+{
+  return modio::encodeClass(getFilehashClassSchema(), &filehash);
 }
 } // namespace modio
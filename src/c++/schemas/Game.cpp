@@ -2,84 +2,43 @@
 
 namespace modio
 {
-void Game::initialize(ModioGame modio_game)
+const ClassSchemaTable &getGameClassSchema()
 {
-  id = modio_game.id;
-  status = modio_game.status;
-  maturity_options = modio_game.maturity_options;
-  date_added = modio_game.date_added;
-  date_updated = modio_game.date_updated;
-  presentation_option = modio_game.presentation_option;
-  date_live = modio_game.date_live;
-  community_options = modio_game.community_options;
-  submission_option = modio_game.submission_option;
-  curation_option = modio_game.curation_option;
-  revenue_options = modio_game.revenue_options;
-  api_access_options = modio_game.api_access_options;
-
-  if (modio_game.ugc_name)
-    ugc_name = modio_game.ugc_name;
-  if (modio_game.instructions_url)
-    instructions_url = modio_game.instructions_url;
-  if (modio_game.name)
-    name = modio_game.name;
-  if (modio_game.name_id)
-    name_id = modio_game.name_id;
-  if (modio_game.summary)
-    summary = modio_game.summary;
-  if (modio_game.instructions)
-    instructions = modio_game.instructions;
-  if (modio_game.profile_url)
-    profile_url = modio_game.profile_url;
-
-  submitted_by.initialize(modio_game.submitted_by);
-  icon.initialize(modio_game.icon);
-  logo.initialize(modio_game.logo);
-  header.initialize(modio_game.header);
+  static const ClassSchemaTable schema(getGameSchema(), {
+      MODIO_CLASS_U32(Game, id),
+      MODIO_CLASS_U32(Game, status),
+      MODIO_CLASS_U32(Game, date_added),
+      MODIO_CLASS_U32(Game, date_updated),
+      MODIO_CLASS_U32(Game, date_live),
+      MODIO_CLASS_U32(Game, presentation_option),
+      MODIO_CLASS_U32(Game, community_options),
+      MODIO_CLASS_U32(Game, submission_option),
+      MODIO_CLASS_U32(Game, curation_option),
+      MODIO_CLASS_U32(Game, revenue_options),
+      MODIO_CLASS_U32(Game, api_access_options),
+      MODIO_CLASS_U32(Game, maturity_options),
+      MODIO_CLASS_STRING(Game, ugc_name),
+      MODIO_CLASS_STRING(Game, instructions_url),
+      MODIO_CLASS_STRING(Game, name),
+      MODIO_CLASS_STRING(Game, name_id),
+      MODIO_CLASS_STRING(Game, summary),
+      MODIO_CLASS_STRING(Game, instructions),
+      MODIO_CLASS_STRING(Game, profile_url),
+      MODIO_CLASS_OBJECT(Game, submitted_by, User, getUserClassSchema()),
+      MODIO_CLASS_OBJECT(Game, icon, Icon, getIconClassSchema()),
+      MODIO_CLASS_OBJECT(Game, logo, Logo, getLogoClassSchema()),
+      MODIO_CLASS_OBJECT(Game, header, Header, getHeaderClassSchema()),
+      MODIO_CLASS_OBJECT_ARRAY(Game, "tag_options", game_tag_options, GameTagOption, getGameTagOptionClassSchema())});
+  return schema;
+}
 
-  game_tag_options.resize(modio_game.game_tag_option_array_size);
-  for (u32 i = 0; i < modio_game.game_tag_option_array_size; i++)
-  {
-    game_tag_options[i].initialize(modio_game.game_tag_option_array[i]);
-  }
+void Game::initialize(ModioGame modio_game)
+{
+  modio::initializeClass(getGameClassSchema(), this, &modio_game);
 }
 
 nlohmann::json toJson(Game &game)
 {
-  nlohmann::json game_json;
-
-  game_json["id"] = game.id;
-  game_json["status"] = game.status;
-  game_json["maturity_options"] = game.maturity_options;
-  game_json["date_added"] = game.date_added;
-  game_json["date_updated"] = game.date_updated;
-  game_json["presentation_option"] = game.presentation_option;
-  game_json["date_live"] = game.date_live;
-  game_json["community_options"] = game.community_options;
-  game_json["submission_option"] = game.submission_option;
-  game_json["curation_option"] = game.curation_option;
-  game_json["revenue_options"] = game.revenue_options;
-  game_json["api_access_options"] = game.api_access_options;
-  game_json["ugc_name"] = game.ugc_name;
-  game_json["instructions_url"] = game.instructions_url;
-  game_json["name"] = game.name;
-  game_json["name_id"] = game.name_id;
-  game_json["summary"] = game.summary;
-  game_json["instructions"] = game.instructions;
-  game_json["profile_url"] = game.profile_url;
-
-  game_json["submitted_by"] = modio::toJson(game.submitted_by);
-  game_json["icon"] = modio::toJson(game.icon);
-  game_json["logo"] = modio::toJson(game.logo);
-  game_json["header"] = modio::toJson(game.header);
-
-  nlohmann::json tag_options_json;
-  for (auto &game_tag_option : game.game_tag_options)
-  {
-    tag_options_json.push_back(modio::toJson(game_tag_option));
-  }
-  game_json["tag_options"] = tag_options_json;
-
-  return game_json;
+  return modio::encodeClass(getGameClassSchema(), &game);
 }
 } // namespace modio
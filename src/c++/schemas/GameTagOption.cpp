@@ -2,37 +2,23 @@
 
 namespace modio
 {
-void GameTagOption::initialize(ModioGameTagOption modio_game_tag_option)
+const ClassSchemaTable &getGameTagOptionClassSchema()
 {
-  hidden = modio_game_tag_option.hidden;
-
-  if (modio_game_tag_option.name)
-    name = modio_game_tag_option.name;
-  if (modio_game_tag_option.type)
-    type = modio_game_tag_option.type;
+  static const ClassSchemaTable schema(getGameTagOptionSchema(), {
+      MODIO_CLASS_U32(GameTagOption, hidden),
+      MODIO_CLASS_STRING(GameTagOption, name),
+      MODIO_CLASS_STRING(GameTagOption, type),
+      MODIO_CLASS_STRING_ARRAY(GameTagOption, "tags", tags)});
+  return schema;
+}
 
-  tags.resize(modio_game_tag_option.tags_array_size);
-  for (u32 i = 0; i < modio_game_tag_option.tags_array_size; i++)
-  {
-    tags[i] = modio_game_tag_option.tags_array[i];
-  }
+void GameTagOption::initialize(ModioGameTagOption modio_game_tag_option)
+{
+  modio::initializeClass(getGameTagOptionClassSchema(), this, &modio_game_tag_option);
 }
 
 nlohmann::json toJson(GameTagOption &game_tag_option)
 {
-  nlohmann::json game_tag_option_json;
-
-  game_tag_option_json["hidden"] = game_tag_option.hidden;
-  game_tag_option_json["name"] = game_tag_option.name;
-  game_tag_option_json["type"] = game_tag_option.type;
-
-  nlohmann::json tags_json;
-  for (auto &tag : game_tag_option.tags)
-  {
-    tags_json.push_back(tag);
-  }
-  game_tag_option_json["tags"] = tags_json;
-
-  return game_tag_option_json;
+  return modio::encodeClass(getGameTagOptionClassSchema(), &game_tag_option);
 }
 } // namespace modio
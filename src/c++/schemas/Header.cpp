@@ -2,21 +2,21 @@
 
 namespace modio
 {
+const ClassSchemaTable &getHeaderClassSchema()
+{
+  static const ClassSchemaTable schema(getHeaderSchema(), {
+      MODIO_CLASS_STRING(Header, filename),
+      MODIO_CLASS_STRING(Header, original)});
+  return schema;
+}
+
 void Header::initialize(ModioHeader modio_header)
 {
-  if (modio_header.filename)
-    filename = modio_header.filename;
-  if (modio_header.original)
-    original = modio_header.original;
+  modio::initializeClass(getHeaderClassSchema(), this, &modio_header);
 }
 
 nlohmann::json toJson(Header &header)
 {
-  nlohmann::json header_json;
-
-  header_json["filename"] = header.filename;
-  header_json["original"] = header.original;
-
-  return header_json;
+  return modio::encodeClass(getHeaderClassSchema(), &header);
 }
 } // namespace modio
@@ -2,30 +2,24 @@
 
 namespace modio
 {
+const ClassSchemaTable &getIconClassSchema()
+{
+  static const ClassSchemaTable schema(getIconSchema(), {
+      MODIO_CLASS_STRING(Icon, filename),
+      MODIO_CLASS_STRING(Icon, original),
+      MODIO_CLASS_STRING(Icon, thumb_64x64),
+      MODIO_CLASS_STRING(Icon, thumb_128x128),
+      MODIO_CLASS_STRING(Icon, thumb_256x256)});
+  return schema;
+}
+
 void Icon::initialize(ModioIcon modio_icon)
 {
-  if (modio_icon.filename)
-    filename = modio_icon.filename;
-  if (modio_icon.original)
-    original = modio_icon.original;
-  if (modio_icon.thumb_64x64)
-    thumb_64x64 = modio_icon.thumb_64x64;
-  if (modio_icon.thumb_128x128)
-    thumb_128x128 = modio_icon.thumb_128x128;
-  if (modio_icon.thumb_256x256)
-    thumb_256x256 = modio_icon.thumb_256x256;
+  modio::initializeClass(getIconClassSchema(), this, &modio_icon);
 }
 
 nlohmann::json toJson(Icon &icon)
 {
-  nlohmann::json icon_json;
-
-  icon_json["filename"] = icon.filename;
-  icon_json["original"] = icon.original;
-  icon_json["thumb_64x64"] = icon.thumb_64x64;
-  icon_json["thumb_128x128"] = icon.thumb_128x128;
-  icon_json["thumb_256x256"] = icon.thumb_256x256;
-
-  return icon_json;
+  return modio::encodeClass(getIconClassSchema(), &icon);
 }
 } // namespace modio
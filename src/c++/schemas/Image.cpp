@@ -2,24 +2,27 @@
 
 namespace modio
 {
-void Image::initialize(ModioImage modio_image)
+const ClassSchemaTable &getImageClassSchema()
 {
-  if (modio_image.filename)
-    filename = modio_image.filename;
-  if (modio_image.original)
-    original = modio_image.original;
-  if (modio_image.thumb_320x180)
-    thumb_320x180 = modio_image.thumb_320x180;
+  static const ClassSchemaTable schema(getImageSchema(), {
+      MODIO_CLASS_STRING(Image, filename),
+      MODIO_CLASS_STRING(Image, original),
+      MODIO_CLASS_STRING(Image, thumb_320x180)});
+  return schema;
 }
 
-nlohmann::json toJson(Image &image)
+void Image::initialize(ModioImage modio_image)
 {
-  nlohmann::json image_json;
+  modio::initializeClass(getImageClassSchema(), this, &modio_image);
+}
 
-  image_json["filename"] = image.filename;
-  image_json["original"] = image.original;
-  image_json["thumb_320x180"] = image.thumb_320x180;
+void Image::initialize(const nlohmann::json &image_json)
+{
+  modio::initializeClass(getImageClassSchema(), this, image_json);
+}
 
-  return image_json;
+nlohmann::json toJson(Image &image)
+{
+  return modio::encodeClass(getImageClassSchema(), &image);
 }
 } // namespace modio
@@ -2,30 +2,29 @@
 
 namespace modio
 {
-void Logo::initialize(ModioLogo modio_iogo)
+const ClassSchemaTable &getLogoClassSchema()
 {
-  if (modio_iogo.filename)
-    filename = modio_iogo.filename;
-  if (modio_iogo.original)
-    original = modio_iogo.original;
-  if (modio_iogo.thumb_320x180)
-    thumb_320x180 = modio_iogo.thumb_320x180;
-  if (modio_iogo.thumb_640x360)
-    thumb_640x360 = modio_iogo.thumb_640x360;
-  if (modio_iogo.thumb_1280x720)
-    thumb_1280x720 = modio_iogo.thumb_1280x720;
+  static const ClassSchemaTable schema(getLogoSchema(), {
+      MODIO_CLASS_STRING(Logo, filename),
+      MODIO_CLASS_STRING(Logo, original),
+      MODIO_CLASS_STRING(Logo, thumb_320x180),
+      MODIO_CLASS_STRING(Logo, thumb_640x360),
+      MODIO_CLASS_STRING(Logo, thumb_1280x720)});
+  return schema;
 }
 
-nlohmann::json toJson(Logo &logo)
+void Logo::initialize(ModioLogo modio_logo)
 {
-  nlohmann::json logo_json;
+  modio::initializeClass(getLogoClassSchema(), this, &modio_logo);
+}
 
-  logo_json["filename"] = logo.filename;
-  logo_json["original"] = logo.original;
-  logo_json["thumb_320x180"] = logo.thumb_320x180;
-  logo_json["thumb_640x360"] = logo.thumb_640x360;
-  logo_json["thumb_1280x720"] = logo.thumb_1280x720;
+void Logo::initialize(const nlohmann::json &logo_json)
+{
+  modio::initializeClass(getLogoClassSchema(), this, logo_json);
+}
 
-  return logo_json;
+nlohmann::json toJson(Logo &logo)
+{
+  return modio::encodeClass(getLogoClassSchema(), &logo);
 }
 } // namespace modio
@@ -2,22 +2,26 @@
 
 namespace modio
 {
+const ClassSchemaTable &getMetadataKVPClassSchema()
+{
+  static const ClassSchemaTable schema(getMetadataKVPSchema(), {
+      MODIO_CLASS_STRING(MetadataKVP, metakey),
+      MODIO_CLASS_STRING(MetadataKVP, metavalue)});
+  return schema;
+}
+
 void MetadataKVP::initialize(ModioMetadataKVP modio_metadata_kvp)
 {
-  if (modio_metadata_kvp.metakey)
-    metakey = modio_metadata_kvp.metakey;
+  modio::initializeClass(getMetadataKVPClassSchema(), this, &modio_metadata_kvp);
+}
 
-  if (modio_metadata_kvp.metavalue)
-    metavalue = modio_metadata_kvp.metavalue;
+void MetadataKVP::initialize(const nlohmann::json &metadata_kvp_json)
+{
+  modio::initializeClass(getMetadataKVPClassSchema(), this, metadata_kvp_json);
 }
 
 nlohmann::json toJson(MetadataKVP &metadata_kvp)
 {
-  nlohmann::json metadata_kvp_json;
-
-  metadata_kvp_json["metakey"] = metadata_kvp.metakey;
-  metadata_kvp_json["metavalue"] = metadata_kvp.metavalue;
-
-  return metadata_kvp_json;
+  return modio::encodeClass(getMetadataKVPClassSchema(), &metadata_kvp);
 }
 } // namespace modio
@@ -0,0 +1,168 @@
+#include "c++/schemas/Metrics.h"
+
+namespace modio
+{
+void Histogram::initialize(ModioHistogram modio_histogram)
+{
+  count = modio_histogram.count;
+  mean_millis = modio_histogram.mean_millis;
+  p50_millis = modio_histogram.p50_millis;
+  p90_millis = modio_histogram.p90_millis;
+  p99_millis = modio_histogram.p99_millis;
+  max_millis = modio_histogram.max_millis;
+}
+
+void EndpointMetrics::initialize(ModioEndpointMetrics modio_endpoint_metrics)
+{
+  if (modio_endpoint_metrics.endpoint)
+    endpoint = modio_endpoint_metrics.endpoint;
+  requests = modio_endpoint_metrics.requests;
+  status_2xx = modio_endpoint_metrics.status_2xx;
+  status_3xx = modio_endpoint_metrics.status_3xx;
+  status_4xx = modio_endpoint_metrics.status_4xx;
+  status_5xx = modio_endpoint_metrics.status_5xx;
+  failed = modio_endpoint_metrics.failed;
+}
+
+void HostMetrics::initialize(ModioHostMetrics modio_host_metrics)
+{
+  if (modio_host_metrics.host)
+    host = modio_host_metrics.host;
+  transfers = modio_host_metrics.transfers;
+  reused_connections = modio_host_metrics.reused_connections;
+  http_version = modio_host_metrics.http_version;
+  mean_dns_millis = modio_host_metrics.mean_dns_millis;
+  mean_connect_millis = modio_host_metrics.mean_connect_millis;
+  mean_tls_millis = modio_host_metrics.mean_tls_millis;
+  mean_ttfb_millis = modio_host_metrics.mean_ttfb_millis;
+  mean_transfer_millis = modio_host_metrics.mean_transfer_millis;
+  download_bytes_per_second = modio_host_metrics.download_bytes_per_second;
+}
+
+void Metrics::initialize(ModioMetrics modio_metrics)
+{
+  requests = modio_metrics.requests;
+  failed_requests = modio_metrics.failed_requests;
+  endpoints.resize(modio_metrics.endpoints_array_size);
+  for (u32 i = 0; i < modio_metrics.endpoints_array_size; i++)
+    endpoints[i].initialize(modio_metrics.endpoints_array[i]);
+  hosts.resize(modio_metrics.hosts_array_size);
+  for (u32 i = 0; i < modio_metrics.hosts_array_size; i++)
+    hosts[i].initialize(modio_metrics.hosts_array[i]);
+  network_latency.initialize(modio_metrics.network_latency);
+  parse_latency.initialize(modio_metrics.parse_latency);
+  callback_latency.initialize(modio_metrics.callback_latency);
+  bytes_up = modio_metrics.bytes_up;
+  bytes_down = modio_metrics.bytes_down;
+  decoded_bytes_down = modio_metrics.decoded_bytes_down;
+  memory_cache_hits = modio_metrics.memory_cache_hits;
+  store_cache_hits = modio_metrics.store_cache_hits;
+  cache_misses = modio_metrics.cache_misses;
+  entity_store_hits = modio_metrics.entity_store_hits;
+  entity_store_misses = modio_metrics.entity_store_misses;
+  memory_cache_hit_ratio = modio_metrics.memory_cache_hit_ratio;
+  store_cache_hit_ratio = modio_metrics.store_cache_hit_ratio;
+  entity_store_hit_ratio = modio_metrics.entity_store_hit_ratio;
+  active_requests = modio_metrics.active_requests;
+  active_downloads = modio_metrics.active_downloads;
+  active_uploads = modio_metrics.active_uploads;
+  mod_download_queue_size = modio_metrics.mod_download_queue_size;
+  modfile_upload_queue_size = modio_metrics.modfile_upload_queue_size;
+  prefetch_queue_size = modio_metrics.prefetch_queue_size;
+  extracted_bytes = modio_metrics.extracted_bytes;
+  extracted_files = modio_metrics.extracted_files;
+  extract_time.initialize(modio_metrics.extract_time);
+  extract_bytes_per_second = modio_metrics.extract_bytes_per_second;
+  process_time.initialize(modio_metrics.process_time);
+}
+
+nlohmann::json toJson(Histogram &histogram)
+{
+  nlohmann::json histogram_json;
+
+  histogram_json["count"] = histogram.count;
+  histogram_json["mean_millis"] = histogram.mean_millis;
+  histogram_json["p50_millis"] = histogram.p50_millis;
+  histogram_json["p90_millis"] = histogram.p90_millis;
+  histogram_json["p99_millis"] = histogram.p99_millis;
+  histogram_json["max_millis"] = histogram.max_millis;
+
+  return histogram_json;
+}
+
+nlohmann::json toJson(EndpointMetrics &endpoint_metrics)
+{
+  nlohmann::json endpoint_metrics_json;
+
+  endpoint_metrics_json["endpoint"] = endpoint_metrics.endpoint;
+  endpoint_metrics_json["requests"] = endpoint_metrics.requests;
+  endpoint_metrics_json["status_2xx"] = endpoint_metrics.status_2xx;
+  endpoint_metrics_json["status_3xx"] = endpoint_metrics.status_3xx;
+  endpoint_metrics_json["status_4xx"] = endpoint_metrics.status_4xx;
+  endpoint_metrics_json["status_5xx"] = endpoint_metrics.status_5xx;
+  endpoint_metrics_json["failed"] = endpoint_metrics.failed;
+
+  return endpoint_metrics_json;
+}
+
+nlohmann::json toJson(HostMetrics &host_metrics)
+{
+  nlohmann::json host_metrics_json;
+
+  host_metrics_json["host"] = host_metrics.host;
+  host_metrics_json["transfers"] = host_metrics.transfers;
+  host_metrics_json["reused_connections"] = host_metrics.reused_connections;
+  host_metrics_json["http_version"] = host_metrics.http_version;
+  host_metrics_json["mean_dns_millis"] = host_metrics.mean_dns_millis;
+  host_metrics_json["mean_connect_millis"] = host_metrics.mean_connect_millis;
+  host_metrics_json["mean_tls_millis"] = host_metrics.mean_tls_millis;
+  host_metrics_json["mean_ttfb_millis"] = host_metrics.mean_ttfb_millis;
+  host_metrics_json["mean_transfer_millis"] = host_metrics.mean_transfer_millis;
+  host_metrics_json["download_bytes_per_second"] = host_metrics.download_bytes_per_second;
+
+  return host_metrics_json;
+}
+
+nlohmann::json toJson(Metrics &metrics)
+{
+  nlohmann::json metrics_json;
+
+  metrics_json["requests"] = metrics.requests;
+  metrics_json["failed_requests"] = metrics.failed_requests;
+  nlohmann::json endpoints_json = nlohmann::json::array();
+  for (auto &endpoint_metrics : metrics.endpoints)
+    endpoints_json.push_back(toJson(endpoint_metrics));
+  metrics_json["endpoints"] = endpoints_json;
+  nlohmann::json hosts_json = nlohmann::json::array();
+  for (auto &host_metrics : metrics.hosts)
+    hosts_json.push_back(toJson(host_metrics));
+  metrics_json["hosts"] = hosts_json;
+  metrics_json["network_latency"] = toJson(metrics.network_latency);
+  metrics_json["parse_latency"] = toJson(metrics.parse_latency);
+  metrics_json["callback_latency"] = toJson(metrics.callback_latency);
+  metrics_json["bytes_up"] = metrics.bytes_up;
+  metrics_json["bytes_down"] = metrics.bytes_down;
+  metrics_json["decoded_bytes_down"] = metrics.decoded_bytes_down;
+  metrics_json["memory_cache_hits"] = metrics.memory_cache_hits;
+  metrics_json["store_cache_hits"] = metrics.store_cache_hits;
+  metrics_json["cache_misses"] = metrics.cache_misses;
+  metrics_json["entity_store_hits"] = metrics.entity_store_hits;
+  metrics_json["entity_store_misses"] = metrics.entity_store_misses;
+  metrics_json["memory_cache_hit_ratio"] = metrics.memory_cache_hit_ratio;
+  metrics_json["store_cache_hit_ratio"] = metrics.store_cache_hit_ratio;
+  metrics_json["entity_store_hit_ratio"] = metrics.entity_store_hit_ratio;
+  metrics_json["active_requests"] = metrics.active_requests;
+  metrics_json["active_downloads"] = metrics.active_downloads;
+  metrics_json["active_uploads"] = metrics.active_uploads;
+  metrics_json["mod_download_queue_size"] = metrics.mod_download_queue_size;
+  metrics_json["modfile_upload_queue_size"] = metrics.modfile_upload_queue_size;
+  metrics_json["prefetch_queue_size"] = metrics.prefetch_queue_size;
+  metrics_json["extracted_bytes"] = metrics.extracted_bytes;
+  metrics_json["extracted_files"] = metrics.extracted_files;
+  metrics_json["extract_time"] = toJson(metrics.extract_time);
+  metrics_json["extract_bytes_per_second"] = metrics.extract_bytes_per_second;
+  metrics_json["process_time"] = toJson(metrics.process_time);
+
+  return metrics_json;
+}
+} // namespace modio
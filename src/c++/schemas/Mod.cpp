@@ -1,90 +1,163 @@
 #include "c++/schemas/Mod.h"
 
+#define MODIO_LAZY_DESCRIPTION 1
+#define MODIO_LAZY_DESCRIPTION_PLAINTEXT 2
+#define MODIO_LAZY_METADATA_BLOB 4
+#define MODIO_LAZY_MEDIA 8
+
 namespace modio
 {
+const ClassSchemaTable &getModClassSchema()
+{
+  static const ClassSchemaTable schema(getModSchema(), {
+      MODIO_CLASS_U32(Mod, id),
+      MODIO_CLASS_U32(Mod, game_id),
+      MODIO_CLASS_U32(Mod, status),
+      MODIO_CLASS_U32(Mod, visible),
+      MODIO_CLASS_U32(Mod, maturity_option),
+      MODIO_CLASS_U32(Mod, date_added),
+      MODIO_CLASS_U32(Mod, date_updated),
+      MODIO_CLASS_U32(Mod, date_live),
+      MODIO_CLASS_STRING(Mod, homepage_url),
+      MODIO_CLASS_STRING(Mod, name),
+      MODIO_CLASS_STRING(Mod, name_id),
+      MODIO_CLASS_STRING(Mod, summary),
+      MODIO_CLASS_STRING(Mod, description),
+      MODIO_CLASS_STRING(Mod, description_plaintext),
+      MODIO_CLASS_STRING(Mod, metadata_blob),
+      MODIO_CLASS_STRING(Mod, profile_url),
+      MODIO_CLASS_OBJECT(Mod, logo, Logo, getLogoClassSchema()),
+      MODIO_CLASS_OBJECT(Mod, submitted_by, User, getUserClassSchema()),
+      MODIO_CLASS_OBJECT(Mod, modfile, Modfile, getModfileClassSchema()),
+      MODIO_CLASS_OBJECT(Mod, media, Media, getMediaClassSchema()),
+      MODIO_CLASS_OBJECT(Mod, stats, Stats, getStatsClassSchema()),
+      MODIO_CLASS_OBJECT_ARRAY(Mod, "tags", tags, Tag, getTagClassSchema()),
+      MODIO_CLASS_OBJECT_ARRAY(Mod, "metadata_kvp", metadata_kvps, MetadataKVP, getMetadataKVPClassSchema())});
+  return schema;
+}
+
+// The mod fields without the ones lazy listings leave in the retained response, like the
+// C lazy table
+static const ClassSchemaTable &getModLazyFieldsClassSchema()
+{
+  static const ClassSchemaTable schema = []() {
+    static const char *lazy_keys[] = {"description", "description_plaintext", "media", "metadata_blob"};
+    ClassSchemaTable lazy_schema = getModClassSchema();
+    for (const char *lazy_key : lazy_keys)
+    {
+      for (auto field = lazy_schema.fields.begin(); field != lazy_schema.fields.end(); field++)
+      {
+        if (strcmp(field->key, lazy_key) == 0)
+        {
+          lazy_schema.fields.erase(field);
+          break;
+        }
+      }
+    }
+    return lazy_schema;
+  }();
+  return schema;
+}
+
 void Mod::initialize(ModioMod modio_mod)
 {
-  id = modio_mod.id;
-  game_id = modio_mod.game_id;
-  status = modio_mod.status;
-  visible = modio_mod.visible;
-  maturity_option = modio_mod.maturity_option;
-  date_added = modio_mod.date_added;
-  date_updated = modio_mod.date_updated;
-  date_live = modio_mod.date_live;
-  if (modio_mod.homepage_url)
-    homepage_url = modio_mod.homepage_url;
-  if (modio_mod.name)
-    name = modio_mod.name;
-  if (modio_mod.name_id)
-    name_id = modio_mod.name_id;
-  if (modio_mod.summary)
-    summary = modio_mod.summary;
-  if (modio_mod.description)
-    description = modio_mod.description;
-  if (modio_mod.description_plaintext)
-    description_plaintext = modio_mod.description_plaintext;
-  if (modio_mod.metadata_blob)
-    metadata_blob = modio_mod.metadata_blob;
-  if (modio_mod.profile_url)
-    profile_url = modio_mod.profile_url;
-  logo.initialize(modio_mod.logo);
-  submitted_by.initialize(modio_mod.submitted_by);
-  modfile.initialize(modio_mod.modfile);
-  media.initialize(modio_mod.media);
-  stats.initialize(modio_mod.stats);
-  tags.resize(modio_mod.tags_array_size);
-  for (u32 i = 0; i < modio_mod.tags_array_size; i++)
-  {
-    tags[i].initialize(modio_mod.tags_array[i]);
-  }
-  metadata_kvps.resize(modio_mod.metadata_kvp_array_size);
-  for (u32 i = 0; i < modio_mod.metadata_kvp_array_size; i++)
+  modio::initializeClass(getModClassSchema(), this, &modio_mod);
+
+  // Mods from a lazy listing lack the heavy fields, the getters look for them
+  lazy_fields = 0;
+  if (modio::LAZY_FIELDS == MODIO_LAZY_FIELDS_ENABLED)
   {
-    metadata_kvps[i].initialize(modio_mod.metadata_kvp_array[i]);
+    if (!modio_mod.description)
+      lazy_fields |= MODIO_LAZY_DESCRIPTION;
+    if (!modio_mod.description_plaintext)
+      lazy_fields |= MODIO_LAZY_DESCRIPTION_PLAINTEXT;
+    if (!modio_mod.metadata_blob)
+      lazy_fields |= MODIO_LAZY_METADATA_BLOB;
+    if (!modio_mod.media.youtube_size && !modio_mod.media.sketchfab_size && !modio_mod.media.images_size)
+      lazy_fields |= MODIO_LAZY_MEDIA;
   }
 }
 
-nlohmann::json toJson(Mod &mod)
+void Mod::initialize(const nlohmann::json &mod_json)
 {
-  nlohmann::json mod_json;
-
-  mod_json["id"] = mod.id;
-  mod_json["game_id"] = mod.game_id;
-  mod_json["status"] = mod.status;
-  mod_json["visible"] = mod.visible;
-  mod_json["maturity_option"] = mod.maturity_option;
-  mod_json["date_added"] = mod.date_added;
-  mod_json["date_updated"] = mod.date_updated;
-  mod_json["date_live"] = mod.date_live;
-  mod_json["homepage_url"] = mod.homepage_url;
-  mod_json["name"] = mod.name;
-  mod_json["name_id"] = mod.name_id;
-  mod_json["summary"] = mod.summary;
-  mod_json["description"] = mod.description;
-  mod_json["description_plaintext"] = mod.description_plaintext;
-  mod_json["metadata_blob"] = mod.metadata_blob;
-  mod_json["profile_url"] = mod.profile_url;
-  mod_json["logo"] = modio::toJson(mod.logo);
-  mod_json["submitted_by"] = modio::toJson(mod.submitted_by);
-  mod_json["modfile"] = modio::toJson(mod.modfile);
-  mod_json["media"] = modio::toJson(mod.media);
-  mod_json["stats"] = modio::toJson(mod.stats);
-
-  nlohmann::json tags_json;
-  for (auto &tag : mod.tags)
+  initializeJson(mod_json, false);
+}
+
+void Mod::initializeLazyFields(const nlohmann::json &mod_json)
+{
+  initializeJson(mod_json, true);
+}
+
+void Mod::initializeJson(const nlohmann::json &mod_json, bool lazy)
+{
+  lazy_fields = 0;
+  if (lazy)
   {
-    tags_json.push_back(modio::toJson(tag));
+    modio::initializeClass(getModLazyFieldsClassSchema(), this, mod_json);
+    description.clear();
+    description_plaintext.clear();
+    metadata_blob.clear();
+    media = Media();
+    lazy_fields = MODIO_LAZY_DESCRIPTION | MODIO_LAZY_DESCRIPTION_PLAINTEXT | MODIO_LAZY_METADATA_BLOB | MODIO_LAZY_MEDIA;
   }
-  mod_json["tags"] = tags_json;
-
-  nlohmann::json metadata_kvps_json;
-  for (auto &metadata_kvp : mod.metadata_kvps)
+  else
   {
-    metadata_kvps_json.push_back(modio::toJson(metadata_kvp));
+    modio::initializeClass(getModClassSchema(), this, mod_json);
   }
-  mod_json["metadata_kvp"] = metadata_kvps_json;
+}
 
-  return mod_json;
+void Mod::loadLazyField(u32 field)
+{
+  if (!(lazy_fields & field))
+    return;
+  lazy_fields &= ~field;
+
+  // Left empty once the listing is no longer retained
+  const nlohmann::json *mod_json = modio::findLazyMod(id);
+  if (!mod_json)
+    return;
+
+  if (field == MODIO_LAZY_DESCRIPTION)
+    modio::getJsonValue(*mod_json, "description", description);
+  else if (field == MODIO_LAZY_DESCRIPTION_PLAINTEXT)
+    modio::getJsonValue(*mod_json, "description_plaintext", description_plaintext);
+  else if (field == MODIO_LAZY_METADATA_BLOB)
+    modio::getJsonValue(*mod_json, "metadata_blob", metadata_blob);
+  else if (field == MODIO_LAZY_MEDIA)
+    media.initialize(modio::getJsonChild(*mod_json, "media"));
+}
+
+const std::string &Mod::getDescription()
+{
+  loadLazyField(MODIO_LAZY_DESCRIPTION);
+  return description;
+}
+
+const std::string &Mod::getDescriptionPlaintext()
+{
+  loadLazyField(MODIO_LAZY_DESCRIPTION_PLAINTEXT);
+  return description_plaintext;
+}
+
+const std::string &Mod::getMetadataBlob()
+{
+  loadLazyField(MODIO_LAZY_METADATA_BLOB);
+  return metadata_blob;
+}
+
+const Media &Mod::getMedia()
+{
+  loadLazyField(MODIO_LAZY_MEDIA);
+  return media;
+}
+
+nlohmann::json toJson(Mod &mod)
+{
+  // Loaded first so the table sees them
+  mod.getDescription();
+  mod.getDescriptionPlaintext();
+  mod.getMetadataBlob();
+  mod.getMedia();
+  return modio::encodeClass(getModClassSchema(), &mod);
 }
 } // namespace modio
@@ -2,25 +2,24 @@
 
 namespace modio
 {
+const ClassSchemaTable &getModEventClassSchema()
+{
+  static const ClassSchemaTable schema(getModEventSchema(), {
+      MODIO_CLASS_U32(ModEvent, id),
+      MODIO_CLASS_U32(ModEvent, mod_id),
+      MODIO_CLASS_U32(ModEvent, user_id),
+      MODIO_CLASS_ENUM(ModEvent, event_type, getEventTypeValues()),
+      MODIO_CLASS_U32(ModEvent, date_added)});
+  return schema;
+}
+
 void ModEvent::initialize(ModioModEvent modio_event)
 {
-  id = modio_event.id;
-  mod_id = modio_event.mod_id;
-  user_id = modio_event.user_id;
-  event_type = modio_event.event_type;
-  date_added = modio_event.date_added;
+  modio::initializeClass(getModEventClassSchema(), this, &modio_event);
 }
 
 nlohmann::json toJson(ModEvent &event)
 {
-  nlohmann::json event_json;
-
-  event_json["id"] = event.id;
-  event_json["mod_id"] = event.mod_id;
-  event_json["user_id"] = event.user_id;
-  event_json["event_type"] = event.event_type;
-  event_json["date_added"] = event.date_added;
-
-  return event_json;
+  return modio::encodeClass(getModEventClassSchema(), &event);
 }
 } // namespace modio
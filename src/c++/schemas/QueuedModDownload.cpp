@@ -2,31 +2,26 @@
 
 namespace modio
 {
-void QueuedModDownload::initialize(ModioQueuedModDownload queued_mod_download)
+const ClassSchemaTable &getQueuedModDownloadClassSchema()
 {
-  state = queued_mod_download.state;
-  mod_id = queued_mod_download.mod_id;
-  current_progress = queued_mod_download.current_progress;
-  total_size = queued_mod_download.total_size;
-  if (queued_mod_download.url)
-    url = queued_mod_download.url;
-  if (queued_mod_download.path)
-    path = queued_mod_download.path;
-  mod.initialize(queued_mod_download.mod);
+  static const ClassSchemaTable schema(getQueuedModDownloadSchema(), {
+      MODIO_CLASS_U32(QueuedModDownload, state),
+      MODIO_CLASS_U32(QueuedModDownload, mod_id),
+      MODIO_CLASS_DOUBLE(QueuedModDownload, current_progress),
+      MODIO_CLASS_DOUBLE(QueuedModDownload, total_size),
+      MODIO_CLASS_STRING(QueuedModDownload, url),
+      MODIO_CLASS_STRING(QueuedModDownload, path),
+      MODIO_CLASS_OBJECT(QueuedModDownload, mod, Mod, getModClassSchema())});
+  return schema;
 }
 
-nlohmann::json toJson(QueuedModDownload &queued_mod_download)
+void QueuedModDownload::initialize(ModioQueuedModDownload modio_queued_mod_download)
 {
-  nlohmann::json queued_mod_download_json;
-
-  queued_mod_download_json["state"] = queued_mod_download.state;
-  queued_mod_download_json["mod_id"] = queued_mod_download.mod_id;
-  queued_mod_download_json["current_progress"] = queued_mod_download.current_progress;
-  queued_mod_download_json["total_size"] = queued_mod_download.total_size;
-  queued_mod_download_json["url"] = queued_mod_download.url;
-  queued_mod_download_json["path"] = queued_mod_download.path;
-  queued_mod_download_json["mod"] = modio::toJson(queued_mod_download.mod);
+  modio::initializeClass(getQueuedModDownloadClassSchema(), this, &modio_queued_mod_download);
+}
 
-  return queued_mod_download_json;
+nlohmann::json toJson(QueuedModDownload &queued_mod_download)
+{
+  return modio::encodeClass(getQueuedModDownloadClassSchema(), &queued_mod_download);
 }
 } // namespace modio
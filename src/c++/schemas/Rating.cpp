@@ -2,23 +2,23 @@
 
 namespace modio
 {
+const ClassSchemaTable &getRatingClassSchema()
+{
+  static const ClassSchemaTable schema(getRatingSchema(), {
+      MODIO_CLASS_U32(Rating, game_id),
+      MODIO_CLASS_U32(Rating, mod_id),
+      MODIO_CLASS_I32(Rating, rating),
+      MODIO_CLASS_U32(Rating, date_added)});
+  return schema;
+}
+
 void Rating::initialize(ModioRating modio_rating)
 {
-  game_id = modio_rating.game_id;
-  mod_id = modio_rating.mod_id;
-  rating = modio_rating.rating;
-  date_added = modio_rating.date_added;
+  modio::initializeClass(getRatingClassSchema(), this, &modio_rating);
 }
 
 nlohmann::json toJson(Rating &rating)
 {
-  nlohmann::json rating_json;
-
-  rating_json["game_id"] = rating.game_id;
-  rating_json["mod_id"] = rating.mod_id;
-  rating_json["rating"] = rating.rating;
-  rating_json["date_added"] = rating.date_added;
-
-  return rating_json;
+  return modio::encodeClass(getRatingClassSchema(), &rating);
 }
 } // namespace modio
@@ -10,7 +10,9 @@ void Response::initialize(ModioResponse modio_response)
   result_offset = modio_response.result_offset;
   result_total = modio_response.result_total;
   result_cached = modio_response.result_cached;
+  result_stale = modio_response.result_stale;
   error.initialize(modio_response.error);
+  transfer.initialize(modio_response.transfer);
 }
 
 nlohmann::json toJson(Response &response)
@@ -23,7 +25,9 @@ nlohmann::json toJson(Response &response)
   response_json["result_offset"] = response.result_offset;
   response_json["result_total"] = response.result_total;
   response_json["result_cached"] = response.result_cached;
+  response_json["result_stale"] = response.result_stale;
   response_json["error"] = modio::toJson(response.error);
+  response_json["transfer"] = modio::toJson(response.transfer);
 
   return response_json;
 }
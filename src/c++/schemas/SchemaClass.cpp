@@ -0,0 +1,307 @@
+#include "c++/schemas/SchemaClass.h"
+
+#include <algorithm>
+
+namespace modio
+{
+static bool isKeyLess(const ClassSchemaField &a, const ClassSchemaField &b)
+{
+  return strcmp(a.key, b.key) < 0;
+}
+
+ClassSchemaTable::ClassSchemaTable(const SchemaTable &c_schema, std::initializer_list<ClassSchemaField> fields)
+  : c_schema(&c_schema), fields(fields)
+{
+  std::sort(this->fields.begin(), this->fields.end(), isKeyLess);
+}
+
+template <typename T>
+static T &getMember(const ClassSchemaField &field, void *object)
+{
+  return *static_cast<T *>(field.get_member(object));
+}
+
+template <typename T>
+static const T &getCField(const SchemaField &field, const void *c_object)
+{
+  return *(const T *)((const char *)c_object + field.offset);
+}
+
+static const char *getCArray(const SchemaField &field, const void *c_object)
+{
+  const char *array;
+  memcpy(&array, (const char *)c_object + field.offset, sizeof(array));
+  return array;
+}
+
+// Null arrays have no elements whatever their count says
+static size_t getCArraySize(const SchemaField &field, const void *c_object)
+{
+  return getCArray(field, c_object) ? *(const u32 *)((const char *)c_object + field.size_offset) : 0;
+}
+
+static void resetClass(const ClassSchemaTable &schema, void *object)
+{
+  for (auto &field : schema.fields)
+  {
+    switch (field.type)
+    {
+    case MODIO_FIELD_U32:
+    case MODIO_FIELD_ENUM:
+      getMember<u32>(field, object) = 0;
+      break;
+    case MODIO_FIELD_I32:
+      getMember<i32>(field, object) = 0;
+      break;
+    case MODIO_FIELD_LONG:
+      getMember<long>(field, object) = 0;
+      break;
+    case MODIO_FIELD_DOUBLE:
+      getMember<double>(field, object) = 0;
+      break;
+    case MODIO_FIELD_BOOL:
+      getMember<bool>(field, object) = false;
+      break;
+    case MODIO_FIELD_STRING:
+      getMember<std::string>(field, object).clear();
+      break;
+    case MODIO_FIELD_STRING_ARRAY:
+      getMember<std::vector<std::string>>(field, object).clear();
+      break;
+    case MODIO_FIELD_OBJECT:
+      resetClass(*field.schema, field.get_member(object));
+      break;
+    case MODIO_FIELD_OBJECT_ARRAY:
+      field.array_ops->resize(field.get_member(object), 0);
+      break;
+    }
+  }
+}
+
+static void initializeField(const ClassSchemaField &field, void *object, const nlohmann::json &value_json)
+{
+  switch (field.type)
+  {
+  case MODIO_FIELD_U32:
+    getMember<u32>(field, object) = value_json.get<u32>();
+    break;
+  case MODIO_FIELD_I32:
+    getMember<i32>(field, object) = value_json.get<i32>();
+    break;
+  case MODIO_FIELD_LONG:
+    getMember<long>(field, object) = value_json.get<long>();
+    break;
+  case MODIO_FIELD_DOUBLE:
+    getMember<double>(field, object) = value_json.get<double>();
+    break;
+  case MODIO_FIELD_BOOL:
+    getMember<bool>(field, object) = value_json.get<bool>();
+    break;
+  case MODIO_FIELD_STRING:
+    getMember<std::string>(field, object) = value_json.get_ref<const std::string &>();
+    break;
+  case MODIO_FIELD_STRING_ARRAY:
+  {
+    std::vector<std::string> &strings = getMember<std::vector<std::string>>(field, object);
+    strings.resize(value_json.size());
+    for (size_t i = 0; i < strings.size(); i++)
+      strings[i] = value_json[i].get_ref<const std::string &>();
+    break;
+  }
+  case MODIO_FIELD_OBJECT:
+    initializeClass(*field.schema, field.get_member(object), value_json);
+    break;
+  case MODIO_FIELD_OBJECT_ARRAY:
+  {
+    void *elements = field.get_member(object);
+    field.array_ops->resize(elements, value_json.size());
+    for (size_t i = 0; i < value_json.size(); i++)
+      initializeClass(*field.schema, field.array_ops->at(elements, i), value_json[i]);
+    break;
+  }
+  case MODIO_FIELD_ENUM:
+  {
+    const std::string *name = value_json.get_ptr<const std::string *>();
+    for (const SchemaEnumValue *enum_value = field.enum_values; name && enum_value->name; enum_value++)
+    {
+      if (*name == enum_value->name)
+      {
+        getMember<u32>(field, object) = enum_value->value;
+        break;
+      }
+    }
+    break;
+  }
+  }
+}
+
+void initializeClass(const ClassSchemaTable &schema, void *object, const nlohmann::json &object_json)
+{
+  resetClass(schema, object);
+
+  const nlohmann::json::object_t *members = object_json.get_ptr<const nlohmann::json::object_t *>();
+  if (!members)
+    return;
+
+  // The same single pass over the sorted members and fields as decodeSchema
+  nlohmann::json::object_t::const_iterator member = members->begin();
+  std::vector<ClassSchemaField>::const_iterator field = schema.fields.begin();
+  while (member != members->end() && field != schema.fields.end())
+  {
+    int order = member->first.compare(field->key);
+    if (order < 0)
+    {
+      member++;
+    }
+    else if (order > 0)
+    {
+      field++;
+    }
+    else
+    {
+      if (!member->second.is_null())
+        initializeField(*field, object, member->second);
+      member++;
+      field++;
+    }
+  }
+}
+
+static void initializeField(const ClassSchemaField &field, void *object, const SchemaField &c_field, const void *c_object)
+{
+  switch (field.type)
+  {
+  case MODIO_FIELD_U32:
+  case MODIO_FIELD_ENUM:
+    getMember<u32>(field, object) = getCField<u32>(c_field, c_object);
+    break;
+  case MODIO_FIELD_I32:
+    getMember<i32>(field, object) = getCField<i32>(c_field, c_object);
+    break;
+  case MODIO_FIELD_LONG:
+    getMember<long>(field, object) = getCField<long>(c_field, c_object);
+    break;
+  case MODIO_FIELD_DOUBLE:
+    getMember<double>(field, object) = getCField<double>(c_field, c_object);
+    break;
+  case MODIO_FIELD_BOOL:
+    getMember<bool>(field, object) = getCField<bool>(c_field, c_object);
+    break;
+  case MODIO_FIELD_STRING:
+  {
+    const char *c_string = getCField<char *>(c_field, c_object);
+    std::string &string = getMember<std::string>(field, object);
+    if (c_string)
+      string = c_string;
+    else
+      string.clear();
+    break;
+  }
+  case MODIO_FIELD_STRING_ARRAY:
+  {
+    char *const *c_strings = getCField<char **>(c_field, c_object);
+    std::vector<std::string> &strings = getMember<std::vector<std::string>>(field, object);
+    strings.resize(getCArraySize(c_field, c_object));
+    for (size_t i = 0; i < strings.size(); i++)
+      strings[i] = c_strings[i] ? c_strings[i] : "";
+    break;
+  }
+  case MODIO_FIELD_OBJECT:
+    initializeClass(*field.schema, field.get_member(object), (const char *)c_object + c_field.offset);
+    break;
+  case MODIO_FIELD_OBJECT_ARRAY:
+  {
+    const char *c_elements = getCArray(c_field, c_object);
+    size_t elements_size = getCArraySize(c_field, c_object);
+    void *elements = field.get_member(object);
+    field.array_ops->resize(elements, elements_size);
+    for (size_t i = 0; i < elements_size; i++)
+      initializeClass(*field.schema, field.array_ops->at(elements, i), c_elements + i * c_field.schema->struct_size);
+    break;
+  }
+  }
+}
+
+void initializeClass(const ClassSchemaTable &schema, void *object, const void *c_object)
+{
+  // Walked together by key, class fields the struct lacks are left reset
+  resetClass(schema, object);
+
+  std::vector<ClassSchemaField>::const_iterator field = schema.fields.begin();
+  std::vector<SchemaField>::const_iterator c_field = schema.c_schema->fields.begin();
+  while (field != schema.fields.end() && c_field != schema.c_schema->fields.end())
+  {
+    int order = strcmp(field->key, c_field->key);
+    if (order < 0)
+    {
+      field++;
+    }
+    else if (order > 0)
+    {
+      c_field++;
+    }
+    else
+    {
+      initializeField(*field, object, *c_field, c_object);
+      field++;
+      c_field++;
+    }
+  }
+}
+
+nlohmann::json encodeClass(const ClassSchemaTable &schema, const void *object)
+{
+  // The accessors take the object as mutable, nothing is written through them here
+  void *members = const_cast<void *>(object);
+  nlohmann::json object_json = nlohmann::json::object();
+  for (auto &field : schema.fields)
+  {
+    switch (field.type)
+    {
+    case MODIO_FIELD_U32:
+      object_json[field.key] = getMember<u32>(field, members);
+      break;
+    case MODIO_FIELD_I32:
+      object_json[field.key] = getMember<i32>(field, members);
+      break;
+    case MODIO_FIELD_LONG:
+      object_json[field.key] = getMember<long>(field, members);
+      break;
+    case MODIO_FIELD_DOUBLE:
+      object_json[field.key] = getMember<double>(field, members);
+      break;
+    case MODIO_FIELD_BOOL:
+      object_json[field.key] = getMember<bool>(field, members);
+      break;
+    case MODIO_FIELD_STRING:
+      object_json[field.key] = getMember<std::string>(field, members);
+      break;
+    case MODIO_FIELD_STRING_ARRAY:
+      object_json[field.key] = getMember<std::vector<std::string>>(field, members);
+      break;
+    case MODIO_FIELD_OBJECT:
+      object_json[field.key] = encodeClass(*field.schema, field.get_member(members));
+      break;
+    case MODIO_FIELD_OBJECT_ARRAY:
+    {
+      void *elements = field.get_member(members);
+      nlohmann::json &elements_json = object_json[field.key] = nlohmann::json::array();
+      for (size_t i = 0; i < field.array_ops->size(elements); i++)
+        elements_json.push_back(encodeClass(*field.schema, field.array_ops->at(elements, i)));
+      break;
+    }
+    case MODIO_FIELD_ENUM:
+      for (const SchemaEnumValue *enum_value = field.enum_values; enum_value->name; enum_value++)
+      {
+        if (enum_value->value == getMember<u32>(field, members))
+        {
+          object_json[field.key] = enum_value->name;
+          break;
+        }
+      }
+      break;
+    }
+  }
+  return object_json;
+}
+} // namespace modio
@@ -2,20 +2,26 @@
 
 namespace modio
 {
-void Tag::initialize(ModioTag modio_tag)
+const ClassSchemaTable &getTagClassSchema()
 {
-  date_added = modio_tag.date_added;
-  if (modio_tag.name)
-    name = modio_tag.name;
+  static const ClassSchemaTable schema(getTagSchema(), {
+      MODIO_CLASS_U32(Tag, date_added),
+      MODIO_CLASS_STRING(Tag, name)});
+  return schema;
 }
 
-nlohmann::json toJson(Tag &tag)
+void Tag::initialize(ModioTag modio_tag)
 {
-  nlohmann::json tag_json;
+  modio::initializeClass(getTagClassSchema(), this, &modio_tag);
+}
 
-  tag_json["date_added"] = tag.date_added;
-  tag_json["name"] = tag.name;
+void Tag::initialize(const nlohmann::json &tag_json)
+{
+  modio::initializeClass(getTagClassSchema(), this, tag_json);
+}
 
-  return tag_json;
+nlohmann::json toJson(Tag &tag)
+{
+  return modio::encodeClass(getTagClassSchema(), &tag);
 }
 } // namespace modio
@@ -0,0 +1,40 @@
+#include "c++/schemas/TransferInfo.h"
+
+namespace modio
+{
+void TransferInfo::initialize(ModioTransferInfo modio_transfer_info)
+{
+  effective_url = "";
+  if (modio_transfer_info.effective_url)
+    effective_url = modio_transfer_info.effective_url;
+  http_version = modio_transfer_info.http_version;
+  connection_reused = modio_transfer_info.connection_reused;
+  dns_millis = modio_transfer_info.dns_millis;
+  connect_millis = modio_transfer_info.connect_millis;
+  tls_millis = modio_transfer_info.tls_millis;
+  ttfb_millis = modio_transfer_info.ttfb_millis;
+  transfer_millis = modio_transfer_info.transfer_millis;
+  total_millis = modio_transfer_info.total_millis;
+  download_bytes_per_second = modio_transfer_info.download_bytes_per_second;
+  upload_bytes_per_second = modio_transfer_info.upload_bytes_per_second;
+}
+
+nlohmann::json toJson(TransferInfo &transfer_info)
+{
+  nlohmann::json transfer_info_json;
+
+  transfer_info_json["effective_url"] = transfer_info.effective_url;
+  transfer_info_json["http_version"] = transfer_info.http_version;
+  transfer_info_json["connection_reused"] = transfer_info.connection_reused;
+  transfer_info_json["dns_millis"] = transfer_info.dns_millis;
+  transfer_info_json["connect_millis"] = transfer_info.connect_millis;
+  transfer_info_json["tls_millis"] = transfer_info.tls_millis;
+  transfer_info_json["ttfb_millis"] = transfer_info.ttfb_millis;
+  transfer_info_json["transfer_millis"] = transfer_info.transfer_millis;
+  transfer_info_json["total_millis"] = transfer_info.total_millis;
+  transfer_info_json["download_bytes_per_second"] = transfer_info.download_bytes_per_second;
+  transfer_info_json["upload_bytes_per_second"] = transfer_info.upload_bytes_per_second;
+
+  return transfer_info_json;
+}
+} // namespace modio
@@ -2,36 +2,32 @@
 
 namespace modio
 {
-void User::initialize(ModioUser modio_user)
+const ClassSchemaTable &getUserClassSchema()
 {
-  id = modio_user.id;
-  date_online = modio_user.date_online;
-  if (modio_user.username)
-    username = modio_user.username;
-  if (modio_user.name_id)
-    name_id = modio_user.name_id;
-  if (modio_user.timezone)
-    timezone = modio_user.timezone;
-  if (modio_user.language)
-    language = modio_user.language;
-  if (modio_user.profile_url)
-    profile_url = modio_user.profile_url;
-  avatar.initialize(modio_user.avatar);
+  static const ClassSchemaTable schema(getUserSchema(), {
+      MODIO_CLASS_U32(User, id),
+      MODIO_CLASS_U32(User, date_online),
+      MODIO_CLASS_STRING(User, username),
+      MODIO_CLASS_STRING(User, name_id),
+      MODIO_CLASS_STRING(User, timezone),
+      MODIO_CLASS_STRING(User, language),
+      MODIO_CLASS_STRING(User, profile_url),
+      MODIO_CLASS_OBJECT(User, avatar, Avatar, getAvatarClassSchema())});
+  return schema;
 }
 
-nlohmann::json toJson(User &user)
+void User::initialize(ModioUser modio_user)
 {
-  nlohmann::json user_json;
+  modio::initializeClass(getUserClassSchema(), this, &modio_user);
+}
 
-  user_json["id"] = user.id;
-  user_json["date_online"] = user.date_online;
-  user_json["username"] = user.username;
-  user_json["name_id"] = user.name_id;
-  user_json["timezone"] = user.timezone;
-  user_json["language"] = user.language;
-  user_json["profile_url"] = user.profile_url;
-  user_json["avatar"] = modio::toJson(user.avatar);
+void User::initialize(const nlohmann::json &user_json)
+{
+  modio::initializeClass(getUserClassSchema(), this, user_json);
+}
 
-  return user_json;
+nlohmann::json toJson(User &user)
+{
+  return modio::encodeClass(getUserClassSchema(), &user);
 }
 } // namespace modio
@@ -1,28 +1,27 @@
 #include "c++/schemas/UserEvent.h"
+#include "c/schemas/ModioModEvent.h"
 
 namespace modio
 {
+const ClassSchemaTable &getUserEventClassSchema()
+{
+  static const ClassSchemaTable schema(getUserEventSchema(), {
+      MODIO_CLASS_U32(UserEvent, id),
+      MODIO_CLASS_U32(UserEvent, game_id),
+      MODIO_CLASS_U32(UserEvent, mod_id),
+      MODIO_CLASS_U32(UserEvent, user_id),
+      MODIO_CLASS_ENUM(UserEvent, event_type, getEventTypeValues()),
+      MODIO_CLASS_U32(UserEvent, date_added)});
+  return schema;
+}
+
 void UserEvent::initialize(ModioUserEvent modio_event)
 {
-  id = modio_event.id;
-  game_id = modio_event.game_id;
-  mod_id = modio_event.mod_id;
-  user_id = modio_event.user_id;
-  event_type = modio_event.event_type;
-  date_added = modio_event.date_added;
+  modio::initializeClass(getUserEventClassSchema(), this, &modio_event);
 }
 
 nlohmann::json toJson(UserEvent &event)
 {
-  nlohmann::json event_json;
-
-  event_json["id"] = event.id;
-  event_json["game_id"] = event.game_id;
-  event_json["mod_id"] = event.mod_id;
-  event_json["user_id"] = event.user_id;
-  event_json["event_type"] = event.event_type;
-  event_json["date_added"] = event.date_added;
-
-  return event_json;
+  return modio::encodeClass(getUserEventClassSchema(), &event);
 }
 } // namespace modio
@@ -1,5 +1,8 @@
 #include "c/creators/ModioFilterCreator.h"
 
+#include <cstring>
+#include <vector>
+
 
 namespace modio
 {
@@ -8,23 +11,6 @@ namespace modio
     return str.substr(0,str.find("="));
   }
 
-  static bool appendIfExists(ModioListNode* list, std::string field, std::string value)
-  {
-    for(ModioListNode* iterator = list; iterator != NULL; iterator = iterator->next)
-    {
-      if(getField(iterator->value) == field)
-      {
-        char* old_value = iterator->value;
-        std::string appended_value = std::string(iterator->value) + "," + value;
-        iterator->value = new char[appended_value.size() + 1];
-        strcpy(iterator->value, appended_value.c_str());
-        delete[] old_value;
-        return true;
-      }
-    }
-    return false;
-  }
-
   static bool replaceIfExists(ModioListNode* list, std::string field, std::string value)
   {
     for(ModioListNode* iterator = list; iterator != NULL; iterator = iterator->next)
@@ -72,6 +58,7 @@ extern "C"
     filter->greater_than_list = NULL;
     filter->not_equal_list = NULL;
     filter->cache_max_age_seconds = 0;
+    filter->cache_policy = MODIO_CACHE_POLICY_DEFAULT;
   }
 
   void modioSetFilterSort(ModioFilterCreator* filter, char const* field, bool ascending)
@@ -118,6 +105,11 @@ extern "C"
     filter->cache_max_age_seconds = max_age_seconds;
   }
 
+  void modioSetFilterCachePolicy(ModioFilterCreator* filter, u32 cache_policy)
+  {
+    filter->cache_policy = cache_policy;
+  }
+
   void modioAddFilterFieldValue(ModioFilterCreator* filter, char const* field, char const* value)
   {
     if(modio::replaceIfExists(filter->field_value_list, std::string(field) , value))
@@ -144,18 +136,14 @@ extern "C"
 
   void modioAddFilterInField(ModioFilterCreator* filter, char const* field, char const* value)
   {
-    if(modio::appendIfExists(filter->in_list, std::string(field) + "-in" , value))
-      return;
-    else
-      filter->in_list = modio::addNewNode(filter->in_list, std::string(field) + "-in=" + value);
+    // One node per value, getFilterString joins them, so long lists build in linear time
+    filter->in_list = modio::addNewNode(filter->in_list, std::string(field) + "-in=" + value);
   }
 
   void modioAddFilterNotInField(ModioFilterCreator* filter, char const* field, char const* value)
   {
-    if(modio::appendIfExists(filter->not_in_list, std::string(field) + "-not-in" , value))
-      return;
-    else
-      filter->not_in_list = modio::addNewNode(filter->not_in_list, std::string(field) + "-not-in=" + value);
+    // One node per value, getFilterString joins them, so long lists build in linear time
+    filter->not_in_list = modio::addNewNode(filter->not_in_list, std::string(field) + "-not-in=" + value);
   }
 
   void modioAddFilterMinField(ModioFilterCreator* filter, char const* field, char const* value)
@@ -256,6 +244,45 @@ namespace modio
     return filter_string;
   }
 
+  // The in lists hold a node per value, newest first. Joined into one comma separated
+  // parameter per field, fields newest first and values in the order they were added.
+  static std::string addJoinedParam(std::string filter_string, ModioListNode* param_list)
+  {
+    std::vector<const char*> values;
+    for(ModioListNode* iterator = param_list; iterator != NULL; iterator = iterator->next)
+      values.push_back(iterator->value);
+
+    // Fields are the text before the '=' of their first value, kept in params[i]
+    std::vector<size_t> field_sizes;
+    std::vector<std::string> params;
+    for(size_t i = values.size(); i-- > 0;)
+    {
+      const char* separator = strchr(values[i], '=');
+      size_t field_size = separator ? separator - values[i] : strlen(values[i]);
+      size_t field_index = 0;
+      while(field_index < params.size() && (field_sizes[field_index] != field_size || params[field_index].compare(0, field_size, values[i], field_size) != 0))
+        field_index++;
+      if(field_index == params.size())
+      {
+        field_sizes.push_back(field_size);
+        params.push_back(values[i]);
+      }
+      else if(separator)
+      {
+        params[field_index] += ',';
+        params[field_index] += separator + 1;
+      }
+    }
+
+    for(size_t i = params.size(); i-- > 0;)
+    {
+      if(filter_string != "")
+        filter_string += "&";
+      filter_string += params[i];
+    }
+    return filter_string;
+  }
+
   std::string getFilterString(ModioFilterCreator* filter)
   {
     std::string filter_string = "";
@@ -267,8 +294,8 @@ namespace modio
     filter_string = addParam(filter_string, filter->field_value_list);
     filter_string = addParam(filter_string, filter->like_list);
     filter_string = addParam(filter_string, filter->not_like_list);
-    filter_string = addParam(filter_string, filter->in_list);
-    filter_string = addParam(filter_string, filter->not_in_list);
+    filter_string = addJoinedParam(filter_string, filter->in_list);
+    filter_string = addJoinedParam(filter_string, filter->not_in_list);
     filter_string = addParam(filter_string, filter->min_list);
     filter_string = addParam(filter_string, filter->max_list);
     filter_string = addParam(filter_string, filter->smaller_than_list);
@@ -14,16 +14,12 @@ extern "C"
         get_all_mod_comments_callbacks[call_number]->url = url;
         get_all_mod_comments_callbacks[call_number]->is_cache = false;
 
-        std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-        if (cache_filename != "")
+        std::shared_ptr<const nlohmann::json> cache_file_json;
+        if (modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
         {
-            nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-            if (!cache_file_json.empty())
-            {
-                get_all_mod_comments_callbacks[call_number]->is_cache = true;
-                modioOnGetAllModComments(call_number, 200, cache_file_json);
-                return;
-            }
+            get_all_mod_comments_callbacks[call_number]->is_cache = true;
+            modioOnGetAllModComments(call_number, 200, *cache_file_json);
+            return;
         }
         modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllModComments);
     }
@@ -11,6 +11,13 @@ extern "C"
 		get_all_mod_dependencies_callbacks[call_number]->callback = callback;
 		get_all_mod_dependencies_callbacks[call_number]->object = object;
 
+		std::shared_ptr<const nlohmann::json> cache_file_json;
+		if (modio::getPrefetchedCall(url, cache_file_json))
+		{
+			modioOnGetAllModDependencies(call_number, 200, *cache_file_json);
+			return;
+		}
+
 		modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllModDependencies);
 	}
 
@@ -80,16 +80,16 @@ u32 modioGetModfileUploadQueueCount()
 void modioGetAllInstalledMods(ModioInstalledMod *installed_mods)
 {
   u32 i = 0;
-  for(auto installed_mod_json : modio::installed_mods)
+  for(auto &installed_mod : modio::getInstalledMods())
   {
-    modioInitInstalledMod(&(installed_mods[i]), installed_mod_json);
+    modioInitInstalledMod(&(installed_mods[i]), modio::toJson(installed_mod));
     i++;
   }
 }
 
 u32 modioGetAllInstalledModsCount()
 {
-  return (u32)modio::installed_mods.size();
+  return (u32)modio::getInstalledMods().size();
 }
 
 u32 modioGetModState(u32 mod_id)
@@ -100,11 +100,8 @@ u32 modioGetModState(u32 mod_id)
       return queued_mod_download->state;
   }
 
-  for(auto installed_mod : modio::installed_mods)
-  {
-    if(modio::hasKey(installed_mod, "mod_id") && installed_mod["mod_id"] == mod_id)
-      return MODIO_MOD_INSTALLED;
-  }
+  if(modio::findInstalledMod(mod_id))
+    return MODIO_MOD_INSTALLED;
 
   return MODIO_MOD_NOT_INSTALLED;
 }
@@ -6,7 +6,7 @@ extern "C"
   {
     if (!modio::directoryExists(modio::getDirectoryPath(path)))
     {
-      modio::writeLogLine("Could not open image directory: " + modio::getDirectoryPath(path), MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("Could not open image directory: " + modio::getDirectoryPath(path), MODIO_DEBUGLEVEL_ERROR);
       modio::handleDownloadImageError(object, callback);
       return;
     }
@@ -14,7 +14,7 @@ extern "C"
     FILE *file = fopen(path, "wb");
     if (!file)
     {
-      modio::writeLogLine("Could not open image file: " + std::string(path), MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("Could not open image file: " + std::string(path), MODIO_DEBUGLEVEL_ERROR);
       modio::handleDownloadImageError(object, callback);
       return;
     }
@@ -1,5 +1,171 @@
 #include "c/methods/MeMethods.h"
 
+static void getUserSubscriptionsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/subscribed/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  if (modio::serveModsFromCache(url, cache_max_age_seconds, object, callback))
+    return;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_user_subscriptions_callbacks[call_number] = new GetUserSubscriptionsParams;
+  get_user_subscriptions_callbacks[call_number]->callback = callback;
+  get_user_subscriptions_callbacks[call_number]->object = object;
+  get_user_subscriptions_callbacks[call_number]->url = url;
+  get_user_subscriptions_callbacks[call_number]->is_cache = false;
+  get_user_subscriptions_callbacks[call_number]->is_stale = false;
+  get_user_subscriptions_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_user_subscriptions_callbacks[call_number]->is_cache = true;
+    modioOnGetUserSubscriptionsShared(call_number, 200, cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && !modio::serveStaleModsFromCache(url, object, callback, get_user_subscriptions_callbacks[call_number]->stale_hash) && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_user_subscriptions_callbacks[call_number]->is_cache = true;
+    get_user_subscriptions_callbacks[call_number]->is_stale = true;
+    modioOnGetUserSubscriptionsShared(call_number, 200, cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserSubscriptions);
+}
+
+static void getUserGamesFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioGame games[], u32 games_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/games/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_user_games_callbacks[call_number] = new GetUserGamesParams;
+  get_user_games_callbacks[call_number]->callback = callback;
+  get_user_games_callbacks[call_number]->object = object;
+  get_user_games_callbacks[call_number]->url = url;
+  get_user_games_callbacks[call_number]->is_cache = false;
+  get_user_games_callbacks[call_number]->is_stale = false;
+  get_user_games_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_user_games_callbacks[call_number]->is_cache = true;
+    modioOnGetUserGames(call_number, 200, *cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_user_games_callbacks[call_number]->is_cache = true;
+    get_user_games_callbacks[call_number]->is_stale = true;
+    modioOnGetUserGames(call_number, 200, *cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserGames);
+}
+
+static void getUserModsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/mods/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  if (modio::serveModsFromCache(url, cache_max_age_seconds, object, callback))
+    return;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_user_mods_callbacks[call_number] = new GetUserModsParams;
+  get_user_mods_callbacks[call_number]->callback = callback;
+  get_user_mods_callbacks[call_number]->object = object;
+  get_user_mods_callbacks[call_number]->url = url;
+  get_user_mods_callbacks[call_number]->is_cache = false;
+  get_user_mods_callbacks[call_number]->is_stale = false;
+  get_user_mods_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_user_mods_callbacks[call_number]->is_cache = true;
+    modioOnGetUserModsShared(call_number, 200, cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && !modio::serveStaleModsFromCache(url, object, callback, get_user_mods_callbacks[call_number]->stale_hash) && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_user_mods_callbacks[call_number]->is_cache = true;
+    get_user_mods_callbacks[call_number]->is_stale = true;
+    modioOnGetUserModsShared(call_number, 200, cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserMods);
+}
+
+static void getUserModfilesFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/files/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_user_modfiles_callbacks[call_number] = new GetUserModfilesParams;
+  get_user_modfiles_callbacks[call_number]->callback = callback;
+  get_user_modfiles_callbacks[call_number]->object = object;
+  get_user_modfiles_callbacks[call_number]->url = url;
+  get_user_modfiles_callbacks[call_number]->is_cache = false;
+  get_user_modfiles_callbacks[call_number]->is_stale = false;
+  get_user_modfiles_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_user_modfiles_callbacks[call_number]->is_cache = true;
+    modioOnGetUserModfiles(call_number, 200, *cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_user_modfiles_callbacks[call_number]->is_cache = true;
+    get_user_modfiles_callbacks[call_number]->is_stale = true;
+    modioOnGetUserModfiles(call_number, 200, *cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserModfiles);
+}
+
+static void getUserRatingsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioRating ratings[], u32 ratings_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/ratings/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_user_ratings_callbacks[call_number] = new GetUserRatingsParams;
+  get_user_ratings_callbacks[call_number]->callback = callback;
+  get_user_ratings_callbacks[call_number]->object = object;
+  get_user_ratings_callbacks[call_number]->url = url;
+  get_user_ratings_callbacks[call_number]->is_cache = false;
+  get_user_ratings_callbacks[call_number]->is_stale = false;
+  get_user_ratings_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_user_ratings_callbacks[call_number]->is_cache = true;
+    modioOnGetUserRatings(call_number, 200, *cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_user_ratings_callbacks[call_number]->is_cache = true;
+    get_user_ratings_callbacks[call_number]->is_stale = true;
+    modioOnGetUserRatings(call_number, 200, *cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserRatings);
+}
+
 extern "C"
 {
   void modioGetAuthenticatedUser(void* object, void (*callback)(void* object, ModioResponse response, ModioUser user))
@@ -17,35 +183,13 @@ extern "C"
 
   void modioGetUserSubscriptionsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/subscribed/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_user_subscriptions_callbacks[call_number] = new GetUserSubscriptionsParams;
-    get_user_subscriptions_callbacks[call_number]->callback = callback;
-    get_user_subscriptions_callbacks[call_number]->object = object;
-    get_user_subscriptions_callbacks[call_number]->url = url;
-    get_user_subscriptions_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      if(!cache_file_json.empty())
-      {
-        get_user_subscriptions_callbacks[call_number]->is_cache = true;
-        modioOnGetUserSubscriptions(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserSubscriptions);
+    getUserSubscriptionsFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetUserSubscriptions(void* object, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetUserSubscriptionsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getUserSubscriptionsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
   void modioGetUserEventsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioUserEvent* events_array, u32 events_array_size))
@@ -69,134 +213,46 @@ extern "C"
 
   void modioGetUserGamesFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioGame games[], u32 games_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/games/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_user_games_callbacks[call_number] = new GetUserGamesParams;
-    get_user_games_callbacks[call_number]->callback = callback;
-    get_user_games_callbacks[call_number]->object = object;
-    get_user_games_callbacks[call_number]->url = url;
-    get_user_games_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      if(!cache_file_json.empty())
-      {
-        get_user_games_callbacks[call_number]->is_cache = true;
-        modioOnGetUserGames(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserGames);
+    getUserGamesFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetUserGames(void* object, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioGame games[], u32 games_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetUserGamesFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getUserGamesFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
   void modioGetUserModsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/mods/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_user_mods_callbacks[call_number] = new GetUserModsParams;
-    get_user_mods_callbacks[call_number]->callback = callback;
-    get_user_mods_callbacks[call_number]->object = object;
-    get_user_mods_callbacks[call_number]->url = url;
-    get_user_mods_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      if(!cache_file_json.empty())
-      {
-        get_user_mods_callbacks[call_number]->is_cache = true;
-        modioOnGetUserMods(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserMods);
+    getUserModsFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetUserMods(void* object, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetUserModsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getUserModsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
   void modioGetUserModfilesFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/files/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_user_modfiles_callbacks[call_number] = new GetUserModfilesParams;
-    get_user_modfiles_callbacks[call_number]->callback = callback;
-    get_user_modfiles_callbacks[call_number]->object = object;
-    get_user_modfiles_callbacks[call_number]->url = url;
-    get_user_modfiles_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      if(!cache_file_json.empty())
-      {
-        get_user_modfiles_callbacks[call_number]->is_cache = true;
-        modioOnGetUserModfiles(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserModfiles);
+    getUserModfilesFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetUserModfiles(void* object, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetUserModfilesFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getUserModfilesFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
   void modioGetUserRatingsFilterString(void* object, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioRating ratings[], u32 ratings_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "me/ratings/?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_user_ratings_callbacks[call_number] = new GetUserRatingsParams;
-    get_user_ratings_callbacks[call_number]->callback = callback;
-    get_user_ratings_callbacks[call_number]->object = object;
-    get_user_ratings_callbacks[call_number]->url = url;
-    get_user_ratings_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      if(!cache_file_json.empty())
-      {
-        get_user_ratings_callbacks[call_number]->is_cache = true;
-        modioOnGetUserRatings(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetUserRatings);
+    getUserRatingsFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetUserRatings(void* object, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioRating ratings[], u32 ratings_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetUserRatingsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getUserRatingsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
 }
@@ -1,54 +1,142 @@
 #include "c/methods/ModMethods.h"
 
-extern "C"
+static void getAllModsFilterString(void* object, char const *filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size), void (*json_callback)(void* object, ModioResponse response, const nlohmann::json &mods_json))
 {
-  void modioGetMod(void *object, u32 mod_id, void (*callback)(void *object, ModioResponse response, ModioMod mod))
-  {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id) + "?api_key=" + modio::API_KEY;
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
 
-    u32 call_number = modio::curlwrapper::getCallNumber();
+  if (modio::serveModsFromCache(url, cache_max_age_seconds, object, callback))
+    return;
 
-    get_mod_callbacks[call_number] = new GetModParams;
-    get_mod_callbacks[call_number]->callback = callback;
-    get_mod_callbacks[call_number]->object = object;
+  u32 call_number = modio::curlwrapper::getCallNumber();
 
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetMod);
-  }
+  get_all_mods_callbacks[call_number] = new GetAllModsParams;
+  get_all_mods_callbacks[call_number]->callback = callback;
+  get_all_mods_callbacks[call_number]->json_callback = json_callback;
+  get_all_mods_callbacks[call_number]->object = object;
+  get_all_mods_callbacks[call_number]->url = url;
+  get_all_mods_callbacks[call_number]->is_cache = false;
+  get_all_mods_callbacks[call_number]->is_stale = false;
+  get_all_mods_callbacks[call_number]->stale_hash = 0;
 
-  void modioGetAllModsFilterString(void* object, char const *filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if (modio::getPrefetchedCall(url, cache_file_json) || modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+    get_all_mods_callbacks[call_number]->is_cache = true;
+    modioOnGetAllModsShared(call_number, 200, cache_file_json);
+    return;
+  }
 
-    u32 call_number = modio::curlwrapper::getCallNumber();
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && !modio::serveStaleModsFromCache(url, object, callback, get_all_mods_callbacks[call_number]->stale_hash) && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_all_mods_callbacks[call_number]->is_cache = true;
+    get_all_mods_callbacks[call_number]->is_stale = true;
+    modioOnGetAllModsShared(call_number, 200, cache_file_json);
+  }
 
-    get_all_mods_callbacks[call_number] = new GetAllModsParams;
-    get_all_mods_callbacks[call_number]->callback = callback;
-    get_all_mods_callbacks[call_number]->object = object;
-    get_all_mods_callbacks[call_number]->url = url;
-    get_all_mods_callbacks[call_number]->is_cache = false;
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllMods);
+}
 
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if (cache_filename != "")
+static void getMod(void *object, u32 mod_id, void (*callback)(void *object, ModioResponse response, ModioMod mod), void (*json_callback)(void* object, ModioResponse response, const nlohmann::json &mod_json))
+{
+  // Mods seen recently in any response are served without asking the server again
+  nlohmann::json mod_json;
+  if (modio::getStoredMod(mod_id, mod_json))
+  {
+    ModioResponse response;
+    modioInitResponse(&response, nlohmann::json());
+    response.code = 200;
+    response.result_cached = true;
+    if (json_callback)
     {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      nlohmann::json empty_json = {};
-      if (!cache_file_json.empty())
-      {
-        get_all_mods_callbacks[call_number]->is_cache = true;
-        modioOnGetAllMods(call_number, 200, cache_file_json);
-        return;
-      }
+      json_callback(object, response, mod_json);
     }
+    else
+    {
+      ModioMod mod;
+      modioInitMod(&mod, mod_json);
+      callback(object, response, mod);
+      modioFreeMod(&mod);
+    }
+    modioFreeResponse(&response);
+    return;
+  }
+
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id) + "?api_key=" + modio::API_KEY;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_mod_callbacks[call_number] = new GetModParams;
+  get_mod_callbacks[call_number]->callback = callback;
+  get_mod_callbacks[call_number]->json_callback = json_callback;
+  get_mod_callbacks[call_number]->object = object;
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetMod);
+}
+
+// A string field of a mod whose listing is retained for the lazy fields, straight from the json
+static char const *getLazyModString(u32 mod_id, const char *key)
+{
+  const nlohmann::json *mod_json = modio::findLazyMod(mod_id);
+  if (!mod_json)
+    return NULL;
+  const std::string *value = modio::getJsonChild(*mod_json, key).get_ptr<const std::string *>();
+  return value ? value->c_str() : NULL;
+}
+
+namespace modio
+{
+void getModJson(void *object, u32 mod_id, void (*json_callback)(void *object, ModioResponse response, const nlohmann::json &mod_json))
+{
+  ::getMod(object, mod_id, NULL, json_callback);
+}
 
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllMods);
+void getAllModsJson(void *object, ModioFilterCreator filter, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size), void (*json_callback)(void *object, ModioResponse response, const nlohmann::json &mods_json))
+{
+  std::string filter_string = modio::getFilterString(&filter);
+  getAllModsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback, json_callback);
+}
+} // namespace modio
+
+extern "C"
+{
+  void modioGetMod(void *object, u32 mod_id, void (*callback)(void *object, ModioResponse response, ModioMod mod))
+  {
+    getMod(object, mod_id, callback, NULL);
+  }
+
+  void modioGetAllModsFilterString(void* object, char const *filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioMod mods[], u32 mods_size))
+  {
+    getAllModsFilterString(object, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback, NULL);
   }
 
   void modioGetAllMods(void *object, ModioFilterCreator filter, void (*callback)(void *object, ModioResponse response, ModioMod mods[], u32 mods_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetAllModsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getAllModsFilterString(object, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback, NULL);
+  }
+
+  char const *modioGetModDescription(ModioMod const *mod)
+  {
+    return mod->description ? mod->description : getLazyModString(mod->id, "description");
+  }
+
+  char const *modioGetModDescriptionPlaintext(ModioMod const *mod)
+  {
+    return mod->description_plaintext ? mod->description_plaintext : getLazyModString(mod->id, "description_plaintext");
+  }
+
+  char const *modioGetModMetadataBlob(ModioMod const *mod)
+  {
+    return mod->metadata_blob ? mod->metadata_blob : getLazyModString(mod->id, "metadata_blob");
   }
 
+  ModioMedia const *modioGetModMedia(ModioMod const *mod)
+  {
+    if (mod->media.youtube_size || mod->media.sketchfab_size || mod->media.images_size)
+      return &mod->media;
+    const ModioMedia *lazy_media = modio::getLazyMedia(mod->id);
+    return lazy_media ? lazy_media : &mod->media;
+  }
   void modioEditMod(void *object, u32 mod_id, ModioModEditor mod_editor, void (*callback)(void *object, ModioResponse response, ModioMod mod))
   {
     u32 call_number = modio::curlwrapper::getCallNumber();
@@ -89,9 +177,10 @@ extern "C"
     std::map<std::string, std::string> data;
     u32 call_number = modio::curlwrapper::getCallNumber();
 
-    delete_mod_callbacks[call_number] = new GenericRequestParams;
+    delete_mod_callbacks[call_number] = new DeleteModParams;
     delete_mod_callbacks[call_number]->callback = callback;
     delete_mod_callbacks[call_number]->object = object;
+    delete_mod_callbacks[call_number]->mod_id = mod_id;
 
     std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id);
 
@@ -12,6 +12,13 @@ extern "C"
     get_mod_stats_callbacks[call_number]->callback = callback;
     get_mod_stats_callbacks[call_number]->object = object;
 
+    std::shared_ptr<const nlohmann::json> cache_file_json;
+    if (modio::getPrefetchedCall(url, cache_file_json))
+    {
+      modioOnGetModStats(call_number, 200, *cache_file_json);
+      return;
+    }
+
     modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetModStats);
   }
 
@@ -27,17 +34,12 @@ extern "C"
     get_all_mod_stats_callbacks[call_number]->url = url;
     get_all_mod_stats_callbacks[call_number]->is_cache = false;
 
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
+    std::shared_ptr<const nlohmann::json> cache_file_json;
+    if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
     {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-      nlohmann::json empty_json = {};
-      if(!cache_file_json.empty())
-      {
-        get_all_mod_stats_callbacks[call_number]->is_cache = true;
-        modioOnGetAllModStats(call_number, 200, cache_file_json);
-        return;
-      }
+      get_all_mod_stats_callbacks[call_number]->is_cache = true;
+      modioOnGetAllModStats(call_number, 200, *cache_file_json);
+      return;
     }
     modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllModStats);
   }
@@ -1,9 +1,56 @@
 #include "c/methods/ModfileMethods.h"
 
+static void getAllModfilesFilterString(void* object, u32 mod_id, char const* filter_string, u32 cache_max_age_seconds, u32 cache_policy, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
+{
+  std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id) + "/files?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
+
+  u32 call_number = modio::curlwrapper::getCallNumber();
+
+  get_all_modfiles_callbacks[call_number] = new GetAllModfilesParams;
+  get_all_modfiles_callbacks[call_number]->callback = callback;
+  get_all_modfiles_callbacks[call_number]->object = object;
+  get_all_modfiles_callbacks[call_number]->url = url;
+  get_all_modfiles_callbacks[call_number]->is_cache = false;
+  get_all_modfiles_callbacks[call_number]->is_stale = false;
+  get_all_modfiles_callbacks[call_number]->stale_hash = 0;
+
+  std::shared_ptr<const nlohmann::json> cache_file_json;
+  if(modio::getCallFromCache(url, cache_max_age_seconds, cache_file_json))
+  {
+    get_all_modfiles_callbacks[call_number]->is_cache = true;
+    modioOnGetAllModfiles(call_number, 200, *cache_file_json);
+    return;
+  }
+
+  if (cache_policy == MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE && modio::getStaleCallFromCache(url, cache_file_json))
+  {
+    get_all_modfiles_callbacks[call_number]->is_cache = true;
+    get_all_modfiles_callbacks[call_number]->is_stale = true;
+    modioOnGetAllModfiles(call_number, 200, *cache_file_json);
+  }
+
+  modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllModfiles);
+}
+
 extern "C"
 {
   void modioGetModfile(void* object, u32 mod_id, u32 modfile_id, void (*callback)(void* object, ModioResponse response, ModioModfile modfile))
   {
+    nlohmann::json modfile_json;
+    if (modio::getStoredModfile(modfile_id, modfile_json) && modio::hasKey(modfile_json, "mod_id") && modfile_json["mod_id"] == mod_id)
+    {
+      ModioResponse response;
+      modioInitResponse(&response, nlohmann::json());
+      response.code = 200;
+      response.result_cached = true;
+      ModioModfile modfile;
+      modioInitModfile(&modfile, modfile_json);
+      callback(object, response, modfile);
+      modioFreeResponse(&response);
+      modioFreeModfile(&modfile);
+      return;
+    }
+
     std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id) + "/files/" + modio::toString(modfile_id) + "?api_key=" + modio::API_KEY;
 
     u32 call_number = modio::curlwrapper::getCallNumber();
@@ -17,36 +64,13 @@ extern "C"
 
   void modioGetAllModfilesFilterString(void* object, u32 mod_id, char const* filter_string, u32 cache_max_age_seconds, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
   {
-    std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(mod_id) + "/files?" + (filter_string ? filter_string : "") + "&api_key=" + modio::API_KEY;
-
-    u32 call_number = modio::curlwrapper::getCallNumber();
-
-    get_all_modfiles_callbacks[call_number] = new GetAllModfilesParams;
-    get_all_modfiles_callbacks[call_number]->callback = callback;
-    get_all_modfiles_callbacks[call_number]->object = object;
-    get_all_modfiles_callbacks[call_number]->url = url;
-    get_all_modfiles_callbacks[call_number]->is_cache = false;
-
-    std::string cache_filename = modio::getCallFileFromCache(url, cache_max_age_seconds);
-    if(cache_filename != "")
-    {
-      nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "cache/" + cache_filename);
-
-      if(!cache_file_json.empty())
-      {
-        get_all_modfiles_callbacks[call_number]->is_cache = true;
-        modioOnGetAllModfiles(call_number, 200, cache_file_json);
-        return;
-      }
-    }
-
-    modio::curlwrapper::get(call_number, url, modio::getHeaders(), &modioOnGetAllModfiles);
+    getAllModfilesFilterString(object, mod_id, filter_string, cache_max_age_seconds, MODIO_CACHE_POLICY_DEFAULT, callback);
   }
 
   void modioGetAllModfiles(void* object, u32 mod_id, ModioFilterCreator filter, void (*callback)(void* object, ModioResponse response, ModioModfile modfiles[], u32 modfiles_size))
   {
     std::string filter_string = modio::getFilterString(&filter);
-    modioGetAllModfilesFilterString(object, mod_id, filter_string.c_str(), filter.cache_max_age_seconds, callback);
+    getAllModfilesFilterString(object, mod_id, filter_string.c_str(), filter.cache_max_age_seconds, filter.cache_policy, callback);
   }
 
   void modioAddModfile(u32 mod_id, ModioModfileCreator modfile_creator)
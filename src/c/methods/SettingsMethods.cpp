@@ -12,8 +12,24 @@ extern "C"
     if(!modio::hasKey(config_json, "allow_background_downloads"))
       config_json["allow_background_downloads"] = 1;
 
+    if(!modio::hasKey(config_json, "binary_cache"))
+      config_json["binary_cache"] = MODIO_BINARY_CACHE_ENABLED;
+
+    if(!modio::hasKey(config_json, "lazy_fields"))
+      config_json["lazy_fields"] = MODIO_LAZY_FIELDS_DISABLED;
+
+    if(!modio::hasKey(config_json, "cache_max_bytes"))
+      config_json["cache_max_bytes"] = MODIO_CACHE_STORE_MAX_BYTES;
+
+    if(!modio::hasKey(config_json, "prefetch_budget"))
+      config_json["prefetch_budget"] = MODIO_PREFETCH_DISABLED;
+
     modio::AUTOMATIC_UPDATES = config_json["automatic_updates"];
     modio::BACKGROUND_DOWNLOADS = config_json["allow_background_downloads"];
+    modio::BINARY_CACHE = config_json["binary_cache"];
+    modio::LAZY_FIELDS = config_json["lazy_fields"];
+    modio::CACHE_MAX_BYTES = config_json["cache_max_bytes"];
+    modio::PREFETCH_BUDGET = config_json["prefetch_budget"];
     modio::writeJson(modio::getModIODirectory() + "config.json", config_json);
   }
 
@@ -53,4 +69,79 @@ extern "C"
 
     modio::BACKGROUND_DOWNLOADS = option;
   }
+
+  u32 modioGetBinaryCacheConfig()
+  {
+    nlohmann::json config_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    u32 binary_cache = 0;
+    if(modio::hasKey(config_json, "binary_cache"))
+      binary_cache = config_json["binary_cache"];
+    return binary_cache;
+  }
+
+  void modioSetBinaryCacheConfig(u32 option)
+  {
+    nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    cache_file_json["binary_cache"] = option;
+    modio::writeJson(modio::getModIODirectory() + "config.json", cache_file_json);
+
+    modio::BINARY_CACHE = option;
+  }
+
+  u32 modioGetLazyFieldsConfig()
+  {
+    nlohmann::json config_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    u32 lazy_fields = 0;
+    if(modio::hasKey(config_json, "lazy_fields"))
+      lazy_fields = config_json["lazy_fields"];
+    return lazy_fields;
+  }
+
+  void modioSetLazyFieldsConfig(u32 option)
+  {
+    nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    cache_file_json["lazy_fields"] = option;
+    modio::writeJson(modio::getModIODirectory() + "config.json", cache_file_json);
+
+    modio::LAZY_FIELDS = option;
+  }
+
+  u32 modioGetCacheMaxBytesConfig()
+  {
+    nlohmann::json config_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    u32 cache_max_bytes = 0;
+    if(modio::hasKey(config_json, "cache_max_bytes"))
+      cache_max_bytes = config_json["cache_max_bytes"];
+    return cache_max_bytes;
+  }
+
+  void modioSetCacheMaxBytesConfig(u32 max_bytes)
+  {
+    nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    cache_file_json["cache_max_bytes"] = max_bytes;
+    modio::writeJson(modio::getModIODirectory() + "config.json", cache_file_json);
+
+    modio::CACHE_MAX_BYTES = max_bytes;
+    modio::setCacheMaxBytes(max_bytes);
+  }
+
+  u32 modioGetPrefetchBudgetConfig()
+  {
+    nlohmann::json config_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    u32 prefetch_budget = 0;
+    if(modio::hasKey(config_json, "prefetch_budget"))
+      prefetch_budget = config_json["prefetch_budget"];
+    return prefetch_budget;
+  }
+
+  void modioSetPrefetchBudgetConfig(u32 requests_per_minute)
+  {
+    nlohmann::json cache_file_json = modio::openJson(modio::getModIODirectory() + "config.json");
+    cache_file_json["prefetch_budget"] = requests_per_minute;
+    modio::writeJson(modio::getModIODirectory() + "config.json", cache_file_json);
+
+    modio::PREFETCH_BUDGET = requests_per_minute;
+    if (requests_per_minute == MODIO_PREFETCH_DISABLED)
+      modio::clearPrefetch();
+  }
 }
@@ -4,12 +4,13 @@ std::map<u32, GetAllModCommentsParams *> get_all_mod_comments_callbacks;
 std::map<u32, GetModCommentParams *> get_mod_comment_callbacks;
 std::map<u32, GenericRequestParams *> delete_mod_comment_callbacks;
 
-void modioOnGetAllModComments(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetAllModComments(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
   response.code = response_code;
   ModioComment *comments_array = NULL;
+  modio::SchemaArena arena;
   u32 comments_array_size = 0;
 
   if (response.code == 200)
@@ -17,7 +18,8 @@ void modioOnGetAllModComments(u32 call_number, u32 response_code, nlohmann::json
     if (modio::hasKey(response_json, "data"))
     {
       comments_array_size = (u32)response_json["data"].size();
-      comments_array = new ModioComment[comments_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      comments_array = modio::allocateSchemaArray<ModioComment>(comments_array_size);
       for (u32 i = 0; i < comments_array_size; i++)
       {
         modioInitComment(&(comments_array[i]), response_json["data"][i]);
@@ -36,10 +38,6 @@ void modioOnGetAllModComments(u32 call_number, u32 response_code, nlohmann::json
   get_all_mod_comments_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < comments_array_size; i++)
-    modioFreeComment(&(comments_array[i]));
-  if (comments_array)
-    delete[] comments_array;
 }
 
 void modioOnGetModComment(u32 call_number, u32 response_code, nlohmann::json response_json)
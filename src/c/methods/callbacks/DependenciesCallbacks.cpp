@@ -4,12 +4,13 @@ std::map<u32, GetAllModDependenciesParams *> get_all_mod_dependencies_callbacks;
 std::map<u32, GenericRequestParams *> add_mod_dependencies_callbacks;
 std::map<u32, GenericRequestParams *> delete_mod_dependencies_callbacks;
 
-void modioOnGetAllModDependencies(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetAllModDependencies(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
   response.code = response_code;
   ModioDependency *dependencies_array = NULL;
+  modio::SchemaArena arena;
   u32 dependencies_array_size = 0;
 
   if (response.code == 200)
@@ -17,7 +18,8 @@ void modioOnGetAllModDependencies(u32 call_number, u32 response_code, nlohmann::
     if (modio::hasKey(response_json, "data"))
     {
       dependencies_array_size = (u32)response_json["data"].size();
-      dependencies_array = new ModioDependency[dependencies_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      dependencies_array = modio::allocateSchemaArray<ModioDependency>(dependencies_array_size);
       for (u32 i = 0; i < dependencies_array_size; i++)
       {
         modioInitDependency(&(dependencies_array[i]), response_json["data"][i]);
@@ -36,10 +38,6 @@ void modioOnGetAllModDependencies(u32 call_number, u32 response_code, nlohmann::
   get_all_mod_dependencies_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < dependencies_array_size; i++)
-    modioFreeDependency(&(dependencies_array[i]));
-  if (dependencies_array)
-    delete[] dependencies_array;
 }
 
 void modioOnAddModDependencies(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -33,23 +33,50 @@ void modioOnGetAuthenticatedUser(u32 call_number, u32 response_code, nlohmann::j
 
 void modioOnGetUserSubscriptions(u32 call_number, u32 response_code, nlohmann::json response_json)
 {
+  modioOnGetUserSubscriptionsShared(call_number, response_code, std::make_shared<const nlohmann::json>(std::move(response_json)));
+}
+
+// Cached responses come in shared with the response cache
+void modioOnGetUserSubscriptionsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json)
+{
+  const nlohmann::json &response_json = *shared_response_json;
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_user_subscriptions_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_user_subscriptions_callbacks[call_number]->is_cache;
+  response.result_stale = get_user_subscriptions_callbacks[call_number]->is_stale;
   ModioMod *mods = NULL;
+  modio::SchemaArena arena;
   u32 mods_size = 0;
 
+  bool lazy_fields = response.code == 200 && modio::LAZY_FIELDS == MODIO_LAZY_FIELDS_ENABLED;
+  if (lazy_fields)
+    modio::retainLazyResponse(shared_response_json);
+  const nlohmann::json &listing_json = response_json;
+
   if (response.code == 200)
   {
-    if (modio::hasKey(response_json, "data"))
+    if (modio::hasKey(listing_json, "data"))
     {
-      if (!get_user_subscriptions_callbacks[call_number]->is_cache)
-        modio::addCallToCache(get_user_subscriptions_callbacks[call_number]->url, response_json);
-
-      mods_size = (u32)response_json["data"].size();
-      mods = new ModioMod[mods_size];
+      const nlohmann::json &mods_json = listing_json["data"];
+      mods_size = (u32)mods_json.size();
+      // Binary cache images are written whole so they still hold the lazy fields after a restart
+      bool lazy_mods = lazy_fields && (get_user_subscriptions_callbacks[call_number]->is_cache || modio::BINARY_CACHE != MODIO_BINARY_CACHE_ENABLED);
+      modio::SchemaArenaScope arena_scope(arena);
+      mods = modio::allocateSchemaArray<ModioMod>(mods_size);
       for (u32 i = 0; i < mods_size; i++)
-        modioInitMod(&mods[i], response_json["data"][i]);
+      {
+        if (lazy_mods)
+          modioInitModLazyFields(&mods[i], mods_json[i]);
+        else
+          modioInitMod(&mods[i], mods_json[i]);
+      }
+
+      if (!get_user_subscriptions_callbacks[call_number]->is_cache)
+      {
+        modio::addModsCallToCache(get_user_subscriptions_callbacks[call_number]->url, listing_json, response, mods, mods_size);
+        modio::storeMods(listing_json);
+      }
     }
     else
     {
@@ -58,16 +85,25 @@ void modioOnGetUserSubscriptions(u32 call_number, u32 response_code, nlohmann::j
     }
   }
 
+  if (response.code == 304)
+    modio::refreshCachedCall(get_user_subscriptions_callbacks[call_number]->url);
+
   get_user_subscriptions_callbacks[call_number]->callback(get_user_subscriptions_callbacks[call_number]->object, response, mods, mods_size);
 
-  delete get_user_subscriptions_callbacks[call_number];
-  get_user_subscriptions_callbacks.erase(call_number);
+  if (get_user_subscriptions_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_user_subscriptions_callbacks[call_number]->is_cache = false;
+    get_user_subscriptions_callbacks[call_number]->is_stale = false;
+    get_user_subscriptions_callbacks[call_number]->stale_hash = modio::getResponseHash(listing_json);
+  }
+  else
+  {
+    delete get_user_subscriptions_callbacks[call_number];
+    get_user_subscriptions_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < mods_size; i++)
-    modioFreeMod(&mods[i]);
-  if (mods)
-    delete[] mods;
 }
 
 void modioOnGetUserEvents(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -76,6 +112,7 @@ void modioOnGetUserEvents(u32 call_number, u32 response_code, nlohmann::json res
   modioInitResponse(&response, response_json);
   response.code = response_code;
   ModioUserEvent *events_array = NULL;
+  modio::SchemaArena arena;
   u32 events_array_size = 0;
 
   if (response.code == 200)
@@ -83,7 +120,8 @@ void modioOnGetUserEvents(u32 call_number, u32 response_code, nlohmann::json res
     if (modio::hasKey(response_json, "data"))
     {
       events_array_size = (u32)response_json["data"].size();
-      events_array = new ModioUserEvent[events_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      events_array = modio::allocateSchemaArray<ModioUserEvent>(events_array_size);
 
       for (u32 i = 0; i < events_array_size; i++)
         modioInitUserEvent(&(events_array[i]), response_json["data"][i]);
@@ -101,18 +139,17 @@ void modioOnGetUserEvents(u32 call_number, u32 response_code, nlohmann::json res
   get_user_events_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < events_array_size; i++)
-    modioFreeUserEvent(&(events_array[i]));
-  if (events_array)
-    delete[] events_array;
 }
 
-void modioOnGetUserGames(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetUserGames(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_user_games_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_user_games_callbacks[call_number]->is_cache;
+  response.result_stale = get_user_games_callbacks[call_number]->is_stale;
   ModioGame *games = NULL;
+  modio::SchemaArena arena;
   u32 games_size = 0;
 
   if (response.code == 200)
@@ -123,7 +160,8 @@ void modioOnGetUserGames(u32 call_number, u32 response_code, nlohmann::json resp
         modio::addCallToCache(get_user_games_callbacks[call_number]->url, response_json);
 
       games_size = (u32)response_json["data"].size();
-      games = new ModioGame[games_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      games = modio::allocateSchemaArray<ModioGame>(games_size);
       for (u32 i = 0; i < games_size; i++)
         modioInitGame(&games[i], response_json["data"][i]);
     }
@@ -134,37 +172,73 @@ void modioOnGetUserGames(u32 call_number, u32 response_code, nlohmann::json resp
     }
   }
 
+  if (response.code == 304)
+    modio::refreshCachedCall(get_user_games_callbacks[call_number]->url);
+
   get_user_games_callbacks[call_number]->callback(get_user_games_callbacks[call_number]->object, response, games, games_size);
 
-  delete get_user_games_callbacks[call_number];
-  get_user_games_callbacks.erase(call_number);
+  if (get_user_games_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_user_games_callbacks[call_number]->is_cache = false;
+    get_user_games_callbacks[call_number]->is_stale = false;
+    get_user_games_callbacks[call_number]->stale_hash = modio::getResponseHash(response_json);
+  }
+  else
+  {
+    delete get_user_games_callbacks[call_number];
+    get_user_games_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < games_size; i++)
-    modioFreeGame(&games[i]);
-  if (games)
-    delete[] games;
 }
 
 void modioOnGetUserMods(u32 call_number, u32 response_code, nlohmann::json response_json)
 {
+  modioOnGetUserModsShared(call_number, response_code, std::make_shared<const nlohmann::json>(std::move(response_json)));
+}
+
+// Cached responses come in shared with the response cache
+void modioOnGetUserModsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json)
+{
+  const nlohmann::json &response_json = *shared_response_json;
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_user_mods_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_user_mods_callbacks[call_number]->is_cache;
+  response.result_stale = get_user_mods_callbacks[call_number]->is_stale;
   u32 mods_size = 0;
   ModioMod *mods = NULL;
+  modio::SchemaArena arena;
+
+  bool lazy_fields = response.code == 200 && modio::LAZY_FIELDS == MODIO_LAZY_FIELDS_ENABLED;
+  if (lazy_fields)
+    modio::retainLazyResponse(shared_response_json);
+  const nlohmann::json &listing_json = response_json;
 
   if (response.code == 200)
   {
-    if (modio::hasKey(response_json, "data"))
+    if (modio::hasKey(listing_json, "data"))
     {
-      if (!get_user_mods_callbacks[call_number]->is_cache)
-        modio::addCallToCache(get_user_mods_callbacks[call_number]->url, response_json);
-
-      mods_size = (u32)response_json["data"].size();
-      mods = new ModioMod[mods_size];
+      const nlohmann::json &mods_json = listing_json["data"];
+      mods_size = (u32)mods_json.size();
+      // Binary cache images are written whole so they still hold the lazy fields after a restart
+      bool lazy_mods = lazy_fields && (get_user_mods_callbacks[call_number]->is_cache || modio::BINARY_CACHE != MODIO_BINARY_CACHE_ENABLED);
+      modio::SchemaArenaScope arena_scope(arena);
+      mods = modio::allocateSchemaArray<ModioMod>(mods_size);
       for (u32 i = 0; i < mods_size; i++)
-        modioInitMod(&mods[i], response_json["data"][i]);
+      {
+        if (lazy_mods)
+          modioInitModLazyFields(&mods[i], mods_json[i]);
+        else
+          modioInitMod(&mods[i], mods_json[i]);
+      }
+
+      if (!get_user_mods_callbacks[call_number]->is_cache)
+      {
+        modio::addModsCallToCache(get_user_mods_callbacks[call_number]->url, listing_json, response, mods, mods_size);
+        modio::storeMods(listing_json);
+      }
     }
     else
     {
@@ -173,24 +247,36 @@ void modioOnGetUserMods(u32 call_number, u32 response_code, nlohmann::json respo
     }
   }
 
-  get_user_mods_callbacks[call_number]->callback(get_user_mods_callbacks[call_number]->object, response, NULL, 0);
+  if (response.code == 304)
+    modio::refreshCachedCall(get_user_mods_callbacks[call_number]->url);
+
+  get_user_mods_callbacks[call_number]->callback(get_user_mods_callbacks[call_number]->object, response, mods, mods_size);
 
-  delete get_user_mods_callbacks[call_number];
-  get_user_mods_callbacks.erase(call_number);
+  if (get_user_mods_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_user_mods_callbacks[call_number]->is_cache = false;
+    get_user_mods_callbacks[call_number]->is_stale = false;
+    get_user_mods_callbacks[call_number]->stale_hash = modio::getResponseHash(listing_json);
+  }
+  else
+  {
+    delete get_user_mods_callbacks[call_number];
+    get_user_mods_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < mods_size; i++)
-    modioFreeMod(&mods[i]);
-  if (mods)
-    delete[] mods;
 }
 
-void modioOnGetUserModfiles(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetUserModfiles(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_user_modfiles_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_user_modfiles_callbacks[call_number]->is_cache;
+  response.result_stale = get_user_modfiles_callbacks[call_number]->is_stale;
   ModioModfile *modfiles = NULL;
+  modio::SchemaArena arena;
   u32 modfiles_size = 0;
 
   if (response.code == 200)
@@ -198,10 +284,14 @@ void modioOnGetUserModfiles(u32 call_number, u32 response_code, nlohmann::json r
     if (modio::hasKey(response_json, "data"))
     {
       if (!get_user_modfiles_callbacks[call_number]->is_cache)
+      {
         modio::addCallToCache(get_user_modfiles_callbacks[call_number]->url, response_json);
+        modio::storeModfiles(response_json);
+      }
 
       modfiles_size = (u32)response_json["data"].size();
-      modfiles = new ModioModfile[modfiles_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      modfiles = modio::allocateSchemaArray<ModioModfile>(modfiles_size);
       for (u32 i = 0; i < modfiles_size; i++)
         modioInitModfile(&modfiles[i], response_json["data"][i]);
     }
@@ -212,24 +302,36 @@ void modioOnGetUserModfiles(u32 call_number, u32 response_code, nlohmann::json r
     }
   }
 
+  if (response.code == 304)
+    modio::refreshCachedCall(get_user_modfiles_callbacks[call_number]->url);
+
   get_user_modfiles_callbacks[call_number]->callback(get_user_modfiles_callbacks[call_number]->object, response, modfiles, modfiles_size);
 
-  delete get_user_modfiles_callbacks[call_number];
-  get_user_modfiles_callbacks.erase(call_number);
+  if (get_user_modfiles_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_user_modfiles_callbacks[call_number]->is_cache = false;
+    get_user_modfiles_callbacks[call_number]->is_stale = false;
+    get_user_modfiles_callbacks[call_number]->stale_hash = modio::getResponseHash(response_json);
+  }
+  else
+  {
+    delete get_user_modfiles_callbacks[call_number];
+    get_user_modfiles_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < modfiles_size; i++)
-    modioFreeModfile(&modfiles[i]);
-  if (modfiles)
-    delete[] modfiles;
 }
 
-void modioOnGetUserRatings(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetUserRatings(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_user_ratings_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_user_ratings_callbacks[call_number]->is_cache;
+  response.result_stale = get_user_ratings_callbacks[call_number]->is_stale;
   ModioRating *ratings = NULL;
+  modio::SchemaArena arena;
   u32 ratings_size = 0;
 
   if (response.code == 200)
@@ -240,7 +342,8 @@ void modioOnGetUserRatings(u32 call_number, u32 response_code, nlohmann::json re
         modio::addCallToCache(get_user_ratings_callbacks[call_number]->url, response_json);
 
       ratings_size = (u32)response_json["data"].size();
-      ratings = new ModioRating[ratings_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      ratings = modio::allocateSchemaArray<ModioRating>(ratings_size);
       for (u32 i = 0; i < ratings_size; i++)
         modioInitRating(&ratings[i], response_json["data"][i]);
     }
@@ -251,16 +354,25 @@ void modioOnGetUserRatings(u32 call_number, u32 response_code, nlohmann::json re
     }
   }
 
+  if (response.code == 304)
+    modio::refreshCachedCall(get_user_ratings_callbacks[call_number]->url);
+
   get_user_ratings_callbacks[call_number]->callback(get_user_ratings_callbacks[call_number]->object, response, ratings, ratings_size);
 
-  delete get_user_ratings_callbacks[call_number];
-  get_user_ratings_callbacks.erase(call_number);
+  if (get_user_ratings_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_user_ratings_callbacks[call_number]->is_cache = false;
+    get_user_ratings_callbacks[call_number]->is_stale = false;
+    get_user_ratings_callbacks[call_number]->stale_hash = modio::getResponseHash(response_json);
+  }
+  else
+  {
+    delete get_user_ratings_callbacks[call_number];
+    get_user_ratings_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < ratings_size; i++)
-    modioFreeRating(&ratings[i]);
-  if (ratings)
-    delete[] ratings;
 }
 
 void clearMeCallbackParams()
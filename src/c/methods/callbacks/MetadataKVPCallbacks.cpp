@@ -10,6 +10,7 @@ void modioOnGetAllMetadataKVP(u32 call_number, u32 response_code, nlohmann::json
   modioInitResponse(&response, response_json);
   response.code = response_code;
   ModioMetadataKVP* metadata_kvp_array = NULL;
+  modio::SchemaArena arena;
   u32 metadata_kvp_array_size = 0;
 
   if(response.code == 200)
@@ -17,7 +18,8 @@ void modioOnGetAllMetadataKVP(u32 call_number, u32 response_code, nlohmann::json
     if(modio::hasKey(response_json, "data"))
     {
       metadata_kvp_array_size = (u32)response_json["data"].size();
-      metadata_kvp_array = new ModioMetadataKVP[metadata_kvp_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      metadata_kvp_array = modio::allocateSchemaArray<ModioMetadataKVP>(metadata_kvp_array_size);
       for(u32 i=0; i<metadata_kvp_array_size; i++)
         modioInitMetadataKVP(&(metadata_kvp_array[i]), response_json["data"][i]);
     }else
@@ -33,10 +35,6 @@ void modioOnGetAllMetadataKVP(u32 call_number, u32 response_code, nlohmann::json
   get_all_metadata_kvp_callbacks.erase(call_number);
   
   modioFreeResponse(&response);
-  for(u32 i=0; i<metadata_kvp_array_size; i++)
-    modioFreeMetadataKVP(&(metadata_kvp_array[i]));
-  if(metadata_kvp_array)
-    delete[] metadata_kvp_array;
 }
 
 void modioOnAddMetadataKVP(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -2,7 +2,7 @@
 
 std::map<u32, GetModParams *> get_mod_callbacks;
 std::map<u32, AddModParams *> add_mod_callbacks;
-std::map<u32, GenericRequestParams *> delete_mod_callbacks;
+std::map<u32, DeleteModParams *> delete_mod_callbacks;
 std::map<u32, GetAllModsParams *> get_all_mods_callbacks;
 std::map<u32, CallbackParamReturnsId *> return_id_callbacks;
 
@@ -12,37 +12,77 @@ void modioOnGetMod(u32 call_number, u32 response_code, nlohmann::json response_j
   modioInitResponse(&response, response_json);
   response.code = response_code;
 
-  ModioMod mod;
-  modioInitMod(&mod, response_json);
+  if (response.code == 200)
+    modio::storeMod(response_json);
 
-  get_mod_callbacks[call_number]->callback(get_mod_callbacks[call_number]->object, response, mod);
+  if (get_mod_callbacks[call_number]->json_callback)
+  {
+    get_mod_callbacks[call_number]->json_callback(get_mod_callbacks[call_number]->object, response, response_json);
+  }
+  else
+  {
+    ModioMod mod;
+    modioInitMod(&mod, response_json);
+    get_mod_callbacks[call_number]->callback(get_mod_callbacks[call_number]->object, response, mod);
+    modioFreeMod(&mod);
+  }
 
   delete get_mod_callbacks[call_number];
   get_mod_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  modioFreeMod(&mod);
 }
 
 void modioOnGetAllMods(u32 call_number, u32 response_code, nlohmann::json response_json)
 {
+  modioOnGetAllModsShared(call_number, response_code, std::make_shared<const nlohmann::json>(std::move(response_json)));
+}
+
+// Cached responses come in shared with the response cache
+void modioOnGetAllModsShared(u32 call_number, u32 response_code, std::shared_ptr<const nlohmann::json> shared_response_json)
+{
+  const nlohmann::json &response_json = *shared_response_json;
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_all_mods_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_all_mods_callbacks[call_number]->is_cache;
+  response.result_stale = get_all_mods_callbacks[call_number]->is_stale;
   u32 mods_size = 0;
   ModioMod *mods = NULL;
+  modio::SchemaArena arena;
+  bool lazy_fields = response.code == 200 && modio::LAZY_FIELDS == MODIO_LAZY_FIELDS_ENABLED;
+  if (lazy_fields)
+    modio::retainLazyResponse(shared_response_json);
+  const nlohmann::json &listing_json = response_json;
+  const nlohmann::json &mods_json = modio::getJsonChild(listing_json, "data");
 
   if (response.code == 200)
   {
-    if (modio::hasKey(response_json, "data"))
+    if (!mods_json.is_null())
     {
-      if (!get_all_mods_callbacks[call_number]->is_cache)
-        modio::addCallToCache(get_all_mods_callbacks[call_number]->url, response_json);
+      mods_size = (u32)mods_json.size();
+      bool needs_image = !get_all_mods_callbacks[call_number]->is_cache && modio::BINARY_CACHE == MODIO_BINARY_CACHE_ENABLED;
+      // The C++ Instance decodes the json itself, the structs are then only needed for the binary cache
+      if (!get_all_mods_callbacks[call_number]->json_callback || needs_image)
+      {
+        modio::SchemaArenaScope arena_scope(arena);
+        mods = modio::allocateSchemaArray<ModioMod>(mods_size);
+        MODIO_TRACE_SCOPE("init mods", "schema");
+        // Binary cache images are written whole so they still hold the lazy fields after a restart
+        for (u32 i = 0; i < mods_size; i++)
+        {
+          if (lazy_fields && !needs_image)
+            modioInitModLazyFields(&mods[i], mods_json[i]);
+          else
+            modioInitMod(&mods[i], mods_json[i]);
+        }
+      }
 
-      mods_size = (u32)response_json["data"].size();
-      mods = new ModioMod[mods_size];
-      for (u32 i = 0; i < mods_size; i++)
-        modioInitMod(&mods[i], response_json["data"][i]);
+      if (!get_all_mods_callbacks[call_number]->is_cache)
+      {
+        modio::addModsCallToCache(get_all_mods_callbacks[call_number]->url, listing_json, response, mods, mods_size);
+        modio::storeMods(listing_json);
+      }
     }
     else
     {
@@ -51,16 +91,38 @@ void modioOnGetAllMods(u32 call_number, u32 response_code, nlohmann::json respon
     }
   }
 
-  get_all_mods_callbacks[call_number]->callback(get_all_mods_callbacks[call_number]->object, response, mods, mods_size);
+  if (response.code == 304)
+    modio::refreshCachedCall(get_all_mods_callbacks[call_number]->url);
 
-  delete get_all_mods_callbacks[call_number];
-  get_all_mods_callbacks.erase(call_number);
+  {
+    MODIO_TRACE_SCOPE("user callback", "callback");
+    if (get_all_mods_callbacks[call_number]->json_callback)
+      get_all_mods_callbacks[call_number]->json_callback(get_all_mods_callbacks[call_number]->object, response, mods_json);
+    else
+      get_all_mods_callbacks[call_number]->callback(get_all_mods_callbacks[call_number]->object, response, mods, mods_size);
+  }
+  if (response.code == 200 && !response.result_stale)
+  {
+    std::vector<u32> mod_ids(mods_size, 0);
+    for (u32 i = 0; i < mods_size; i++)
+      modio::getJsonValue(mods_json[i], "id", mod_ids[i]);
+    modio::queueListingPrefetch(get_all_mods_callbacks[call_number]->url, response, mod_ids);
+  }
+
+  if (get_all_mods_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_all_mods_callbacks[call_number]->is_cache = false;
+    get_all_mods_callbacks[call_number]->is_stale = false;
+    get_all_mods_callbacks[call_number]->stale_hash = modio::getResponseHash(listing_json);
+  }
+  else
+  {
+    delete get_all_mods_callbacks[call_number];
+    get_all_mods_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < mods_size; i++)
-    modioFreeMod(&mods[i]);
-  if (mods)
-    delete[] mods;
 }
 
 void modioOnModAdded(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -72,6 +134,9 @@ void modioOnModAdded(u32 call_number, u32 response_code, nlohmann::json response
   ModioMod mod;
   modioInitMod(&mod, response_json);
 
+  if (response.code == 200 || response.code == 201)
+    modio::storeMod(response_json);
+
   add_mod_callbacks[call_number]->callback(add_mod_callbacks[call_number]->object, response, mod);
 
   delete add_mod_callbacks[call_number];
@@ -87,6 +152,13 @@ void modioOnModDeleted(u32 call_number, u32 response_code, nlohmann::json respon
   modioInitResponse(&response, response_json);
   response.code = response_code;
 
+  // Neither the stored mod nor a cached listing may bring the deleted mod back
+  if (response.code >= 200 && response.code < 300)
+  {
+    modio::removeStoredMod(delete_mod_callbacks[call_number]->mod_id);
+    modio::invalidateCachedMod(delete_mod_callbacks[call_number]->mod_id);
+  }
+
   delete_mod_callbacks[call_number]->callback(delete_mod_callbacks[call_number]->object, response);
 
   delete delete_mod_callbacks[call_number];
@@ -10,6 +10,7 @@ void modioOnGetAllEvents(u32 call_number, u32 response_code, nlohmann::json resp
   response.code = response_code;
 
   ModioModEvent *events_array = NULL;
+  modio::SchemaArena arena;
   u32 events_array_size = 0;
 
   if (response.code == 200)
@@ -17,7 +18,8 @@ void modioOnGetAllEvents(u32 call_number, u32 response_code, nlohmann::json resp
     if (modio::hasKey(response_json, "data"))
     {
       events_array_size = (u32)response_json["data"].size();
-      events_array = new ModioModEvent[events_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      events_array = modio::allocateSchemaArray<ModioModEvent>(events_array_size);
 
       for (u32 i = 0; i < events_array_size; i++)
         modioInitModEvent(&(events_array[i]), response_json["data"][i]);
@@ -35,10 +37,6 @@ void modioOnGetAllEvents(u32 call_number, u32 response_code, nlohmann::json resp
   get_all_events_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < events_array_size; i++)
-    modioFreeModEvent(&(events_array[i]));
-  if (events_array)
-    delete[] events_array;
 }
 
 void modioOnGetEvents(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -47,6 +45,7 @@ void modioOnGetEvents(u32 call_number, u32 response_code, nlohmann::json respons
   modioInitResponse(&response, response_json);
   response.code = response_code;
   ModioModEvent *events_array = NULL;
+  modio::SchemaArena arena;
   u32 events_array_size = 0;
 
   if (response.code == 200)
@@ -54,7 +53,8 @@ void modioOnGetEvents(u32 call_number, u32 response_code, nlohmann::json respons
     if (modio::hasKey(response_json, "data"))
     {
       events_array_size = (u32)response_json["data"].size();
-      events_array = new ModioModEvent[events_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      events_array = modio::allocateSchemaArray<ModioModEvent>(events_array_size);
 
       for (u32 i = 0; i < events_array_size; i++)
         modioInitModEvent(&(events_array[i]), response_json["data"][i]);
@@ -71,10 +71,6 @@ void modioOnGetEvents(u32 call_number, u32 response_code, nlohmann::json respons
   get_events_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < events_array_size; i++)
-    modioFreeModEvent(&(events_array[i]));
-  if (events_array)
-    delete[] events_array;
 }
 
 void clearModEventCallbackParams()
@@ -3,7 +3,7 @@
 std::map<u32, GetModStatsParams *> get_mod_stats_callbacks;
 std::map<u32, GetAllModStatsParams *> get_all_mod_stats_callbacks;
 
-void modioOnGetModStats(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetModStats(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
@@ -21,7 +21,7 @@ void modioOnGetModStats(u32 call_number, u32 response_code, nlohmann::json respo
   modioFreeStats(&stats);
 }
 
-void modioOnGetAllModStats(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetAllModStats(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
@@ -29,6 +29,7 @@ void modioOnGetAllModStats(u32 call_number, u32 response_code, nlohmann::json re
 
   u32 mods_stats_size = 0;
   ModioStats *mods_stats = NULL;
+  modio::SchemaArena arena;
 
   if (response.code == 200)
   {
@@ -38,7 +39,8 @@ void modioOnGetAllModStats(u32 call_number, u32 response_code, nlohmann::json re
         modio::addCallToCache(get_all_mod_stats_callbacks[call_number]->url, response_json);
 
       mods_stats_size = (u32)response_json["data"].size();
-      mods_stats = new ModioStats[mods_stats_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      mods_stats = modio::allocateSchemaArray<ModioStats>(mods_stats_size);
       for (u32 i = 0; i < mods_stats_size; i++)
         modioInitStats(&mods_stats[i], response_json["data"][i]);
     }
@@ -50,10 +52,6 @@ void modioOnGetAllModStats(u32 call_number, u32 response_code, nlohmann::json re
   get_all_mod_stats_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < mods_stats_size; i++)
-    modioFreeStats(&mods_stats[i]);
-  if (mods_stats)
-    delete[] mods_stats;
 }
 
 void clearModStatsCallbackParams()
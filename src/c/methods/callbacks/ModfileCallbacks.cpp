@@ -15,6 +15,9 @@ void modioOnGetModfile(u32 call_number, u32 response_code, nlohmann::json respon
   ModioModfile modfile;
   modioInitModfile(&modfile, response_json);
 
+  if (response.code == 200)
+    modio::storeModfile(response_json);
+
   get_modfile_callbacks[call_number]->callback(get_modfile_callbacks[call_number]->object, response, modfile);
 
   delete get_modfile_callbacks[call_number];
@@ -24,23 +27,30 @@ void modioOnGetModfile(u32 call_number, u32 response_code, nlohmann::json respon
   modioFreeModfile(&modfile);
 }
 
-void modioOnGetAllModfiles(u32 call_number, u32 response_code, nlohmann::json response_json)
+void modioOnGetAllModfiles(u32 call_number, u32 response_code, const nlohmann::json &response_json)
 {
   ModioResponse response;
   modioInitResponse(&response, response_json);
-  response.code = response_code;
+  response.code = modio::getRevalidatedResponseCode(get_all_modfiles_callbacks[call_number]->stale_hash, response_code, response_json);
+  response.result_cached = get_all_modfiles_callbacks[call_number]->is_cache;
+  response.result_stale = get_all_modfiles_callbacks[call_number]->is_stale;
   u32 modfiles_size = 0;
   ModioModfile *modfiles = NULL;
+  modio::SchemaArena arena;
 
   if (response.code == 200)
   {
     if (modio::hasKey(response_json, "data"))
     {
       if (!get_all_modfiles_callbacks[call_number]->is_cache)
+      {
         modio::addCallToCache(get_all_modfiles_callbacks[call_number]->url, response_json);
+        modio::storeModfiles(response_json);
+      }
 
       modfiles_size = (u32)response_json["data"].size();
-      modfiles = new ModioModfile[modfiles_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      modfiles = modio::allocateSchemaArray<ModioModfile>(modfiles_size);
 
       for (u32 i = 0; i < modfiles_size; i++)
         modioInitModfile(&modfiles[i], response_json["data"][i]);
@@ -52,16 +62,25 @@ void modioOnGetAllModfiles(u32 call_number, u32 response_code, nlohmann::json re
     }
   }
 
+  if (response.code == 304)
+    modio::refreshCachedCall(get_all_modfiles_callbacks[call_number]->url);
+
   get_all_modfiles_callbacks[call_number]->callback(get_all_modfiles_callbacks[call_number]->object, response, modfiles, modfiles_size);
 
-  delete get_all_modfiles_callbacks[call_number];
-  get_all_modfiles_callbacks.erase(call_number);
+  if (get_all_modfiles_callbacks[call_number]->is_stale)
+  {
+    // The call goes on to the network, the response is compared with the one just served
+    get_all_modfiles_callbacks[call_number]->is_cache = false;
+    get_all_modfiles_callbacks[call_number]->is_stale = false;
+    get_all_modfiles_callbacks[call_number]->stale_hash = modio::getResponseHash(response_json);
+  }
+  else
+  {
+    delete get_all_modfiles_callbacks[call_number];
+    get_all_modfiles_callbacks.erase(call_number);
+  }
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < modfiles_size; i++)
-    modioFreeModfile(&modfiles[i]);
-  if (modfiles)
-    delete[] modfiles;
 }
 
 void modioOnModfileAdded(u32 call_number, u32 response_code, nlohmann::json response_json)
@@ -73,6 +92,9 @@ void modioOnModfileAdded(u32 call_number, u32 response_code, nlohmann::json resp
   ModioModfile modfile;
   modioInitModfile(&modfile, response_json);
 
+  if (response.code == 201)
+    modio::storeModfile(response_json);
+
   add_modfile_callbacks[call_number]->callback(add_modfile_callbacks[call_number]->object, response, modfile);
 
   delete add_modfile_callbacks[call_number];
@@ -91,6 +113,9 @@ void modioOnModfileEdited(u32 call_number, u32 response_code, nlohmann::json res
   ModioModfile modfile;
   modioInitModfile(&modfile, response_json);
 
+  if (response.code == 200)
+    modio::storeModfile(response_json);
+
   edit_modfile_callbacks[call_number]->callback(edit_modfile_callbacks[call_number]->object, response, modfile);
 
   delete edit_modfile_callbacks[call_number];
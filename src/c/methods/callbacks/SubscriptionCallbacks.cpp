@@ -12,6 +12,9 @@ void modioOnSubscribeToMod(u32 call_number, u32 response_code, nlohmann::json re
   ModioMod mod;
   modioInitMod(&mod, response_json);
 
+  if (response.code == 201)
+    modio::storeMod(response_json);
+
   subscribe_to_mod_callbacks[call_number]->callback(subscribe_to_mod_callbacks[call_number]->object, response, mod);
 
   delete subscribe_to_mod_callbacks[call_number];
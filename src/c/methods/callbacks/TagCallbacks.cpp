@@ -11,6 +11,7 @@ void modioOnGetModTags(u32 call_number, u32 response_code, nlohmann::json respon
   response.code = response_code;
 
   ModioTag *tags_array = NULL;
+  modio::SchemaArena arena;
   u32 tags_array_size = 0;
 
   if (response.code == 200)
@@ -18,7 +19,8 @@ void modioOnGetModTags(u32 call_number, u32 response_code, nlohmann::json respon
     if (modio::hasKey(response_json, "data"))
     {
       tags_array_size = (u32)response_json["data"].size();
-      tags_array = new ModioTag[tags_array_size];
+      modio::SchemaArenaScope arena_scope(arena);
+      tags_array = modio::allocateSchemaArray<ModioTag>(tags_array_size);
       for (u32 i = 0; i < tags_array_size; i++)
       {
         modioInitTag(&(tags_array[i]), response_json["data"][i]);
@@ -37,10 +39,6 @@ void modioOnGetModTags(u32 call_number, u32 response_code, nlohmann::json respon
   get_mod_tags_callbacks.erase(call_number);
 
   modioFreeResponse(&response);
-  for (u32 i = 0; i < tags_array_size; i++)
-    modioFreeTag(&(tags_array[i]));
-  if (tags_array)
-    delete[] tags_array;
 }
 
 void modioOnTagsAdded(u32 call_number, u32 response_code, nlohmann::json response_json)
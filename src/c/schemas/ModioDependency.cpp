@@ -1,23 +1,26 @@
 #include "c/schemas/ModioDependency.h"
 
+namespace modio
+{
+const SchemaTable &getDependencySchema()
+{
+  static const SchemaTable schema(sizeof(ModioDependency), alignof(ModioDependency), {
+      MODIO_SCHEMA_U32(ModioDependency, mod_id),
+      MODIO_SCHEMA_U32(ModioDependency, date_added)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitDependency(ModioDependency* dependency, nlohmann::json dependency_json)
+  void modioInitDependency(ModioDependency* dependency, const nlohmann::json &dependency_json)
   {
-    dependency->mod_id = 0;
-    if(modio::hasKey(dependency_json, "mod_id"))
-      dependency->mod_id = dependency_json["mod_id"];
-
-    dependency->date_added = 0;
-    if(modio::hasKey(dependency_json, "date_added"))
-      dependency->date_added = dependency_json["date_added"];
+    modio::decodeSchema(modio::getDependencySchema(), dependency, dependency_json);
   }
 
   void modioFreeDependency(ModioDependency* dependency)
   {
     if(dependency)
-    {
-      //No pointers
-    }
+      modio::freeSchema(modio::getDependencySchema(), dependency);
   }
 }
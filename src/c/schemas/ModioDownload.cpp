@@ -1,28 +1,26 @@
 #include "c/schemas/ModioDownload.h"
 
+namespace modio
+{
+const SchemaTable &getDownloadSchema()
+{
+  static const SchemaTable schema(sizeof(ModioDownload), alignof(ModioDownload), {
+      MODIO_SCHEMA_STRING(ModioDownload, binary_url),
+      MODIO_SCHEMA_U32(ModioDownload, date_expires)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitDownload(ModioDownload* download, nlohmann::json download_json)
+  void modioInitDownload(ModioDownload* download, const nlohmann::json &download_json)
   {
-    download->date_expires = 0;
-    if(modio::hasKey(download_json, "date_expires"))
-      download->date_expires = download_json["date_expires"];
-
-    download->binary_url = NULL;
-    if(modio::hasKey(download_json, "binary_url"))
-    {
-      std::string binary_url_str = download_json["binary_url"];
-      download->binary_url = new char[binary_url_str.size() + 1];
-      strcpy(download->binary_url, binary_url_str.c_str());
-    }
+    modio::decodeSchema(modio::getDownloadSchema(), download, download_json);
   }
 
   void modioFreeDownload(ModioDownload* download)
   {
     if(download)
-    {
-      if(download->binary_url)
-        delete[] download->binary_url;
-    }
+      modio::freeSchema(modio::getDownloadSchema(), download);
   }
 }
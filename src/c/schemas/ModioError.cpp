@@ -2,37 +2,30 @@
 
 extern "C"
 {
-  void modioInitError(ModioError* error, nlohmann::json error_json)
+  void modioInitError(ModioError* error, const nlohmann::json &error_json)
   {
     error->code = 0;
-    if(modio::hasKey(error_json, "code"))
-      error->code = error_json["code"];
+    modio::getJsonValue(error_json, "code", error->code);
 
-    error->message = NULL;
-    if(modio::hasKey(error_json, "message"))
-    {
-      std::string message_str = error_json["message"];
-      error->message = new char[message_str.size() + 1];
-      strcpy(error->message, message_str.c_str());
-    }
+    error->message = modio::getJsonCString(error_json, "message");
 
     error->errors_array = NULL;
     error->errors_array_size = 0;
-    if(modio::hasKey(error_json, "errors"))
+    const nlohmann::json *errors_json = modio::findKey(error_json, "errors");
+    if(errors_json)
     {
-      nlohmann::json errors_json = error_json["errors"];
-      error->errors_array_size = (u32)errors_json.size();
-      error->errors_array = new char*[error->errors_array_size];
+      error->errors_array_size = (u32)errors_json->size();
+      error->errors_array = modio::allocateSchemaArray<char*>(error->errors_array_size);
 
       int i = 0;
-      for(auto it=errors_json.begin(); it!=errors_json.end(); it++)
+      for(auto it=errors_json->begin(); it!=errors_json->end(); it++)
       {
 
         std::string errors_str = it.key();// + ": " + std::string(i.value());
         errors_str += ": ";
-        std::string error_value = it.value();
+        const std::string &error_value = it.value().get_ref<const std::string &>();
         errors_str += error_value;
-        error->errors_array[i]= new char[errors_str.size() + 1];
+        error->errors_array[i]= modio::allocateSchemaArray<char>(errors_str.size() + 1);
         strcpy(error->errors_array[i], errors_str.c_str());
         i++;
       }
@@ -44,15 +37,15 @@ extern "C"
     if(error)
     {
       if(error->message)
-        delete[] error->message;
+        modio::freeSchemaArray(error->message);
 
       if(error->errors_array)
       {
         for(u32 i=0; i<error->errors_array_size; i++)
         {
-          delete[] error->errors_array[i];
+          modio::freeSchemaArray(error->errors_array[i]);
         }
-        delete[] error->errors_array;
+        modio::freeSchemaArray(error->errors_array);
       }
     }
   }
@@ -1,24 +1,25 @@
 #include "c/schemas/ModioFilehash.h"
 
+namespace modio
+{
+const SchemaTable &getFilehashSchema()
+{
+  static const SchemaTable schema(sizeof(ModioFilehash), alignof(ModioFilehash), {
+      MODIO_SCHEMA_STRING(ModioFilehash, md5)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitFilehash(ModioFilehash* filehash, nlohmann::json filehash_json)
+  void modioInitFilehash(ModioFilehash* filehash, const nlohmann::json &filehash_json)
   {
-    filehash->md5 = NULL;
-    if(modio::hasKey(filehash_json, "md5"))
-    {
-      std::string md5_str = filehash_json["md5"];
-      filehash->md5 = new char[md5_str.size() + 1];
-      strcpy(filehash->md5, md5_str.c_str());
-    }
+    modio::decodeSchema(modio::getFilehashSchema(), filehash, filehash_json);
   }
 
   void modioFreeFilehash(ModioFilehash* filehash)
   {
     if(filehash)
-    {
-      if(filehash->md5)
-        delete[] filehash->md5;
-    }
+      modio::freeSchema(modio::getFilehashSchema(), filehash);
   }
 }
@@ -1,61 +1,28 @@
 #include "c/schemas/ModioGameTagOption.h"
 
+namespace modio
+{
+const SchemaTable &getGameTagOptionSchema()
+{
+  static const SchemaTable schema(sizeof(ModioGameTagOption), alignof(ModioGameTagOption), {
+      MODIO_SCHEMA_U32(ModioGameTagOption, hidden),
+      MODIO_SCHEMA_STRING(ModioGameTagOption, name),
+      MODIO_SCHEMA_STRING(ModioGameTagOption, type),
+      MODIO_SCHEMA_STRING_ARRAY(ModioGameTagOption, "tags", tags_array, tags_array_size)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitGameTagOption(ModioGameTagOption* game_tag_option, nlohmann::json game_tag_option_json)
+  void modioInitGameTagOption(ModioGameTagOption* game_tag_option, const nlohmann::json &game_tag_option_json)
   {
-    game_tag_option->hidden = 0;
-    if(modio::hasKey(game_tag_option_json, "hidden"))
-      game_tag_option->hidden = game_tag_option_json["hidden"];
-
-    game_tag_option->name = NULL;
-    if(modio::hasKey(game_tag_option_json, "name"))
-    {
-      std::string name_str = game_tag_option_json["name"];
-      game_tag_option->name = new char[name_str.size() + 1];
-      strcpy(game_tag_option->name, name_str.c_str());
-    }
-
-    game_tag_option->type = NULL;
-    if(modio::hasKey(game_tag_option_json, "type"))
-    {
-      std::string type_str = game_tag_option_json["type"];
-      game_tag_option->type = new char[type_str.size() + 1];
-      strcpy(game_tag_option->type, type_str.c_str());
-    }
-
-    game_tag_option->tags_array = NULL;
-    game_tag_option->tags_array_size = 0;
-    if(modio::hasKey(game_tag_option_json, "tags"))
-    {
-      game_tag_option->tags_array_size = (u32)game_tag_option_json["tags"].size();
-      game_tag_option->tags_array = new char*[game_tag_option->tags_array_size];
-      for(size_t i=0; i<game_tag_option->tags_array_size; i++)
-      {
-        std::string tag_str = game_tag_option_json["tags"][i];
-        game_tag_option->tags_array[i]= new char[tag_str.size() + 1];
-        strcpy(game_tag_option->tags_array[i], tag_str.c_str());
-      }
-    }
+    modio::decodeSchema(modio::getGameTagOptionSchema(), game_tag_option, game_tag_option_json);
   }
 
   void modioFreeGameTagOption(ModioGameTagOption* game_tag_option)
   {
     if(game_tag_option)
-    {
-      if(game_tag_option->name)
-        delete[] game_tag_option->name;
-
-      if(game_tag_option->type)
-        delete[] game_tag_option->type;
-
-      for(size_t i=0; i<game_tag_option->tags_array_size; i++)
-      {
-        delete[] game_tag_option->tags_array[i];
-      }
-
-      if(game_tag_option->tags_array)
-        delete[] game_tag_option->tags_array;
-    }
+      modio::freeSchema(modio::getGameTagOptionSchema(), game_tag_option);
   }
 }
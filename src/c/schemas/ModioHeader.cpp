@@ -1,34 +1,26 @@
 #include "c/schemas/ModioHeader.h"
 
+namespace modio
+{
+const SchemaTable &getHeaderSchema()
+{
+  static const SchemaTable schema(sizeof(ModioHeader), alignof(ModioHeader), {
+      MODIO_SCHEMA_STRING(ModioHeader, filename),
+      MODIO_SCHEMA_STRING(ModioHeader, original)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitHeader(ModioHeader* header, nlohmann::json header_json)
+  void modioInitHeader(ModioHeader* header, const nlohmann::json &header_json)
   {
-    header->filename = NULL;
-    if(modio::hasKey(header_json, "filename"))
-    {
-      std::string filename_str = header_json["filename"];
-      header->filename = new char[filename_str.size() + 1];
-      strcpy(header->filename, filename_str.c_str());
-    }
-
-    header->original = NULL;
-    if(modio::hasKey(header_json, "original"))
-    {
-      std::string original_str = header_json["original"];
-      header->original = new char[original_str.size() + 1];
-      strcpy(header->original, original_str.c_str());
-    }
+    modio::decodeSchema(modio::getHeaderSchema(), header, header_json);
   }
 
   void modioFreeHeader(ModioHeader* header)
   {
     if(header)
-    {
-      if(header->filename)
-        delete[] header->filename;
-      if(header->original)
-        delete[] header->original;
-    }
+      modio::freeSchema(modio::getHeaderSchema(), header);
   }
 }
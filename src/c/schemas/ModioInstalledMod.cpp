@@ -2,29 +2,20 @@
 
 extern "C"
 {
-	void modioInitInstalledMod(ModioInstalledMod* installed_mod, nlohmann::json installed_mod_json)
+	void modioInitInstalledMod(ModioInstalledMod* installed_mod, const nlohmann::json &installed_mod_json)
 	{
 		installed_mod->mod_id = 0;
-		if (modio::hasKey(installed_mod_json, "mod_id"))
-			installed_mod->mod_id = installed_mod_json["mod_id"];
+		modio::getJsonValue(installed_mod_json, "mod_id", installed_mod->mod_id);
 
 		installed_mod->modfile_id = 0;
-		if (modio::hasKey(installed_mod_json, "modfile_id"))
-			installed_mod->modfile_id = installed_mod_json["modfile_id"];
+		modio::getJsonValue(installed_mod_json, "modfile_id", installed_mod->modfile_id);
 
 		installed_mod->date_updated = 0;
-		if (modio::hasKey(installed_mod_json, "date_updated"))
-			installed_mod->date_updated = installed_mod_json["date_updated"];
+		modio::getJsonValue(installed_mod_json, "date_updated", installed_mod->date_updated);
 
-		installed_mod->path = NULL;
-		if (modio::hasKey(installed_mod_json, "path"))
-		{
-			std::string path_str = installed_mod_json["path"];
-			installed_mod->path = new char[path_str.size() + 1];
-			strcpy(installed_mod->path, path_str.c_str());
-		}
+		installed_mod->path = modio::getJsonCString(installed_mod_json, "path");
 
-		nlohmann::json mod_cache_json = modio::openJson(modio::addSlashIfNeeded(installed_mod->path) + "modio.json");
+		nlohmann::json mod_cache_json = modio::getInstalledModJson(installed_mod->mod_id, installed_mod->path ? installed_mod->path : "");
 		modioInitMod(&(installed_mod->mod), mod_cache_json);
 	}
 
@@ -33,7 +24,7 @@ extern "C"
 		if (installed_mod)
 		{
 			if (installed_mod->path)
-				delete[] installed_mod->path;
+				modio::freeSchemaArray(installed_mod->path);
 
 			modioFreeMod(&installed_mod->mod);
 		}
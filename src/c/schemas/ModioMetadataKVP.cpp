@@ -1,35 +1,26 @@
 #include "c/schemas/ModioMetadataKVP.h"
 
+namespace modio
+{
+const SchemaTable &getMetadataKVPSchema()
+{
+  static const SchemaTable schema(sizeof(ModioMetadataKVP), alignof(ModioMetadataKVP), {
+      MODIO_SCHEMA_STRING(ModioMetadataKVP, metakey),
+      MODIO_SCHEMA_STRING(ModioMetadataKVP, metavalue)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitMetadataKVP(ModioMetadataKVP* metadata_kvp, nlohmann::json metadata_kvp_json)
+  void modioInitMetadataKVP(ModioMetadataKVP* metadata_kvp, const nlohmann::json &metadata_kvp_json)
   {
-    metadata_kvp->metakey = NULL;
-    if(modio::hasKey(metadata_kvp_json, "metakey"))
-    {
-      std::string metakey_str = metadata_kvp_json["metakey"];
-      metadata_kvp->metakey = new char[metakey_str.size() + 1];
-      strcpy(metadata_kvp->metakey, metakey_str.c_str());
-    }
-
-    metadata_kvp->metavalue = NULL;
-    if(modio::hasKey(metadata_kvp_json, "metavalue"))
-    {
-      std::string metavalue_str = metadata_kvp_json["metavalue"];
-      metadata_kvp->metavalue = new char[metavalue_str.size() + 1];
-      strcpy(metadata_kvp->metavalue, metavalue_str.c_str());
-    }
+    modio::decodeSchema(modio::getMetadataKVPSchema(), metadata_kvp, metadata_kvp_json);
   }
 
   void modioFreeMetadataKVP(ModioMetadataKVP* metadata_kvp)
   {
     if(metadata_kvp)
-    {
-      if(metadata_kvp->metakey)
-        delete[] metadata_kvp->metakey;
-
-      if(metadata_kvp->metavalue)
-        delete[] metadata_kvp->metavalue;
-    }
+      modio::freeSchema(modio::getMetadataKVPSchema(), metadata_kvp);
   }
 }
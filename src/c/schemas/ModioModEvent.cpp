@@ -1,51 +1,44 @@
 #include "c/schemas/ModioModEvent.h"
 
-extern "C"
+namespace modio
 {
-  void modioInitModEvent(ModioModEvent* event, nlohmann::json event_json)
-  {
-    event->id = 0;
-    if(modio::hasKey(event_json, "id"))
-      event->id = event_json["id"];
-
-    event->mod_id = 0;
-    if(modio::hasKey(event_json, "mod_id"))
-      event->mod_id = event_json["mod_id"];
-
-    event->user_id = 0;
-    if(modio::hasKey(event_json, "user_id"))
-      event->user_id = event_json["user_id"];
+const SchemaEnumValue *getEventTypeValues()
+{
+  static const SchemaEnumValue event_type_values[] = {
+    {"MODFILE_CHANGED", MODIO_EVENT_MODFILE_CHANGED},
+    {"MOD_AVAILABLE", MODIO_EVENT_MOD_AVAILABLE},
+    {"MOD_UNAVAILABLE", MODIO_EVENT_MOD_UNAVAILABLE},
+    {"MOD_EDITED", MODIO_EVENT_MOD_EDITED},
+    {"USER_TEAM_JOIN", MODIO_EVENT_USER_TEAM_JOIN},
+    {"USER_TEAM_LEAVE", MODIO_EVENT_USER_TEAM_LEAVE},
+    {"USER_SUBSCRIBE", MODIO_EVENT_USER_SUBSCRIBE},
+    {"USER_UNSUBSCRIBE", MODIO_EVENT_USER_UNSUBSCRIBE},
+    {NULL, MODIO_EVENT_UNDEFINED}};
+  return event_type_values;
+}
 
-    event->event_type = 0;
-    if(modio::hasKey(event_json, "event_type"))
-    {
-      if(event_json["event_type"] == "MODFILE_CHANGED")
-        event->event_type = MODIO_EVENT_MODFILE_CHANGED;
-      else if(event_json["event_type"] == "MOD_AVAILABLE")
-        event->event_type = MODIO_EVENT_MOD_AVAILABLE;
-      else if(event_json["event_type"] == "MOD_UNAVAILABLE")
-        event->event_type = MODIO_EVENT_MOD_UNAVAILABLE;
-      else if(event_json["event_type"] == "MOD_EDITED")
-        event->event_type = MODIO_EVENT_MOD_EDITED;
-      else if(event_json["event_type"] == "USER_TEAM_JOIN")
-        event->event_type = MODIO_EVENT_USER_TEAM_JOIN;
-      else if(event_json["event_type"] == "USER_TEAM_LEAVE")
-        event->event_type = MODIO_EVENT_USER_TEAM_LEAVE;
-      else if(event_json["event_type"] == "USER_SUBSCRIBE")
-        event->event_type = MODIO_EVENT_USER_SUBSCRIBE;
-      else if(event_json["event_type"] == "USER_UNSUBSCRIBE")
-        event->event_type = MODIO_EVENT_USER_UNSUBSCRIBE;
-      else
-        event->event_type = MODIO_EVENT_UNDEFINED;
-    }
+const SchemaTable &getModEventSchema()
+{
+  static const SchemaTable schema(sizeof(ModioModEvent), alignof(ModioModEvent), {
+      MODIO_SCHEMA_U32(ModioModEvent, id),
+      MODIO_SCHEMA_U32(ModioModEvent, mod_id),
+      MODIO_SCHEMA_U32(ModioModEvent, user_id),
+      MODIO_SCHEMA_ENUM(ModioModEvent, event_type, getEventTypeValues()),
+      MODIO_SCHEMA_U32(ModioModEvent, date_added)});
+  return schema;
+}
+} // namespace modio
 
-    event->date_added = 0;
-    if(modio::hasKey(event_json, "date_added"))
-      event->date_added = event_json["date_added"];
+extern "C"
+{
+  void modioInitModEvent(ModioModEvent* event, const nlohmann::json &event_json)
+  {
+    modio::decodeSchema(modio::getModEventSchema(), event, event_json);
   }
 
-  void modioFreeModEvent(ModioModEvent* tag)
+  void modioFreeModEvent(ModioModEvent* event)
   {
-    //No pointers
+    if(event)
+      modio::freeSchema(modio::getModEventSchema(), event);
   }
 }
@@ -1,56 +1,31 @@
 #include "c/schemas/ModioQueuedModDownload.h"
 
+namespace modio
+{
+const SchemaTable &getQueuedModDownloadSchema()
+{
+  static const SchemaTable schema(sizeof(ModioQueuedModDownload), alignof(ModioQueuedModDownload), {
+      MODIO_SCHEMA_U32(ModioQueuedModDownload, mod_id),
+      MODIO_SCHEMA_U32(ModioQueuedModDownload, state),
+      MODIO_SCHEMA_DOUBLE(ModioQueuedModDownload, current_progress),
+      MODIO_SCHEMA_DOUBLE(ModioQueuedModDownload, total_size),
+      MODIO_SCHEMA_STRING(ModioQueuedModDownload, url),
+      MODIO_SCHEMA_STRING(ModioQueuedModDownload, path),
+      MODIO_SCHEMA_OBJECT(ModioQueuedModDownload, mod, getModSchema())});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitQueuedModDownload(ModioQueuedModDownload* queued_mod_download, nlohmann::json queued_mod_download_json)
+  void modioInitQueuedModDownload(ModioQueuedModDownload* queued_mod_download, const nlohmann::json &queued_mod_download_json)
   {
-    queued_mod_download->mod_id = 0;
-    if(modio::hasKey(queued_mod_download_json, "mod_id"))
-      queued_mod_download->mod_id = queued_mod_download_json["mod_id"];
-
-    queued_mod_download->state = 0;
-    if(modio::hasKey(queued_mod_download_json, "state"))
-      queued_mod_download->state = queued_mod_download_json["state"];
-
-    queued_mod_download->current_progress = 0;
-    if(modio::hasKey(queued_mod_download_json, "current_progress"))
-      queued_mod_download->current_progress = queued_mod_download_json["current_progress"];
-
-    queued_mod_download->total_size = 0;
-    if(modio::hasKey(queued_mod_download_json, "total_size"))
-      queued_mod_download->total_size = queued_mod_download_json["total_size"];
-
-    queued_mod_download->url = NULL;
-    if(modio::hasKey(queued_mod_download_json, "url"))
-    {
-      std::string url_str = queued_mod_download_json["url"];
-      queued_mod_download->url = new char[url_str.size() + 1];
-      strcpy(queued_mod_download->url, url_str.c_str());
-    }
-
-    queued_mod_download->path = NULL;
-    if(modio::hasKey(queued_mod_download_json, "path"))
-    {
-      std::string path_str = queued_mod_download_json["path"];
-      queued_mod_download->path = new char[path_str.size() + 1];
-      strcpy(queued_mod_download->path, path_str.c_str());
-    }
-
-    nlohmann::json mod_json;
-    if(modio::hasKey(queued_mod_download_json, "mod"))
-      mod_json = queued_mod_download_json["mod"];
-    modioInitMod(&(queued_mod_download->mod), mod_json);
+    modio::decodeSchema(modio::getQueuedModDownloadSchema(), queued_mod_download, queued_mod_download_json);
   }
 
   void modioFreeQueuedModDownload(ModioQueuedModDownload* queued_mod_download)
   {
     if(queued_mod_download)
-    {
-      if(queued_mod_download->url)
-        delete[] queued_mod_download->url;
-      if(queued_mod_download->path)
-        delete[] queued_mod_download->path;
-      modioFreeMod(&(queued_mod_download->mod));      
-    }
+      modio::freeSchema(modio::getQueuedModDownloadSchema(), queued_mod_download);
   }
 }
@@ -1,27 +1,28 @@
 #include "c/schemas/ModioRating.h"
 
+namespace modio
+{
+const SchemaTable &getRatingSchema()
+{
+  static const SchemaTable schema(sizeof(ModioRating), alignof(ModioRating), {
+      MODIO_SCHEMA_U32(ModioRating, game_id),
+      MODIO_SCHEMA_U32(ModioRating, mod_id),
+      MODIO_SCHEMA_I32(ModioRating, rating),
+      MODIO_SCHEMA_U32(ModioRating, date_added)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitRating(ModioRating* rating, nlohmann::json rating_json)
+  void modioInitRating(ModioRating* rating, const nlohmann::json &rating_json)
   {
-    rating->game_id = 0;
-    if(modio::hasKey(rating_json, "game_id"))
-      rating->game_id = rating_json["game_id"];
-    
-    rating->mod_id = 0;
-    if(modio::hasKey(rating_json, "mod_id"))
-      rating->mod_id = rating_json["mod_id"];
-    
-    rating->rating = 0;
-    if(modio::hasKey(rating_json, "rating"))
-      rating->rating = rating_json["rating"];
-    
-    rating->date_added = 0;
-    if(modio::hasKey(rating_json, "date_added"))
-      rating->date_added = rating_json["date_added"];
+    modio::decodeSchema(modio::getRatingSchema(), rating, rating_json);
   }
 
   void modioFreeRating(ModioRating* rating)
   {
+    if(rating)
+      modio::freeSchema(modio::getRatingSchema(), rating);
   }
 }
@@ -1,33 +1,60 @@
 #include "c/schemas/ModioResponse.h"
 
+static const ModioTransferInfo *g_response_transfer = NULL;
+
+namespace modio
+{
+void setResponseTransfer(const ModioTransferInfo *transfer)
+{
+  g_response_transfer = transfer;
+}
+
+const ModioTransferInfo *getResponseTransfer()
+{
+  return g_response_transfer;
+}
+}
+
+static void initTransferInfo(ModioTransferInfo *transfer)
+{
+  if (g_response_transfer)
+  {
+    *transfer = *g_response_transfer;
+    transfer->effective_url = NULL;
+    if (g_response_transfer->effective_url)
+    {
+      transfer->effective_url = modio::allocateSchemaArray<char>(strlen(g_response_transfer->effective_url) + 1);
+      strcpy(transfer->effective_url, g_response_transfer->effective_url);
+    }
+    g_response_transfer = NULL;
+    return;
+  }
+
+  memset(transfer, 0, sizeof(ModioTransferInfo));
+}
+
 extern "C"
 {
-  void modioInitResponse(ModioResponse* response, nlohmann::json response_json)
+  void modioInitResponse(ModioResponse* response, const nlohmann::json &response_json)
   {
     response->code = 0;
     response->result_cached = false;
+    response->result_stale = false;
 
     response->result_count = 0;
-    if(modio::hasKey(response_json,"result_count"))
-      response->result_count = response_json["result_count"];
+    modio::getJsonValue(response_json, "result_count", response->result_count);
 
     response->result_limit = 0;
-    if(modio::hasKey(response_json,"result_limit"))
-      response->result_limit = response_json["result_limit"];
+    modio::getJsonValue(response_json, "result_limit", response->result_limit);
 
     response->result_offset = -1;
-    if(modio::hasKey(response_json,"result_offset"))
-      response->result_offset = response_json["result_offset"];
+    modio::getJsonValue(response_json, "result_offset", response->result_offset);
 
     response->result_total = 0;
-    if(modio::hasKey(response_json,"result_total"))
-      response->result_total = response_json["result_total"];
-
-    nlohmann::json error_json;
-    if(modio::hasKey(response_json, "error"))
-      error_json = response_json["error"];
+    modio::getJsonValue(response_json, "result_total", response->result_total);
 
-    modioInitError(&(response->error), error_json);
+    modioInitError(&(response->error), modio::getJsonChild(response_json, "error"));
+    initTransferInfo(&(response->transfer));
   }
 
   void modioFreeResponse(ModioResponse* response)
@@ -35,6 +62,8 @@ extern "C"
     if(response)
     {
       modioFreeError(&(response->error));
+      if (response->transfer.effective_url)
+        modio::freeSchemaArray(response->transfer.effective_url);
     }
   }
 }
@@ -1,28 +1,26 @@
 #include "c/schemas/ModioTag.h"
 
+namespace modio
+{
+const SchemaTable &getTagSchema()
+{
+  static const SchemaTable schema(sizeof(ModioTag), alignof(ModioTag), {
+      MODIO_SCHEMA_U32(ModioTag, date_added),
+      MODIO_SCHEMA_STRING(ModioTag, name)});
+  return schema;
+}
+} // namespace modio
+
 extern "C"
 {
-  void modioInitTag(ModioTag* tag, nlohmann::json tag_json)
+  void modioInitTag(ModioTag* tag, const nlohmann::json &tag_json)
   {
-    tag->date_added = 0;
-    if(modio::hasKey(tag_json, "date_added"))
-      tag->date_added = tag_json["date_added"];
-
-    tag->name = NULL;
-    if(modio::hasKey(tag_json, "name"))
-    {
-      std::string name_str = tag_json["name"];
-      tag->name = new char[name_str.size() + 1];
-      strcpy(tag->name, name_str.c_str());
-    }
+    modio::decodeSchema(modio::getTagSchema(), tag, tag_json);
   }
 
   void modioFreeTag(ModioTag* tag)
   {
     if(tag)
-    {
-      if(tag->name)
-        delete[] tag->name;
-    }
+      modio::freeSchema(modio::getTagSchema(), tag);
   }
 }
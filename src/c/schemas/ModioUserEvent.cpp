@@ -1,55 +1,31 @@
 #include "c/schemas/ModioUserEvent.h"
+#include "c/schemas/ModioModEvent.h"
+
+namespace modio
+{
+const SchemaTable &getUserEventSchema()
+{
+  static const SchemaTable schema(sizeof(ModioUserEvent), alignof(ModioUserEvent), {
+      MODIO_SCHEMA_U32(ModioUserEvent, id),
+      MODIO_SCHEMA_U32(ModioUserEvent, game_id),
+      MODIO_SCHEMA_U32(ModioUserEvent, mod_id),
+      MODIO_SCHEMA_U32(ModioUserEvent, user_id),
+      MODIO_SCHEMA_ENUM(ModioUserEvent, event_type, getEventTypeValues()),
+      MODIO_SCHEMA_U32(ModioUserEvent, date_added)});
+  return schema;
+}
+} // namespace modio
 
 extern "C"
 {
-  void modioInitUserEvent(ModioUserEvent* event, nlohmann::json event_json)
+  void modioInitUserEvent(ModioUserEvent* event, const nlohmann::json &event_json)
   {
-    event->id = 0;
-    if(modio::hasKey(event_json, "id"))
-      event->id = event_json["id"];
-
-    event->game_id = 0;
-    if(modio::hasKey(event_json, "game_id"))
-      event->game_id = event_json["game_id"];
-
-    event->mod_id = 0;
-    if(modio::hasKey(event_json, "mod_id"))
-      event->mod_id = event_json["mod_id"];
-
-    event->user_id = 0;
-    if(modio::hasKey(event_json, "user_id"))
-      event->user_id = event_json["user_id"];
-
-    event->event_type = 0;
-    if(modio::hasKey(event_json, "event_type"))
-    {
-      if(event_json["event_type"] == "MODFILE_CHANGED")
-        event->event_type = MODIO_EVENT_MODFILE_CHANGED;
-      else if(event_json["event_type"] == "MOD_AVAILABLE")
-        event->event_type = MODIO_EVENT_MOD_AVAILABLE;
-      else if(event_json["event_type"] == "MOD_UNAVAILABLE")
-        event->event_type = MODIO_EVENT_MOD_UNAVAILABLE;
-      else if(event_json["event_type"] == "MOD_EDITED")
-        event->event_type = MODIO_EVENT_MOD_EDITED;
-      else if(event_json["event_type"] == "USER_TEAM_JOIN")
-        event->event_type = MODIO_EVENT_USER_TEAM_JOIN;
-      else if(event_json["event_type"] == "USER_TEAM_LEAVE")
-        event->event_type = MODIO_EVENT_USER_TEAM_LEAVE;
-      else if(event_json["event_type"] == "USER_SUBSCRIBE")
-        event->event_type = MODIO_EVENT_USER_SUBSCRIBE;
-      else if(event_json["event_type"] == "USER_UNSUBSCRIBE")
-        event->event_type = MODIO_EVENT_USER_UNSUBSCRIBE;
-      else
-        event->event_type = MODIO_EVENT_UNDEFINED;
-    }
-
-    event->date_added = 0;
-    if(modio::hasKey(event_json, "date_added"))
-      event->date_added = event_json["date_added"];
+    modio::decodeSchema(modio::getUserEventSchema(), event, event_json);
   }
 
-  void modioFreeUserEvent(ModioUserEvent* tag)
+  void modioFreeUserEvent(ModioUserEvent* event)
   {
-    //No pointers
+    if(event)
+      modio::freeSchema(modio::getUserEventSchema(), event);
   }
 }
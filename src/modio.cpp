@@ -11,7 +11,7 @@ static void loadEventPollingFile()
   if (modio::hasKey(event_polling_json, "last_mod_event_poll"))
   {
     modio::LAST_MOD_EVENT_POLL = event_polling_json["last_mod_event_poll"];
-    modio::writeLogLine("Mod events data loaded. The last mod event poll was at " + modio::toString(modio::LAST_MOD_EVENT_POLL), MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG("Mod events data loaded. The last mod event poll was at " + modio::toString(modio::LAST_MOD_EVENT_POLL), MODIO_DEBUGLEVEL_LOG);
   }
   else
   {
@@ -38,7 +38,7 @@ static void loadAuthenticationFile()
     if (modio::hasKey(token_file_json, "last_user_event_poll"))
     {
       modio::LAST_USER_EVENT_POLL = token_file_json["last_user_event_poll"];
-      modio::writeLogLine("User events data loaded. The last user event poll was at " + modio::toString(modio::LAST_USER_EVENT_POLL), MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("User events data loaded. The last user event poll was at " + modio::toString(modio::LAST_USER_EVENT_POLL), MODIO_DEBUGLEVEL_LOG);
     }
     else
     {
@@ -58,21 +58,22 @@ void modioInit(u32 environment, u32 game_id, char const *api_key, char const *ro
   
   modio::createDirectory(modio::getModIODirectory());
   modio::createDirectory(modio::getModIODirectory() + "mods/");
-  modio::createDirectory(modio::getModIODirectory() + "cache/");
   modio::createDirectory(modio::getModIODirectory() + "tmp/");
 
   modio::clearLog();
+  modio::startLogger(modio::getModIODirectory() + "log");
 
   modio::writeLogLine("Initializing SDK", MODIO_DEBUGLEVEL_LOG);
   if (root_path)
   {
-    modio::writeLogLine(".modio/ directory created at " + std::string(root_path), MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG(".modio/ directory created at " + std::string(root_path), MODIO_DEBUGLEVEL_LOG);
   }else
   {
     modio::writeLogLine(".modio/ directory created at current workspace.", MODIO_DEBUGLEVEL_LOG);
   }
   
   modio::writeLogLine("v0.11.3 DEV", MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("Json parse backend: ") + modio::getJsonBackendName(modio::getJsonBackend()), MODIO_DEBUGLEVEL_LOG);
 
   if (environment == MODIO_ENVIRONMENT_TEST)
     modio::MODIO_URL = "https://api.test.mod.io/";
@@ -107,11 +108,34 @@ void modioSetDebugLevel(u32 debug_level)
   modio::DEBUG_LEVEL = debug_level;
 }
 
+void modioStartTracing(u32 max_events)
+{
+  modio::startTracing(max_events);
+}
+
+void modioStopTracing(void)
+{
+  modio::stopTracing();
+}
+
+bool modioWriteTrace(char const *path)
+{
+  return modio::writeTrace(path);
+}
+
+void modioSetLogListener(void (*callback)(u32 debug_level, char const *message))
+{
+  modio::setLogListener(callback);
+}
+
 void modioShutdown()
 {
   modio::writeLogLine("mod.io C interface is shutting down", MODIO_DEBUGLEVEL_LOG);
 
   modio::curlwrapper::shutdownCurl();
+  modio::clearPrefetch();
+  modio::closeInstalledMods();
+  modio::closeCacheStore();
 
   clearAuthenticationCallbackParams();
   clearCommentsCallbackParams();
@@ -132,13 +156,35 @@ void modioShutdown()
   modioFreeUser(&modio::current_user);
 
   modio::writeLogLine("mod.io C interface finished shutting down", MODIO_DEBUGLEVEL_LOG);
+  modio::stopLogger();
 }
 
 void modioProcess()
 {
+  double process_start_micros = modio::getSteadyTimeMicros();
+  modio::processLazyFields();
   if (modio::AUTOMATIC_UPDATES == MODIO_UPDATES_ENABLED)
     modio::pollEvents();
   modio::curlwrapper::process();
+  modio::writeInstalledMods();
+  modio::processCacheStore();
+  modio::processPrefetch();
+  modio::recordProcess(modio::getSteadyTimeMicros() - process_start_micros);
+}
+
+ModioCacheStats modioGetCacheStats()
+{
+  return modio::getCacheStats();
+}
+
+ModioMetrics modioGetMetrics()
+{
+  return modio::getMetrics();
+}
+
+void modioFreeMetrics(ModioMetrics *metrics)
+{
+  modio::freeMetrics(metrics);
 }
 
 void modioSleep(u32 milliseconds)
@@ -5,18 +5,109 @@ namespace modio
 namespace curlwrapper
 {
 
+// Phase durations of a finished transfer from the curl timers, which are cumulative from
+// when the multi handle picked the transfer up. effective_url points into the handle.
+static ModioTransferInfo getTransferInfo(CURL *curl)
+{
+  curl_off_t name_lookup = 0, connect = 0, app_connect = 0, pre_transfer = 0, start_transfer = 0, total = 0;
+  curl_off_t download_speed = 0, upload_speed = 0;
+  long http_version = 0, new_connections = 0;
+  curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &name_lookup);
+  curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+  curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &app_connect);
+  curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &pre_transfer);
+  curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &start_transfer);
+  curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+  curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD_T, &download_speed);
+  curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD_T, &upload_speed);
+  curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &http_version);
+  curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+
+  ModioTransferInfo transfer;
+  transfer.effective_url = NULL;
+  curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &transfer.effective_url);
+
+  switch (http_version)
+  {
+  case CURL_HTTP_VERSION_1_0:
+    transfer.http_version = 10;
+    break;
+  case CURL_HTTP_VERSION_1_1:
+    transfer.http_version = 11;
+    break;
+  case CURL_HTTP_VERSION_2_0:
+    transfer.http_version = 20;
+    break;
+  case 30: // CURL_HTTP_VERSION_3, missing from older curl headers
+    transfer.http_version = 30;
+    break;
+  default:
+    transfer.http_version = 0;
+  }
+
+  transfer.connection_reused = new_connections == 0;
+  transfer.dns_millis = name_lookup / 1000.0;
+  transfer.connect_millis = std::max<curl_off_t>(connect - name_lookup, 0) / 1000.0;
+  transfer.tls_millis = app_connect > 0 ? std::max<curl_off_t>(app_connect - connect, 0) / 1000.0 : 0;
+  transfer.ttfb_millis = std::max<curl_off_t>(start_transfer - pre_transfer, 0) / 1000.0;
+  transfer.transfer_millis = std::max<curl_off_t>(total - start_transfer, 0) / 1000.0;
+  transfer.total_millis = total / 1000.0;
+  transfer.download_bytes_per_second = (double)download_speed;
+  transfer.upload_bytes_per_second = (double)upload_speed;
+  return transfer;
+}
+
+// Adds the phases of a finished transfer under the span of id, the time before curl
+// picked it up shows as queued
+static void traceTransfer(const ModioTransferInfo &transfer, const char *category, u64 id, double queued_micros, double finished_micros)
+{
+  double start_micros = std::max(queued_micros, finished_micros - transfer.total_millis * 1000.0);
+  double dns_end_micros = start_micros + transfer.dns_millis * 1000.0;
+  double connect_end_micros = dns_end_micros + transfer.connect_millis * 1000.0;
+  double transfer_start_micros = start_micros + (transfer.total_millis - transfer.transfer_millis) * 1000.0;
+  modio::addAsyncTraceSpan("queued", category, id, queued_micros, start_micros);
+  modio::addAsyncTraceSpan("dns", category, id, start_micros, dns_end_micros);
+  modio::addAsyncTraceSpan("connect", category, id, dns_end_micros, connect_end_micros);
+  if (transfer.tls_millis > 0)
+    modio::addAsyncTraceSpan("tls", category, id, connect_end_micros, connect_end_micros + transfer.tls_millis * 1000.0);
+  modio::addAsyncTraceSpan("ttfb", category, id, transfer_start_micros - transfer.ttfb_millis * 1000.0, transfer_start_micros);
+  modio::addAsyncTraceSpan("transfer", category, id, transfer_start_micros, start_micros + transfer.total_millis * 1000.0);
+}
+
+static void recordTransfer(CURL *curl, const ModioTransferInfo &transfer, const std::string &endpoint, u32 response_code)
+{
+  curl_off_t bytes_up = 0, bytes_down = 0;
+  curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &bytes_up);
+  curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes_down);
+  modio::recordTransfer(endpoint, response_code, (u64)bytes_up, (u64)bytes_down);
+  modio::recordHostTransfer(transfer, (u64)bytes_down);
+}
+
+static modio::TraceArgs getTraceArgs(const ModioTransferInfo &transfer, u32 response_code)
+{
+  modio::TraceArgs args;
+  args.url = transfer.effective_url ? transfer.effective_url : "";
+  args.has_response_code = true;
+  args.response_code = response_code;
+  return args;
+}
+
 void onJsonRequestFinished(CURL *curl)
 {
   JsonResponseHandler *ongoing_call = g_ongoing_calls[curl];
   u32 response_code;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+
+  double finished_micros = modio::getSteadyTimeMicros();
   nlohmann::json response_json = modio::toJson(ongoing_call->response);
+  double parsed_micros = modio::getSteadyTimeMicros();
+  ModioTransferInfo transfer = getTransferInfo(curl);
 
   if (ongoing_call->headers.find("X-Ratelimit-RetryAfter") != ongoing_call->headers.end())
   {
     u32 x_ratelimit_retryafter = stoul(ongoing_call->headers["X-Ratelimit-RetryAfter"]);
     modio::RETRY_AFTER = modio::getCurrentTime() + x_ratelimit_retryafter;
-    modio::writeLogLine("API request limit hit. Could not poll events. Rerying after " + modio::toString(modio::RETRY_AFTER), MODIO_DEBUGLEVEL_WARNING);
+    MODIO_LOG("API request limit hit. Could not poll events. Rerying after " + modio::toString(modio::RETRY_AFTER), MODIO_DEBUGLEVEL_WARNING);
   }
 
   if (ongoing_call->headers.find("X-RateLimit-Remaining") != ongoing_call->headers.end())
@@ -24,15 +115,32 @@ void onJsonRequestFinished(CURL *curl)
     std::string x_rate_limit_remaining = ongoing_call->headers["X-RateLimit-Remaining"];
     if (x_rate_limit_remaining[x_rate_limit_remaining.size() - 1] == '\n')
       x_rate_limit_remaining.pop_back();
-    writeLogLine("X-RateLimit-Remaining: " + x_rate_limit_remaining, MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG("X-RateLimit-Remaining: " + x_rate_limit_remaining, MODIO_DEBUGLEVEL_LOG);
   }
 
-  writeLogLine("Json request Finished. Response code: " + toString(response_code), MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Json request Finished. Response code: " + toString(response_code), MODIO_DEBUGLEVEL_LOG);
   if (response_code >= 400 && response_code <= 599)
   {
-    writeLogLine(response_json.dump(), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG(response_json.dump(), MODIO_DEBUGLEVEL_ERROR);
   }
+  modio::setResponseTransfer(&transfer);
   ongoing_call->callback(ongoing_call->call_number, response_code, response_json);
+  modio::setResponseTransfer(NULL);
+  double called_back_micros = modio::getSteadyTimeMicros();
+
+  curl_off_t bytes_up = 0, bytes_down = 0;
+  curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &bytes_up);
+  curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &bytes_down);
+  modio::recordRequest(transfer.effective_url ? transfer.effective_url : "", response_code, finished_micros - ongoing_call->queued_micros, parsed_micros - finished_micros, called_back_micros - parsed_micros, (u64)bytes_up, (u64)bytes_down, ongoing_call->response.size());
+  modio::recordHostTransfer(transfer, (u64)bytes_down);
+
+  if (modio::isTracing())
+  {
+    modio::addAsyncTraceSpan("request", "request", ongoing_call->call_number, ongoing_call->queued_micros, called_back_micros, getTraceArgs(transfer, response_code));
+    traceTransfer(transfer, "request", ongoing_call->call_number, ongoing_call->queued_micros, finished_micros);
+    modio::addAsyncTraceSpan("parse", "request", ongoing_call->call_number, finished_micros, parsed_micros);
+    modio::addAsyncTraceSpan("callback", "request", ongoing_call->call_number, parsed_micros, called_back_micros);
+  }
   g_ongoing_calls.erase(curl);
   delete ongoing_call;
   g_call_count++;
@@ -51,40 +159,92 @@ void onDownloadFinished(CURL *curl)
   }
   else
   {
-    writeLogLine("Response code: " + modio::toString(response_code) + " Could not download form: " + ongoing_download->url, MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG("Response code: " + modio::toString(response_code) + " Could not download form: " + ongoing_download->url, MODIO_DEBUGLEVEL_LOG);
   }
 
+  ModioTransferInfo transfer = getTransferInfo(curl);
+  recordTransfer(curl, transfer, "download", response_code);
+  double finished_micros = modio::isTracing() ? modio::getSteadyTimeMicros() : 0;
+  modio::setResponseTransfer(&transfer);
   ongoing_download->callback(ongoing_download->call_number, response_code);
+  modio::setResponseTransfer(NULL);
+  if (modio::isTracing())
+  {
+    modio::addAsyncTraceSpan("download", "download", ongoing_download->call_number, ongoing_download->queued_micros, modio::getSteadyTimeMicros(), getTraceArgs(transfer, response_code));
+    traceTransfer(transfer, "download", ongoing_download->call_number, ongoing_download->queued_micros, finished_micros);
+  }
   g_call_count++;
   g_ongoing_downloads.erase(curl);
   delete ongoing_download;
 }
 
-void onModDownloadFinished(CURL *curl)
+void onModDownloadFinished(CURL *curl, CURLcode result)
 {
   fclose(g_current_mod_download->file);
   g_current_mod_download->file = NULL;
 
-  if (g_current_mod_download->queued_mod_download->state == MODIO_MOD_DOWNLOADING)
+  u32 state = g_current_mod_download->queued_mod_download->state;
+  bool interrupted = result != CURLE_OK && (state == MODIO_MOD_STARTING_DOWNLOAD || state == MODIO_MOD_DOWNLOADING);
+
+  if (interrupted && g_mod_download_retries < MODIO_MAX_DOWNLOAD_RETRIES)
   {
-    std::string installation_path = modio::getModIODirectory() + "mods/" + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + "/";
-    std::string downloaded_zip_path = g_current_mod_download->queued_mod_download->path;
-    nlohmann::json mod_json = modio::toJson(g_current_mod_download->queued_mod_download->mod);
+    // The partial file stays in place, downloadMod resumes from its size
+    g_mod_download_retries++;
+    QueuedModDownload *queued_mod_download = g_current_mod_download->queued_mod_download;
+    MODIO_LOG("Mod download interrupted: " + std::string(curl_easy_strerror(result)) + " Mod id: " + toString(queued_mod_download->mod_id) + " Retry " + toString(g_mod_download_retries) + " of " + toString(MODIO_MAX_DOWNLOAD_RETRIES), MODIO_DEBUGLEVEL_WARNING);
 
-    addToDownloadedModsJson(installation_path, downloaded_zip_path, mod_json);
-    
-    writeLogLine("Finished downloading mod", MODIO_DEBUGLEVEL_LOG);
+    queued_mod_download->state = MODIO_MOD_QUEUED;
+    delete g_current_mod_download;
+    g_current_mod_download = NULL;
 
+    downloadMod(queued_mod_download);
+    return;
+  }
+
+  if (state == MODIO_MOD_DOWNLOADING || interrupted)
+  {
     u32 response_code;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
 
+    if (interrupted)
+    {
+      MODIO_LOG("Could not download mod: " + std::string(curl_easy_strerror(result)) + " Mod id: " + toString(g_current_mod_download->queued_mod_download->mod_id), MODIO_DEBUGLEVEL_ERROR);
+      // A truncated zip must not be installed nor resumed from
+      modio::removeFile(g_current_mod_download->queued_mod_download->path);
+      response_code = 0;
+    }
+    else
+    {
+      std::string installation_path = modio::getModIODirectory() + "mods/" + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + "/";
+      std::string downloaded_zip_path = g_current_mod_download->queued_mod_download->path;
+      nlohmann::json mod_json = modio::toJson(g_current_mod_download->queued_mod_download->mod);
+
+      addToDownloadedModsJson(installation_path, downloaded_zip_path, mod_json);
+
+      writeLogLine("Finished downloading mod", MODIO_DEBUGLEVEL_LOG);
+    }
+
     if (response_code >= 200 && response_code < 300)
     {
-      writeLogLine("Download finished successfully. Mod id: " + toString(g_current_mod_download->queued_mod_download->mod_id) + " Url: " + g_current_mod_download->queued_mod_download->url, MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Download finished successfully. Mod id: " + toString(g_current_mod_download->queued_mod_download->mod_id) + " Url: " + g_current_mod_download->queued_mod_download->url, MODIO_DEBUGLEVEL_LOG);
     }
     else
     {
-      writeLogLine("Response code: " + modio::toString(response_code) + " Mod id: " + modio::toString(g_current_mod_download->queued_mod_download->mod_id), MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("Response code: " + modio::toString(response_code) + " Mod id: " + modio::toString(g_current_mod_download->queued_mod_download->mod_id), MODIO_DEBUGLEVEL_ERROR);
+    }
+
+    g_mod_download_retries = 0;
+    ModioTransferInfo transfer = getTransferInfo(curl);
+    recordTransfer(curl, transfer, "mod download", response_code);
+
+    if (modio::isTracing())
+    {
+      u32 mod_id = g_current_mod_download->queued_mod_download->mod_id;
+      double finished_micros = modio::getSteadyTimeMicros();
+      modio::TraceArgs trace_args = getTraceArgs(transfer, response_code);
+      trace_args.mod_id = mod_id;
+      modio::addAsyncTraceSpan("mod download", "mod download", mod_id, g_current_mod_download->queued_micros, finished_micros, trace_args);
+      traceTransfer(transfer, "mod download", mod_id, g_current_mod_download->queued_micros, finished_micros);
     }
 
     if (modio::download_callback)
@@ -103,12 +263,12 @@ void onModDownloadFinished(CURL *curl)
   }
   else if (g_current_mod_download->queued_mod_download->state == MODIO_MOD_PAUSING)
   {
-    modio::writeLogLine("Mod " + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + " download paused", MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG("Mod " + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + " download paused", MODIO_DEBUGLEVEL_LOG);
     g_current_mod_download->queued_mod_download->state = MODIO_MOD_PAUSED;
   }
   else if (g_current_mod_download->queued_mod_download->state == MODIO_PRIORITIZING_OTHER_DOWNLOAD)
   {
-    modio::writeLogLine("Mod " + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + " download paused. Another mod is being prioritized.", MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG("Mod " + modio::toString(g_current_mod_download->queued_mod_download->mod_id) + " download paused. Another mod is being prioritized.", MODIO_DEBUGLEVEL_LOG);
     g_current_mod_download->queued_mod_download->state = MODIO_MOD_QUEUED;
     updateModDownloadQueue();
     downloadNextQueuedMod();
@@ -118,12 +278,13 @@ void onModDownloadFinished(CURL *curl)
 
 void onModfileUploadFinished(CURL *curl)
 {
-  writeLogLine("Upload Finished. Mod id: " + toString(g_current_modfile_upload->queued_modfile_upload->mod_id) /*+ " Url: " + current_queued_modfile_upload->url*/, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Upload Finished. Mod id: " + toString(g_current_modfile_upload->queued_modfile_upload->mod_id) /*+ " Url: " + current_queued_modfile_upload->url*/, MODIO_DEBUGLEVEL_LOG);
 
   if (g_current_modfile_upload->queued_modfile_upload->state == MODIO_MOD_UPLOADING)
   {
     u32 response_code;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+    recordTransfer(curl, getTransferInfo(curl), "modfile upload", response_code);
 
     if (modio::upload_callback)
     {
@@ -14,6 +14,7 @@ std::list<QueuedModDownload *> g_mod_download_queue;
 std::list<QueuedModfileUpload *> g_modfile_upload_queue;
 
 CurrentModDownload* g_current_mod_download;
+u32 g_mod_download_retries = 0;
 CurrentModfileUpload* g_current_modfile_upload;
 
 std::list<QueuedModDownload *> getModDownloadQueue()
@@ -30,11 +31,13 @@ std::list<QueuedModfileUpload *> getModfileUploadQueue()
 JsonResponseHandler::JsonResponseHandler(u32 call_number_, struct curl_slist *slist_, char *post_fields_, curl_mime *mime_form_, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback_)
   : call_number(call_number_), response(""), slist(slist_), post_fields(post_fields_), mime_form(mime_form_), callback(callback_)
 {
+  queued_micros = modio::getSteadyTimeMicros();
 }
 #elif defined(MODIO_OSX_DETECTED) || defined(MODIO_LINUX_DETECTED)
 JsonResponseHandler::JsonResponseHandler(u32 call_number_, struct curl_slist *slist_, char *post_fields_, struct curl_httppost *formpost_, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback_)
   : call_number(call_number_), response(""), slist(slist_), post_fields(post_fields_), formpost(formpost_), callback(callback_)
 {
+  queued_micros = modio::getSteadyTimeMicros();
 }
 #endif
 
@@ -56,6 +59,7 @@ CurrentModDownload::CurrentModDownload()
   curl_handle = NULL;
   slist = NULL;
   file = NULL;
+  queued_micros = modio::getSteadyTimeMicros();
 }
 
 CurrentModDownload::~CurrentModDownload()
@@ -85,6 +89,7 @@ CurrentModfileUpload::~CurrentModfileUpload()
 OngoingDownload::OngoingDownload(u32 call_number_, std::string url_, struct curl_slist *slist_, std::function<void(u32 call_number, u32 response_code)> callback_)
   : call_number(call_number_), url(url_), slist(slist_), callback(callback_)
 {
+  queued_micros = modio::getSteadyTimeMicros();
 }
 
 OngoingDownload::~OngoingDownload()
@@ -113,6 +118,15 @@ void updateModDownloadQueue()
   }
 }
 
+void updateTransferGauges()
+{
+  modio::setGauge(MODIO_GAUGE_ACTIVE_REQUESTS, (u32)g_ongoing_calls.size());
+  modio::setGauge(MODIO_GAUGE_ACTIVE_DOWNLOADS, (u32)g_ongoing_downloads.size() + (g_current_mod_download ? 1 : 0));
+  modio::setGauge(MODIO_GAUGE_ACTIVE_UPLOADS, g_current_modfile_upload ? 1 : 0);
+  modio::setGauge(MODIO_GAUGE_MOD_DOWNLOAD_QUEUE, (u32)g_mod_download_queue.size());
+  modio::setGauge(MODIO_GAUGE_MODFILE_UPLOAD_QUEUE, (u32)g_modfile_upload_queue.size());
+}
+
 void updateModDownloadQueueFile()
 {
   modio::writeLogLine("Updating mod download queue file...", MODIO_DEBUGLEVEL_LOG);
@@ -4,6 +4,26 @@ namespace modio
 {
 namespace curlwrapper
 {
+static CurlTransport g_curl_transport;
+static Transport *g_transport = &g_curl_transport;
+// GETs waiting on an identical one already in flight, by hash of the canonical url and headers
+static std::map<u64, std::vector<std::pair<u32, JsonRequestCallback> > > g_pending_gets;
+
+void setTransport(Transport *transport)
+{
+  g_transport = transport ? transport : &g_curl_transport;
+}
+
+Transport *getTransport()
+{
+  return g_transport;
+}
+
+CurlTransport *getCurlTransport()
+{
+  return &g_curl_transport;
+}
+
 void initCurl()
 {
   g_current_mod_download = NULL;
@@ -25,22 +45,14 @@ void shutdownCurl()
 
   g_ongoing_call = 0;
   g_call_count = 0;
+  g_pending_gets.clear();
 
-  curl_multi_cleanup(g_curl_multi_handle);
+  if (g_transport != &g_curl_transport)
+    g_transport->shutdown();
 
-  for (auto ongoing_call : g_ongoing_calls)
-  {
-    curl_easy_cleanup(ongoing_call.first);
-    delete ongoing_call.second;
-  }
-  g_ongoing_calls.clear();
+  curl_multi_cleanup(g_curl_multi_handle);
 
-  for (auto ongoing_download : g_ongoing_downloads)
-  {
-    curl_easy_cleanup(ongoing_download.first);
-    delete ongoing_download.second;
-  }
-  g_ongoing_downloads.clear();
+  g_curl_transport.shutdown();
 
   for (auto mod_download : g_mod_download_queue)
   {
@@ -56,6 +68,8 @@ void shutdownCurl()
 
   if (g_current_modfile_upload)
     delete g_current_modfile_upload;
+
+  updateTransferGauges();
 }
 
 u32 getCallNumber()
@@ -66,6 +80,85 @@ u32 getCallNumber()
 }
 
 void process()
+{
+  g_transport->process();
+  updateTransferGauges();
+}
+
+u32 getPendingGetCount()
+{
+  return (u32)g_pending_gets.size();
+}
+
+void get(u32 call_number, std::string url, std::vector<std::string> headers, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  std::string request_key = modio::getCanonicalUrl(url);
+  for (auto &header : headers)
+    request_key += "\n" + header;
+  u64 request_hash = modio::hash64(request_key);
+
+  auto pending_get = g_pending_gets.find(request_hash);
+  if (pending_get != g_pending_gets.end())
+  {
+    MODIO_LOG("Joining identical request in flight: " + url, MODIO_DEBUGLEVEL_LOG);
+    pending_get->second.push_back(std::make_pair(call_number, callback));
+    return;
+  }
+
+  g_pending_gets[request_hash];
+  g_transport->get(call_number, url, headers, [request_hash, callback](u32 call_number, u32 response_code, nlohmann::json response_json) {
+    // Taken out first so an identical call made from a callback goes to the network
+    std::vector<std::pair<u32, JsonRequestCallback> > waiting_calls;
+    auto pending_get = g_pending_gets.find(request_hash);
+    if (pending_get != g_pending_gets.end())
+    {
+      waiting_calls.swap(pending_get->second);
+      g_pending_gets.erase(pending_get);
+    }
+
+    // Every joined call gets the transfer on its response
+    const ModioTransferInfo *transfer = modio::getResponseTransfer();
+    callback(call_number, response_code, response_json);
+    for (auto &waiting_call : waiting_calls)
+    {
+      modio::setResponseTransfer(transfer);
+      waiting_call.second(waiting_call.first, response_code, response_json);
+    }
+  });
+  updateTransferGauges();
+}
+
+void post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  g_transport->post(call_number, url, headers, data, callback);
+  updateTransferGauges();
+}
+
+void put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  g_transport->put(call_number, url, headers, curlform_copycontents, callback);
+  updateTransferGauges();
+}
+
+void postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  g_transport->postForm(call_number, url, headers, curlform_copycontents, curlform_files, callback);
+  updateTransferGauges();
+}
+
+void deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  g_transport->deleteCall(call_number, url, headers, data, callback);
+  updateTransferGauges();
+}
+
+void download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, std::function<void(u32 call_number, u32 response_code)> callback)
+{
+  g_transport->download(call_number, headers, url, path, file, callback);
+  updateTransferGauges();
+}
+
+void CurlTransport::process()
 {
   CURLMcode code;
   i32 handle_count;
@@ -92,7 +185,7 @@ void process()
       }
       else if (g_current_mod_download && g_current_mod_download->curl_handle && g_current_mod_download->curl_handle == curl_handle)
       {
-        onModDownloadFinished(curl_handle);
+        onModDownloadFinished(curl_handle, curl_message->data.result);
       }
       else if (g_current_modfile_upload && g_current_modfile_upload->curl_handle && g_current_modfile_upload->curl_handle == curl_handle)
       {
@@ -108,14 +201,31 @@ void process()
     }
     else if (curl_message)
     {
-      writeLogLine("Unhandled curl message returned" + modio::toString((u32)curl_message->msg), MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("Unhandled curl message returned" + modio::toString((u32)curl_message->msg), MODIO_DEBUGLEVEL_ERROR);
     }
   } while (curl_message);
 }
 
-void get(u32 call_number, std::string url, std::vector<std::string> headers, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+void CurlTransport::shutdown()
 {
-  writeLogLine("GET: " + url, MODIO_DEBUGLEVEL_LOG);
+  for (auto ongoing_call : g_ongoing_calls)
+  {
+    curl_easy_cleanup(ongoing_call.first);
+    delete ongoing_call.second;
+  }
+  g_ongoing_calls.clear();
+
+  for (auto ongoing_download : g_ongoing_downloads)
+  {
+    curl_easy_cleanup(ongoing_download.first);
+    delete ongoing_download.second;
+  }
+  g_ongoing_downloads.clear();
+}
+
+void CurlTransport::get(u32 call_number, std::string url, std::vector<std::string> headers, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+{
+  MODIO_LOG("GET: " + url, MODIO_DEBUGLEVEL_LOG);
 
   CURL *curl;
   curl = curl_easy_init();
@@ -140,9 +250,9 @@ void get(u32 call_number, std::string url, std::vector<std::string> headers, std
   }
 }
 
-void post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+void CurlTransport::post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
 {
-  writeLogLine(std::string("POST: ") + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("POST: ") + url, MODIO_DEBUGLEVEL_LOG);
 
   CURL *curl;
   curl = curl_easy_init();
@@ -173,9 +283,9 @@ void post(u32 call_number, std::string url, std::vector<std::string> headers, st
   }
 }
 
-void put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+void CurlTransport::put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
 {
-  writeLogLine(std::string("PUT: ") + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("PUT: ") + url, MODIO_DEBUGLEVEL_LOG);
 
   CURL *curl;
   curl = curl_easy_init();
@@ -207,10 +317,10 @@ void put(u32 call_number, std::string url, std::vector<std::string> headers, std
   }
 }
 
-void postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, std::function<void(u32 call_number, u32 response_code, nlohmann::json response)> callback)
+void CurlTransport::postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, std::function<void(u32 call_number, u32 response_code, nlohmann::json response)> callback)
 {
 #ifdef MODIO_WINDOWS_DETECTED
-  writeLogLine("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
   CURL *curl;
 
   curl = curl_easy_init();
@@ -264,7 +374,7 @@ void postForm(u32 call_number, std::string url, std::vector<std::string> headers
     curl_multi_add_handle(g_curl_multi_handle, curl);
   }
 #elif defined(MODIO_OSX_DETECTED) || defined(MODIO_LINUX_DETECTED)
-  writeLogLine("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
   CURL *curl;
 
   curl = curl_easy_init();
@@ -323,9 +433,9 @@ void postForm(u32 call_number, std::string url, std::vector<std::string> headers
 #endif
 }
 
-void deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
+void CurlTransport::deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, std::function<void(u32 call_number, u32 response_code, nlohmann::json response_json)> callback)
 {
-  writeLogLine(std::string("DELETE: ") + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("DELETE: ") + url, MODIO_DEBUGLEVEL_LOG);
 
   CURL *curl;
   curl = curl_easy_init();
@@ -373,12 +483,13 @@ void resumeModDownloads()
   {
     downloadMod(*g_mod_download_queue.begin());
   }
+  updateTransferGauges();
 }
 
-void download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, std::function<void(u32 call_number, u32 response_code)> callback)
+void CurlTransport::download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, std::function<void(u32 call_number, u32 response_code)> callback)
 {
   //TODO: Add to download queue
-  writeLogLine("DOWNLOAD: " + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("DOWNLOAD: " + url, MODIO_DEBUGLEVEL_LOG);
   CURL *curl;
   curl = curl_easy_init();
 
@@ -420,14 +531,14 @@ static void onGetDownloadMod(u32 call_number, u32 response_code, nlohmann::json
     if (g_current_mod_download->queued_mod_download == NULL)
     {
       modioFreeMod(&modio_mod);
-      writeLogLine("Could not find mod " + modio::toString(modio_mod.id) + "on the download queue. It won't be downloaded.", MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Could not find mod " + modio::toString(modio_mod.id) + "on the download queue. It won't be downloaded.", MODIO_DEBUGLEVEL_LOG);
       return;
     }
 
     //TODO: Return a download listener error if mod has no modfile
     if (modio_mod.modfile.download.binary_url == NULL)
     {
-      modio::writeLogLine("The mod " + modio::toString(modio_mod.id) + " has no modfile to be downloaded", MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("The mod " + modio::toString(modio_mod.id) + " has no modfile to be downloaded", MODIO_DEBUGLEVEL_ERROR);
       handleOnGetDownloadModError(&modio_mod);
       return;
     }
@@ -436,13 +547,13 @@ static void onGetDownloadMod(u32 call_number, u32 response_code, nlohmann::json
       g_current_mod_download->queued_mod_download->url = modio_mod.modfile.download.binary_url;
       g_current_mod_download->queued_mod_download->mod.id = modio_mod.id;
 
-      writeLogLine("Openning file for mod download: " + g_current_mod_download->queued_mod_download->path, MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Openning file for mod download: " + g_current_mod_download->queued_mod_download->path, MODIO_DEBUGLEVEL_LOG);
 
       FILE *file;
       curl_off_t progress = (curl_off_t)getFileSize(g_current_mod_download->queued_mod_download->path);
       if (progress != 0)
       {
-        writeLogLine("Progress detected. Resuming download from " + toString((u32)progress), MODIO_DEBUGLEVEL_LOG);
+        MODIO_LOG("Progress detected. Resuming download from " + toString((u32)progress), MODIO_DEBUGLEVEL_LOG);
         file = fopen(g_current_mod_download->queued_mod_download->path.c_str(), "ab");
       }
       else
@@ -452,14 +563,14 @@ static void onGetDownloadMod(u32 call_number, u32 response_code, nlohmann::json
 
       if(!file)
       {
-        modio::writeLogLine("The mod " + modio::toString(modio_mod.id) + " has no modfile to be downloaded", MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG("The mod " + modio::toString(modio_mod.id) + " has no modfile to be downloaded", MODIO_DEBUGLEVEL_ERROR);
         handleOnGetDownloadModError(&modio_mod);
         return;
       }
 
       modioFreeMod(&modio_mod);
 
-      writeLogLine("Download started. Mod id: " + toString(g_current_mod_download->queued_mod_download->mod_id) + " Url: " + g_current_mod_download->queued_mod_download->url, MODIO_DEBUGLEVEL_LOG);
+      MODIO_LOG("Download started. Mod id: " + toString(g_current_mod_download->queued_mod_download->mod_id) + " Url: " + g_current_mod_download->queued_mod_download->url, MODIO_DEBUGLEVEL_LOG);
 
       CURL *curl;
       curl = curl_easy_init();
@@ -498,7 +609,23 @@ static void onGetDownloadMod(u32 call_number, u32 response_code, nlohmann::json
   }
   else
   {
-    modio::writeLogLine("Could not download mod. Could not gather mod information.", MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not download mod. Could not gather mod information. Response code: " + modio::toString(response_code), MODIO_DEBUGLEVEL_ERROR);
+
+    // The mod being downloaded is always at the front, drop it so the rest of the queue keeps going
+    if (!g_mod_download_queue.empty())
+    {
+      QueuedModDownload *queued_mod_download = g_mod_download_queue.front();
+
+      if (modio::download_callback)
+        modio::download_callback(response_code, queued_mod_download->mod_id);
+
+      g_mod_download_queue.remove(queued_mod_download);
+      delete queued_mod_download;
+      g_mod_download_retries = 0;
+
+      updateModDownloadQueueFile();
+      downloadNextQueuedMod();
+    }
   }
 }
 
@@ -517,7 +644,7 @@ void queueModDownload(ModioMod &modio_mod)
   {
     if (queued_mod_download->mod_id == modio_mod.id)
     {
-      writeLogLine("Could not queue the mod: " + toString(modio_mod.id) + ". It's already queued.", MODIO_DEBUGLEVEL_WARNING);
+      MODIO_LOG("Could not queue the mod: " + toString(modio_mod.id) + ". It's already queued.", MODIO_DEBUGLEVEL_WARNING);
       return;
     }
   }
@@ -534,12 +661,13 @@ void queueModDownload(ModioMod &modio_mod)
 
   updateModDownloadQueueFile();
 
-  writeLogLine("Download queued. Mod id: " + toString(modio_mod.id), MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Download queued. Mod id: " + toString(modio_mod.id), MODIO_DEBUGLEVEL_LOG);
 
   if (g_mod_download_queue.size() == 1)
   {
     downloadMod(queued_mod_download);
   }
+  updateTransferGauges();
 }
 
 void uploadModfile(QueuedModfileUpload *queued_modfile_upload)
@@ -548,7 +676,7 @@ void uploadModfile(QueuedModfileUpload *queued_modfile_upload)
 
   std::string modfile_zip_path = "";
 
-  writeLogLine("Uploading mod: " + toString(queued_modfile_upload->mod_id) + " located at path: " + queued_modfile_upload->path, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Uploading mod: " + toString(queued_modfile_upload->mod_id) + " located at path: " + queued_modfile_upload->path, MODIO_DEBUGLEVEL_LOG);
 
   if (modio::isDirectory(modfile_path))
   {
@@ -561,7 +689,7 @@ void uploadModfile(QueuedModfileUpload *queued_modfile_upload)
   }
   else
   {
-    writeLogLine("Could not find the modfile to upload: " + modfile_path, MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Could not find the modfile to upload: " + modfile_path, MODIO_DEBUGLEVEL_ERROR);
 
     if (modio::upload_callback)
     {
@@ -581,7 +709,7 @@ void uploadModfile(QueuedModfileUpload *queued_modfile_upload)
 
   std::string url = modio::MODIO_URL + modio::MODIO_VERSION_PATH + "games/" + modio::toString(modio::GAME_ID) + "/mods/" + modio::toString(queued_modfile_upload->mod_id) + "/files";
 
-  writeLogLine("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("POST FORM: " + url, MODIO_DEBUGLEVEL_LOG);
 
   CURL *curl;
   curl = curl_easy_init();
@@ -644,7 +772,7 @@ void queueModfileUpload(u32 mod_id, ModioModfileCreator *modio_modfile_creator)
   {
     if (queued_modfile_upload->mod_id == mod_id)
     {
-      writeLogLine("Could not queue the mod: " + toString(mod_id) + ". It's already queued.", MODIO_DEBUGLEVEL_WARNING);
+      MODIO_LOG("Could not queue the mod: " + toString(mod_id) + ". It's already queued.", MODIO_DEBUGLEVEL_WARNING);
       return;
     }
   }
@@ -659,12 +787,13 @@ void queueModfileUpload(u32 mod_id, ModioModfileCreator *modio_modfile_creator)
 
   //updateModUploadQueueFile();
 
-  writeLogLine("Upload queued. Mod id: " + toString(mod_id), MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Upload queued. Mod id: " + toString(mod_id), MODIO_DEBUGLEVEL_LOG);
 
   if (g_modfile_upload_queue.size() == 1)
   {
     uploadModfile(queued_modfile_upload);
   }
+  updateTransferGauges();
 }
 } // namespace curlwrapper
 } // namespace modio
@@ -6,14 +6,18 @@ namespace minizipwrapper
 {
 void extract(std::string zip_path, std::string directory_path)
 {
+  MODIO_TRACE_SCOPE("extract", "unzip");
+  double extract_start_micros = modio::getSteadyTimeMicros();
+  u64 extracted_bytes = 0;
+  u32 extracted_files = 0;
   directory_path = addSlashIfNeeded(directory_path);
   
-  writeLogLine(std::string("Extracting ") + zip_path, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("Extracting ") + zip_path, MODIO_DEBUGLEVEL_LOG);
   unzFile zipfile = unzOpen(zip_path.c_str());
 
   if (zipfile == NULL)
   {
-    writeLogLine("Cannot open " + zip_path, MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG("Cannot open " + zip_path, MODIO_DEBUGLEVEL_ERROR);
     return;
   }
 
@@ -38,7 +42,7 @@ void extract(std::string zip_path, std::string directory_path)
     if (err != UNZ_OK)
     {
       unzClose(zipfile);
-      writeLogLine("error " + toString(err) + " with zipfile in unzGetCurrentFileInfo", MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG("error " + toString(err) + " with zipfile in unzGetCurrentFileInfo", MODIO_DEBUGLEVEL_ERROR);
       return;
     }
 
@@ -58,7 +62,7 @@ void extract(std::string zip_path, std::string directory_path)
 
       if (err != UNZ_OK)
       {
-        writeLogLine(std::string("Cannot open ") + filename, MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG(std::string("Cannot open ") + filename, MODIO_DEBUGLEVEL_ERROR);
         return;
       }
 
@@ -68,7 +72,7 @@ void extract(std::string zip_path, std::string directory_path)
 
       if (!out)
       {
-        writeLogLine(std::string("error opening ") + final_filename, MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG(std::string("error opening ") + final_filename, MODIO_DEBUGLEVEL_ERROR);
         return;
       }
 
@@ -78,7 +82,7 @@ void extract(std::string zip_path, std::string directory_path)
         err = unzReadCurrentFile(zipfile, read_buffer, READ_SIZE);
         if (err < 0)
         {
-          writeLogLine("error " + toString(err) + " with zipfile in unzReadCurrentFile", MODIO_DEBUGLEVEL_ERROR);
+          MODIO_LOG("error " + toString(err) + " with zipfile in unzReadCurrentFile", MODIO_DEBUGLEVEL_ERROR);
           unzCloseCurrentFile(zipfile);
           unzClose(zipfile);
           return;
@@ -87,16 +91,18 @@ void extract(std::string zip_path, std::string directory_path)
         {
           if (fwrite(read_buffer, (size_t)err, 1, out) != 1)
           {
-            writeLogLine("error " + toString(err) + " in writing extracted file", MODIO_DEBUGLEVEL_ERROR);
+            MODIO_LOG("error " + toString(err) + " in writing extracted file", MODIO_DEBUGLEVEL_ERROR);
           }
+          extracted_bytes += (u64)err;
         }
       } while (err > 0);
 
       fclose(out);
+      extracted_files++;
 
       err = unzCloseCurrentFile(zipfile);
       if (err != UNZ_OK)
-        writeLogLine("error " + toString(err) + " with " + filename + " in unzCloseCurrentFile", MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG("error " + toString(err) + " with " + filename + " in unzCloseCurrentFile", MODIO_DEBUGLEVEL_ERROR);
     }
 
     if ((i + 1) < global_info.number_entry)
@@ -105,21 +111,23 @@ void extract(std::string zip_path, std::string directory_path)
 
       if (err != UNZ_OK)
       {
-        writeLogLine("error " + toString(err) + " with zipfile in unzGoToNextFile", MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG("error " + toString(err) + " with zipfile in unzGoToNextFile", MODIO_DEBUGLEVEL_ERROR);
         unzClose(zipfile);
         return;
       }
     }
   }
   unzClose(zipfile);
-  writeLogLine(zip_path + " extracted", MODIO_DEBUGLEVEL_LOG);
+  modio::recordExtract(extracted_bytes, extracted_files, modio::getSteadyTimeMicros() - extract_start_micros);
+  MODIO_LOG(zip_path + " extracted", MODIO_DEBUGLEVEL_LOG);
 }
 
 void compressFiles(std::string root_directory, std::vector<std::string> filenames, std::string zip_path)
 {
-  writeLogLine("Compressing " + modio::toString((u32)filenames.size()) + " files", MODIO_DEBUGLEVEL_LOG);
+  MODIO_TRACE_SCOPE("compress files", "zip");
+  MODIO_LOG("Compressing " + modio::toString((u32)filenames.size()) + " files", MODIO_DEBUGLEVEL_LOG);
 
-  writeLogLine(std::string("Compressing ") + " into " + zip_path, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG(std::string("Compressing ") + " into " + zip_path, MODIO_DEBUGLEVEL_LOG);
 
   zipFile zf = NULL;
   //#ifdef USEWIN32IOAPI
@@ -150,11 +158,11 @@ void compressFiles(std::string root_directory, std::vector<std::string> filename
 
   if (zf == NULL)
   {
-    writeLogLine(std::string("Could not open ") + zipfilename, MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG(std::string("Could not open ") + zipfilename, MODIO_DEBUGLEVEL_ERROR);
   }
   else
   {
-    writeLogLine(std::string("Creating ") + zipfilename, MODIO_DEBUGLEVEL_LOG);
+    MODIO_LOG(std::string("Creating ") + zipfilename, MODIO_DEBUGLEVEL_LOG);
   }
 
   for (size_t i = 0; i < filenames.size(); i++)
@@ -207,13 +215,13 @@ void compressFiles(std::string root_directory, std::vector<std::string> filename
                                   password, crcFile, zip64);
 
     if (err != ZIP_OK)
-      writeLogLine(std::string("Could not open ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
+      MODIO_LOG(std::string("Could not open ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
     else
     {
       fin = fopen(complete_file_path.c_str(), "rb");
       if (fin == NULL)
       {
-        writeLogLine(std::string("Could not open ") + filenameinzip + " for reading", MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG(std::string("Could not open ") + filenameinzip + " for reading", MODIO_DEBUGLEVEL_ERROR);
       }
     }
 
@@ -225,14 +233,14 @@ void compressFiles(std::string root_directory, std::vector<std::string> filename
         size_read = fread(buf, 1, size_buf, fin);
         if ((size_read < size_buf) && (feof(fin) == 0))
         {
-          writeLogLine(std::string("Error in reading ") + filenameinzip, MODIO_DEBUGLEVEL_ERROR);
+          MODIO_LOG(std::string("Error in reading ") + filenameinzip, MODIO_DEBUGLEVEL_ERROR);
         }
 
         if (size_read > 0)
         {
           err = zipWriteInFileInZip(zf, buf, (unsigned int)size_read);
           if (err < 0)
-            writeLogLine(std::string("Error in writing ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
+            MODIO_LOG(std::string("Error in writing ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
         }
       } while ((err == ZIP_OK) && (size_read > 0));
     }
@@ -246,22 +254,23 @@ void compressFiles(std::string root_directory, std::vector<std::string> filename
     {
       err = zipCloseFileInZip(zf);
       if (err != ZIP_OK)
-        writeLogLine(std::string("Error in closing ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
+        MODIO_LOG(std::string("Error in closing ") + filenameinzip + " in zipfile, zlib error: " + toString(err), MODIO_DEBUGLEVEL_ERROR);
     }
   }
 
   errclose = zipClose(zf, NULL);
 
   if (errclose != ZIP_OK)
-    writeLogLine(std::string("Error in closing ") + zipfilename + ", zlib error: " + toString(errclose), MODIO_DEBUGLEVEL_ERROR);
+    MODIO_LOG(std::string("Error in closing ") + zipfilename + ", zlib error: " + toString(errclose), MODIO_DEBUGLEVEL_ERROR);
 
   free(buf);
 }
 
 void compressDirectory(std::string directory, std::string zip_path)
 {
+  MODIO_TRACE_SCOPE("compress directory", "zip");
   directory = modio::addSlashIfNeeded(directory);
-  writeLogLine("Compressing directory " + directory, MODIO_DEBUGLEVEL_LOG);
+  MODIO_LOG("Compressing directory " + directory, MODIO_DEBUGLEVEL_LOG);
   std::vector<std::string> filenames = getFilenames(directory);
   for(u32 i=0; i<filenames.size(); i++)
   {
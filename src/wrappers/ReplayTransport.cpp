@@ -0,0 +1,247 @@
+#include "wrappers/CurlWrapper.h"
+
+namespace modio
+{
+namespace curlwrapper
+{
+static double getSteadyTimeMillis()
+{
+  return (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string getRecordKey(const std::string &method, const std::string &url, const std::string &body)
+{
+  char key[17];
+  snprintf(key, sizeof(key), "%016llx", modio::hash64(method + " " + url + "\n" + body));
+  return key;
+}
+
+static bool copyFile(const std::string &from_path, const std::string &to_path)
+{
+  std::ifstream from(from_path, std::ios::binary);
+  if (!from.is_open())
+    return false;
+  std::ofstream to(to_path, std::ios::binary);
+  to << from.rdbuf();
+  return true;
+}
+
+ReplayTransport::ReplayTransport(const std::string &directory_, u32 mode_)
+  : directory(modio::addSlashIfNeeded(directory_)), mode(mode_), latency(0), bandwidth(0), link_free_at(0)
+{
+  if (mode == MODIO_TRANSPORT_RECORD)
+    modio::createPath(directory);
+}
+
+ReplayTransport::~ReplayTransport()
+{
+  shutdown();
+}
+
+void ReplayTransport::setLatency(u32 milliseconds)
+{
+  latency = milliseconds;
+}
+
+void ReplayTransport::setBandwidth(u32 bytes_per_second)
+{
+  bandwidth = bytes_per_second;
+}
+
+u32 ReplayTransport::getPendingCount() const
+{
+  return (u32)pending_replies.size();
+}
+
+std::string ReplayTransport::getRecordPath(const std::string &key)
+{
+  return directory + key;
+}
+
+void ReplayTransport::storeRecord(const std::string &method, const std::string &url, const std::string &body, u32 response_code, const nlohmann::json &response_json)
+{
+  nlohmann::json record_json;
+  record_json["method"] = method;
+  record_json["url"] = url;
+  record_json["response_code"] = response_code;
+  record_json["response"] = response_json;
+  modio::writeJson(getRecordPath(getRecordKey(method, url, body)) + ".json", record_json);
+}
+
+double ReplayTransport::scheduleDelivery(double size)
+{
+  // Every transfer waits for its own latency, the bandwidth is shared: a body is sent
+  // once the link drained everything that was scheduled before it
+  double now = getSteadyTimeMillis();
+  double deliver_at = now + latency;
+  if (bandwidth > 0)
+  {
+    link_free_at = (link_free_at > now ? link_free_at : now) + size * 1000 / bandwidth;
+    if (link_free_at > deliver_at)
+      deliver_at = link_free_at;
+  }
+  return deliver_at;
+}
+
+void ReplayTransport::jsonCall(const std::string &method, u32 call_number, const std::string &url, const std::string &body, JsonRequestCallback callback, const std::function<void(JsonRequestCallback)> &forward)
+{
+  std::string record_path = getRecordPath(getRecordKey(method, url, body)) + ".json";
+
+  if (mode == MODIO_TRANSPORT_RECORD)
+  {
+    forward([this, method, url, body, callback](u32 call_number, u32 response_code, nlohmann::json response_json) {
+      storeRecord(method, url, body, response_code, response_json);
+      callback(call_number, response_code, response_json);
+    });
+    return;
+  }
+
+  MODIO_LOG("REPLAY " + method + ": " + url, MODIO_DEBUGLEVEL_LOG);
+
+  PendingReply *pending_reply = new PendingReply();
+  pending_reply->call_number = call_number;
+  pending_reply->json_callback = callback;
+  pending_reply->file = NULL;
+  pending_reply->response_code = 0;
+
+  nlohmann::json record_json = modio::openJson(record_path);
+  if (modio::hasKey(record_json, "response_code") && record_json.find("response") != record_json.end())
+  {
+    pending_reply->response_code = record_json["response_code"];
+    pending_reply->response_json = record_json["response"];
+  }
+  else
+  {
+    MODIO_LOG("No recorded response for " + method + ": " + url, MODIO_DEBUGLEVEL_ERROR);
+    pending_reply->response_json = "{}"_json;
+  }
+
+  pending_reply->deliver_at = scheduleDelivery((double)pending_reply->response_json.dump().size());
+  pending_replies.insert(std::make_pair(pending_reply->deliver_at, pending_reply));
+}
+
+void ReplayTransport::get(u32 call_number, std::string url, std::vector<std::string> headers, JsonRequestCallback callback)
+{
+  jsonCall("GET", call_number, url, "", callback, [&](JsonRequestCallback recording_callback) {
+    getCurlTransport()->get(call_number, url, headers, recording_callback);
+  });
+}
+
+void ReplayTransport::post(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback)
+{
+  jsonCall("POST", call_number, url, mapDataToUrlString(data), callback, [&](JsonRequestCallback recording_callback) {
+    getCurlTransport()->post(call_number, url, headers, data, recording_callback);
+  });
+}
+
+void ReplayTransport::put(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, JsonRequestCallback callback)
+{
+  jsonCall("PUT", call_number, url, multimapDataToUrlString(curlform_copycontents), callback, [&](JsonRequestCallback recording_callback) {
+    getCurlTransport()->put(call_number, url, headers, curlform_copycontents, recording_callback);
+  });
+}
+
+void ReplayTransport::postForm(u32 call_number, std::string url, std::vector<std::string> headers, std::multimap<std::string, std::string> curlform_copycontents, std::map<std::string, std::string> curlform_files, JsonRequestCallback callback)
+{
+  // Only the form fields identify the call, uploaded file contents are not part of the key
+  jsonCall("POST FORM", call_number, url, multimapDataToUrlString(curlform_copycontents), callback, [&](JsonRequestCallback recording_callback) {
+    getCurlTransport()->postForm(call_number, url, headers, curlform_copycontents, curlform_files, recording_callback);
+  });
+}
+
+void ReplayTransport::deleteCall(u32 call_number, std::string url, std::vector<std::string> headers, std::map<std::string, std::string> data, JsonRequestCallback callback)
+{
+  jsonCall("DELETE", call_number, url, mapDataToUrlString(data), callback, [&](JsonRequestCallback recording_callback) {
+    getCurlTransport()->deleteCall(call_number, url, headers, data, recording_callback);
+  });
+}
+
+void ReplayTransport::download(u32 call_number, std::vector<std::string> headers, std::string url, std::string path, FILE *file, DownloadCallback callback)
+{
+  std::string record_path = getRecordPath(getRecordKey("DOWNLOAD", url, ""));
+
+  if (mode == MODIO_TRANSPORT_RECORD)
+  {
+    getCurlTransport()->download(call_number, headers, url, path, file, [record_path, url, path, callback](u32 call_number, u32 response_code) {
+      // The callback owns the file handle, the body can only be copied once it has been closed
+      callback(call_number, response_code);
+      nlohmann::json record_json;
+      record_json["method"] = "DOWNLOAD";
+      record_json["url"] = url;
+      record_json["response_code"] = response_code;
+      modio::writeJson(record_path + ".json", record_json);
+      if (!copyFile(path, record_path + ".bin"))
+        MODIO_LOG("Could not record download body: " + path, MODIO_DEBUGLEVEL_ERROR);
+    });
+    return;
+  }
+
+  MODIO_LOG("REPLAY DOWNLOAD: " + url, MODIO_DEBUGLEVEL_LOG);
+
+  PendingReply *pending_reply = new PendingReply();
+  pending_reply->call_number = call_number;
+  pending_reply->download_callback = callback;
+  pending_reply->file = file;
+  pending_reply->response_code = 0;
+
+  nlohmann::json record_json = modio::openJson(record_path + ".json");
+  if (modio::hasKey(record_json, "response_code") && modio::fileExists(record_path + ".bin"))
+  {
+    pending_reply->response_code = record_json["response_code"];
+    pending_reply->body_path = record_path + ".bin";
+  }
+  else
+  {
+    MODIO_LOG("No recorded download for " + url, MODIO_DEBUGLEVEL_ERROR);
+  }
+
+  pending_reply->deliver_at = scheduleDelivery(pending_reply->body_path != "" ? modio::getFileSize(pending_reply->body_path) : 0);
+  pending_replies.insert(std::make_pair(pending_reply->deliver_at, pending_reply));
+}
+
+void ReplayTransport::process()
+{
+  double current_time = getSteadyTimeMillis();
+
+  // Callbacks may issue new calls, those are delivered on a later process()
+  std::vector<PendingReply *> due_replies;
+  while (!pending_replies.empty() && pending_replies.begin()->first <= current_time)
+  {
+    due_replies.push_back(pending_replies.begin()->second);
+    pending_replies.erase(pending_replies.begin());
+  }
+
+  for (auto pending_reply : due_replies)
+  {
+    if (pending_reply->json_callback)
+    {
+      pending_reply->json_callback(pending_reply->call_number, pending_reply->response_code, pending_reply->response_json);
+    }
+    else
+    {
+      if (pending_reply->body_path != "" && pending_reply->file)
+      {
+        std::ifstream body(pending_reply->body_path, std::ios::binary);
+        char buffer[8192];
+        while (body.read(buffer, sizeof(buffer)) || body.gcount() > 0)
+          fwrite(buffer, 1, (size_t)body.gcount(), pending_reply->file);
+      }
+      pending_reply->download_callback(pending_reply->call_number, pending_reply->response_code);
+    }
+    delete pending_reply;
+  }
+
+  // Mod downloads and modfile uploads keep running on the curl multi handle
+  getCurlTransport()->process();
+}
+
+void ReplayTransport::shutdown()
+{
+  for (auto &pending_reply : pending_replies)
+    delete pending_reply.second;
+  pending_replies.clear();
+  link_free_at = 0;
+}
+
+} // namespace curlwrapper
+} // namespace modio
@@ -0,0 +1,97 @@
+#ifndef MODIO_TEST_FAKE_TRANSPORT_H
+#define MODIO_TEST_FAKE_TRANSPORT_H
+
+#include "modio.h"
+
+// Runs the SDK without a server. Every json call is held until process(), which answers
+// it with what reply() gives for its method and url. Downloads fail right away.
+class FakeTransport : public modio::curlwrapper::Transport
+{
+public:
+	virtual ~FakeTransport() {}
+
+	void get(u32 call_number, std::string url, std::vector<std::string>, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		hold("GET", call_number, url, callback);
+	}
+	void post(u32 call_number, std::string url, std::vector<std::string>, std::map<std::string, std::string>, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		hold("POST", call_number, url, callback);
+	}
+	void put(u32 call_number, std::string url, std::vector<std::string>, std::multimap<std::string, std::string>, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		hold("PUT", call_number, url, callback);
+	}
+	void postForm(u32 call_number, std::string url, std::vector<std::string>, std::multimap<std::string, std::string>, std::map<std::string, std::string>, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		hold("POST", call_number, url, callback);
+	}
+	void deleteCall(u32 call_number, std::string url, std::vector<std::string>, std::map<std::string, std::string>, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		hold("DELETE", call_number, url, callback);
+	}
+	void download(u32 call_number, std::vector<std::string>, std::string, std::string, FILE *, modio::curlwrapper::DownloadCallback callback)
+	{
+		callback(call_number, 0);
+	}
+
+	void process()
+	{
+		std::vector<HeldCall> due_calls;
+		due_calls.swap(held_calls);
+		for (auto &due_call : due_calls)
+		{
+			nlohmann::json response_json;
+			u32 response_code = reply(due_call.method, due_call.url, response_json);
+			due_call.callback(due_call.call_number, response_code, response_json);
+		}
+	}
+	void shutdown()
+	{
+		held_calls.clear();
+	}
+
+	// Calls that reached the transport with method and a url containing url_part
+	u32 getRequestCount(const std::string &method, const std::string &url_part) const
+	{
+		u32 count = 0;
+		for (auto &request : requests)
+		{
+			if (request.first == method && request.second.find(url_part) != std::string::npos)
+				count++;
+		}
+		return count;
+	}
+
+protected:
+	// Fails the call like an unreachable server unless overridden
+	virtual u32 reply(const std::string &, const std::string &, nlohmann::json &)
+	{
+		return 0;
+	}
+
+private:
+	struct HeldCall
+	{
+		std::string method;
+		u32 call_number;
+		std::string url;
+		modio::curlwrapper::JsonRequestCallback callback;
+	};
+
+	void hold(const std::string &method, u32 call_number, const std::string &url, modio::curlwrapper::JsonRequestCallback callback)
+	{
+		requests.push_back(std::make_pair(method, url));
+		HeldCall held_call;
+		held_call.method = method;
+		held_call.call_number = call_number;
+		held_call.url = url;
+		held_call.callback = callback;
+		held_calls.push_back(held_call);
+	}
+
+	std::vector<std::pair<std::string, std::string>> requests;
+	std::vector<HeldCall> held_calls;
+};
+
+#endif
@@ -0,0 +1,240 @@
+#include <fstream>
+#include <iterator>
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "CacheStore.h"
+
+#define TEST_CACHE_STORE_PATH "test_cache_store.bin"
+
+static std::string readFile(const std::string &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(content.data(), content.size());
+}
+
+// Deflate can't shrink it, so it is stored as it is and takes its full size
+static std::string getIncompressibleValue(u32 size, u32 seed)
+{
+	std::string value(size, 0);
+	u32 state = seed * 2654435761u + 1;
+	for (u32 i = 0; i < size; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		value[i] = (char)(state >> 16);
+	}
+	return value;
+}
+
+static bool hasValue(modio::CacheStore &cache_store, const std::string &key, const std::string &expected_value)
+{
+	std::string value;
+	return cache_store.get(key, 60, value) && value == expected_value;
+}
+
+TEST(CacheStore, TestPutGetReopen)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	double now_millis = modio::getCurrentTimeMillis();
+	std::string large_value(4096, 'a');
+	EXPECT_TRUE(cache_store.put("small", "small value", now_millis, std::vector<u32>(1, 7)));
+	EXPECT_TRUE(cache_store.put("large", large_value, now_millis));
+	cache_store.close();
+
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	EXPECT_EQ(cache_store.getRecordCount(), 2);
+	EXPECT_TRUE(hasValue(cache_store, "small", "small value"));
+	// Compressed on the way in, inflated on the way out
+	EXPECT_TRUE(hasValue(cache_store, "large", large_value));
+	EXPECT_LT(cache_store.getLiveBytes(), cache_store.getRawBytes());
+	ASSERT_EQ(cache_store.getTaggedKeys(7).size(), 1);
+	EXPECT_EQ(cache_store.getTaggedKeys(7)[0], "small");
+
+	std::string value;
+	EXPECT_FALSE(cache_store.get("missing", 60, value));
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestRecoversFromDamagedRecord)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	double now_millis = modio::getCurrentTimeMillis();
+	cache_store.put("first", "value of the first record", now_millis);
+	cache_store.put("second", "value of the second record", now_millis);
+	cache_store.put("third", "value of the third record", now_millis);
+	cache_store.close();
+
+	// A torn write of the last record leaves bytes its CRC does not match
+	std::string content = readFile(TEST_CACHE_STORE_PATH);
+	size_t third_value = content.find("value of the third record");
+	ASSERT_NE(third_value, std::string::npos);
+	content[third_value] = 'X';
+	writeFile(TEST_CACHE_STORE_PATH, content);
+
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	EXPECT_EQ(cache_store.getRecordCount(), 2);
+	EXPECT_TRUE(hasValue(cache_store, "first", "value of the first record"));
+	EXPECT_TRUE(hasValue(cache_store, "second", "value of the second record"));
+	std::string value;
+	EXPECT_FALSE(cache_store.get("third", 60, value));
+
+	// The damaged tail is dropped for good, new records go where it was
+	EXPECT_TRUE(cache_store.put("fourth", "value of the fourth record", now_millis));
+	cache_store.close();
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	EXPECT_EQ(cache_store.getRecordCount(), 3);
+	EXPECT_TRUE(hasValue(cache_store, "fourth", "value of the fourth record"));
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestRecoversFromDamagedHeader)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	double now_millis = modio::getCurrentTimeMillis();
+	cache_store.put("first", "value of the first record", now_millis);
+	cache_store.close();
+
+	// Both header slots damaged, the store starts over empty instead of failing
+	std::string content = readFile(TEST_CACHE_STORE_PATH);
+	for (u32 i = 0; i < 128; i++)
+		content[i] = (char)0xFF;
+	writeFile(TEST_CACHE_STORE_PATH, content);
+
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	EXPECT_EQ(cache_store.getRecordCount(), 0);
+	EXPECT_TRUE(cache_store.put("first", "value of the first record", now_millis));
+	EXPECT_TRUE(hasValue(cache_store, "first", "value of the first record"));
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestTombstonesSurviveReopen)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	double now_millis = modio::getCurrentTimeMillis();
+	cache_store.put("first", "first value", now_millis, std::vector<u32>(1, 1));
+	cache_store.put("second", "second value", now_millis, std::vector<u32>(1, 2));
+	cache_store.put("third", "third value", now_millis, std::vector<u32>(1, 2));
+	cache_store.put("fourth", "fourth value", now_millis);
+
+	// second sits behind a live record and needs a tombstone, dropping first only moves
+	// the start of the log
+	cache_store.remove("second");
+	cache_store.remove("first");
+	cache_store.put("third", "third value, rewritten", now_millis, std::vector<u32>(1, 2));
+	cache_store.removeTagged(2);
+	cache_store.close();
+
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, MODIO_CACHE_STORE_MAX_BYTES));
+	EXPECT_EQ(cache_store.getRecordCount(), 1);
+	std::string value;
+	EXPECT_FALSE(cache_store.get("first", 60, value));
+	EXPECT_FALSE(cache_store.get("second", 60, value));
+	EXPECT_FALSE(cache_store.get("third", 60, value));
+	EXPECT_TRUE(hasValue(cache_store, "fourth", "fourth value"));
+	EXPECT_TRUE(cache_store.getTaggedKeys(2).empty());
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestEvictsLeastRecentlyReadWithinBudget)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	u64 max_bytes = 64 * 1024;
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, max_bytes));
+	double now_millis = modio::getCurrentTimeMillis();
+
+	std::string kept_value = getIncompressibleValue(4096, 0);
+	cache_store.put("kept", kept_value, now_millis);
+	for (u32 i = 1; i <= 64; i++)
+	{
+		// Read between the puts, so it always is the most recently used
+		EXPECT_TRUE(hasValue(cache_store, "kept", kept_value));
+		EXPECT_TRUE(cache_store.put("key" + modio::toString(i), getIncompressibleValue(4096, i), now_millis));
+		EXPECT_LE(cache_store.getLiveBytes(), max_bytes);
+	}
+
+	EXPECT_GT(cache_store.getEvictionCount(), 0);
+	EXPECT_TRUE(hasValue(cache_store, "kept", kept_value));
+	EXPECT_TRUE(hasValue(cache_store, "key64", getIncompressibleValue(4096, 64)));
+	std::string value;
+	EXPECT_FALSE(cache_store.get("key1", 60, value));
+
+	// Larger than the whole budget, never stored
+	EXPECT_FALSE(cache_store.put("huge", getIncompressibleValue((u32)max_bytes * 2, 1), now_millis));
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestFileStaysCappedNearBudget)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	u64 max_bytes = 256 * 1024;
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, max_bytes));
+	double now_millis = modio::getCurrentTimeMillis();
+
+	// Rewriting the same keys leaves dead records behind that only compaction reclaims
+	for (u32 i = 0; i < 2000; i++)
+	{
+		EXPECT_TRUE(cache_store.put("key" + modio::toString(i % 100), getIncompressibleValue(3000, i), now_millis));
+		EXPECT_LE(cache_store.getFileBytes(), 4096 + max_bytes + max_bytes / 4);
+		EXPECT_LE(cache_store.getLiveBytes(), max_bytes);
+	}
+	EXPECT_TRUE(hasValue(cache_store, "key99", getIncompressibleValue(3000, 1999)));
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
+
+TEST(CacheStore, TestCompactionKeepsLiveRecords)
+{
+	remove(TEST_CACHE_STORE_PATH);
+	u64 max_bytes = 1024 * 1024;
+	modio::CacheStore cache_store;
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, max_bytes));
+	double now_millis = modio::getCurrentTimeMillis();
+
+	for (u32 i = 0; i < 200; i++)
+		cache_store.put("key" + modio::toString(i), getIncompressibleValue(2000, i), now_millis, std::vector<u32>(1, i % 10));
+	// Every other record dropped, the dead space outweighs what is left
+	for (u32 i = 0; i < 200; i += 2)
+		cache_store.remove("key" + modio::toString(i));
+	for (u32 i = 1; i < 200; i += 4)
+		cache_store.put("key" + modio::toString(i), getIncompressibleValue(2000, i + 1000), now_millis, std::vector<u32>(1, i % 10));
+	EXPECT_TRUE(cache_store.needsCompaction());
+
+	u64 live_bytes = cache_store.getLiveBytes();
+	ASSERT_TRUE(cache_store.compact());
+	EXPECT_FALSE(cache_store.needsCompaction());
+	EXPECT_EQ(cache_store.getRecordCount(), 100);
+	EXPECT_EQ(cache_store.getLiveBytes(), live_bytes);
+
+	cache_store.close();
+	ASSERT_TRUE(cache_store.open(TEST_CACHE_STORE_PATH, max_bytes));
+	EXPECT_EQ(cache_store.getRecordCount(), 100);
+	for (u32 i = 1; i < 200; i += 2)
+	{
+		u32 seed = (i - 1) % 4 == 0 ? i + 1000 : i;
+		EXPECT_TRUE(hasValue(cache_store, "key" + modio::toString(i), getIncompressibleValue(2000, seed)));
+	}
+	EXPECT_EQ(cache_store.getTaggedKeys(1).size(), 20);
+	EXPECT_TRUE(cache_store.getTaggedKeys(0).empty());
+	cache_store.close();
+	remove(TEST_CACHE_STORE_PATH);
+}
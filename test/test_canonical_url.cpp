@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+#include "fake_transport.h"
+
+#define TEST_MODS_URL "https://api.mod.io/v1/games/7/mods"
+
+TEST(CanonicalUrl, TestReordersParameters)
+{
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?api_key=key&_limit=20&_offset=40"), TEST_MODS_URL "?_limit=20&_offset=40&api_key=key");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?_offset=40&api_key=key&_limit=20"), modio::getCanonicalUrl(TEST_MODS_URL "?_limit=20&api_key=key&_offset=40"));
+	// Repeated names keep every value, in a stable order
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?tags=b&tags=a"), TEST_MODS_URL "?tags=a&tags=b");
+	EXPECT_NE(modio::getCanonicalUrl(TEST_MODS_URL "?_limit=20"), modio::getCanonicalUrl(TEST_MODS_URL "?_limit=21"));
+}
+
+TEST(CanonicalUrl, TestSortsAndDeduplicatesInLists)
+{
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?id-in=3,1,2,1"), TEST_MODS_URL "?id-in=1,2,3");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?id-not-in=9,,7,9"), TEST_MODS_URL "?id-not-in=7,9");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?tags-in=Easy,Hard&id-in=2,1"), modio::getCanonicalUrl(TEST_MODS_URL "?id-in=1,2,2&tags-in=Hard,Easy"));
+	// Only lists are reordered, other values keep their commas where they are
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=b,a"), TEST_MODS_URL "?name=b,a");
+}
+
+TEST(CanonicalUrl, TestNormalizesPercentEncoding)
+{
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=a%20b"), TEST_MODS_URL "?name=a%20b");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=a b"), TEST_MODS_URL "?name=a%20b");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=%7e%41"), TEST_MODS_URL "?name=~A");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=%2f"), modio::getCanonicalUrl(TEST_MODS_URL "?name=%2F"));
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=%2F"), TEST_MODS_URL "?name=%2F");
+	// A lone percent sign is kept as a literal one
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?name=100%"), TEST_MODS_URL "?name=100%25");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?tags-in=B%2CA"), TEST_MODS_URL "?tags-in=A,B");
+}
+
+TEST(CanonicalUrl, TestDropsEmptyParameters)
+{
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?&_limit=20&&api_key=key&"), TEST_MODS_URL "?_limit=20&api_key=key");
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?"), TEST_MODS_URL "?");
+	// A name without a value is the same as one with an empty value
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL "?_q&_limit=20"), modio::getCanonicalUrl(TEST_MODS_URL "?_limit=20&_q="));
+}
+
+TEST(CanonicalUrl, TestKeepsUrlsWithoutQuery)
+{
+	EXPECT_EQ(modio::getCanonicalUrl(TEST_MODS_URL), TEST_MODS_URL);
+	EXPECT_EQ(modio::getCanonicalUrl(""), "");
+	EXPECT_EQ(modio::getCanonicalUrlHash(TEST_MODS_URL "?b=2&a=1"), modio::getCanonicalUrlHash(TEST_MODS_URL "?a=1&b=2"));
+}
+
+namespace
+{
+// Holds every GET until process() answers them all with mod_json
+class ModTransport : public FakeTransport
+{
+protected:
+	u32 reply(const std::string &, const std::string &, nlohmann::json &response_json)
+	{
+		response_json = mod_json;
+		return 200;
+	}
+};
+} // namespace
+
+TEST(CanonicalUrl, TestIdenticalGetsShareOneRequest)
+{
+	ModTransport transport;
+	modio::curlwrapper::setTransport(&transport);
+
+	std::vector<u32> answered_calls;
+	auto callback = [&answered_calls](u32 call_number, u32 response_code, nlohmann::json response_json) {
+		EXPECT_EQ(response_code, 200);
+		EXPECT_EQ(response_json, mod_json);
+		answered_calls.push_back(call_number);
+	};
+	std::vector<std::string> headers(1, "Accept: application/json");
+	modio::curlwrapper::get(1, TEST_MODS_URL "?_limit=20&api_key=key", headers, callback);
+	// The same request written differently joins the one in flight
+	modio::curlwrapper::get(2, TEST_MODS_URL "?api_key=key&_limit=20", headers, callback);
+	EXPECT_EQ(transport.getRequestCount("GET", TEST_MODS_URL), 1);
+	EXPECT_EQ(modio::curlwrapper::getPendingGetCount(), 1);
+
+	transport.process();
+	ASSERT_EQ(answered_calls.size(), 2);
+	EXPECT_EQ(answered_calls[0], 1);
+	EXPECT_EQ(answered_calls[1], 2);
+	EXPECT_EQ(modio::curlwrapper::getPendingGetCount(), 0);
+
+	// Once answered, the next identical call goes to the network again
+	modio::curlwrapper::get(3, TEST_MODS_URL "?_limit=20&api_key=key", headers, callback);
+	EXPECT_EQ(transport.getRequestCount("GET", TEST_MODS_URL), 2);
+	transport.process();
+	EXPECT_EQ(answered_calls.size(), 3);
+
+	modio::curlwrapper::setTransport(NULL);
+}
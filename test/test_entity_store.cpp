@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "EntityStore.h"
+#include "json_examples.h"
+#include "fake_transport.h"
+
+#define TEST_ENTITY_STORE_ROOT_DIRECTORY "test_entity_store_root/"
+
+static nlohmann::json getMod(u32 mod_id, u32 date_updated)
+{
+	nlohmann::json stored_mod_json = mod_json;
+	stored_mod_json["id"] = mod_id;
+	stored_mod_json["date_updated"] = date_updated;
+	return stored_mod_json;
+}
+
+TEST(EntityStore, TestOlderCopyNeverRollsBack)
+{
+	modio::EntityStore entity_store;
+	double now_millis = modio::getCurrentTimeMillis();
+	entity_store.putMod(getMod(1, 200), now_millis);
+
+	// A cached or delayed response carrying an older copy is ignored
+	entity_store.putMod(getMod(1, 100), now_millis);
+	nlohmann::json stored_mod_json;
+	ASSERT_TRUE(entity_store.getMod(1, 60, stored_mod_json));
+	EXPECT_EQ(stored_mod_json["date_updated"], 200);
+
+	// The same or a newer date_updated replaces it
+	nlohmann::json renamed_mod_json = getMod(1, 200);
+	renamed_mod_json["name"] = "Renamed";
+	entity_store.putMod(renamed_mod_json, now_millis);
+	ASSERT_TRUE(entity_store.getMod(1, 60, stored_mod_json));
+	EXPECT_EQ(stored_mod_json["name"], "Renamed");
+	entity_store.putMod(getMod(1, 300), now_millis);
+	ASSERT_TRUE(entity_store.getMod(1, 60, stored_mod_json));
+	EXPECT_EQ(stored_mod_json["date_updated"], 300);
+
+	// Events older than the stored copy leave it, newer ones drop it
+	entity_store.invalidateMod(1, 300);
+	EXPECT_TRUE(entity_store.getMod(1, 60, stored_mod_json));
+	entity_store.invalidateMod(1, 301);
+	EXPECT_FALSE(entity_store.getMod(1, 60, stored_mod_json));
+
+	// Too old to be served, but still not replaced by an older copy
+	entity_store.putMod(getMod(2, 200), now_millis - 120 * 1000.0);
+	EXPECT_FALSE(entity_store.getMod(2, 60, stored_mod_json));
+	EXPECT_TRUE(entity_store.getMod(2, 180, stored_mod_json));
+}
+
+TEST(EntityStore, TestLeastRecentlyUsedGoesFirst)
+{
+	modio::EntityTable entity_table(3);
+	double now_millis = modio::getCurrentTimeMillis();
+	for (u32 id = 1; id <= 3; id++)
+		entity_table.put(id, 100, now_millis, getMod(id, 100));
+
+	// Reading the oldest makes the second one the next to go
+	nlohmann::json entity_json;
+	ASSERT_TRUE(entity_table.get(1, 60, entity_json));
+	entity_table.put(4, 100, now_millis, getMod(4, 100));
+	EXPECT_EQ(entity_table.getCount(), 3);
+	EXPECT_TRUE(entity_table.get(1, 60, entity_json));
+	EXPECT_FALSE(entity_table.get(2, 60, entity_json));
+	EXPECT_TRUE(entity_table.get(3, 60, entity_json));
+	EXPECT_TRUE(entity_table.get(4, 60, entity_json));
+
+	// Putting an entity again also counts as a use
+	entity_table.put(1, 100, now_millis, getMod(1, 100));
+	entity_table.put(5, 100, now_millis, getMod(5, 100));
+	EXPECT_EQ(entity_table.getCount(), 3);
+	EXPECT_TRUE(entity_table.get(1, 60, entity_json));
+	EXPECT_FALSE(entity_table.get(3, 60, entity_json));
+}
+
+namespace
+{
+// Accepts every delete, anything else fails
+class DeleteTransport : public FakeTransport
+{
+protected:
+	u32 reply(const std::string &method, const std::string &, nlohmann::json &)
+	{
+		return method == "DELETE" ? 204 : 0;
+	}
+};
+
+u32 g_delete_mod_code = 0;
+
+void onDeleteMod(void *, ModioResponse response)
+{
+	g_delete_mod_code = response.code;
+}
+} // namespace
+
+TEST(EntityStore, TestDeletedModIsNotServed)
+{
+	DeleteTransport transport;
+	modio::removeDirectory(TEST_ENTITY_STORE_ROOT_DIRECTORY);
+	modio::createPath(TEST_ENTITY_STORE_ROOT_DIRECTORY);
+	modio::curlwrapper::setTransport(&transport);
+	modioInit(MODIO_ENVIRONMENT_TEST, 7, "key", TEST_ENTITY_STORE_ROOT_DIRECTORY);
+
+	modio::storeMod(getMod(1, 100));
+	nlohmann::json stored_mod_json;
+	ASSERT_TRUE(modio::getStoredMod(1, stored_mod_json));
+
+	modioDeleteMod(NULL, 1, &onDeleteMod);
+	modioProcess();
+	EXPECT_EQ(g_delete_mod_code, 204);
+	EXPECT_FALSE(modio::getStoredMod(1, stored_mod_json));
+
+	modioShutdown();
+	modio::curlwrapper::setTransport(NULL);
+	modio::removeDirectory(TEST_ENTITY_STORE_ROOT_DIRECTORY);
+}
@@ -0,0 +1,33 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+
+TEST(FilterCreator, TestJoinsInListsPerField)
+{
+	ModioFilterCreator filter;
+	modioInitFilter(&filter);
+	modioSetFilterLimit(&filter, 20);
+	modioAddFilterInField(&filter, "id", "3");
+	modioAddFilterInField(&filter, "id", "1");
+	modioAddFilterInField(&filter, "tags", "Easy");
+	modioAddFilterInField(&filter, "id", "2");
+	modioAddFilterNotInField(&filter, "id", "9");
+	modioAddFilterNotInField(&filter, "id", "8");
+
+	// Fields newest first, values in the order they were added
+	EXPECT_EQ(modio::getFilterString(&filter), "_limit=20&tags-in=Easy&id-in=3,1,2&id-not-in=9,8");
+	modioFreeFilter(&filter);
+}
+
+TEST(FilterCreator, TestLongInList)
+{
+	ModioFilterCreator filter;
+	modioInitFilter(&filter);
+	std::string expected_filter_string = "id-in=";
+	for (u32 i = 1; i <= 1000; i++)
+	{
+		modioAddFilterInField(&filter, "id", modio::toString(i).c_str());
+		expected_filter_string += (i > 1 ? "," : "") + modio::toString(i);
+	}
+	EXPECT_EQ(modio::getFilterString(&filter), expected_filter_string);
+	modioFreeFilter(&filter);
+}
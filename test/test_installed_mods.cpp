@@ -0,0 +1,160 @@
+#include <fstream>
+#ifndef _WIN32
+#include <utime.h>
+#endif
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "InstalledModRegistry.h"
+#include "fake_transport.h"
+
+#define TEST_INSTALLED_MODS_PATH "test_installed_mods.json"
+#define TEST_INSTALLED_ROOT_DIRECTORY "test_installed_root/"
+
+static modio::FileFingerprint getFingerprint(u64 modified_time)
+{
+	modio::FileFingerprint fingerprint = modio::FileFingerprint();
+	fingerprint.modified_time = modified_time;
+	fingerprint.size = 100;
+	return fingerprint;
+}
+
+TEST(InstalledModRegistry, TestFindReturnsFirstInstalled)
+{
+	modio::InstalledModRegistry registry;
+	registry.put(1, "mods/a/", 10, 100, getFingerprint(1));
+	registry.put(2, "mods/b/", 20, 200, getFingerprint(2));
+	registry.put(1, "mods/c/", 11, 101, getFingerprint(3));
+	EXPECT_EQ(registry.getCount(), 3);
+
+	ASSERT_NE(registry.find(1), (const modio::InstalledModRecord *)NULL);
+	EXPECT_EQ(registry.find(1)->path, "mods/a/");
+	EXPECT_EQ(registry.find(2)->modfile_id, 20);
+	EXPECT_EQ(registry.find(3), (const modio::InstalledModRecord *)NULL);
+
+	// The same path updates its record in place instead of adding one
+	registry.put(1, "mods/a/", 12, 102, getFingerprint(4));
+	EXPECT_EQ(registry.getCount(), 3);
+	EXPECT_EQ(registry.find(1)->modfile_id, 12);
+	EXPECT_EQ(registry.find(1)->date_updated, 102);
+	EXPECT_EQ(registry.getRecords()[0].path, "mods/a/");
+	EXPECT_EQ(registry.getRecords()[2].path, "mods/c/");
+
+	registry.clear();
+	EXPECT_EQ(registry.getCount(), 0);
+	EXPECT_EQ(registry.find(1), (const modio::InstalledModRecord *)NULL);
+}
+
+TEST(InstalledModRegistry, TestWritesOncePerBatch)
+{
+	remove(TEST_INSTALLED_MODS_PATH);
+	modio::InstalledModRegistry registry;
+	EXPECT_FALSE(registry.isDirty());
+
+	// Many installs only mark the registry, nothing is written until write()
+	for (u32 i = 1; i <= 100; i++)
+		registry.put(i, "mods/" + modio::toString(i) + "/", i * 10, i * 100, getFingerprint(i));
+	EXPECT_TRUE(registry.isDirty());
+	EXPECT_FALSE(modio::fileExists(TEST_INSTALLED_MODS_PATH));
+
+	registry.write(TEST_INSTALLED_MODS_PATH);
+	EXPECT_FALSE(registry.isDirty());
+	nlohmann::json installed_mods_json = modio::openJson(TEST_INSTALLED_MODS_PATH);
+	ASSERT_EQ(installed_mods_json.size(), 100);
+	EXPECT_EQ(installed_mods_json[0], modio::toJson(registry.getRecords()[0]));
+	EXPECT_EQ(installed_mods_json[99]["mod_id"], 100);
+	EXPECT_EQ(installed_mods_json[99]["fingerprint"]["modified_time"], 100);
+
+	// Clearing an empty registry leaves nothing to write
+	modio::InstalledModRegistry empty_registry;
+	empty_registry.clear();
+	EXPECT_FALSE(empty_registry.isDirty());
+	registry.clear();
+	EXPECT_TRUE(registry.isDirty());
+	remove(TEST_INSTALLED_MODS_PATH);
+}
+
+TEST(InstalledModRegistry, TestUnknownFingerprintIsNotStored)
+{
+	modio::InstalledModRegistry registry;
+	registry.put(1, "mods/a/", 10, 100, modio::FileFingerprint());
+	EXPECT_FALSE(modio::hasKey(modio::toJson(registry.getRecords()[0]), "fingerprint"));
+}
+
+static void writeFile(const std::string &path, const std::string &content)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(content.data(), content.size());
+}
+
+TEST(InstalledModRegistry, TestChangedFileChangesFingerprint)
+{
+	modio::removeDirectory(TEST_INSTALLED_ROOT_DIRECTORY);
+	modio::createPath(TEST_INSTALLED_ROOT_DIRECTORY);
+	std::string file_path = std::string(TEST_INSTALLED_ROOT_DIRECTORY) + "modio.json";
+	writeFile(file_path, "{\"id\": 1}");
+	modio::FileFingerprint fingerprint;
+	ASSERT_TRUE(modio::getFileFingerprint(TEST_INSTALLED_ROOT_DIRECTORY, "modio.json", fingerprint));
+	modio::FileFingerprint unchanged_fingerprint;
+	ASSERT_TRUE(modio::getFileFingerprint(TEST_INSTALLED_ROOT_DIRECTORY, "modio.json", unchanged_fingerprint));
+	EXPECT_EQ(fingerprint, unchanged_fingerprint);
+
+	modio::FileFingerprint changed_fingerprint;
+	writeFile(file_path, "{\"id\": 12}");
+	ASSERT_TRUE(modio::getFileFingerprint(TEST_INSTALLED_ROOT_DIRECTORY, "modio.json", changed_fingerprint));
+	EXPECT_NE(fingerprint, changed_fingerprint);
+
+#ifndef _WIN32
+	// Same size, only the modification time tells them apart
+	writeFile(file_path, "{\"id\": 13}");
+	struct utimbuf times;
+	times.actime = 1000000000;
+	times.modtime = 1000000000;
+	ASSERT_EQ(utime(file_path.c_str(), &times), 0);
+	modio::FileFingerprint rewritten_fingerprint;
+	ASSERT_TRUE(modio::getFileFingerprint(TEST_INSTALLED_ROOT_DIRECTORY, "modio.json", rewritten_fingerprint));
+	EXPECT_EQ(rewritten_fingerprint.size, changed_fingerprint.size);
+	EXPECT_NE(rewritten_fingerprint, changed_fingerprint);
+#endif
+
+	EXPECT_FALSE(modio::getFileFingerprint(TEST_INSTALLED_ROOT_DIRECTORY, "missing.json", fingerprint));
+	modio::removeDirectory(TEST_INSTALLED_ROOT_DIRECTORY);
+}
+
+TEST(InstalledModRegistry, TestShutdownWritesAndClears)
+{
+	// Fails every call, modioInit runs without a server
+	FakeTransport transport;
+	modio::removeDirectory(TEST_INSTALLED_ROOT_DIRECTORY);
+	std::string mod_path = std::string(TEST_INSTALLED_ROOT_DIRECTORY) + "mods/1/";
+	modio::createPath(mod_path);
+	modio::curlwrapper::setTransport(&transport);
+	modioInit(MODIO_ENVIRONMENT_TEST, 7, "key", TEST_INSTALLED_ROOT_DIRECTORY);
+
+	modio::writeJson(mod_path + "modio.json", nlohmann::json::parse("{\"id\": 1}"));
+	modio::addToInstalledModsJson(1, mod_path, 10, 100);
+	ASSERT_NE(modio::findInstalledMod(1), (const modio::InstalledModRecord *)NULL);
+	std::string installed_mods_path = modio::getModIODirectory() + "installed_mods.json";
+
+	// The pending install is written out and nothing is left for the next modioInit
+	modioShutdown();
+	EXPECT_EQ(modio::findInstalledMod(1), (const modio::InstalledModRecord *)NULL);
+	EXPECT_TRUE(modio::getInstalledMods().empty());
+	nlohmann::json installed_mods_json = modio::openJson(installed_mods_path);
+	ASSERT_EQ(installed_mods_json.size(), 1);
+	EXPECT_EQ(installed_mods_json[0]["mod_id"], 1);
+
+	// Loaded back from the file by the next initialization
+	modioInit(MODIO_ENVIRONMENT_TEST, 7, "key", TEST_INSTALLED_ROOT_DIRECTORY);
+	ASSERT_NE(modio::findInstalledMod(1), (const modio::InstalledModRecord *)NULL);
+	EXPECT_EQ(modio::findInstalledMod(1)->modfile_id, 10);
+	modioShutdown();
+
+	// A modio.json changed since, here replaced by another mod, is read again instead of
+	// trusted by its stored fingerprint
+	writeFile(mod_path + "modio.json", "{\"id\": 2, \"name\": \"Another mod\"}");
+	modioInit(MODIO_ENVIRONMENT_TEST, 7, "key", TEST_INSTALLED_ROOT_DIRECTORY);
+	EXPECT_EQ(modio::findInstalledMod(1), (const modio::InstalledModRecord *)NULL);
+	modioShutdown();
+	modio::curlwrapper::setTransport(NULL);
+	modio::removeDirectory(TEST_INSTALLED_ROOT_DIRECTORY);
+}
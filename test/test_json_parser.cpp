@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+#include "JsonParser.h"
+
+static std::vector<std::string> getExampleDocuments()
+{
+	std::vector<nlohmann::json> examples = {message_json, logo_json, error_json, icon_json, header_image_json, avatar_json, image_json, event_json, comment_json, mod_dependency_json, game_tag_option_json, modfile_json, filehash_json, download_json, mod_media_json, mod_tag_json, metadata_kvp_json, rating_json, stats_json, team_member_json, user_json, game_json, mod_json};
+	std::vector<std::string> documents;
+	for (auto &example : examples)
+	{
+		documents.push_back(example.dump());
+		documents.push_back(example.dump(2));
+		documents.push_back(example.dump(-1, ' ', true));
+	}
+	return documents;
+}
+
+static std::string getNestedDocument(u32 depth)
+{
+	return std::string(depth, '[') + "1" + std::string(depth, ']');
+}
+
+// Whatever a backend takes must equal the nlohmann parse, and what nlohmann rejects it
+// must reject too. Documents marked as taken may not be left to the fallback.
+static void expectSameAsNlohmann(const std::string &document, bool taken)
+{
+	nlohmann::json expected_json;
+	bool expected_valid = true;
+	try
+	{
+		expected_json = nlohmann::json::parse(document);
+	}
+	catch (nlohmann::json::exception &)
+	{
+		expected_valid = false;
+	}
+
+	for (u32 backend = MODIO_JSON_BACKEND_SCALAR; backend <= MODIO_JSON_BACKEND_AVX2; backend++)
+	{
+		modio::setJsonBackend(backend);
+		SCOPED_TRACE(std::string(modio::getJsonBackendName(modio::getJsonBackend())) + ": " + document.substr(0, 80));
+
+		nlohmann::json parsed_json;
+		bool parsed = modio::parseJson(document.data(), document.size(), parsed_json);
+		if (!expected_valid)
+		{
+			EXPECT_FALSE(parsed);
+			continue;
+		}
+		if (taken)
+		{
+			EXPECT_TRUE(parsed);
+		}
+		if (parsed)
+		{
+			EXPECT_EQ(parsed_json, expected_json);
+			// Also tells integers, unsigned and floats apart
+			EXPECT_EQ(parsed_json.dump(), expected_json.dump());
+		}
+	}
+}
+
+class JsonParser : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		backend = modio::getJsonBackend();
+	}
+
+	void TearDown() override
+	{
+		modio::setJsonBackend(backend);
+	}
+
+	u32 backend;
+};
+
+TEST_F(JsonParser, TestExamplesMatchNlohmann)
+{
+	for (auto &document : getExampleDocuments())
+		expectSameAsNlohmann(document, true);
+}
+
+TEST_F(JsonParser, TestTruncatedExamplesAreRejected)
+{
+	// Cut at every byte, across the 64 byte blocks of the first stage
+	std::string document = mod_json.dump();
+	for (size_t size = 0; size < document.size(); size++)
+		expectSameAsNlohmann(document.substr(0, size), false);
+}
+
+TEST_F(JsonParser, TestDeepNesting)
+{
+	expectSameAsNlohmann(getNestedDocument(64), true);
+	expectSameAsNlohmann(getNestedDocument(MODIO_JSON_MAX_DEPTH - 1), true);
+	// Left to nlohmann past the limit, never parsed wrong
+	expectSameAsNlohmann(getNestedDocument(MODIO_JSON_MAX_DEPTH + 16), false);
+	expectSameAsNlohmann(std::string(64, '[') + "1" + std::string(63, ']'), false);
+	expectSameAsNlohmann(std::string(64, '{') + std::string(64, '}'), false);
+	expectSameAsNlohmann("{\"a\":{\"b\":{\"c\":[{\"d\":[[],{}]}]}}}", true);
+}
+
+TEST_F(JsonParser, TestEscapes)
+{
+	const char *documents[] = {
+			"\"\\u0041\\u00e9\\ud83d\\ude00\"", "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"", "\"\\u0000\"", "{\"a\\\"b\":\"c\\\\\"}",
+			"\"a\\\\\"", "\"a\\\"b\"", "[\"a\\\\\",\"b\"]"};
+	for (const char *document : documents)
+		expectSameAsNlohmann(document, true);
+
+	const char *malformed_documents[] = {"\"\\x\"", "\"\\ud83d\"", "\"\\ude00\"", "\"\\u12\"", "\"\\\"", "\"\t\""};
+	for (const char *document : malformed_documents)
+		expectSameAsNlohmann(document, false);
+
+	// Escaped quotes and backslash runs across the block boundaries
+	for (u32 size = 50; size < 140; size++)
+	{
+		expectSameAsNlohmann("[\"" + std::string(size, 'a') + "\\\\\\\"\\\\\",1]", true);
+		expectSameAsNlohmann("[\"" + std::string(size, '\\') + "\",1]", false);
+	}
+}
+
+TEST_F(JsonParser, TestUtf8)
+{
+	expectSameAsNlohmann("\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"", true);
+	const char *malformed_documents[] = {"\"\xc3\"", "\"\xc3\x28\"", "\"\xed\xa0\x80\"", "\"\xc0\xaf\"", "\"\xf8\x88\x80\x80\x80\"", "\"\xff\"", "\xef\xbb\xbf{}"};
+	for (const char *document : malformed_documents)
+		expectSameAsNlohmann(document, false);
+}
+
+TEST_F(JsonParser, TestNumbers)
+{
+	const char *documents[] = {
+			"0", "1", "-1", "-0", "0.5", "-0.0", "1e5", "1E-5", "1.5e+3", "4294967295", "4294967296",
+			"9223372036854775807", "-9223372036854775808", "-9223372036854775809", "18446744073709551615",
+			"18446744073709551616", "1e308", "2.2250738585072014e-308", "[1,-2,3.25,4e2]"};
+	for (const char *document : documents)
+		expectSameAsNlohmann(document, true);
+
+	const char *malformed_documents[] = {"01", "1.", "-", "--1", "1e", "+1", ".5", "[-]", "[0e]", "0x10", "1e999"};
+	for (const char *document : malformed_documents)
+		expectSameAsNlohmann(document, false);
+}
+
+TEST_F(JsonParser, TestMalformedDocuments)
+{
+	const char *malformed_documents[] = {
+			"", " ", "tru", "nul", "[1,]", "{\"a\":1,}", "{\"a\" 1}", "[1 2]", "{\"a\":1}{}", "\"abc",
+			"[\"a\"\"b\"]", "[1]x", "{1:2}", "{\"a\":}", "]", "}", "[", "{"};
+	for (const char *document : malformed_documents)
+		expectSameAsNlohmann(document, false);
+
+	const char *documents[] = {"null", "true ", "  [ 1 , 2 ]  ", "[]", "{}", "{\"a\":1,\"a\":2}", "\"\""};
+	for (const char *document : documents)
+		expectSameAsNlohmann(document, true);
+}
+
+TEST_F(JsonParser, TestMutatedExamples)
+{
+	// Seeded, so a failure shows up the same on every run
+	std::vector<std::string> documents = getExampleDocuments();
+	const char alphabet[] = "{}[]:,\"\\ \n0123456789-+.eEtrufalsn\x01\xc3\xa9u";
+	u32 state = 7;
+	for (u32 i = 0; i < 2000; i++)
+	{
+		std::string document = documents[i % documents.size()];
+		for (u32 edit = 0; edit < 3 && !document.empty(); edit++)
+		{
+			state = state * 1103515245u + 12345u;
+			size_t position = (state >> 8) % document.size();
+			char character = alphabet[(state >> 4) % (sizeof(alphabet) - 1)];
+			if (state % 3 == 0)
+				document[position] = character;
+			else if (state % 3 == 1)
+				document.insert(document.begin() + position, character);
+			else
+				document.erase(position, 1);
+		}
+		expectSameAsNlohmann(document, false);
+	}
+}
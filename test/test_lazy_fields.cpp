@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+#include "LazyFields.h"
+
+static std::shared_ptr<const nlohmann::json> getListing(u32 first_mod_id, u32 mods_size)
+{
+	nlohmann::json listing_json;
+	listing_json["data"] = nlohmann::json::array();
+	for (u32 i = 0; i < mods_size; i++)
+	{
+		nlohmann::json listed_mod_json = mod_json;
+		listed_mod_json["id"] = first_mod_id + i;
+		listing_json["data"].push_back(listed_mod_json);
+	}
+	return std::make_shared<const nlohmann::json>(listing_json);
+}
+
+TEST(LazyFields, TestMediaOutlivesEvictionUntilProcess)
+{
+	modio::clearLazyFields();
+	modio::retainLazyResponse(getListing(1, 1));
+	const ModioMedia *media = modio::getLazyMedia(1);
+	ASSERT_NE(media, (const ModioMedia *)NULL);
+	ASSERT_EQ(media->images_size, mod_json["media"]["images"].size());
+	std::string image_filename = mod_json["media"]["images"][0]["filename"];
+
+	// A prefetch in the same process call pushes the listing out
+	for (u32 i = 0; i < MODIO_LAZY_FIELDS_MAX_RESPONSES; i++)
+		modio::retainLazyResponse(getListing(100 + i, 1));
+	EXPECT_EQ(modio::findLazyMod(1), (const nlohmann::json *)NULL);
+	EXPECT_EQ(modio::getLazyMedia(1), (const ModioMedia *)NULL);
+
+	// Still readable until the next process call frees it
+	EXPECT_EQ(media->images_size, mod_json["media"]["images"].size());
+	EXPECT_STREQ(media->images_array[0].filename, image_filename.c_str());
+	modio::processLazyFields();
+	modio::clearLazyFields();
+}
+
+TEST(LazyFields, TestNewerCopyKeepsHandedOutMedia)
+{
+	modio::clearLazyFields();
+	modio::retainLazyResponse(getListing(1, 2));
+	const ModioMedia *media = modio::getLazyMedia(2);
+	ASSERT_NE(media, (const ModioMedia *)NULL);
+
+	// The mod moves to the newer listing, the media from the old one stays readable
+	modio::retainLazyResponse(getListing(2, 1));
+	EXPECT_EQ(media->images_size, mod_json["media"]["images"].size());
+	const ModioMedia *newer_media = modio::getLazyMedia(2);
+	ASSERT_NE(newer_media, (const ModioMedia *)NULL);
+	EXPECT_EQ(newer_media->images_size, media->images_size);
+
+	modio::processLazyFields();
+	EXPECT_EQ(modio::getLazyMedia(2), newer_media);
+	modio::clearLazyFields();
+}
+
+TEST(LazyFields, TestRetainedAgainMovesToFront)
+{
+	modio::clearLazyFields();
+	std::shared_ptr<const nlohmann::json> first_listing = getListing(1, 2);
+	modio::retainLazyResponse(first_listing);
+	const ModioMedia *media = modio::getLazyMedia(1);
+	ASSERT_NE(media, (const ModioMedia *)NULL);
+
+	// Paging on, then back to the first page served from the response cache
+	for (u32 i = 1; i < MODIO_LAZY_FIELDS_MAX_RESPONSES; i++)
+		modio::retainLazyResponse(getListing(100 + i, 1));
+	modio::retainLazyResponse(first_listing);
+	EXPECT_NE(modio::findLazyMod(1), (const nlohmann::json *)NULL);
+	EXPECT_EQ(modio::getLazyMedia(1), media);
+
+	// The copy listed earlier ageing out leaves the mods of the first page alone
+	modio::retainLazyResponse(getListing(200, 1));
+	modio::processLazyFields();
+	EXPECT_NE(modio::findLazyMod(1), (const nlohmann::json *)NULL);
+	EXPECT_NE(modio::findLazyMod(2), (const nlohmann::json *)NULL);
+	EXPECT_EQ(modio::getLazyMedia(1), media);
+	EXPECT_EQ(modio::findLazyMod(101), (const nlohmann::json *)NULL);
+
+	// Still released once it is the oldest again
+	for (u32 i = 1; i < MODIO_LAZY_FIELDS_MAX_RESPONSES; i++)
+		modio::retainLazyResponse(getListing(300 + i, 1));
+	EXPECT_EQ(modio::findLazyMod(1), (const nlohmann::json *)NULL);
+	modio::clearLazyFields();
+}
@@ -0,0 +1,50 @@
+#include <fstream>
+#include <thread>
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "Logger.h"
+
+#define TEST_LOG_PATH "test_logger.log"
+
+static u32 countLines(const std::string &path)
+{
+	std::ifstream file(path);
+	std::string line;
+	u32 count = 0;
+	while (std::getline(file, line))
+		count++;
+	return count;
+}
+
+TEST(Logger, TestStopKeepsEveryQueuedLine)
+{
+	for (u32 round = 0; round < 20; round++)
+	{
+		remove(TEST_LOG_PATH);
+		modio::startLogger(TEST_LOG_PATH);
+
+		// Producers race stopLogger, each line is either queued and written by it or refused
+		std::atomic<u32> queued_lines(0);
+		std::vector<std::thread> producers;
+		for (u32 i = 0; i < 4; i++)
+		{
+			producers.push_back(std::thread([&queued_lines]() {
+				for (u32 j = 0; j < 200; j++)
+				{
+					if (modio::queueLogLine(MODIO_DEBUGLEVEL_LOG, "line"))
+						queued_lines++;
+				}
+			}));
+		}
+		modio::stopLogger();
+		for (auto &producer : producers)
+			producer.join();
+
+		EXPECT_EQ(countLines(TEST_LOG_PATH), queued_lines.load());
+		// Nothing is left behind for the next start
+		modio::startLogger(TEST_LOG_PATH);
+		modio::stopLogger();
+		EXPECT_EQ(countLines(TEST_LOG_PATH), queued_lines.load());
+	}
+	remove(TEST_LOG_PATH);
+}
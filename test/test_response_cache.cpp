@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "ResponseCache.h"
+#include "json_examples.h"
+
+TEST(ResponseCache, TestImagesAndResponsesShareTheBudget)
+{
+	modio::ResponseCache response_cache(4096);
+	double now_millis = modio::getCurrentTimeMillis();
+	std::shared_ptr<const std::string> image = std::make_shared<const std::string>(std::string("\0\1\2\3", 4) + std::string(2000, 'x'));
+	response_cache.addImage("mods:url", now_millis, image);
+	response_cache.add("url", now_millis, std::make_shared<const nlohmann::json>(mod_json), 1000);
+	EXPECT_EQ(response_cache.getBytes(), image->size() + 1000);
+
+	// Handed out as stored, raw bytes included
+	EXPECT_EQ(response_cache.getImage("mods:url", 60), image);
+	ASSERT_TRUE(response_cache.get("url", 60) != NULL);
+	EXPECT_EQ(*response_cache.get("url", 60), mod_json);
+
+	// Each entry only answers for its own kind
+	EXPECT_TRUE(response_cache.get("mods:url", 60) == NULL);
+	EXPECT_TRUE(response_cache.getImage("url", 60) == NULL);
+
+	// The image was read last, the response goes first
+	response_cache.getImage("mods:url", 60);
+	response_cache.addImage("other", now_millis, std::make_shared<const std::string>(2000, 'y'));
+	EXPECT_TRUE(response_cache.get("url", 60) == NULL);
+	EXPECT_TRUE(response_cache.getImage("mods:url", 60) != NULL);
+	EXPECT_LE(response_cache.getBytes(), 4096);
+}
+
+TEST(ResponseCache, TestTouchKeepsTrackedSize)
+{
+	modio::ResponseCache response_cache(4096);
+	double old_millis = modio::getCurrentTimeMillis() - 120 * 1000.0;
+	response_cache.add("url", old_millis, std::make_shared<const nlohmann::json>(mod_json), 1000);
+	response_cache.addImage("mods:url", old_millis, std::make_shared<const std::string>(500, 'x'));
+	EXPECT_TRUE(response_cache.get("url", 60) == NULL);
+
+	// A revalidated entry is fresh again without being measured again
+	response_cache.touch("url", modio::getCurrentTimeMillis());
+	response_cache.touch("mods:url", modio::getCurrentTimeMillis());
+	response_cache.touch("missing", modio::getCurrentTimeMillis());
+	EXPECT_TRUE(response_cache.get("url", 60) != NULL);
+	EXPECT_TRUE(response_cache.getImage("mods:url", 60) != NULL);
+	EXPECT_EQ(response_cache.getBytes(), 1500);
+}
+
+TEST(ResponseCache, TestRemovesTaggedEntries)
+{
+	modio::ResponseCache response_cache(4096);
+	double now_millis = modio::getCurrentTimeMillis();
+	response_cache.add("listing", now_millis, std::make_shared<const nlohmann::json>(mod_json), 1000, std::vector<u32>{1, 2});
+	response_cache.addImage("mods:listing", now_millis, std::make_shared<const std::string>(500, 'x'), std::vector<u32>{1, 2});
+	response_cache.add("other", now_millis, std::make_shared<const nlohmann::json>(mod_json), 1000, std::vector<u32>{3});
+
+	response_cache.removeTagged(2);
+	EXPECT_TRUE(response_cache.get("listing", 60) == NULL);
+	EXPECT_TRUE(response_cache.getImage("mods:listing", 60) == NULL);
+	EXPECT_TRUE(response_cache.get("other", 60) != NULL);
+	EXPECT_EQ(response_cache.getBytes(), 1000);
+
+	// Replaced or evicted entries leave no tags behind for a later url
+	response_cache.add("other", now_millis, std::make_shared<const nlohmann::json>(mod_json), 1000);
+	response_cache.removeTagged(3);
+	EXPECT_TRUE(response_cache.get("other", 60) != NULL);
+	response_cache.add("big", now_millis, std::make_shared<const nlohmann::json>(mod_json), 4000, std::vector<u32>{4});
+	EXPECT_TRUE(response_cache.get("other", 60) == NULL);
+	response_cache.removeTagged(4);
+	EXPECT_EQ(response_cache.getBytes(), 0);
+}
+
+TEST(ResponseCache, TestInvalidatedModLeavesMemoryWithoutStore)
+{
+	// No modioInit, cache.bin is not open and only the memory tier holds the response
+	modio::closeCacheStore();
+	std::string url = "https://api.test.mod.io/v1/games/7/mods?id-in=2";
+	nlohmann::json listing_json;
+	listing_json["data"] = nlohmann::json::array({mod_json});
+	modio::addCallToCache(url, listing_json);
+	std::shared_ptr<const nlohmann::json> response_json;
+	ASSERT_TRUE(modio::getCallFromCache(url, 60, response_json));
+
+	modio::invalidateCachedMod(mod_json["id"]);
+	EXPECT_FALSE(modio::getCallFromCache(url, 60, response_json));
+
+	// Patching drops it from memory the same way
+	modio::addCallToCache(url, listing_json);
+	modio::patchCachedMod(mod_json);
+	EXPECT_FALSE(modio::getCallFromCache(url, 60, response_json));
+	modio::closeCacheStore();
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+#include "c++/schemas/Mod.h"
+#include "c++/schemas/Game.h"
+#include "c++/schemas/ModEvent.h"
+#include "c++/schemas/Logo.h"
+
+TEST(SchemaClass, TestModFromStructMatchesJson)
+{
+	ModioMod modio_mod;
+	modioInitMod(&modio_mod, mod_json);
+	modio::Mod struct_mod;
+	struct_mod.initialize(modio_mod);
+	modioFreeMod(&modio_mod);
+
+	modio::Mod json_mod;
+	json_mod.initialize(mod_json);
+
+	EXPECT_EQ(json_mod.id, 2);
+	EXPECT_EQ(json_mod.name, "Rogue Knight HD Pack");
+	EXPECT_EQ(json_mod.modfile.filehash.md5, mod_json["modfile"]["filehash"]["md5"].get<std::string>());
+	EXPECT_EQ(json_mod.tags.size(), mod_json["tags"].size());
+	EXPECT_EQ(json_mod.metadata_kvps.size(), mod_json["metadata_kvp"].size());
+	EXPECT_EQ(json_mod.media.images.size(), mod_json["media"]["images"].size());
+	EXPECT_EQ(modio::toJson(struct_mod), modio::toJson(json_mod));
+}
+
+TEST(SchemaClass, TestGameFromStructKeepsArrays)
+{
+	ModioGame modio_game;
+	modioInitGame(&modio_game, game_json);
+	modio::Game game;
+	game.initialize(modio_game);
+	modioFreeGame(&modio_game);
+
+	EXPECT_EQ(game.name, game_json["name"].get<std::string>());
+	EXPECT_EQ(game.submitted_by.avatar.filename, game_json["submitted_by"]["avatar"]["filename"].get<std::string>());
+	ASSERT_EQ(game.game_tag_options.size(), game_json["tag_options"].size());
+	for (size_t i = 0; i < game.game_tag_options.size(); i++)
+		EXPECT_EQ(game.game_tag_options[i].tags, game_json["tag_options"][i]["tags"].get<std::vector<std::string>>());
+	EXPECT_EQ(modio::toJson(game)["tag_options"].size(), game_json["tag_options"].size());
+}
+
+TEST(SchemaClass, TestEnumRoundTripsByName)
+{
+	ModioModEvent modio_event;
+	modioInitModEvent(&modio_event, event_json);
+	modio::ModEvent event;
+	event.initialize(modio_event);
+	modioFreeModEvent(&modio_event);
+
+	EXPECT_EQ(event.event_type, MODIO_EVENT_MODFILE_CHANGED);
+	EXPECT_EQ(modio::toJson(event)["event_type"], event_json["event_type"]);
+}
+
+TEST(SchemaClass, TestReinitializeResetsMissingFields)
+{
+	modio::Logo logo;
+	logo.initialize(logo_json);
+	EXPECT_EQ(logo.filename, "modio-color-dark.png");
+
+	// Null and missing fields read as empty, nothing is kept from before
+	nlohmann::json partial_logo_json = R"({"filename": null, "original": "original.png"})"_json;
+	logo.initialize(partial_logo_json);
+	EXPECT_EQ(logo.filename, "");
+	EXPECT_EQ(logo.original, "original.png");
+	EXPECT_EQ(logo.thumb_320x180, "");
+}
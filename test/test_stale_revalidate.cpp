@@ -0,0 +1,124 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+#include "fake_transport.h"
+
+#define TEST_STALE_ROOT_DIRECTORY "test_stale_root/"
+
+namespace
+{
+// Answers every listing with page_json, anything else fails
+class ListingTransport : public FakeTransport
+{
+public:
+	nlohmann::json page_json;
+
+protected:
+	u32 reply(const std::string &method, const std::string &url, nlohmann::json &response_json)
+	{
+		if (method == "GET" && url.find("/mods?") != std::string::npos)
+		{
+			response_json = page_json;
+			return 200;
+		}
+		response_json = error_json;
+		return 404;
+	}
+};
+
+struct ListingResult
+{
+	u32 code;
+	bool cached;
+	bool stale;
+	u32 mods_size;
+};
+
+std::vector<ListingResult> g_listing_results;
+
+void onGetAllMods(void *, ModioResponse response, ModioMod *, u32 mods_size)
+{
+	ListingResult result;
+	result.code = response.code;
+	result.cached = response.result_cached;
+	result.stale = response.result_stale;
+	result.mods_size = mods_size;
+	g_listing_results.push_back(result);
+}
+
+void getAllMods(ModioFilterCreator &filter, size_t expected_results)
+{
+	modioGetAllMods(NULL, filter, &onGetAllMods);
+	for (u32 i = 0; i < 100 && g_listing_results.size() < expected_results; i++)
+		modioProcess();
+}
+} // namespace
+
+static void checkStaleThenRevalidate(u32 binary_cache)
+{
+	ListingTransport transport;
+	transport.page_json["data"] = nlohmann::json::array({mod_json});
+	transport.page_json["result_count"] = 1;
+	transport.page_json["result_offset"] = 0;
+	transport.page_json["result_limit"] = 100;
+	transport.page_json["result_total"] = 1;
+
+	modio::removeDirectory(TEST_STALE_ROOT_DIRECTORY);
+	modio::curlwrapper::setTransport(&transport);
+	modioInit(MODIO_ENVIRONMENT_TEST, 7, "key", TEST_STALE_ROOT_DIRECTORY);
+	modioSetBinaryCacheConfig(binary_cache);
+	g_listing_results.clear();
+
+	ModioFilterCreator filter;
+	modioInitFilter(&filter);
+	modioSetFilterCacheMaxAgeSeconds(&filter, 0);
+	modioSetFilterCachePolicy(&filter, MODIO_CACHE_POLICY_STALE_WHILE_REVALIDATE);
+
+	getAllMods(filter, 1);
+	ASSERT_EQ(g_listing_results.size(), 1);
+	EXPECT_EQ(g_listing_results[0].code, 200);
+	EXPECT_FALSE(g_listing_results[0].stale);
+	EXPECT_EQ(transport.getRequestCount("GET", "/mods?"), 1);
+
+	// Older than the max age, the cached listing goes out marked stale and the same page
+	// coming back from the server is reported as not modified
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	getAllMods(filter, 3);
+	ASSERT_EQ(g_listing_results.size(), 3);
+	EXPECT_EQ(g_listing_results[1].code, 200);
+	EXPECT_TRUE(g_listing_results[1].cached);
+	EXPECT_TRUE(g_listing_results[1].stale);
+	EXPECT_EQ(g_listing_results[1].mods_size, 1);
+	EXPECT_EQ(g_listing_results[2].code, 304);
+	EXPECT_FALSE(g_listing_results[2].stale);
+	EXPECT_EQ(transport.getRequestCount("GET", "/mods?"), 2);
+
+	// A changed page is delivered in full after the stale one
+	nlohmann::json second_mod_json = mod_json;
+	second_mod_json["id"] = 3;
+	transport.page_json["data"].push_back(second_mod_json);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	getAllMods(filter, 5);
+	ASSERT_EQ(g_listing_results.size(), 5);
+	EXPECT_TRUE(g_listing_results[3].stale);
+	EXPECT_EQ(g_listing_results[3].mods_size, 1);
+	EXPECT_EQ(g_listing_results[4].code, 200);
+	EXPECT_FALSE(g_listing_results[4].stale);
+	EXPECT_EQ(g_listing_results[4].mods_size, 2);
+
+	modioFreeFilter(&filter);
+	modioShutdown();
+	modio::curlwrapper::setTransport(NULL);
+	modio::removeDirectory(TEST_STALE_ROOT_DIRECTORY);
+}
+
+TEST(StaleWhileRevalidate, TestHashMatchIsNotModified)
+{
+	checkStaleThenRevalidate(MODIO_BINARY_CACHE_DISABLED);
+}
+
+TEST(StaleWhileRevalidate, TestHashMatchIsNotModifiedFromBinaryCache)
+{
+	checkStaleThenRevalidate(MODIO_BINARY_CACHE_ENABLED);
+}
@@ -0,0 +1,41 @@
+#include <fstream>
+#include <iterator>
+#include "gtest/gtest.h"
+#include "modio.h"
+
+#define TEST_TRACE_PATH "test_trace.json"
+
+TEST(Tracer, TestWritesFullIdsAndArgs)
+{
+	modio::startTracing(16);
+	modio::TraceArgs trace_args;
+	trace_args.url = "https://api.mod.io/v1/games/7/mods";
+	trace_args.has_response_code = true;
+	trace_args.response_code = 0;
+	trace_args.mod_id = 42;
+	modio::addAsyncTraceSpan("request", "request", 0x100000002ull, 10, 20, trace_args);
+	modio::addTraceSpan("parse", "cache", 30, 35);
+	modio::stopTracing();
+	ASSERT_TRUE(modio::writeTrace(TEST_TRACE_PATH));
+
+	std::ifstream trace_file(TEST_TRACE_PATH);
+	nlohmann::json trace_json = nlohmann::json::parse(std::string((std::istreambuf_iterator<char>(trace_file)), std::istreambuf_iterator<char>()));
+	const nlohmann::json &trace_events_json = trace_json["traceEvents"];
+	ASSERT_EQ(trace_events_json.size(), 3);
+
+	// Both ends of the async span keep the high bits of the id, only the begin has the args
+	EXPECT_EQ(trace_events_json[0]["ph"], "b");
+	EXPECT_EQ(trace_events_json[0]["id"], "0x100000002");
+	EXPECT_EQ(trace_events_json[0]["args"]["url"], "https://api.mod.io/v1/games/7/mods");
+	EXPECT_EQ(trace_events_json[0]["args"]["response_code"], 0);
+	EXPECT_EQ(trace_events_json[0]["args"]["mod_id"], 42);
+	EXPECT_EQ(trace_events_json[1]["ph"], "e");
+	EXPECT_EQ(trace_events_json[1]["id"], "0x100000002");
+	EXPECT_EQ(trace_events_json[1].count("args"), 0);
+
+	EXPECT_EQ(trace_events_json[2]["ph"], "X");
+	EXPECT_EQ(trace_events_json[2]["dur"], 5.0);
+	EXPECT_EQ(trace_events_json[2].count("args"), 0);
+	trace_file.close();
+	remove(TEST_TRACE_PATH);
+}
@@ -0,0 +1,91 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "modio.h"
+#include "json_examples.h"
+
+#define TEST_REPLAY_DIRECTORY "test_replay_records/"
+#define TEST_MODS_URL "https://api.mod.io/v1/games/7/mods?_limit=100&api_key=key"
+
+struct ReplayedCall
+{
+	u32 call_number;
+	u32 response_code;
+	nlohmann::json response_json;
+};
+
+static modio::curlwrapper::JsonRequestCallback getReplayCallback(std::vector<ReplayedCall> &replayed_calls)
+{
+	return [&replayed_calls](u32 call_number, u32 response_code, nlohmann::json response_json) {
+		ReplayedCall replayed_call;
+		replayed_call.call_number = call_number;
+		replayed_call.response_code = response_code;
+		replayed_call.response_json = response_json;
+		replayed_calls.push_back(replayed_call);
+	};
+}
+
+static void processUntilDelivered(modio::curlwrapper::ReplayTransport &transport)
+{
+	for (u32 i = 0; i < 1000 && transport.getPendingCount() > 0; i++)
+	{
+		transport.process();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+TEST(ReplayTransport, TestReplaysRecordedSession)
+{
+	modio::removeDirectory(TEST_REPLAY_DIRECTORY);
+	modio::curlwrapper::ReplayTransport transport(TEST_REPLAY_DIRECTORY, MODIO_TRANSPORT_RECORD);
+	nlohmann::json page_json;
+	page_json["data"] = nlohmann::json::array({mod_json});
+	page_json["result_count"] = 1;
+	transport.storeRecord("GET", TEST_MODS_URL, "", 200, page_json);
+	transport.storeRecord("GET", std::string(TEST_MODS_URL) + "&_offset=100", "", 404, error_json);
+
+	modio::curlwrapper::ReplayTransport replay_transport(TEST_REPLAY_DIRECTORY, MODIO_TRANSPORT_REPLAY);
+	std::vector<ReplayedCall> replayed_calls;
+	replay_transport.get(1, TEST_MODS_URL, std::vector<std::string>(), getReplayCallback(replayed_calls));
+	replay_transport.get(2, std::string(TEST_MODS_URL) + "&_offset=100", std::vector<std::string>(), getReplayCallback(replayed_calls));
+	replay_transport.get(3, std::string(TEST_MODS_URL) + "&_offset=200", std::vector<std::string>(), getReplayCallback(replayed_calls));
+	EXPECT_EQ(replay_transport.getPendingCount(), 3);
+	processUntilDelivered(replay_transport);
+
+	ASSERT_EQ(replayed_calls.size(), 3);
+	EXPECT_EQ(replayed_calls[0].call_number, 1);
+	EXPECT_EQ(replayed_calls[0].response_code, 200);
+	EXPECT_EQ(replayed_calls[0].response_json, page_json);
+	EXPECT_EQ(replayed_calls[1].call_number, 2);
+	EXPECT_EQ(replayed_calls[1].response_code, 404);
+	EXPECT_EQ(replayed_calls[1].response_json, error_json);
+	// Calls that were never recorded fail like an unreachable server
+	EXPECT_EQ(replayed_calls[2].call_number, 3);
+	EXPECT_EQ(replayed_calls[2].response_code, 0);
+
+	modio::removeDirectory(TEST_REPLAY_DIRECTORY);
+}
+
+TEST(ReplayTransport, TestDeliversByDueTime)
+{
+	modio::removeDirectory(TEST_REPLAY_DIRECTORY);
+	modio::curlwrapper::ReplayTransport transport(TEST_REPLAY_DIRECTORY, MODIO_TRANSPORT_RECORD);
+	transport.storeRecord("GET", TEST_MODS_URL, "", 200, mod_json);
+
+	modio::curlwrapper::ReplayTransport replay_transport(TEST_REPLAY_DIRECTORY, MODIO_TRANSPORT_REPLAY);
+	std::vector<ReplayedCall> replayed_calls;
+	replay_transport.setLatency(60000);
+	replay_transport.get(1, TEST_MODS_URL, std::vector<std::string>(), getReplayCallback(replayed_calls));
+	replay_transport.setLatency(0);
+	replay_transport.get(2, TEST_MODS_URL, std::vector<std::string>(), getReplayCallback(replayed_calls));
+	std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	replay_transport.process();
+
+	// The slow reply made first does not hold back the one due now
+	ASSERT_EQ(replayed_calls.size(), 1);
+	EXPECT_EQ(replayed_calls[0].call_number, 2);
+	EXPECT_EQ(replay_transport.getPendingCount(), 1);
+
+	replay_transport.shutdown();
+	EXPECT_EQ(replay_transport.getPendingCount(), 0);
+	modio::removeDirectory(TEST_REPLAY_DIRECTORY);
+}